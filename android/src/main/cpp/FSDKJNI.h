@@ -0,0 +1,223 @@
+#pragma once
+
+#include <jni.h>
+
+#include "LuxandFaceSDK.h"
+#include "FSDKFrameConversion.h"
+#include "FSDKQualityFilter.h"
+
+// Conversions between the Java classes declared in com.luxand.FSDK and the FaceSDK C structures.
+namespace fsdk::jni {
+
+inline int GetIntField(JNIEnv* env, jobject object, const char* name) {
+    jclass cls = env->GetObjectClass(object);
+    const jint value = env->GetIntField(object, env->GetFieldID(cls, name, "I"));
+    env->DeleteLocalRef(cls);
+    return value;
+}
+
+inline void SetIntField(JNIEnv* env, jobject object, const char* name, int value) {
+    jclass cls = env->GetObjectClass(object);
+    env->SetIntField(object, env->GetFieldID(cls, name, "I"), value);
+    env->DeleteLocalRef(cls);
+}
+
+inline HImage GetImage(JNIEnv* env, jobject image) {
+    return (HImage)GetIntField(env, image, "himage");
+}
+
+inline void SetImage(JNIEnv* env, jobject image, HImage handle) {
+    SetIntField(env, image, "himage", (int)handle);
+}
+
+inline int GetTracker(JNIEnv* env, jobject tracker) {
+    return GetIntField(env, tracker, "htracker");
+}
+
+inline void SetPoint(JNIEnv* env, jobject point, const TPoint& value) {
+    SetIntField(env, point, "x", value.x);
+    SetIntField(env, point, "y", value.y);
+}
+
+inline TPoint GetPoint(JNIEnv* env, jobject point) {
+    return TPoint{GetIntField(env, point, "x"), GetIntField(env, point, "y")};
+}
+
+inline void SetFace(JNIEnv* env, jobject face, const TFace& value) {
+    jclass faceClass = env->GetObjectClass(face);
+
+    jobject bbox = env->GetObjectField(face, env->GetFieldID(faceClass, "bbox", "Lcom/luxand/FSDK$BBox;"));
+    jclass bboxClass = env->GetObjectClass(bbox);
+    jobject p0 = env->GetObjectField(bbox, env->GetFieldID(bboxClass, "p0", "Lcom/luxand/FSDK$TPoint;"));
+    jobject p1 = env->GetObjectField(bbox, env->GetFieldID(bboxClass, "p1", "Lcom/luxand/FSDK$TPoint;"));
+    SetPoint(env, p0, value.bbox.p0);
+    SetPoint(env, p1, value.bbox.p1);
+
+    auto features = (jobjectArray)env->GetObjectField(face, env->GetFieldID(faceClass, "features", "[Lcom/luxand/FSDK$TPoint;"));
+    for (int i = 0; i < 5; ++i) {
+        jobject point = env->GetObjectArrayElement(features, i);
+        SetPoint(env, point, value.features[i]);
+        env->DeleteLocalRef(point);
+    }
+
+    env->DeleteLocalRef(features);
+    env->DeleteLocalRef(p1);
+    env->DeleteLocalRef(p0);
+    env->DeleteLocalRef(bboxClass);
+    env->DeleteLocalRef(bbox);
+    env->DeleteLocalRef(faceClass);
+}
+
+inline jobject NewFace(JNIEnv* env, const TFace& value) {
+    jclass faceClass = env->FindClass("com/luxand/FSDK$TFace");
+    jobject face = env->NewObject(faceClass, env->GetMethodID(faceClass, "<init>", "()V"));
+    SetFace(env, face, value);
+    env->DeleteLocalRef(faceClass);
+    return face;
+}
+
+inline TFace GetFace(JNIEnv* env, jobject face) {
+    TFace result = {};
+    jclass faceClass = env->GetObjectClass(face);
+
+    jobject bbox = env->GetObjectField(face, env->GetFieldID(faceClass, "bbox", "Lcom/luxand/FSDK$BBox;"));
+    jclass bboxClass = env->GetObjectClass(bbox);
+    jobject p0 = env->GetObjectField(bbox, env->GetFieldID(bboxClass, "p0", "Lcom/luxand/FSDK$TPoint;"));
+    jobject p1 = env->GetObjectField(bbox, env->GetFieldID(bboxClass, "p1", "Lcom/luxand/FSDK$TPoint;"));
+    result.bbox.p0 = GetPoint(env, p0);
+    result.bbox.p1 = GetPoint(env, p1);
+
+    auto features = (jobjectArray)env->GetObjectField(face, env->GetFieldID(faceClass, "features", "[Lcom/luxand/FSDK$TPoint;"));
+    for (int i = 0; i < 5; ++i) {
+        jobject point = env->GetObjectArrayElement(features, i);
+        result.features[i] = GetPoint(env, point);
+        env->DeleteLocalRef(point);
+    }
+
+    env->DeleteLocalRef(features);
+    env->DeleteLocalRef(p1);
+    env->DeleteLocalRef(p0);
+    env->DeleteLocalRef(bboxClass);
+    env->DeleteLocalRef(bbox);
+    env->DeleteLocalRef(faceClass);
+    return result;
+}
+
+inline void SetFaces(JNIEnv* env, jobject faces, const TFace* values, int count) {
+    jclass facesClass = env->GetObjectClass(faces);
+    jclass faceClass = env->FindClass("com/luxand/FSDK$TFace");
+    jobjectArray array = env->NewObjectArray(count, faceClass, nullptr);
+    for (int i = 0; i < count; ++i) {
+        jobject face = NewFace(env, values[i]);
+        env->SetObjectArrayElement(array, i, face);
+        env->DeleteLocalRef(face);
+    }
+    env->SetObjectField(faces, env->GetFieldID(facesClass, "faces", "[Lcom/luxand/FSDK$TFace;"), array);
+    env->DeleteLocalRef(array);
+    env->DeleteLocalRef(faceClass);
+    env->DeleteLocalRef(facesClass);
+}
+
+inline void SetFeatures(JNIEnv* env, jobject features, const TPoint* values, int count) {
+    jclass featuresClass = env->GetObjectClass(features);
+    jclass pointClass = env->FindClass("com/luxand/FSDK$TPoint");
+    jmethodID constructor = env->GetMethodID(pointClass, "<init>", "()V");
+
+    auto array = (jobjectArray)env->GetObjectField(features, env->GetFieldID(featuresClass, "features", "[Lcom/luxand/FSDK$TPoint;"));
+    for (int i = 0; i < count; ++i) {
+        jobject point = env->NewObject(pointClass, constructor);
+        SetPoint(env, point, values[i]);
+        env->SetObjectArrayElement(array, i, point);
+        env->DeleteLocalRef(point);
+    }
+
+    env->DeleteLocalRef(array);
+    env->DeleteLocalRef(pointClass);
+    env->DeleteLocalRef(featuresClass);
+}
+
+inline void GetFeatures(JNIEnv* env, jobject features, TPoint* values, int count) {
+    jclass featuresClass = env->GetObjectClass(features);
+    auto array = (jobjectArray)env->GetObjectField(features, env->GetFieldID(featuresClass, "features", "[Lcom/luxand/FSDK$TPoint;"));
+    for (int i = 0; i < count; ++i) {
+        jobject point = env->GetObjectArrayElement(array, i);
+        values[i] = point ? GetPoint(env, point) : TPoint{0, 0};
+        env->DeleteLocalRef(point);
+    }
+    env->DeleteLocalRef(array);
+    env->DeleteLocalRef(featuresClass);
+}
+
+inline void SetFaceTemplate(JNIEnv* env, jobject faceTemplate, const FSDK_FaceTemplate& value) {
+    jclass templateClass = env->GetObjectClass(faceTemplate);
+    auto array = (jbyteArray)env->GetObjectField(faceTemplate, env->GetFieldID(templateClass, "template", "[B"));
+    env->SetByteArrayRegion(array, 0, sizeof(value.ftemplate), (const jbyte*)value.ftemplate);
+    env->DeleteLocalRef(array);
+    env->DeleteLocalRef(templateClass);
+}
+
+inline FSDK_FaceTemplate GetFaceTemplate(JNIEnv* env, jobject faceTemplate) {
+    FSDK_FaceTemplate result = {};
+    jclass templateClass = env->GetObjectClass(faceTemplate);
+    auto array = (jbyteArray)env->GetObjectField(faceTemplate, env->GetFieldID(templateClass, "template", "[B"));
+    const jsize length = env->GetArrayLength(array);
+    env->GetByteArrayRegion(array, 0, length < (jsize)sizeof(result.ftemplate) ? length : sizeof(result.ftemplate), (jbyte*)result.ftemplate);
+    env->DeleteLocalRef(array);
+    env->DeleteLocalRef(templateClass);
+    return result;
+}
+
+inline void SetInt(JNIEnv* env, jintArray array, int value) {
+    const jint element = value;
+    env->SetIntArrayRegion(array, 0, 1, &element);
+}
+
+inline void SetLong(JNIEnv* env, jlongArray array, long long value) {
+    const jlong element = value;
+    env->SetLongArrayRegion(array, 0, 1, &element);
+}
+
+// Scores are stored in the order of the QualityScores fields
+inline void SetQualityScores(JNIEnv* env, jdoubleArray scores, const QualityScores& value) {
+    const jdouble values[8] = {value.sharpness, value.brightness, value.darkFraction, value.brightFraction,
+                               value.eyeDistance, value.roll, value.yaw, (jdouble)value.failed};
+    env->SetDoubleArrayRegion(scores, 0, 8, values);
+}
+
+inline void SetString(JNIEnv* env, jobjectArray array, const char* value) {
+    jstring string = env->NewStringUTF(value);
+    env->SetObjectArrayElement(array, 0, string);
+    env->DeleteLocalRef(string);
+}
+
+// Describes a plane stored in a direct ByteBuffer (i.e. android.media.Image.Plane) without copying it.
+// Non-direct buffers produce a plane without data, which the conversion functions reject.
+inline ImagePlane GetPlane(JNIEnv* env, jobject buffer, int rowStride, int pixelStride) {
+    ImagePlane plane = {nullptr, 0, rowStride, pixelStride};
+    if (buffer) {
+        plane.data = static_cast<const unsigned char*>(env->GetDirectBufferAddress(buffer));
+        plane.size = plane.data ? env->GetDirectBufferCapacity(buffer) : 0;
+    }
+    return plane;
+}
+
+// Holds the UTF-8 characters of a Java string for the lifetime of the object.
+class StringChars {
+public:
+    StringChars(JNIEnv* env, jstring string) : env(env), string(string), chars(string ? env->GetStringUTFChars(string, nullptr) : nullptr) {}
+    ~StringChars() {
+        if (chars)
+            env->ReleaseStringUTFChars(string, chars);
+    }
+    StringChars(const StringChars&) = delete;
+    StringChars& operator=(const StringChars&) = delete;
+
+    const char* c_str() const { return chars ? chars : ""; }
+
+private:
+    JNIEnv* env;
+    jstring string;
+    const char* chars;
+};
+
+}
@@ -0,0 +1,650 @@
+#include <jni.h>
+
+#include <cmath>
+#include <vector>
+
+#include "FSDKJNI.h"
+#include "FSDKTiledDetection.h"
+#include "FSDKAnalysisContext.h"
+#include "FSDKTrace.h"
+#include "FSDKFrameConversion.h"
+#include "FSDKFrameRecording.h"
+#include "FSDKTemplateCache.h"
+#include "FSDKThumbnailStore.h"
+#include "FSDKFaceAtlas.h"
+#include "FSDKKeyframeTracker.h"
+#include "FSDKMemoryGovernor.h"
+#include "FSDKResultSlot.h"
+#include "FSDKTrackerLock.h"
+#include "FSDKQualityFilter.h"
+#include "FSDKInitialization.h"
+#include "FSDKFaceIndex.h"
+#include "FSDKParameters.h"
+#include "bindings/FSDKJSIBindings.h"
+
+using namespace fsdk::jni;
+
+extern "C" {
+
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_DetectMultipleFacesTiled(JNIEnv* env, jclass, jobject image, jint tileSize, jint overlap, jint threads,
+                                                                           jboolean fullImagePass, jfloat iouThreshold, jobject faces) {
+    fsdk::TiledDetectionParameters parameters;
+    parameters.tileSize = tileSize;
+    parameters.overlap = overlap;
+    parameters.threads = threads;
+    parameters.fullImagePass = fullImagePass;
+    parameters.iouThreshold = iouThreshold;
+
+    const int maxFaces = GetIntField(env, faces, "maxFaces");
+    std::vector<TFace> result(maxFaces > 0 ? maxFaces : 0);
+
+    int count = 0;
+    const int errorCode = fsdk::DetectMultipleFacesTiled(GetImage(env, image), parameters, &count, result.data(), (int)(sizeof(TFace) * result.size()));
+    SetFaces(env, faces, result.data(), count);
+    return errorCode;
+}
+
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_CreateAnalysisContext(JNIEnv* env, jclass, jobject image, jintArray context) {
+    fsdk::HAnalysisContext value = 0;
+    const int errorCode = fsdk::CreateAnalysisContext(GetImage(env, image), &value);
+    SetInt(env, context, (int)value);
+    return errorCode;
+}
+
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_FreeAnalysisContext(JNIEnv*, jclass, jint context) {
+    return fsdk::FreeAnalysisContext(context);
+}
+
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_AnalysisContextDetectFace(JNIEnv* env, jclass, jint context, jobject face) {
+    TFace value = {};
+    const int errorCode = fsdk::AnalysisContextDetectFace(context, &value);
+    SetFace(env, face, value);
+    return errorCode;
+}
+
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_AnalysisContextDetectFacialFeatures(JNIEnv* env, jclass, jint context, jobject features) {
+    FSDK_Features value = {};
+    const int errorCode = fsdk::AnalysisContextDetectFacialFeatures(context, &value);
+    SetFeatures(env, features, value, FSDK_FACIAL_FEATURE_COUNT);
+    return errorCode;
+}
+
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_AnalysisContextDetectFacialAttribute(JNIEnv* env, jclass, jint context, jstring name, jobjectArray values, jlong maxSize) {
+    std::vector<char> value(maxSize > 0 ? maxSize : 1, 0);
+    const int errorCode = fsdk::AnalysisContextDetectFacialAttribute(context, StringChars(env, name).c_str(), value.data(), (long long)value.size());
+    SetString(env, values, errorCode == FSDKE_OK ? value.data() : "");
+    return errorCode;
+}
+
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_AnalysisContextGetFaceTemplate(JNIEnv* env, jclass, jint context, jobject faceTemplate) {
+    FSDK_FaceTemplate value = {};
+    const int errorCode = fsdk::AnalysisContextGetFaceTemplate(context, &value);
+    SetFaceTemplate(env, faceTemplate, value);
+    return errorCode;
+}
+
+JNIEXPORT void JNICALL Java_com_luxand_FSDKNative_InvalidateImageAnalysis(JNIEnv* env, jclass, jobject image) {
+    fsdk::InvalidateImageAnalysis(GetImage(env, image));
+}
+
+JNIEXPORT void JNICALL Java_com_luxand_FSDKNative_ReleaseImageAnalysis(JNIEnv* env, jclass, jobject image) {
+    fsdk::ReleaseImageAnalysis(GetImage(env, image));
+}
+
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_LoadImageFromYUV420(JNIEnv* env, jclass, jobject image,
+                                                                      jobject y, jint yRowStride, jint yPixelStride,
+                                                                      jobject u, jint uRowStride, jint uPixelStride,
+                                                                      jobject v, jint vRowStride, jint vPixelStride,
+                                                                      jint width, jint height, jint rotationDegrees, jboolean mirrored, jlong timestamp) {
+    const fsdk::ImagePlane yPlane = GetPlane(env, y, yRowStride, yPixelStride);
+    const fsdk::ImagePlane uPlane = GetPlane(env, u, uRowStride, uPixelStride);
+    const fsdk::ImagePlane vPlane = GetPlane(env, v, vRowStride, vPixelStride);
+
+    HImage value = 0;
+    const int errorCode = fsdk::LoadImageFromYUV420(&value, yPlane, uPlane, vPlane, width, height, rotationDegrees, mirrored);
+    if (errorCode == FSDKE_OK) {
+        // Recording errors are reported when the recording stops
+        fsdk::RecordYUV420Frame(yPlane, uPlane, vPlane, width, height, rotationDegrees, mirrored, timestamp, value);
+        SetImage(env, image, value);
+    }
+    return errorCode;
+}
+
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_LoadImageFromColorPlanes(JNIEnv* env, jclass, jobject image,
+                                                                           jobject first, jint firstRowStride, jint firstPixelStride,
+                                                                           jobject second, jint secondRowStride, jint secondPixelStride,
+                                                                           jobject third, jint thirdRowStride, jint thirdPixelStride,
+                                                                           jint width, jint height, jint rotationDegrees, jboolean mirrored,
+                                                                           jlong timestamp) {
+    const fsdk::ImagePlane planes[3] = {
+        GetPlane(env, first, firstRowStride, firstPixelStride),
+        GetPlane(env, second, secondRowStride, secondPixelStride),
+        GetPlane(env, third, thirdRowStride, thirdPixelStride)
+    };
+
+    HImage value = 0;
+    const int errorCode = fsdk::LoadImageFromColorPlanes(&value, planes, width, height, rotationDegrees, mirrored);
+    if (errorCode == FSDKE_OK) {
+        fsdk::RecordColorPlanesFrame(planes, width, height, rotationDegrees, mirrored, timestamp, value);
+        SetImage(env, image, value);
+    }
+    return errorCode;
+}
+
+JNIEXPORT jboolean JNICALL Java_com_luxand_FSDKNative_TraceEnabled(JNIEnv*, jclass) {
+    return fsdk::trace::Enabled();
+}
+
+JNIEXPORT void JNICALL Java_com_luxand_FSDKNative_SetTraceEnabled(JNIEnv*, jclass, jboolean enabled, jint capacity) {
+    if (enabled)
+        fsdk::trace::Enable(capacity);
+    else
+        fsdk::trace::Disable();
+}
+
+JNIEXPORT void JNICALL Java_com_luxand_FSDKNative_ClearTrace(JNIEnv*, jclass) {
+    fsdk::trace::Clear();
+}
+
+JNIEXPORT jlong JNICALL Java_com_luxand_FSDKNative_GetTraceTime(JNIEnv*, jclass) {
+    return fsdk::trace::Now();
+}
+
+JNIEXPORT void JNICALL Java_com_luxand_FSDKNative_SetTraceFrameTimestamp(JNIEnv*, jclass, jlong frameTimestamp) {
+    fsdk::trace::SetFrameTimestamp(frameTimestamp);
+}
+
+JNIEXPORT void JNICALL Java_com_luxand_FSDKNative_RecordTraceSpan(JNIEnv* env, jclass, jstring name, jlong frameTimestamp, jlong start, jlong end) {
+    if (!fsdk::trace::Enabled())
+        return;
+    fsdk::trace::RecordCopy(StringChars(env, name).c_str(), frameTimestamp, start, end);
+}
+
+JNIEXPORT jstring JNICALL Java_com_luxand_FSDKNative_DumpTrace(JNIEnv* env, jclass) {
+    return env->NewStringUTF(fsdk::trace::Dump().c_str());
+}
+
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_SaveTrace(JNIEnv* env, jclass, jstring filename) {
+    return fsdk::trace::Save(StringChars(env, filename).c_str());
+}
+
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_SetParameter(JNIEnv* env, jclass, jstring name, jstring value) {
+    return fsdk::SetParameter(StringChars(env, name).c_str(), StringChars(env, value).c_str());
+}
+
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_SetParameters(JNIEnv* env, jclass, jstring parameters, jintArray errorPosition) {
+    int position = 0;
+    const int errorCode = fsdk::SetParameters(StringChars(env, parameters).c_str(), &position);
+    SetInt(env, errorPosition, position);
+    return errorCode;
+}
+
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_SetFaceDetectionParameters(JNIEnv*, jclass, jboolean handleArbitraryRotations, jboolean determineFaceRotationAngle,
+                                                                             jint internalResizeWidth) {
+    return fsdk::SetFaceDetectionParameters(handleArbitraryRotations, determineFaceRotationAngle, internalResizeWidth);
+}
+
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_SetFaceDetectionThreshold(JNIEnv*, jclass, jint threshold) {
+    return fsdk::SetFaceDetectionThreshold(threshold);
+}
+
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_CreateTemplateCache(JNIEnv* env, jclass, jstring filename, jlong maxEntries, jstring configuration, jintArray cache) {
+    fsdk::HTemplateCache value = 0;
+    const int errorCode = fsdk::CreateTemplateCache(StringChars(env, filename).c_str(), maxEntries, StringChars(env, configuration).c_str(), &value);
+    SetInt(env, cache, (int)value);
+    return errorCode;
+}
+
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_FreeTemplateCache(JNIEnv*, jclass, jint cache) {
+    return fsdk::FreeTemplateCache(cache);
+}
+
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_SaveTemplateCache(JNIEnv*, jclass, jint cache) {
+    return fsdk::SaveTemplateCache(cache);
+}
+
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_ClearTemplateCache(JNIEnv*, jclass, jint cache) {
+    return fsdk::ClearTemplateCache(cache);
+}
+
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_GetTemplateCacheStatistics(JNIEnv* env, jclass, jint cache, jlongArray statistics) {
+    fsdk::TemplateCacheStatistics value = {};
+    const int errorCode = fsdk::GetTemplateCacheStatistics(cache, &value);
+    const jlong values[4] = {value.hits, value.misses, value.entries, value.evictions};
+    env->SetLongArrayRegion(statistics, 0, 4, values);
+    return errorCode;
+}
+
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_TemplateCacheGetFaceTemplateFromFile(JNIEnv* env, jclass, jint cache, jstring filename, jobject faceTemplate, jobject face) {
+    FSDK_FaceTemplate templateValue = {};
+    TFace faceValue = {};
+    const int errorCode = fsdk::TemplateCacheGetFaceTemplateFromFile(cache, StringChars(env, filename).c_str(), &templateValue, &faceValue);
+    SetFaceTemplate(env, faceTemplate, templateValue);
+    SetFace(env, face, faceValue);
+    return errorCode;
+}
+
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_TemplateCacheGetFaceTemplateFromBuffer(JNIEnv* env, jclass, jint cache, jbyteArray buffer, jobject faceTemplate, jobject face) {
+    FSDK_FaceTemplate templateValue = {};
+    TFace faceValue = {};
+    const jsize size = env->GetArrayLength(buffer);
+    jbyte* bytes = env->GetByteArrayElements(buffer, nullptr);
+    const int errorCode = fsdk::TemplateCacheGetFaceTemplateFromBuffer(cache, (const unsigned char*)bytes, size, &templateValue, &faceValue);
+    env->ReleaseByteArrayElements(buffer, bytes, JNI_ABORT);
+    SetFaceTemplate(env, faceTemplate, templateValue);
+    SetFace(env, face, faceValue);
+    return errorCode;
+}
+
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_TemplateCacheGetFaceTemplate(JNIEnv* env, jclass, jint cache, jobject image, jobject faceTemplate, jobject face) {
+    FSDK_FaceTemplate templateValue = {};
+    TFace faceValue = {};
+    const int errorCode = fsdk::TemplateCacheGetFaceTemplate(cache, GetImage(env, image), &templateValue, &faceValue);
+    SetFaceTemplate(env, faceTemplate, templateValue);
+    SetFace(env, face, faceValue);
+    return errorCode;
+}
+
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_CreateThumbnailStore(JNIEnv* env, jclass, jstring filename, jint maxSize, jlong maxCachedImages, jintArray store) {
+    fsdk::HThumbnailStore value = 0;
+    const int errorCode = fsdk::CreateThumbnailStore(StringChars(env, filename).c_str(), maxSize, maxCachedImages, &value);
+    SetInt(env, store, (int)value);
+    return errorCode;
+}
+
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_FreeThumbnailStore(JNIEnv*, jclass, jint store) {
+    return fsdk::FreeThumbnailStore(store);
+}
+
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_CompactThumbnailStore(JNIEnv*, jclass, jint store) {
+    return fsdk::CompactThumbnailStore(store);
+}
+
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_GetThumbnailStoreStatistics(JNIEnv* env, jclass, jint store, jlongArray statistics) {
+    fsdk::ThumbnailStoreStatistics value = {};
+    const int errorCode = fsdk::GetThumbnailStoreStatistics(store, &value);
+    const jlong values[4] = {value.thumbnails, value.fileSize, value.garbageSize, value.cachedImages};
+    env->SetLongArrayRegion(statistics, 0, 4, values);
+    return errorCode;
+}
+
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_AttachThumbnailStore(JNIEnv* env, jclass, jobject tracker, jint store) {
+    return fsdk::AttachThumbnailStore(GetTracker(env, tracker), store);
+}
+
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_SetTrackerFaceImage(JNIEnv* env, jclass, jobject tracker, jlong faceID, jobject image) {
+    return fsdk::SetTrackerFaceImage(GetTracker(env, tracker), faceID, GetImage(env, image));
+}
+
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_GetTrackerFaceImage(JNIEnv* env, jclass, jobject tracker, jlong faceID, jobject image) {
+    HImage value = 0;
+    const int errorCode = fsdk::GetTrackerFaceImage(GetTracker(env, tracker), faceID, &value);
+    if (errorCode == FSDKE_OK)
+        SetImage(env, image, value);
+    return errorCode;
+}
+
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_DeleteTrackerFaceImage(JNIEnv* env, jclass, jobject tracker, jlong faceID) {
+    return fsdk::DeleteTrackerFaceImage(GetTracker(env, tracker), faceID);
+}
+
+JNIEXPORT jbyteArray JNICALL Java_com_luxand_FSDKNative_GetTrackerFaceThumbnail(JNIEnv* env, jclass, jobject tracker, jlong faceID, jintArray errorCode) {
+    fsdk::Thumbnail thumbnail = {};
+    const int result = fsdk::GetTrackerFaceThumbnail(GetTracker(env, tracker), faceID, &thumbnail);
+    SetInt(env, errorCode, result);
+
+    // Copied once, straight from the mapped store file
+    const jsize size = result == FSDKE_OK ? (jsize)thumbnail.size : 0;
+    jbyteArray value = env->NewByteArray(size);
+    if (value && size)
+        env->SetByteArrayRegion(value, 0, size, (const jbyte*)thumbnail.data);
+    return value;
+}
+
+JNIEXPORT void JNICALL Java_com_luxand_FSDKNative_ReleaseTrackerThumbnails(JNIEnv* env, jclass, jobject tracker) {
+    fsdk::ReleaseTrackerThumbnails(GetTracker(env, tracker));
+}
+
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_PurgeID(JNIEnv* env, jclass, jobject tracker, jlong id) {
+    return fsdk::PurgeID(GetTracker(env, tracker), id);
+}
+
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_DeleteTrackerFace(JNIEnv* env, jclass, jobject tracker, jlong faceID) {
+    return fsdk::DeleteTrackerFace(GetTracker(env, tracker), faceID);
+}
+
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_ClearTracker(JNIEnv* env, jclass, jobject tracker) {
+    return fsdk::ClearTracker(GetTracker(env, tracker));
+}
+
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_GetFaceAtlasLayout(JNIEnv* env, jclass, jint count, jint width, jint height, jint imageMode, jlongArray layout) {
+    fsdk::FaceAtlasLayout value = {};
+    const int errorCode = fsdk::GetFaceAtlasLayout(count, width, height, (FSDK_IMAGEMODE)imageMode, &value);
+    const jlong values[4] = {value.channels, value.stride, value.faceSize, value.size};
+    env->SetLongArrayRegion(layout, 0, 4, values);
+    return errorCode;
+}
+
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_ExtractFaceAtlas(JNIEnv* env, jclass, jobject image, jintArray features, jint count, jint width, jint height,
+                                                                   jint imageMode, jint threads, jbyteArray atlas, jintArray resizedFeatures, jintArray errorCodes) {
+    fsdk::FaceAtlasLayout layout = {};
+    int errorCode = fsdk::GetFaceAtlasLayout(count, width, height, (FSDK_IMAGEMODE)imageMode, &layout);
+    if (errorCode != FSDKE_OK)
+        return errorCode;
+    const jsize points = count * FSDK_FACIAL_FEATURE_COUNT * 2;
+    if (env->GetArrayLength(features) < points || env->GetArrayLength(resizedFeatures) < points ||
+        env->GetArrayLength(errorCodes) < count || env->GetArrayLength(atlas) < layout.size)
+        return FSDKE_INVALID_ARGUMENT;
+
+    // Features are packed as x, y pairs, which is the layout of FSDK_Features
+    std::vector<FSDK_Features> inputFeatures(count), resultFeatures(count);
+    std::vector<int> faceErrorCodes(count);
+    static_assert(sizeof(FSDK_Features) == FSDK_FACIAL_FEATURE_COUNT * 2 * sizeof(jint), "features are packed as x, y pairs");
+    env->GetIntArrayRegion(features, 0, points, (jint*)inputFeatures.data());
+
+    jbyte* bytes = env->GetByteArrayElements(atlas, nullptr);
+    errorCode = fsdk::ExtractFaceAtlas(GetImage(env, image), inputFeatures.data(), count, width, height, (FSDK_IMAGEMODE)imageMode, threads,
+                                       (unsigned char*)bytes, resultFeatures.data(), faceErrorCodes.data());
+    env->ReleaseByteArrayElements(atlas, bytes, 0);
+
+    env->SetIntArrayRegion(resizedFeatures, 0, points, (const jint*)resultFeatures.data());
+    env->SetIntArrayRegion(errorCodes, 0, count, faceErrorCodes.data());
+    return errorCode;
+}
+
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_CreateKeyframeTracker(JNIEnv* env, jclass, jobject tracker, jint keyframeInterval, jint workingWidth,
+                                                                        jint searchRadius, jfloat minCorrelation, jintArray keyframeTracker) {
+    fsdk::KeyframeTrackerParameters parameters;
+    parameters.keyframeInterval = keyframeInterval;
+    parameters.workingWidth = workingWidth;
+    parameters.searchRadius = searchRadius;
+    parameters.minCorrelation = minCorrelation;
+
+    fsdk::HKeyframeTracker value = 0;
+    const int errorCode = fsdk::CreateKeyframeTracker(GetTracker(env, tracker), parameters, &value);
+    SetInt(env, keyframeTracker, (int)value);
+    return errorCode;
+}
+
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_FreeKeyframeTracker(JNIEnv*, jclass, jint keyframeTracker) {
+    return fsdk::FreeKeyframeTracker(keyframeTracker);
+}
+
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_KeyframeTrackerFeedFrame(JNIEnv* env, jclass, jint keyframeTracker, jlong cameraIdx, jobject image,
+                                                                           jlongArray faceCount, jlongArray ids, jbooleanArray keyframe) {
+    const jsize maxFaces = env->GetArrayLength(ids);
+    std::vector<long long> values(maxFaces);
+    long long count = 0;
+    bool isKeyframe = false;
+    const int errorCode = fsdk::KeyframeTrackerFeedFrame(keyframeTracker, cameraIdx, GetImage(env, image), &count, values.data(),
+                                                         (long long)maxFaces * sizeof(long long), &isKeyframe);
+
+    static_assert(sizeof(jlong) == sizeof(long long), "IDs are copied as is");
+    env->SetLongArrayRegion(ids, 0, (jsize)count, (const jlong*)values.data());
+    SetLong(env, faceCount, count);
+    const jboolean element = isKeyframe;
+    env->SetBooleanArrayRegion(keyframe, 0, 1, &element);
+    return errorCode;
+}
+
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_KeyframeTrackerGetFace(JNIEnv* env, jclass, jint keyframeTracker, jlong cameraIdx, jlong id, jobject face) {
+    TFace value = {};
+    const int errorCode = fsdk::KeyframeTrackerGetFace(keyframeTracker, cameraIdx, id, &value);
+    SetFace(env, face, value);
+    return errorCode;
+}
+
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_KeyframeTrackerGetFacialFeatures(JNIEnv* env, jclass, jint keyframeTracker, jlong cameraIdx, jlong id,
+                                                                                   jobject features) {
+    FSDK_Features value = {};
+    const int errorCode = fsdk::KeyframeTrackerGetFacialFeatures(keyframeTracker, cameraIdx, id, &value);
+    SetFeatures(env, features, value, FSDK_FACIAL_FEATURE_COUNT);
+    return errorCode;
+}
+
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_StartFrameRecording(JNIEnv* env, jclass, jstring filename, jboolean compressed) {
+    return fsdk::StartFrameRecording(StringChars(env, filename).c_str(), compressed);
+}
+
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_StopFrameRecording(JNIEnv* env, jclass, jlongArray statistics) {
+    fsdk::FrameRecordingStatistics value = {};
+    const int errorCode = fsdk::StopFrameRecording(&value);
+    const jlong values[2] = {value.frames, value.bytes};
+    env->SetLongArrayRegion(statistics, 0, 2, values);
+    return errorCode;
+}
+
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_AttachMemoryGovernor(JNIEnv* env, jclass, jobject tracker, jlong maxTemplates, jfloat targetRatio,
+                                                                       jdouble minIdleSeconds, jint interval) {
+    fsdk::MemoryGovernorParameters parameters;
+    parameters.maxTemplates = maxTemplates;
+    parameters.targetRatio = targetRatio;
+    parameters.minIdleSeconds = minIdleSeconds;
+    parameters.intervalMs = interval;
+    return fsdk::AttachMemoryGovernor(GetTracker(env, tracker), parameters);
+}
+
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_DetachMemoryGovernor(JNIEnv* env, jclass, jobject tracker) {
+    return fsdk::DetachMemoryGovernor(GetTracker(env, tracker));
+}
+
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_GetMemoryGovernorStatistics(JNIEnv* env, jclass, jobject tracker, jlongArray statistics) {
+    fsdk::MemoryGovernorStatistics value = {};
+    const int errorCode = fsdk::GetMemoryGovernorStatistics(GetTracker(env, tracker), &value);
+    const jlong values[6] = {value.ids, value.templates, value.protectedIDs, value.evictedIDs, value.evictedTemplates, value.sweeps};
+    env->SetLongArrayRegion(statistics, 0, 6, values);
+    return errorCode;
+}
+
+JNIEXPORT void JNICALL Java_com_luxand_FSDKNative_TrackerFrameFed(JNIEnv* env, jclass, jobject tracker, jlong cameraIdx, jint errorCode, jlongArray ids,
+                                                                  jlong count) {
+    std::vector<long long> values(errorCode == FSDKE_OK ? (size_t)count : 0);
+    if (!values.empty())
+        env->GetLongArrayRegion(ids, 0, (jsize)values.size(), (jlong*)values.data());
+    const HTracker handle = GetTracker(env, tracker);
+    fsdk::MemoryGovernorFrameFed(handle, errorCode, values.data(), (long long)values.size());
+    fsdk::ResultSlotFrameFed(handle, cameraIdx, errorCode, values.data(), (long long)values.size());
+}
+
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_LockTrackerID(JNIEnv* env, jclass, jobject tracker, jlong id) {
+    return fsdk::LockTrackerID(GetTracker(env, tracker), id);
+}
+
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_UnlockTrackerID(JNIEnv* env, jclass, jobject tracker, jlong id) {
+    return fsdk::UnlockTrackerID(GetTracker(env, tracker), id);
+}
+
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_SetTrackerName(JNIEnv* env, jclass, jobject tracker, jlong id, jstring name) {
+    return fsdk::SetTrackerName(GetTracker(env, tracker), id, StringChars(env, name).c_str());
+}
+
+JNIEXPORT void JNICALL Java_com_luxand_FSDKNative_ClearTrackerIDs(JNIEnv* env, jclass, jobject tracker) {
+    fsdk::ClearTrackerIDs(GetTracker(env, tracker));
+}
+
+JNIEXPORT void JNICALL Java_com_luxand_FSDKNative_ReleaseTrackerMemoryGovernor(JNIEnv* env, jclass, jobject tracker) {
+    fsdk::ReleaseTrackerMemoryGovernor(GetTracker(env, tracker));
+}
+
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_CreateResultSlot(JNIEnv* env, jclass, jint maxFaces, jstring attributes, jintArray slot) {
+    fsdk::HResultSlot value = 0;
+    const int errorCode = fsdk::CreateResultSlot(maxFaces, StringChars(env, attributes).c_str(), &value);
+    SetInt(env, slot, (int)value);
+    return errorCode;
+}
+
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_FreeResultSlot(JNIEnv*, jclass, jint slot) {
+    return fsdk::FreeResultSlot(slot);
+}
+
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_AttachResultSlot(JNIEnv* env, jclass, jobject tracker, jint slot) {
+    return fsdk::AttachResultSlot(GetTracker(env, tracker), slot);
+}
+
+JNIEXPORT void JNICALL Java_com_luxand_FSDKNative_ReleaseTrackerResultSlot(JNIEnv* env, jclass, jobject tracker) {
+    fsdk::ReleaseTrackerResultSlot(GetTracker(env, tracker));
+}
+
+// The lock is returned to Kotlin as a pointer and must be unlocked on the thread that took it
+JNIEXPORT jlong JNICALL Java_com_luxand_FSDKNative_LockTracker(JNIEnv* env, jclass, jobject tracker, jboolean exclusive) {
+    return (jlong)new fsdk::TrackerLock(GetTracker(env, tracker), exclusive ? fsdk::TrackerLock::EXCLUSIVE : fsdk::TrackerLock::SHARED);
+}
+
+JNIEXPORT void JNICALL Java_com_luxand_FSDKNative_UnlockTracker(JNIEnv*, jclass, jlong lock) {
+    delete (fsdk::TrackerLock*)lock;
+}
+
+JNIEXPORT void JNICALL Java_com_luxand_FSDKNative_ReleaseTrackerLock(JNIEnv* env, jclass, jobject tracker) {
+    fsdk::ReleaseTrackerLock(GetTracker(env, tracker));
+}
+
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_CreateQualityFilter(JNIEnv* env, jclass, jdouble minSharpness, jdouble minBrightness, jdouble maxBrightness,
+                                                                      jdouble maxClippedFraction, jdouble minEyeDistance, jdouble maxRoll, jdouble maxYaw,
+                                                                      jintArray filter) {
+    fsdk::QualityFilterParameters parameters;
+    parameters.minSharpness = minSharpness;
+    parameters.minBrightness = minBrightness;
+    parameters.maxBrightness = maxBrightness;
+    parameters.maxClippedFraction = maxClippedFraction;
+    parameters.minEyeDistance = minEyeDistance;
+    parameters.maxRoll = maxRoll;
+    parameters.maxYaw = maxYaw;
+
+    fsdk::HQualityFilter value = 0;
+    const int errorCode = fsdk::CreateQualityFilter(parameters, &value);
+    SetInt(env, filter, (int)value);
+    return errorCode;
+}
+
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_FreeQualityFilter(JNIEnv*, jclass, jint filter) {
+    return fsdk::FreeQualityFilter(filter);
+}
+
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_QualityFilterEvaluate(JNIEnv* env, jclass, jint filter, jobject image, jobject face, jdoubleArray scores) {
+    const TFace faceValue = GetFace(env, face);
+    fsdk::QualityScores value = {};
+    const int errorCode = fsdk::QualityFilterEvaluate(filter, GetImage(env, image), &faceValue, &value);
+    SetQualityScores(env, scores, value);
+    return errorCode;
+}
+
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_QualityFilterEvaluateTrackerFace(JNIEnv* env, jclass, jint filter, jobject tracker, jlong cameraIdx, jlong id,
+                                                                                   jobject image, jdoubleArray scores) {
+    fsdk::QualityScores value = {};
+    const int errorCode = fsdk::QualityFilterEvaluateTrackerFace(filter, GetTracker(env, tracker), cameraIdx, id, GetImage(env, image), &value);
+    SetQualityScores(env, scores, value);
+    return errorCode;
+}
+
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_QualityFilterGetFaceTemplate(JNIEnv* env, jclass, jint filter, jobject image, jobject face,
+                                                                               jobject faceTemplate, jdoubleArray scores) {
+    const TFace faceValue = GetFace(env, face);
+    FSDK_FaceTemplate templateValue = {};
+    fsdk::QualityScores value = {};
+    const int errorCode = fsdk::QualityFilterGetFaceTemplate(filter, GetImage(env, image), &faceValue, &templateValue, &value);
+    SetFaceTemplate(env, faceTemplate, templateValue);
+    SetQualityScores(env, scores, value);
+    return errorCode;
+}
+
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_StartInitialization(JNIEnv* env, jclass, jstring prefetchDirectories, jstring livenessModel, jboolean warmUp,
+                                                                      jstring trackerParameters) {
+    fsdk::InitializationParameters parameters;
+    parameters.prefetchDirectories = StringChars(env, prefetchDirectories).c_str();
+    parameters.livenessModel = StringChars(env, livenessModel).c_str();
+    parameters.warmUp = warmUp;
+    parameters.trackerParameters = StringChars(env, trackerParameters).c_str();
+    return fsdk::StartInitialization(parameters);
+}
+
+// Durations are passed in microseconds
+JNIEXPORT void JNICALL Java_com_luxand_FSDKNative_GetInitializationStatus(JNIEnv* env, jclass, jlongArray status) {
+    fsdk::InitializationStatus value;
+    fsdk::GetInitializationStatus(&value);
+    const jlong values[11] = {value.state,
+                              value.errorCode,
+                              value.prefetchedFiles,
+                              value.prefetchedBytes,
+                              std::llround(value.prefetchSeconds * 1e6),
+                              std::llround(value.initializeSeconds * 1e6),
+                              std::llround(value.livenessSeconds * 1e6),
+                              std::llround(value.detectionSeconds * 1e6),
+                              std::llround(value.templateSeconds * 1e6),
+                              std::llround(value.trackerSeconds * 1e6),
+                              std::llround(value.totalSeconds * 1e6)};
+    env->SetLongArrayRegion(status, 0, 11, values);
+}
+
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_CreateFaceIndex(JNIEnv* env, jclass, jstring filename, jint maxConnections, jint efConstruction, jint efSearch,
+                                                                  jintArray index) {
+    fsdk::FaceIndexParameters parameters;
+    parameters.maxConnections = maxConnections;
+    parameters.efConstruction = efConstruction;
+    parameters.efSearch = efSearch;
+
+    fsdk::HFaceIndex value = 0;
+    const int errorCode = fsdk::CreateFaceIndex(StringChars(env, filename).c_str(), parameters, &value);
+    SetInt(env, index, (int)value);
+    return errorCode;
+}
+
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_FreeFaceIndex(JNIEnv*, jclass, jint index) {
+    return fsdk::FreeFaceIndex(index);
+}
+
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_SaveFaceIndex(JNIEnv*, jclass, jint index) {
+    return fsdk::SaveFaceIndex(index);
+}
+
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_FaceIndexAddFaceTemplate(JNIEnv* env, jclass, jint index, jlong id, jobject faceTemplate) {
+    const FSDK_FaceTemplate value = GetFaceTemplate(env, faceTemplate);
+    return fsdk::FaceIndexAddFaceTemplate(index, id, &value);
+}
+
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_FaceIndexAddTrackerFaces(JNIEnv* env, jclass, jint index, jobject tracker, jlongArray count) {
+    long long value = 0;
+    const int errorCode = fsdk::FaceIndexAddTrackerFaces(index, GetTracker(env, tracker), &value);
+    SetLong(env, count, value);
+    return errorCode;
+}
+
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_FaceIndexRemoveID(JNIEnv*, jclass, jint index, jlong id) {
+    return fsdk::FaceIndexRemoveID(index, id);
+}
+
+// The matches are returned as parallel arrays sized for the maximal number of matches
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_FaceIndexMatchFaces(JNIEnv* env, jclass, jint index, jobject faceTemplate, jfloat threshold, jlongArray ids,
+                                                                      jfloatArray similarities, jlongArray count) {
+    const FSDK_FaceTemplate value = GetFaceTemplate(env, faceTemplate);
+    const jsize maxCount = env->GetArrayLength(ids);
+    std::vector<IDSimilarity> matches(maxCount > 0 ? (size_t)maxCount : 1);
+    long long matched = 0;
+    const int errorCode = fsdk::FaceIndexMatchFaces(index, &value, threshold, matches.data(), &matched, maxCount * (long long)sizeof(IDSimilarity));
+
+    for (long long i = 0; errorCode == FSDKE_OK && i < matched; ++i) {
+        const jlong id = matches[i].ID;
+        const jfloat similarity = matches[i].similarity;
+        env->SetLongArrayRegion(ids, (jsize)i, 1, &id);
+        env->SetFloatArrayRegion(similarities, (jsize)i, 1, &similarity);
+    }
+    SetLong(env, count, errorCode == FSDKE_OK ? matched : 0);
+    return errorCode;
+}
+
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_GetFaceIndexStatistics(JNIEnv* env, jclass, jint index, jlongArray statistics) {
+    fsdk::FaceIndexStatistics value = {};
+    const int errorCode = fsdk::GetFaceIndexStatistics(index, &value);
+    const jlong values[5] = {value.templates, value.ids, value.removed, value.searches, value.comparisons};
+    env->SetLongArrayRegion(statistics, 0, 5, values);
+    return errorCode;
+}
+
+// The runtime pointer comes from ReactContext.javaScriptContextHolder, the call is made on the JavaScript thread
+JNIEXPORT jint JNICALL Java_com_luxand_FSDKNative_InstallJSIBindings(JNIEnv*, jclass, jlong runtime) {
+    if (!runtime)
+        return FSDKE_FAILED;
+    fsdk::InstallJSIBindings(*reinterpret_cast<facebook::jsi::Runtime*>(runtime));
+    return FSDKE_OK;
+}
+
+}
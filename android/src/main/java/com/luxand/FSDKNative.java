@@ -0,0 +1,122 @@
+/*
+ * Native extensions built on top of the FaceSDK Library
+ * Copyright (C) 2025 Luxand, Inc.
+ */
+
+package com.luxand;
+
+import java.nio.ByteBuffer;
+
+public class FSDKNative
+{
+	static {
+		System.loadLibrary("fsdk");
+		System.loadLibrary("luxandfacesdk");
+	}
+
+	public static native int DetectMultipleFacesTiled(FSDK.HImage Image, int TileSize, int Overlap, int NumThreads, boolean FullImagePass, float IoUThreshold, FSDK.TFaces2 faces);
+
+	public static native int CreateAnalysisContext(FSDK.HImage Image, int Context[]);
+	public static native int FreeAnalysisContext(int Context);
+	public static native int AnalysisContextDetectFace(int Context, FSDK.TFace Face);
+	public static native int AnalysisContextDetectFacialFeatures(int Context, FSDK.FSDK_Features FacialFeatures);
+	public static native int AnalysisContextDetectFacialAttribute(int Context, String AttributeName, String AttributeValues[], long MaxSizeInBytes);
+	public static native int AnalysisContextGetFaceTemplate(int Context, FSDK.FSDK_FaceTemplate FaceTemplate);
+	public static native void InvalidateImageAnalysis(FSDK.HImage Image);
+	public static native void ReleaseImageAnalysis(FSDK.HImage Image);
+
+	public static native int LoadImageFromYUV420(FSDK.HImage Image, ByteBuffer Y, int YRowStride, int YPixelStride, ByteBuffer U, int URowStride, int UPixelStride,
+		ByteBuffer V, int VRowStride, int VPixelStride, int Width, int Height, int RotationDegrees, boolean Mirrored, long Timestamp);
+	public static native int LoadImageFromColorPlanes(FSDK.HImage Image, ByteBuffer First, int FirstRowStride, int FirstPixelStride, ByteBuffer Second, int SecondRowStride, int SecondPixelStride,
+		ByteBuffer Third, int ThirdRowStride, int ThirdPixelStride, int Width, int Height, int RotationDegrees, boolean Mirrored, long Timestamp);
+
+	public static native int StartFrameRecording(String FileName, boolean Compressed);
+	public static native int StopFrameRecording(long Statistics[]);
+
+	public static native boolean TraceEnabled();
+	public static native void SetTraceEnabled(boolean Enabled, int Capacity);
+	public static native void ClearTrace();
+	public static native long GetTraceTime();
+	public static native void SetTraceFrameTimestamp(long FrameTimestamp);
+	public static native void RecordTraceSpan(String Name, long FrameTimestamp, long Start, long End);
+	public static native String DumpTrace();
+	public static native int SaveTrace(String FileName);
+
+	public static native int SetParameter(String Name, String Value);
+	public static native int SetParameters(String Parameters, int ErrorPosition[]);
+	public static native int SetFaceDetectionParameters(boolean HandleArbitraryRotations, boolean DetermineFaceRotationAngle, int InternalResizeWidth);
+	public static native int SetFaceDetectionThreshold(int Threshold);
+
+	public static native int CreateTemplateCache(String FileName, long MaxEntries, String Configuration, int Cache[]);
+	public static native int FreeTemplateCache(int Cache);
+	public static native int SaveTemplateCache(int Cache);
+	public static native int ClearTemplateCache(int Cache);
+	public static native int GetTemplateCacheStatistics(int Cache, long Statistics[]);
+	public static native int TemplateCacheGetFaceTemplateFromFile(int Cache, String FileName, FSDK.FSDK_FaceTemplate FaceTemplate, FSDK.TFace Face);
+	public static native int TemplateCacheGetFaceTemplateFromBuffer(int Cache, byte Buffer[], FSDK.FSDK_FaceTemplate FaceTemplate, FSDK.TFace Face);
+	public static native int TemplateCacheGetFaceTemplate(int Cache, FSDK.HImage Image, FSDK.FSDK_FaceTemplate FaceTemplate, FSDK.TFace Face);
+
+	public static native int CreateThumbnailStore(String FileName, int MaxSize, long MaxCachedImages, int Store[]);
+	public static native int FreeThumbnailStore(int Store);
+	public static native int CompactThumbnailStore(int Store);
+	public static native int GetThumbnailStoreStatistics(int Store, long Statistics[]);
+	public static native int AttachThumbnailStore(FSDK.HTracker Tracker, int Store);
+	public static native int SetTrackerFaceImage(FSDK.HTracker Tracker, long FaceID, FSDK.HImage Image);
+	public static native int GetTrackerFaceImage(FSDK.HTracker Tracker, long FaceID, FSDK.HImage Image);
+	public static native int DeleteTrackerFaceImage(FSDK.HTracker Tracker, long FaceID);
+	public static native byte[] GetTrackerFaceThumbnail(FSDK.HTracker Tracker, long FaceID, int ErrorCode[]);
+	public static native void ReleaseTrackerThumbnails(FSDK.HTracker Tracker);
+	public static native int PurgeID(FSDK.HTracker Tracker, long ID);
+	public static native int DeleteTrackerFace(FSDK.HTracker Tracker, long FaceID);
+	public static native int ClearTracker(FSDK.HTracker Tracker);
+
+	public static native int AttachMemoryGovernor(FSDK.HTracker Tracker, long MaxTemplates, float TargetRatio, double MinIdleSeconds, int Interval);
+	public static native int DetachMemoryGovernor(FSDK.HTracker Tracker);
+	public static native int GetMemoryGovernorStatistics(FSDK.HTracker Tracker, long Statistics[]);
+	public static native int LockTrackerID(FSDK.HTracker Tracker, long ID);
+	public static native int UnlockTrackerID(FSDK.HTracker Tracker, long ID);
+	public static native int SetTrackerName(FSDK.HTracker Tracker, long ID, String Name);
+	public static native void ClearTrackerIDs(FSDK.HTracker Tracker);
+	public static native void ReleaseTrackerMemoryGovernor(FSDK.HTracker Tracker);
+
+	public static native int CreateResultSlot(int MaxFaces, String Attributes, int Slot[]);
+	public static native int FreeResultSlot(int Slot);
+	public static native int AttachResultSlot(FSDK.HTracker Tracker, int Slot);
+	public static native void ReleaseTrackerResultSlot(FSDK.HTracker Tracker);
+	public static native int InstallJSIBindings(long Runtime);
+	public static native void TrackerFrameFed(FSDK.HTracker Tracker, long CameraIdx, int ErrorCode, long IDs[], long Count);
+
+	public static native long LockTracker(FSDK.HTracker Tracker, boolean Exclusive);
+	public static native void UnlockTracker(long Lock);
+	public static native void ReleaseTrackerLock(FSDK.HTracker Tracker);
+
+	public static native int CreateQualityFilter(double MinSharpness, double MinBrightness, double MaxBrightness, double MaxClippedFraction,
+		double MinEyeDistance, double MaxRoll, double MaxYaw, int Filter[]);
+	public static native int FreeQualityFilter(int Filter);
+	public static native int QualityFilterEvaluate(int Filter, FSDK.HImage Image, FSDK.TFace Face, double Scores[]);
+	public static native int QualityFilterEvaluateTrackerFace(int Filter, FSDK.HTracker Tracker, long CameraIdx, long ID, FSDK.HImage Image, double Scores[]);
+	public static native int QualityFilterGetFaceTemplate(int Filter, FSDK.HImage Image, FSDK.TFace Face, FSDK.FSDK_FaceTemplate FaceTemplate, double Scores[]);
+
+	public static native int StartInitialization(String PrefetchDirectories, String LivenessModel, boolean WarmUp, String TrackerParameters);
+	public static native void GetInitializationStatus(long Status[]);
+
+	public static native int CreateFaceIndex(String FileName, int MaxConnections, int EfConstruction, int EfSearch, int Index[]);
+	public static native int FreeFaceIndex(int Index);
+	public static native int SaveFaceIndex(int Index);
+	public static native int FaceIndexAddFaceTemplate(int Index, long ID, FSDK.FSDK_FaceTemplate FaceTemplate);
+	public static native int FaceIndexAddTrackerFaces(int Index, FSDK.HTracker Tracker, long Count[]);
+	public static native int FaceIndexRemoveID(int Index, long ID);
+	public static native int FaceIndexMatchFaces(int Index, FSDK.FSDK_FaceTemplate FaceTemplate, float Threshold, long IDs[], float Similarities[], long Count[]);
+	public static native int GetFaceIndexStatistics(int Index, long Statistics[]);
+
+	public static native int GetFaceAtlasLayout(int Count, int Width, int Height, int ImageMode, long Layout[]);
+	public static native int ExtractFaceAtlas(FSDK.HImage Image, int FacialFeatures[], int Count, int Width, int Height, int ImageMode, int Threads,
+		byte Atlas[], int ResizedFeatures[], int ErrorCodes[]);
+
+	public static native int CreateKeyframeTracker(FSDK.HTracker Tracker, int KeyframeInterval, int WorkingWidth, int SearchRadius, float MinCorrelation,
+		int KeyframeTracker[]);
+	public static native int FreeKeyframeTracker(int KeyframeTracker);
+	public static native int KeyframeTrackerFeedFrame(int KeyframeTracker, long CameraIdx, FSDK.HImage Image, long FaceCount[], long IDs[], boolean Keyframe[]);
+	public static native int KeyframeTrackerGetFace(int KeyframeTracker, long CameraIdx, long ID, FSDK.TFace Face);
+	public static native int KeyframeTrackerGetFacialFeatures(int KeyframeTracker, long CameraIdx, long ID, FSDK.FSDK_Features FacialFeatures);
+}
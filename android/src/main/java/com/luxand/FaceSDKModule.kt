@@ -273,6 +273,19 @@ class FaceSDKModule(reactContext: ReactApplicationContext) : NativeFaceSDKSpec(r
     return map
   }
 
+  private fun QualityScoresToWritableMap(scores: DoubleArray): WritableMap {
+    val map = Arguments.createMap()
+    map.putDouble("sharpness", scores[0])
+    map.putDouble("brightness", scores[1])
+    map.putDouble("darkFraction", scores[2])
+    map.putDouble("brightFraction", scores[3])
+    map.putDouble("eyeDistance", scores[4])
+    map.putDouble("roll", scores[5])
+    map.putDouble("yaw", scores[6])
+    map.putInt("failed", scores[7].toInt())
+    return map
+  }
+
   private fun ReadableMapToFace(map: ReadableMap): FSDK.TFace {
     val bbox = map.getMap("bbox")
     val features = map.getArray("features")
@@ -318,6 +331,30 @@ class FaceSDKModule(reactContext: ReactApplicationContext) : NativeFaceSDKSpec(r
     return map
   }
 
+  private inline fun <T> Traced(name: String, function: () -> T): T {
+    if (!FSDKNative.TraceEnabled())
+      return function()
+
+    val start = FSDKNative.GetTraceTime()
+    val result = function()
+    FSDKNative.RecordTraceSpan(name, -1, start, FSDKNative.GetTraceTime())
+    return result
+  }
+
+  /** Runs the function holding the reader/writer lock of the tracker, see cpp/FSDKTrackerLock.h */
+  private inline fun <T> TrackerLock(tracker: Double, exclusive: Boolean, function: () -> T): T {
+    val lock = FSDKNative.LockTracker(Tracker(tracker.toInt()), exclusive)
+    try {
+      return function()
+    } finally {
+      FSDKNative.UnlockTracker(lock)
+    }
+  }
+
+  private inline fun <T> SharedTrackerLock(tracker: Double, function: () -> T): T = TrackerLock(tracker, false, function)
+
+  private inline fun <T> ExclusiveTrackerLock(tracker: Double, function: () -> T): T = TrackerLock(tracker, true, function)
+
   private fun ExecuteSDKFunction(function: (WritableMap) -> Int): WritableMap {
     val map = Arguments.createMap()
     val result = Arguments.createMap()
@@ -539,6 +576,20 @@ class FaceSDKModule(reactContext: ReactApplicationContext) : NativeFaceSDKSpec(r
     }
   }
 
+  private fun ExecuteCachedFaceTemplateResultSDKFunction(function: (FSDK.FSDK_FaceTemplate, FSDK.TFace) -> Int): WritableMap {
+    return ExecuteSDKFunction {
+      map ->
+        val faceTemplate = FSDK.FSDK_FaceTemplate()
+        val face = FSDK.TFace()
+        val errorCode = function(faceTemplate, face)
+
+        map.putString("value", Base64.encodeToString(faceTemplate.template, Base64.NO_WRAP))
+        map.putMap("face", FaceToWritableMap(face))
+
+        errorCode
+    }
+  }
+
   private fun ExecuteLongArrayResultSDKFunction(function: (LongArray) -> Int, maxSize: Int, name: String = "value"): WritableMap {
     return ExecuteSDKFunction {
       map ->
@@ -612,7 +663,10 @@ class FaceSDKModule(reactContext: ReactApplicationContext) : NativeFaceSDKSpec(r
   }
 
   override fun FreeImage(image: Double): WritableMap {
-    return ExecuteSDKFunction { FSDK.FreeImage(Image(image.toInt())) }
+    return ExecuteSDKFunction { _ ->
+      FSDKNative.ReleaseImageAnalysis(Image(image.toInt()))
+      FSDK.FreeImage(Image(image.toInt()))
+    }
   }
 
   override fun LoadImageFromFile(filename: String): WritableMap {
@@ -696,7 +750,11 @@ class FaceSDKModule(reactContext: ReactApplicationContext) : NativeFaceSDKSpec(r
   }
 
   override fun MirrorImage(image: Double, vertical: Boolean): WritableMap {
-    return ExecuteSDKFunction { _ -> FSDK.MirrorImage(Image(image.toInt()), vertical) }
+    return ExecuteSDKFunction { _ ->
+      val errorCode = FSDK.MirrorImage(Image(image.toInt()), vertical)
+      FSDKNative.InvalidateImageAnalysis(Image(image.toInt()))
+      errorCode
+    }
   }
 
   override fun ExtractFaceImage(image: Double, features: ReadableArray, width: Double, height: Double): WritableMap {
@@ -716,6 +774,37 @@ class FaceSDKModule(reactContext: ReactApplicationContext) : NativeFaceSDKSpec(r
     }
   }
 
+  override fun ExtractFaceAtlas(image: Double, features: ReadableArray, count: Double, width: Double, height: Double, imageMode: Double, threads: Double): WritableMap {
+    return ExecuteSDKFunction {
+      map ->
+        val layout = LongArray(4)
+        var errorCode = FSDKNative.GetFaceAtlasLayout(count.toInt(), width.toInt(), height.toInt(), imageMode.toInt(), layout)
+        if (errorCode != FSDK.FSDKE_OK) {
+          return@ExecuteSDKFunction errorCode
+        }
+
+        val points = count.toInt() * FSDK.FSDK_FACIAL_FEATURE_COUNT * 2
+        val inputFeatures = IntArray(points) { i -> if (i < features.size()) features.getInt(i) else 0 }
+        val atlas = ByteArray(layout[3].toInt())
+        val resultFeatures = IntArray(points)
+        val errorCodes = IntArray(count.toInt())
+        errorCode = FSDKNative.ExtractFaceAtlas(Image(image.toInt()), inputFeatures, count.toInt(), width.toInt(), height.toInt(), imageMode.toInt(), threads.toInt(), atlas, resultFeatures, errorCodes)
+
+        val packedFeatures = Arguments.createArray()
+        resultFeatures.forEach { packedFeatures.pushInt(it) }
+        val faceErrorCodes = Arguments.createArray()
+        errorCodes.forEach { faceErrorCodes.pushInt(it) }
+
+        map.putString("value", Base64.encodeToString(atlas, Base64.NO_WRAP))
+        map.putArray("features", packedFeatures)
+        map.putArray("errorCodes", faceErrorCodes)
+        map.putInt("stride", layout[1].toInt())
+        map.putDouble("faceSize", layout[2].toDouble())
+
+        errorCode
+    }
+  }
+
   override fun DetectFace(image: Double): WritableMap {
     return ExecuteFacePositionResultSDKFunction({ face -> FSDK.DetectFace(Image(image.toInt()), face) })
   }
@@ -732,12 +821,16 @@ class FaceSDKModule(reactContext: ReactApplicationContext) : NativeFaceSDKSpec(r
     return ExecuteTFaces2ResultSDKFunction({ faces -> FSDK.DetectMultipleFaces2(Image(image.toInt()), faces) }, maxFaces.toInt())
   }
 
+  override fun DetectMultipleFacesTiled(image: Double, maxFaces: Double, tileSize: Double, overlap: Double, threads: Double, fullImagePass: Boolean, iouThreshold: Double): WritableMap {
+    return ExecuteTFaces2ResultSDKFunction({ faces -> Traced("DetectMultipleFacesTiled") { FSDKNative.DetectMultipleFacesTiled(Image(image.toInt()), tileSize.toInt(), overlap.toInt(), threads.toInt(), fullImagePass, iouThreshold.toFloat(), faces) } }, maxFaces.toInt())
+  }
+
   override fun SetFaceDetectionParameters(handleArbitraryRotations: Boolean, determineFaceRotationAngle: Boolean, internalResizeWidth: Double): WritableMap {
-    return ExecuteSDKFunction { _ -> FSDK.SetFaceDetectionParameters(handleArbitraryRotations, determineFaceRotationAngle, internalResizeWidth.toInt()) }
+    return ExecuteSDKFunction { _ -> FSDKNative.SetFaceDetectionParameters(handleArbitraryRotations, determineFaceRotationAngle, internalResizeWidth.toInt()) }
   }
 
   override fun SetFaceDetectionThreshold(threshold: Double): WritableMap {
-    return ExecuteSDKFunction { _ -> FSDK.SetFaceDetectionThreshold(threshold.toInt()) }
+    return ExecuteSDKFunction { _ -> FSDKNative.SetFaceDetectionThreshold(threshold.toInt()) }
   }
 
   override fun GetDetectedFaceConfidence(): WritableMap {
@@ -812,35 +905,47 @@ class FaceSDKModule(reactContext: ReactApplicationContext) : NativeFaceSDKSpec(r
   }
 
   override fun FreeTracker(tracker: Double): WritableMap {
-    return ExecuteSDKFunction { _ -> FSDK.FreeTracker(Tracker(tracker.toInt())) }
+    return ExecuteSDKFunction { _ ->
+      FSDKNative.ReleaseTrackerThumbnails(Tracker(tracker.toInt()))
+      FSDKNative.ReleaseTrackerMemoryGovernor(Tracker(tracker.toInt()))
+      FSDKNative.ReleaseTrackerResultSlot(Tracker(tracker.toInt()))
+      val errorCode = ExclusiveTrackerLock(tracker) { FSDK.FreeTracker(Tracker(tracker.toInt())) }
+      FSDKNative.ReleaseTrackerLock(Tracker(tracker.toInt()))
+      errorCode
+    }
   }
 
   override fun ClearTracker(tracker: Double): WritableMap {
-    return ExecuteSDKFunction { _ -> FSDK.ClearTracker(Tracker(tracker.toInt())) }
+    return ExecuteSDKFunction { _ ->
+      val errorCode = FSDKNative.ClearTracker(Tracker(tracker.toInt()))
+      if (errorCode == FSDK.FSDKE_OK)
+        FSDKNative.ClearTrackerIDs(Tracker(tracker.toInt()))
+      errorCode
+    }
   }
 
   override fun SaveTrackerMemoryToFile(tracker: Double, filename: String): WritableMap {
-    return ExecuteSDKFunction { _ -> FSDK.SaveTrackerMemoryToFile(Tracker(tracker.toInt()), filename) }
+    return ExecuteSDKFunction { _ -> SharedTrackerLock(tracker) { FSDK.SaveTrackerMemoryToFile(Tracker(tracker.toInt()), filename) } }
   }
 
   override fun GetTrackerMemoryBufferSize(tracker: Double): WritableMap {
-    return ExecuteLongResultSDKFunction({ value -> FSDK.GetTrackerMemoryBufferSize(Tracker(tracker.toInt()), value) })
+    return ExecuteLongResultSDKFunction({ value -> SharedTrackerLock(tracker) { FSDK.GetTrackerMemoryBufferSize(Tracker(tracker.toInt()), value) } })
   }
 
   override fun SaveTrackerMemoryToBuffer(tracker: Double, bufferSize: Double): WritableMap {
-    return ExecuteByteBufferResultSDKFunction({ value -> FSDK.SaveTrackerMemoryToBuffer(Tracker(tracker.toInt()), value) }, bufferSize.toInt())
+    return ExecuteByteBufferResultSDKFunction({ value -> SharedTrackerLock(tracker) { FSDK.SaveTrackerMemoryToBuffer(Tracker(tracker.toInt()), value) } }, bufferSize.toInt())
   }
 
   override fun SetTrackerParameter(tracker: Double, name: String, value: String): WritableMap {
-    return ExecuteSDKFunction { _ -> FSDK.SetTrackerParameter(Tracker(tracker.toInt()), name, value) }
+    return ExecuteSDKFunction { _ -> ExclusiveTrackerLock(tracker) { FSDK.SetTrackerParameter(Tracker(tracker.toInt()), name, value) } }
   }
 
   override fun SetTrackerMultipleParameters(tracker: Double, values: String): WritableMap {
-    return ExecuteIntegerResultSDKFunction({ value -> FSDK.SetTrackerMultipleParameters(Tracker(tracker.toInt()), values, value) })
+    return ExecuteIntegerResultSDKFunction({ value -> ExclusiveTrackerLock(tracker) { FSDK.SetTrackerMultipleParameters(Tracker(tracker.toInt()), values, value) } })
   }
 
   override fun GetTrackerParameter(tracker: Double, parameter: String, maxSize: Double): WritableMap {
-    return ExecuteStringResultSDKFunction({ value -> FSDK.GetTrackerParameter(Tracker(tracker.toInt()), parameter, value, maxSize.toInt()) })
+    return ExecuteStringResultSDKFunction({ value -> SharedTrackerLock(tracker) { FSDK.GetTrackerParameter(Tracker(tracker.toInt()), parameter, value, maxSize.toInt()) } })
   }
 
   override fun FeedFrame(tracker: Double, index: Double, image: Double, maxFaces: Double): WritableMap {
@@ -848,7 +953,8 @@ class FaceSDKModule(reactContext: ReactApplicationContext) : NativeFaceSDKSpec(r
       map ->
         val ids = LongArray(maxFaces.toInt()) { -1L }
         val count = LongArray(1) { 0L }
-        val errorCode = FSDK.FeedFrame(Tracker(tracker.toInt()), index.toLong(), Image(image.toInt()), count, ids)
+        val errorCode = Traced("FeedFrame") { ExclusiveTrackerLock(tracker) { FSDK.FeedFrame(Tracker(tracker.toInt()), index.toLong(), Image(image.toInt()), count, ids) } }
+        FSDKNative.TrackerFrameFed(Tracker(tracker.toInt()), index.toLong(), errorCode, ids, count[0])
 
         val result = Arguments.createArray()
         for (i in 0..count[0].toInt() - 1) {
@@ -862,111 +968,119 @@ class FaceSDKModule(reactContext: ReactApplicationContext) : NativeFaceSDKSpec(r
   }
 
   override fun GetTrackerEyes(tracker: Double, index: Double, id: Double): WritableMap {
-    return ExecuteFeaturesResultSDKFunction({ value -> FSDK.GetTrackerEyes(Tracker(tracker.toInt()), index.toLong(), id.toLong(), value) })
+    return ExecuteFeaturesResultSDKFunction({ value -> SharedTrackerLock(tracker) { FSDK.GetTrackerEyes(Tracker(tracker.toInt()), index.toLong(), id.toLong(), value) } })
   }
 
   override fun GetTrackerFacialFeatures(tracker: Double, index: Double, id: Double): WritableMap {
-    return ExecuteFeaturesResultSDKFunction({ value -> FSDK.GetTrackerFacialFeatures(Tracker(tracker.toInt()), index.toLong(), id.toLong(), value) })
+    return ExecuteFeaturesResultSDKFunction({ value -> SharedTrackerLock(tracker) { FSDK.GetTrackerFacialFeatures(Tracker(tracker.toInt()), index.toLong(), id.toLong(), value) } })
   }
 
   override fun GetTrackerFacePosition(tracker: Double, index: Double, id: Double): WritableMap {
-    return ExecuteFacePositionResultSDKFunction({ value -> FSDK.GetTrackerFacePosition(Tracker(tracker.toInt()), index.toLong(), id.toLong(), value) })
+    return ExecuteFacePositionResultSDKFunction({ value -> SharedTrackerLock(tracker) { FSDK.GetTrackerFacePosition(Tracker(tracker.toInt()), index.toLong(), id.toLong(), value) } })
   }
 
   override fun GetTrackerFace(tracker: Double, index: Double, id: Double): WritableMap {
-    return ExecuteTFaceResultSDKFunction({ value -> FSDK.GetTrackerFace(Tracker(tracker.toInt()), index.toLong(), id.toLong(), value) })
+    return ExecuteTFaceResultSDKFunction({ value -> SharedTrackerLock(tracker) { FSDK.GetTrackerFace(Tracker(tracker.toInt()), index.toLong(), id.toLong(), value) } })
   }
 
   override fun LockID(tracker: Double, id: Double): WritableMap {
-    return ExecuteSDKFunction { _ -> FSDK.LockID(Tracker(tracker.toInt()), id.toLong()) }
+    return ExecuteSDKFunction { _ -> FSDKNative.LockTrackerID(Tracker(tracker.toInt()), id.toLong()) }
   }
 
   override fun UnlockID(tracker: Double, id: Double): WritableMap {
-    return ExecuteSDKFunction { _ -> FSDK.UnlockID(Tracker(tracker.toInt()), id.toLong()) }
+    return ExecuteSDKFunction { _ -> FSDKNative.UnlockTrackerID(Tracker(tracker.toInt()), id.toLong()) }
   }
 
   override fun PurgeID(tracker: Double, id: Double): WritableMap {
-    return ExecuteSDKFunction { _ -> FSDK.PurgeID(Tracker(tracker.toInt()), id.toLong()) }
+    return ExecuteSDKFunction { _ -> FSDKNative.PurgeID(Tracker(tracker.toInt()), id.toLong()) }
   }
 
   override fun SetName(tracker: Double, id: Double, name: String): WritableMap {
-    return ExecuteSDKFunction { _ -> FSDK.SetName(Tracker(tracker.toInt()), id.toLong(), name) }
+    return ExecuteSDKFunction { _ -> FSDKNative.SetTrackerName(Tracker(tracker.toInt()), id.toLong(), name) }
   }
 
   override fun GetName(tracker: Double, id: Double, maxLength: Double): WritableMap {
-    return ExecuteStringResultSDKFunction({ value -> FSDK.GetName(Tracker(tracker.toInt()), id.toLong(), value, maxLength.toLong()) })
+    return ExecuteStringResultSDKFunction({ value -> SharedTrackerLock(tracker) { FSDK.GetName(Tracker(tracker.toInt()), id.toLong(), value, maxLength.toLong()) } })
   }
 
   override fun GetAllNames(tracker: Double, id: Double, maxLength: Double): WritableMap {
-    return ExecuteStringResultSDKFunction({ value -> FSDK.GetAllNames(Tracker(tracker.toInt()), id.toLong(), value, maxLength.toLong()) })
+    return ExecuteStringResultSDKFunction({ value -> SharedTrackerLock(tracker) { FSDK.GetAllNames(Tracker(tracker.toInt()), id.toLong(), value, maxLength.toLong()) } })
   }
 
   override fun GetIDReassignment(tracker: Double, id: Double): WritableMap {
-    return ExecuteLongResultSDKFunction({ value -> FSDK.GetIDReassignment(Tracker(tracker.toInt()), id.toLong(), value) })
+    return ExecuteLongResultSDKFunction({ value -> SharedTrackerLock(tracker) { FSDK.GetIDReassignment(Tracker(tracker.toInt()), id.toLong(), value) } })
   }
 
   override fun GetSimilarIDCount(tracker: Double, id: Double): WritableMap {
-    return ExecuteLongResultSDKFunction({ value -> FSDK.GetSimilarIDCount(Tracker(tracker.toInt()), id.toLong(), value) })
+    return ExecuteLongResultSDKFunction({ value -> SharedTrackerLock(tracker) { FSDK.GetSimilarIDCount(Tracker(tracker.toInt()), id.toLong(), value) } })
   }
 
   override fun GetSimilarIDList(tracker: Double, id: Double, count: Double): WritableMap {
-    return ExecuteLongResultSDKFunction({ value -> FSDK.GetSimilarIDCount(Tracker(tracker.toInt()), id.toLong(), value) })
+    return ExecuteLongResultSDKFunction({ value -> SharedTrackerLock(tracker) { FSDK.GetSimilarIDCount(Tracker(tracker.toInt()), id.toLong(), value) } })
   }
 
   override fun GetTrackerIDsCount(tracker: Double): WritableMap {
-    return ExecuteLongResultSDKFunction({ value -> FSDK.GetTrackerIDsCount(Tracker(tracker.toInt()), value) })
+    return ExecuteLongResultSDKFunction({ value -> SharedTrackerLock(tracker) { FSDK.GetTrackerIDsCount(Tracker(tracker.toInt()), value) } })
   }
 
   override fun GetTrackerAllIDs(tracker: Double, count: Double): WritableMap {
-    return ExecuteLongResultSDKFunction({ value -> FSDK.GetTrackerAllIDs(Tracker(tracker.toInt()), value) })
+    return ExecuteLongResultSDKFunction({ value -> SharedTrackerLock(tracker) { FSDK.GetTrackerAllIDs(Tracker(tracker.toInt()), value) } })
   }
 
   override fun GetTrackerFaceIDsCountForID(tracker: Double, id: Double): WritableMap {
-    return ExecuteLongResultSDKFunction({ value -> FSDK.GetTrackerFaceIDsCountForID(Tracker(tracker.toInt()), id.toLong(), value) })
+    return ExecuteLongResultSDKFunction({ value -> SharedTrackerLock(tracker) { FSDK.GetTrackerFaceIDsCountForID(Tracker(tracker.toInt()), id.toLong(), value) } })
   }
 
   override fun GetTrackerFaceIDsForID(tracker: Double, id: Double, count: Double): WritableMap {
-    return ExecuteLongResultSDKFunction({ value -> FSDK.GetTrackerFaceIDsForID(Tracker(tracker.toInt()), id.toLong(), value) })
+    return ExecuteLongResultSDKFunction({ value -> SharedTrackerLock(tracker) { FSDK.GetTrackerFaceIDsForID(Tracker(tracker.toInt()), id.toLong(), value) } })
   }
 
   override fun GetTrackerIDByFaceID(tracker: Double, faceID: Double): WritableMap {
-    return ExecuteLongResultSDKFunction({ value -> FSDK.GetTrackerIDByFaceID(Tracker(tracker.toInt()), faceID.toLong(), value) })
+    return ExecuteLongResultSDKFunction({ value -> SharedTrackerLock(tracker) { FSDK.GetTrackerIDByFaceID(Tracker(tracker.toInt()), faceID.toLong(), value) } })
   }
 
   override fun GetTrackerFaceTemplate(tracker: Double, faceID: Double): WritableMap {
-    return ExecuteFaceTemplateResultSDKFunction({ value -> FSDK.GetTrackerFaceTemplate(Tracker(tracker.toInt()), faceID.toLong(), value) })
+    return ExecuteFaceTemplateResultSDKFunction({ value -> SharedTrackerLock(tracker) { FSDK.GetTrackerFaceTemplate(Tracker(tracker.toInt()), faceID.toLong(), value) } })
   }
 
   override fun GetTrackerFaceImage(tracker: Double, faceID: Double): WritableMap {
-    return ExecuteImageResultSDKFunction({ value -> FSDK.GetTrackerFaceImage(Tracker(tracker.toInt()), faceID.toLong(), value) })
+    return ExecuteSDKFunction {
+      map ->
+        val value = Image()
+        val errorCode = FSDKNative.GetTrackerFaceImage(Tracker(tracker.toInt()), faceID.toLong(), value)
+
+        map.putInt("value", value.himage)
+
+        errorCode
+    }
   }
 
   override fun SetTrackerFaceImage(tracker: Double, faceID: Double, image: Double): WritableMap {
-    return ExecuteSDKFunction{ _ -> FSDK.GetTrackerFaceImage(Tracker(tracker.toInt()), faceID.toLong(), Image(image.toInt())) }
+    return ExecuteSDKFunction{ _ -> FSDKNative.SetTrackerFaceImage(Tracker(tracker.toInt()), faceID.toLong(), Image(image.toInt())) }
   }
 
   override fun DeleteTrackerFaceImage(tracker: Double, faceID: Double): WritableMap {
-    return ExecuteSDKFunction{ _ -> FSDK.DeleteTrackerFaceImage(Tracker(tracker.toInt()), faceID.toLong()) }
+    return ExecuteSDKFunction{ _ -> FSDKNative.DeleteTrackerFaceImage(Tracker(tracker.toInt()), faceID.toLong()) }
   }
 
   override fun TrackerCreateID(tracker: Double, faceTemplate: String): WritableMap {
-    return ExecuteTrackerIDResultSDKFunction({ id, faceID -> FSDK.TrackerCreateID(Tracker(tracker.toInt()), Base64ToTemplate(faceTemplate), id, faceID) })
+    return ExecuteTrackerIDResultSDKFunction({ id, faceID -> ExclusiveTrackerLock(tracker) { FSDK.TrackerCreateID(Tracker(tracker.toInt()), Base64ToTemplate(faceTemplate), id, faceID) } })
   }
 
   override fun AddTrackerFaceTemplate(tracker: Double, id: Double, faceTemplate: String): WritableMap {
-    return ExecuteLongResultSDKFunction({ value -> FSDK.AddTrackerFaceTemplate(Tracker(tracker.toInt()), id.toLong(), Base64ToTemplate(faceTemplate), value) })
+    return ExecuteLongResultSDKFunction({ value -> ExclusiveTrackerLock(tracker) { FSDK.AddTrackerFaceTemplate(Tracker(tracker.toInt()), id.toLong(), Base64ToTemplate(faceTemplate), value) } })
   }
 
   override fun DeleteTrackerFace(tracker: Double, faceID: Double): WritableMap {
-    return ExecuteSDKFunction{ _ -> FSDK.DeleteTrackerFace(Tracker(tracker.toInt()), faceID.toLong()) }
+    return ExecuteSDKFunction{ _ -> FSDKNative.DeleteTrackerFace(Tracker(tracker.toInt()), faceID.toLong()) }
   }
 
   override fun TrackerMatchFaces(tracker: Double, faceTemplate: String, threshold: Double, maxSize: Double): WritableMap {
-    return ExecuteIDSimilaritiesSDKFunction({ value, count -> FSDK.TrackerMatchFaces(Tracker(tracker.toInt()), Base64ToTemplate(faceTemplate), threshold.toFloat(), value, count) }, maxSize.toInt())
+    return ExecuteIDSimilaritiesSDKFunction({ value, count -> SharedTrackerLock(tracker) { FSDK.TrackerMatchFaces(Tracker(tracker.toInt()), Base64ToTemplate(faceTemplate), threshold.toFloat(), value, count) } }, maxSize.toInt())
   }
 
   override fun GetTrackerFacialAttribute(tracker: Double, index: Double, id: Double, name: String, maxSize: Double): WritableMap {
-    return ExecuteStringResultSDKFunction({ value -> FSDK.GetTrackerFacialAttribute(Tracker(tracker.toInt()), index.toLong(), id.toLong(), name, value, maxSize.toLong()) })
+    return ExecuteStringResultSDKFunction({ value -> SharedTrackerLock(tracker) { FSDK.GetTrackerFacialAttribute(Tracker(tracker.toInt()), index.toLong(), id.toLong(), name, value, maxSize.toLong()) } })
   }
 
   override fun DetectFacialAttributeUsingFeatures(image: Double, features: ReadableArray, name: String, maxSize: Double): WritableMap {
@@ -1002,11 +1116,330 @@ class FaceSDKModule(reactContext: ReactApplicationContext) : NativeFaceSDKSpec(r
   }
 
   override fun SetParameter(name: String, value: String): WritableMap {
-    return ExecuteSDKFunction { _ -> FSDK.SetParameter(name, value) }
+    return ExecuteSDKFunction { _ -> FSDKNative.SetParameter(name, value) }
   }
 
   override fun SetParameters(parameters: String): WritableMap {
-    return ExecuteIntegerResultSDKFunction({ value -> FSDK.SetParameters(parameters, value) })
+    return ExecuteIntegerResultSDKFunction({ value -> FSDKNative.SetParameters(parameters, value) })
+  }
+
+  override fun CreateAnalysisContext(image: Double): WritableMap {
+    return ExecuteIntegerResultSDKFunction({ value -> FSDKNative.CreateAnalysisContext(Image(image.toInt()), value) })
+  }
+
+  override fun FreeAnalysisContext(context: Double): WritableMap {
+    return ExecuteSDKFunction { _ -> FSDKNative.FreeAnalysisContext(context.toInt()) }
+  }
+
+  override fun AnalysisContextDetectFace(context: Double): WritableMap {
+    return ExecuteTFaceResultSDKFunction({ face -> FSDKNative.AnalysisContextDetectFace(context.toInt(), face) })
+  }
+
+  override fun AnalysisContextDetectFacialFeatures(context: Double): WritableMap {
+    return ExecuteFeaturesResultSDKFunction({ features -> FSDKNative.AnalysisContextDetectFacialFeatures(context.toInt(), features) })
+  }
+
+  override fun AnalysisContextDetectFacialAttribute(context: Double, name: String, maxSize: Double): WritableMap {
+    return ExecuteStringResultSDKFunction({ value -> FSDKNative.AnalysisContextDetectFacialAttribute(context.toInt(), name, value, maxSize.toLong()) })
+  }
+
+  override fun AnalysisContextGetFaceTemplate(context: Double): WritableMap {
+    return ExecuteFaceTemplateResultSDKFunction({ value -> FSDKNative.AnalysisContextGetFaceTemplate(context.toInt(), value) })
+  }
+
+  override fun SetTraceEnabled(enabled: Boolean, capacity: Double): WritableMap {
+    return ExecuteSDKFunction { _ ->
+      FSDKNative.SetTraceEnabled(enabled, capacity.toInt())
+      FSDK.FSDKE_OK
+    }
+  }
+
+  override fun ClearTrace(): WritableMap {
+    return ExecuteSDKFunction { _ ->
+      FSDKNative.ClearTrace()
+      FSDK.FSDKE_OK
+    }
+  }
+
+  override fun GetTraceTime(): WritableMap {
+    return ExecuteLongResultSDKFunction({ value ->
+      value[0] = FSDKNative.GetTraceTime()
+      FSDK.FSDKE_OK
+    })
+  }
+
+  override fun SetTraceFrameTimestamp(frameTimestamp: Double): WritableMap {
+    return ExecuteSDKFunction { _ ->
+      FSDKNative.SetTraceFrameTimestamp(frameTimestamp.toLong())
+      FSDK.FSDKE_OK
+    }
+  }
+
+  override fun RecordTraceSpan(name: String, frameTimestamp: Double, start: Double, end: Double): WritableMap {
+    return ExecuteSDKFunction { _ ->
+      FSDKNative.RecordTraceSpan(name, frameTimestamp.toLong(), start.toLong(), end.toLong())
+      FSDK.FSDKE_OK
+    }
+  }
+
+  override fun DumpTrace(): WritableMap {
+    return ExecuteStringResultSDKFunction({ value ->
+      value[0] = FSDKNative.DumpTrace()
+      FSDK.FSDKE_OK
+    })
+  }
+
+  override fun SaveTrace(filename: String): WritableMap {
+    return ExecuteSDKFunction { _ -> FSDKNative.SaveTrace(filename) }
+  }
+
+  override fun CreateTemplateCache(filename: String, maxEntries: Double, configuration: String): WritableMap {
+    return ExecuteIntegerResultSDKFunction({ value -> FSDKNative.CreateTemplateCache(filename, maxEntries.toLong(), configuration, value) })
+  }
+
+  override fun FreeTemplateCache(cache: Double): WritableMap {
+    return ExecuteSDKFunction { _ -> FSDKNative.FreeTemplateCache(cache.toInt()) }
+  }
+
+  override fun SaveTemplateCache(cache: Double): WritableMap {
+    return ExecuteSDKFunction { _ -> FSDKNative.SaveTemplateCache(cache.toInt()) }
+  }
+
+  override fun ClearTemplateCache(cache: Double): WritableMap {
+    return ExecuteSDKFunction { _ -> FSDKNative.ClearTemplateCache(cache.toInt()) }
+  }
+
+  override fun GetTemplateCacheStatistics(cache: Double): WritableMap {
+    return ExecuteLongArrayResultSDKFunction({ value -> FSDKNative.GetTemplateCacheStatistics(cache.toInt(), value) }, 4)
+  }
+
+  override fun TemplateCacheGetFaceTemplateFromFile(cache: Double, filename: String): WritableMap {
+    return ExecuteCachedFaceTemplateResultSDKFunction({ faceTemplate, face -> FSDKNative.TemplateCacheGetFaceTemplateFromFile(cache.toInt(), filename, faceTemplate, face) })
+  }
+
+  override fun TemplateCacheGetFaceTemplateFromBuffer(cache: Double, base64: String): WritableMap {
+    val buffer = Base64.decode(base64, Base64.DEFAULT)
+    return ExecuteCachedFaceTemplateResultSDKFunction({ faceTemplate, face -> FSDKNative.TemplateCacheGetFaceTemplateFromBuffer(cache.toInt(), buffer, faceTemplate, face) })
+  }
+
+  override fun TemplateCacheGetFaceTemplate(cache: Double, image: Double): WritableMap {
+    return ExecuteCachedFaceTemplateResultSDKFunction({ faceTemplate, face -> FSDKNative.TemplateCacheGetFaceTemplate(cache.toInt(), Image(image.toInt()), faceTemplate, face) })
+  }
+
+  override fun CreateThumbnailStore(filename: String, maxSize: Double, maxCachedImages: Double): WritableMap {
+    return ExecuteIntegerResultSDKFunction({ value -> FSDKNative.CreateThumbnailStore(filename, maxSize.toInt(), maxCachedImages.toLong(), value) })
+  }
+
+  override fun FreeThumbnailStore(store: Double): WritableMap {
+    return ExecuteSDKFunction { _ -> FSDKNative.FreeThumbnailStore(store.toInt()) }
+  }
+
+  override fun CompactThumbnailStore(store: Double): WritableMap {
+    return ExecuteSDKFunction { _ -> FSDKNative.CompactThumbnailStore(store.toInt()) }
+  }
+
+  override fun GetThumbnailStoreStatistics(store: Double): WritableMap {
+    return ExecuteLongArrayResultSDKFunction({ value -> FSDKNative.GetThumbnailStoreStatistics(store.toInt(), value) }, 4)
+  }
+
+  override fun AttachThumbnailStore(tracker: Double, store: Double): WritableMap {
+    return ExecuteSDKFunction { _ -> FSDKNative.AttachThumbnailStore(Tracker(tracker.toInt()), store.toInt()) }
+  }
+
+  override fun GetTrackerFaceThumbnail(tracker: Double, faceID: Double): WritableMap {
+    return ExecuteSDKFunction {
+      map ->
+        val errorCode = IntArray(1)
+        val value = FSDKNative.GetTrackerFaceThumbnail(Tracker(tracker.toInt()), faceID.toLong(), errorCode)
+
+        map.putString("value", Base64.encodeToString(value, Base64.NO_WRAP))
+
+        errorCode[0]
+    }
+  }
+
+  override fun CreateKeyframeTracker(tracker: Double, keyframeInterval: Double, workingWidth: Double, searchRadius: Double, minCorrelation: Double): WritableMap {
+    return ExecuteIntegerResultSDKFunction({ value ->
+      FSDKNative.CreateKeyframeTracker(Tracker(tracker.toInt()), keyframeInterval.toInt(), workingWidth.toInt(), searchRadius.toInt(), minCorrelation.toFloat(), value)
+    })
+  }
+
+  override fun FreeKeyframeTracker(keyframeTracker: Double): WritableMap {
+    return ExecuteSDKFunction { _ -> FSDKNative.FreeKeyframeTracker(keyframeTracker.toInt()) }
+  }
+
+  override fun KeyframeTrackerFeedFrame(keyframeTracker: Double, index: Double, image: Double, maxFaces: Double): WritableMap {
+    return ExecuteSDKFunction {
+      map ->
+        val ids = LongArray(maxFaces.toInt()) { -1L }
+        val count = LongArray(1) { 0L }
+        val keyframe = BooleanArray(1)
+        val errorCode = FSDKNative.KeyframeTrackerFeedFrame(keyframeTracker.toInt(), index.toLong(), Image(image.toInt()), count, ids, keyframe)
+
+        val result = Arguments.createArray()
+        for (i in 0..count[0].toInt() - 1) {
+          result.pushInt(ids[i].toInt())
+        }
+
+        map.putArray("value", result)
+        map.putBoolean("keyframe", keyframe[0])
+
+        errorCode
+    }
+  }
+
+  override fun KeyframeTrackerGetFace(keyframeTracker: Double, index: Double, id: Double): WritableMap {
+    return ExecuteTFaceResultSDKFunction({ value -> FSDKNative.KeyframeTrackerGetFace(keyframeTracker.toInt(), index.toLong(), id.toLong(), value) })
+  }
+
+  override fun KeyframeTrackerGetFacialFeatures(keyframeTracker: Double, index: Double, id: Double): WritableMap {
+    return ExecuteFeaturesResultSDKFunction({ value -> FSDKNative.KeyframeTrackerGetFacialFeatures(keyframeTracker.toInt(), index.toLong(), id.toLong(), value) })
+  }
+
+  override fun StartFrameRecording(filename: String, compressed: Boolean): WritableMap {
+    return ExecuteSDKFunction { _ -> FSDKNative.StartFrameRecording(filename, compressed) }
+  }
+
+  override fun StopFrameRecording(): WritableMap {
+    return ExecuteLongArrayResultSDKFunction({ value -> FSDKNative.StopFrameRecording(value) }, 2)
+  }
+
+  override fun AttachMemoryGovernor(tracker: Double, maxTemplates: Double, targetRatio: Double, minIdleSeconds: Double, interval: Double): WritableMap {
+    return ExecuteSDKFunction { _ ->
+      FSDKNative.AttachMemoryGovernor(Tracker(tracker.toInt()), maxTemplates.toLong(), targetRatio.toFloat(), minIdleSeconds, interval.toInt())
+    }
+  }
+
+  override fun DetachMemoryGovernor(tracker: Double): WritableMap {
+    return ExecuteSDKFunction { _ -> FSDKNative.DetachMemoryGovernor(Tracker(tracker.toInt())) }
+  }
+
+  override fun GetMemoryGovernorStatistics(tracker: Double): WritableMap {
+    return ExecuteLongArrayResultSDKFunction({ value -> FSDKNative.GetMemoryGovernorStatistics(Tracker(tracker.toInt()), value) }, 6)
+  }
+
+  override fun CreateResultSlot(maxFaces: Double, attributes: String): WritableMap {
+    return ExecuteIntegerResultSDKFunction({ value -> FSDKNative.CreateResultSlot(maxFaces.toInt(), attributes, value) })
+  }
+
+  override fun FreeResultSlot(slot: Double): WritableMap {
+    return ExecuteSDKFunction { _ -> FSDKNative.FreeResultSlot(slot.toInt()) }
+  }
+
+  override fun AttachResultSlot(tracker: Double, slot: Double): WritableMap {
+    return ExecuteSDKFunction { _ -> FSDKNative.AttachResultSlot(Tracker(tracker.toInt()), slot.toInt()) }
+  }
+
+  override fun InstallJSIBindings(): WritableMap {
+    // Synchronous methods run on the JavaScript thread, where the runtime may be used
+    return ExecuteSDKFunction { _ -> FSDKNative.InstallJSIBindings(reactContext.javaScriptContextHolder?.get() ?: 0L) }
+  }
+
+  override fun CreateQualityFilter(minSharpness: Double, minBrightness: Double, maxBrightness: Double, maxClippedFraction: Double, minEyeDistance: Double, maxRoll: Double, maxYaw: Double): WritableMap {
+    return ExecuteIntegerResultSDKFunction({ value ->
+      FSDKNative.CreateQualityFilter(minSharpness, minBrightness, maxBrightness, maxClippedFraction, minEyeDistance, maxRoll, maxYaw, value)
+    })
+  }
+
+  override fun FreeQualityFilter(filter: Double): WritableMap {
+    return ExecuteSDKFunction { _ -> FSDKNative.FreeQualityFilter(filter.toInt()) }
+  }
+
+  override fun QualityFilterEvaluate(filter: Double, image: Double, face: ReadableMap): WritableMap {
+    return ExecuteSDKFunction {
+      map ->
+        val scores = DoubleArray(8)
+        val errorCode = FSDKNative.QualityFilterEvaluate(filter.toInt(), Image(image.toInt()), ReadableMapToFace(face), scores)
+
+        map.putMap("value", QualityScoresToWritableMap(scores))
+
+        errorCode
+    }
+  }
+
+  override fun QualityFilterEvaluateTrackerFace(filter: Double, tracker: Double, index: Double, id: Double, image: Double): WritableMap {
+    return ExecuteSDKFunction {
+      map ->
+        val scores = DoubleArray(8)
+        val errorCode = FSDKNative.QualityFilterEvaluateTrackerFace(filter.toInt(), Tracker(tracker.toInt()), index.toLong(), id.toLong(), Image(image.toInt()), scores)
+
+        map.putMap("value", QualityScoresToWritableMap(scores))
+
+        errorCode
+    }
+  }
+
+  override fun QualityFilterGetFaceTemplate(filter: Double, image: Double, face: ReadableMap): WritableMap {
+    return ExecuteSDKFunction {
+      map ->
+        val faceTemplate = FSDK.FSDK_FaceTemplate()
+        val scores = DoubleArray(8)
+        val errorCode = FSDKNative.QualityFilterGetFaceTemplate(filter.toInt(), Image(image.toInt()), ReadableMapToFace(face), faceTemplate, scores)
+
+        // No template is computed for a face failing the filter
+        val passed = errorCode == FSDK.FSDKE_OK && scores[7] == 0.0
+        map.putString("value", if (passed) Base64.encodeToString(faceTemplate.template, Base64.NO_WRAP) else "")
+        map.putMap("quality", QualityScoresToWritableMap(scores))
+
+        errorCode
+    }
+  }
+
+  override fun StartInitialization(prefetchDirectories: String, iBeta: Boolean, warmUp: Boolean, trackerParameters: String): WritableMap {
+    val app = reactContext.applicationContext as Application
+    val livenessModel = if (iBeta) "external:dataDir=" + app.cacheDir.absolutePath else ""
+
+    return ExecuteSDKFunction { _ -> FSDKNative.StartInitialization(prefetchDirectories, livenessModel, warmUp, trackerParameters) }
+  }
+
+  override fun GetInitializationStatus(): WritableMap {
+    return ExecuteLongArrayResultSDKFunction({ value ->
+      FSDKNative.GetInitializationStatus(value)
+      FSDK.FSDKE_OK
+    }, 11)
+  }
+
+  override fun CreateFaceIndex(filename: String, maxConnections: Double, efConstruction: Double, efSearch: Double): WritableMap {
+    return ExecuteIntegerResultSDKFunction({ value ->
+      FSDKNative.CreateFaceIndex(filename, maxConnections.toInt(), efConstruction.toInt(), efSearch.toInt(), value)
+    })
+  }
+
+  override fun FreeFaceIndex(index: Double): WritableMap {
+    return ExecuteSDKFunction { _ -> FSDKNative.FreeFaceIndex(index.toInt()) }
+  }
+
+  override fun SaveFaceIndex(index: Double): WritableMap {
+    return ExecuteSDKFunction { _ -> FSDKNative.SaveFaceIndex(index.toInt()) }
+  }
+
+  override fun FaceIndexAddFaceTemplate(index: Double, id: Double, faceTemplate: String): WritableMap {
+    return ExecuteSDKFunction { _ -> FSDKNative.FaceIndexAddFaceTemplate(index.toInt(), id.toLong(), Base64ToTemplate(faceTemplate)) }
+  }
+
+  override fun FaceIndexAddTrackerFaces(index: Double, tracker: Double): WritableMap {
+    return ExecuteLongResultSDKFunction({ value -> FSDKNative.FaceIndexAddTrackerFaces(index.toInt(), Tracker(tracker.toInt()), value) })
+  }
+
+  override fun FaceIndexRemoveID(index: Double, id: Double): WritableMap {
+    return ExecuteSDKFunction { _ -> FSDKNative.FaceIndexRemoveID(index.toInt(), id.toLong()) }
+  }
+
+  override fun FaceIndexMatchFaces(index: Double, faceTemplate: String, threshold: Double, maxSize: Double): WritableMap {
+    return ExecuteIDSimilaritiesSDKFunction({ value, count ->
+      val ids = LongArray(value.size)
+      val similarities = FloatArray(value.size)
+      val errorCode = FSDKNative.FaceIndexMatchFaces(index.toInt(), Base64ToTemplate(faceTemplate), threshold.toFloat(), ids, similarities, count)
+      for (i in 0..count[0].toInt() - 1) {
+        value[i].ID = ids[i]
+        value[i].similarity = similarities[i]
+      }
+      errorCode
+    }, maxSize.toInt())
+  }
+
+  override fun GetFaceIndexStatistics(index: Double): WritableMap {
+    return ExecuteLongArrayResultSDKFunction({ value -> FSDKNative.GetFaceIndexStatistics(index.toInt(), value) }, 5)
   }
 
   override fun InitializeIBeta(): WritableMap {
@@ -0,0 +1,242 @@
+#pragma once
+
+#include "LuxandFaceSDK.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+// Helpers shared by the command line benchmark tools: argument parsing, FaceSDK initialization,
+// latency statistics, Pareto frontier and CSV/JSON output.
+namespace fsdk::benchmark {
+
+inline long long Now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+inline std::string Trim(const std::string& value) {
+    const size_t first = value.find_first_not_of(" \t\r\n");
+    if (first == std::string::npos)
+        return "";
+    return value.substr(first, value.find_last_not_of(" \t\r\n") - first + 1);
+}
+
+inline std::vector<std::string> Split(const std::string& value, char separator) {
+    std::vector<std::string> result;
+    size_t start = 0;
+    while (true) {
+        const size_t end = value.find(separator, start);
+        result.push_back(Trim(value.substr(start, end == std::string::npos ? std::string::npos : end - start)));
+        if (end == std::string::npos)
+            return result;
+        start = end + 1;
+    }
+}
+
+// Parses "--name value" pairs and "--flag" switches. Options may be repeated.
+class Arguments {
+public:
+    Arguments(int argc, char** argv) {
+        for (int i = 1; i < argc; ++i) {
+            std::string name = argv[i];
+            if (name.rfind("--", 0) != 0) {
+                positional.push_back(name);
+                continue;
+            }
+            name = name.substr(2);
+            const bool hasValue = i + 1 < argc && std::string(argv[i + 1]).rfind("--", 0) != 0;
+            options[name].push_back(hasValue ? argv[++i] : "");
+        }
+    }
+
+    bool Has(const std::string& name) const {
+        return options.count(name) > 0;
+    }
+
+    std::string Get(const std::string& name, const std::string& defaultValue = "") const {
+        const auto it = options.find(name);
+        return it == options.end() ? defaultValue : it->second.back();
+    }
+
+    int GetInt(const std::string& name, int defaultValue) const {
+        return Has(name) ? atoi(Get(name).c_str()) : defaultValue;
+    }
+
+    std::vector<std::string> GetAll(const std::string& name) const {
+        const auto it = options.find(name);
+        return it == options.end() ? std::vector<std::string>() : it->second;
+    }
+
+    std::vector<std::string> positional;
+
+private:
+    std::map<std::string, std::vector<std::string>> options;
+};
+
+inline void Check(int errorCode, const char* what) {
+    if (errorCode == FSDKE_OK)
+        return;
+    fprintf(stderr, "%s failed with error %d\n", what, errorCode);
+    exit(1);
+}
+
+// Activates and initializes FaceSDK. The license key is taken from --license or the FSDK_LICENSE_KEY
+// environment variable, data files are loaded from --data and --threads sets the number of SDK threads.
+inline void InitializeFSDK(const Arguments& arguments) {
+    std::string license = arguments.Get("license");
+    if (license.empty() && getenv("FSDK_LICENSE_KEY"))
+        license = getenv("FSDK_LICENSE_KEY");
+    Check(FSDK_ActivateLibrary(license.c_str()), "FSDK_ActivateLibrary");
+
+    std::string data = arguments.Get("data");
+    Check(FSDK_Initialize(&data[0]), "FSDK_Initialize");
+
+    if (arguments.Has("threads"))
+        Check(FSDK_SetNumThreads(arguments.GetInt("threads", 1)), "FSDK_SetNumThreads");
+}
+
+// Linear interpolation between the closest ranks, `values` must be sorted.
+inline double Percentile(const std::vector<double>& values, double percentile) {
+    if (values.empty())
+        return 0;
+    const double rank = percentile / 100.0 * (values.size() - 1);
+    const size_t lower = (size_t)std::floor(rank);
+    const size_t upper = std::min(lower + 1, values.size() - 1);
+    return values[lower] + (values[upper] - values[lower]) * (rank - lower);
+}
+
+struct Summary {
+    size_t count = 0;
+    double total = 0;
+    double mean = 0;
+    double p50 = 0;
+    double p90 = 0;
+    double p99 = 0;
+    double max = 0;
+};
+
+inline Summary Summarize(std::vector<double> values) {
+    Summary summary;
+    if (values.empty())
+        return summary;
+    std::sort(values.begin(), values.end());
+    summary.count = values.size();
+    for (const double value : values)
+        summary.total += value;
+    summary.mean = summary.total / values.size();
+    summary.p50 = Percentile(values, 50);
+    summary.p90 = Percentile(values, 90);
+    summary.p99 = Percentile(values, 99);
+    summary.max = values.back();
+    return summary;
+}
+
+// Marks the points not dominated by any other point. Every objective is maximized,
+// negate the objectives that should be minimized.
+inline std::vector<bool> ParetoFrontier(const std::vector<std::vector<double>>& points) {
+    std::vector<bool> frontier(points.size(), true);
+    for (size_t i = 0; i < points.size(); ++i) {
+        for (size_t j = 0; j < points.size() && frontier[i]; ++j) {
+            if (i == j)
+                continue;
+            bool notWorse = true, better = false;
+            for (size_t k = 0; k < points[i].size(); ++k) {
+                notWorse = notWorse && points[j][k] >= points[i][k];
+                better = better || points[j][k] > points[i][k];
+            }
+            if (notWorse && better)
+                frontier[i] = false;
+        }
+    }
+    return frontier;
+}
+
+// A table written either as CSV or as a JSON array of objects. Values are stored
+// as strings, numeric columns are written to JSON without quotes.
+class Table {
+public:
+    explicit Table(std::vector<std::string> columns) : columns(std::move(columns)) {}
+
+    void AddRow(std::vector<std::string> row) {
+        rows.push_back(std::move(row));
+    }
+
+    static std::string Number(double value, int precision = 4) {
+        if (!std::isfinite(value))
+            return "";
+        char buffer[64];
+        snprintf(buffer, sizeof(buffer), "%.*f", precision, value);
+        return buffer;
+    }
+
+    bool SaveCSV(const std::string& filename) const {
+        std::ofstream file(filename);
+        for (size_t i = 0; i < columns.size(); ++i)
+            file << (i ? "," : "") << EscapeCSV(columns[i]);
+        file << '\n';
+        for (const auto& row : rows) {
+            for (size_t i = 0; i < row.size(); ++i)
+                file << (i ? "," : "") << EscapeCSV(row[i]);
+            file << '\n';
+        }
+        return (bool)file;
+    }
+
+    bool SaveJSON(const std::string& filename) const {
+        std::ofstream file(filename);
+        file << "[\n";
+        for (size_t r = 0; r < rows.size(); ++r) {
+            file << "  {";
+            for (size_t i = 0; i < columns.size(); ++i) {
+                const std::string& value = i < rows[r].size() ? rows[r][i] : "";
+                file << (i ? ", " : "") << '"' << EscapeJSON(columns[i]) << "\": ";
+                if (value.empty())
+                    file << "null";
+                else if (IsNumber(value))
+                    file << value;
+                else
+                    file << '"' << EscapeJSON(value) << '"';
+            }
+            file << (r + 1 < rows.size() ? "},\n" : "}\n");
+        }
+        file << "]\n";
+        return (bool)file;
+    }
+
+private:
+    static bool IsNumber(const std::string& value) {
+        char* end = nullptr;
+        strtod(value.c_str(), &end);
+        return end && *end == 0 && value.find_first_of("xXnN") == std::string::npos;
+    }
+
+    static std::string EscapeCSV(const std::string& value) {
+        if (value.find_first_of(",\"\n") == std::string::npos)
+            return value;
+        std::string result = "\"";
+        for (const char c : value)
+            result += c == '"' ? "\"\"" : std::string(1, c);
+        return result + '"';
+    }
+
+    static std::string EscapeJSON(const std::string& value) {
+        std::string result;
+        for (const char c : value) {
+            if (c == '"' || c == '\\')
+                result += '\\';
+            result += (unsigned char)c < 0x20 ? ' ' : c;
+        }
+        return result;
+    }
+
+    std::vector<std::string> columns;
+    std::vector<std::vector<std::string>> rows;
+};
+
+}
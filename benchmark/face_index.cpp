@@ -0,0 +1,237 @@
+// Measures the recall and the speed of the HNSW graph behind the face index (cpp/FSDKFaceIndex.h) on synthetic
+// templates, since a million real templates are rarely at hand. Templates are random unit vectors grouped
+// around cluster centers, compared by their dot product; queries are indexed templates with added noise, the
+// way a new photo of an enrolled person is. The exact neighbours are found by brute force.
+//
+// face_index [--count 1000000] [--dim 128] [--clusters 1000] [--queries 1000] [--k 10] [--ef "32,64,128,256"]
+//            [--m 16] [--ef-construction 200] [--remove 0.1] [--search-threads N] [--seed 1]
+//            [--image face.jpg] [--csv summary.csv] [--json summary.json] [--license KEY] [--data PATH]
+//
+// For every --ef the tool reports recall@k against brute force, queries per second on one core and on
+// --search-threads cores, latency percentiles, similarities computed per query and the speedup over brute
+// force. --remove removes a fraction of the templates after the graph is built, like FaceIndexRemoveID.
+// FaceSDK templates can only be compared with FSDK_MatchFaces, so the search time of the face index is about
+// the number of similarities per query times the time of one FSDK_MatchFaces call; with --image the tool
+// measures that call on the face found on the image and reports the projected latency.
+
+#include "BenchmarkUtils.h"
+#include "FSDKHNSW.h"
+#include "FSDKParallel.h"
+
+#include <cstdio>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+using namespace fsdk::benchmark;
+
+namespace {
+
+struct Vectors {
+    int dim = 0;
+    std::vector<float> values;
+
+    const float* operator[](size_t index) const {
+        return &values[index * dim];
+    }
+
+    float Similarity(const float* first, const float* second) const {
+        float sum = 0;
+        for (int i = 0; i < dim; ++i)
+            sum += first[i] * second[i];
+        return sum;
+    }
+};
+
+void Normalize(float* vector, int dim) {
+    float norm = 0;
+    for (int i = 0; i < dim; ++i)
+        norm += vector[i] * vector[i];
+    norm = norm > 0 ? 1 / std::sqrt(norm) : 0;
+    for (int i = 0; i < dim; ++i)
+        vector[i] *= norm;
+}
+
+// Templates around the cluster centers and queries near random templates
+void Generate(int count, int queryCount, int dim, int clusters, uint64_t seed, Vectors* templates, Vectors* queries) {
+    std::mt19937_64 random(seed);
+    std::normal_distribution<float> normal;
+    std::vector<float> centers((size_t)clusters * dim);
+    for (float& value : centers)
+        value = normal(random);
+
+    templates->dim = queries->dim = dim;
+    templates->values.resize((size_t)count * dim);
+    for (int i = 0; i < count; ++i) {
+        const float* center = &centers[(random() % clusters) * dim];
+        float* vector = &templates->values[(size_t)i * dim];
+        for (int d = 0; d < dim; ++d)
+            vector[d] = center[d] + 0.8f * normal(random);
+        Normalize(vector, dim);
+    }
+
+    queries->values.resize((size_t)queryCount * dim);
+    for (int i = 0; i < queryCount; ++i) {
+        const float* source = (*templates)[random() % count];
+        float* vector = &queries->values[(size_t)i * dim];
+        for (int d = 0; d < dim; ++d)
+            vector[d] = source[d] + 0.04f * normal(random);
+        Normalize(vector, dim);
+    }
+}
+
+// The k most similar templates not removed, most similar first
+std::vector<uint32_t> BruteForce(const Vectors& templates, const std::vector<char>& removed, const float* query, int k) {
+    std::vector<fsdk::HNSWGraph::Candidate> all;
+    all.reserve(removed.size());
+    for (uint32_t i = 0; i < removed.size(); ++i)
+        if (!removed[i])
+            all.emplace_back(templates.Similarity(query, templates[i]), i);
+    k = std::min(k, (int)all.size());
+    std::partial_sort(all.begin(), all.begin() + k, all.end(), std::greater<fsdk::HNSWGraph::Candidate>());
+
+    std::vector<uint32_t> result(k);
+    for (int i = 0; i < k; ++i)
+        result[i] = all[i].second;
+    return result;
+}
+
+// Nanoseconds of one FSDK_MatchFaces call on the template of the face found on the image
+double MeasureMatchFaces(const Arguments& arguments, const std::string& filename) {
+    InitializeFSDK(arguments);
+    HImage image;
+    Check(FSDK_LoadImageFromFile(&image, filename.c_str()), "FSDK_LoadImageFromFile");
+    FSDK_FaceTemplate faceTemplate;
+    Check(FSDK_GetFaceTemplate2(image, &faceTemplate), "FSDK_GetFaceTemplate2");
+    FSDK_FreeImage(image);
+
+    const int calls = 20000;
+    float similarity = 0;
+    const long long start = Now();
+    for (int i = 0; i < calls; ++i)
+        Check(FSDK_MatchFaces(&faceTemplate, &faceTemplate, &similarity), "FSDK_MatchFaces");
+    const double elapsed = (double)(Now() - start) / calls;
+    FSDK_Finalize();
+    return elapsed;
+}
+
+}
+
+int main(int argc, char** argv) {
+    const Arguments arguments(argc, argv);
+    if (arguments.Has("help")) {
+        fprintf(stderr,
+                "Usage: face_index [--count 1000000] [--dim 128] [--clusters 1000] [--queries 1000] [--k 10] [--ef \"32,64,128,256\"]\n"
+                "                  [--m 16] [--ef-construction 200] [--remove 0.1] [--search-threads N] [--seed 1]\n"
+                "                  [--image face.jpg] [--csv summary.csv] [--json summary.json] [--license KEY] [--data PATH]\n");
+        return 1;
+    }
+
+    const int count = std::max(1, arguments.GetInt("count", 1000000));
+    const int dim = std::max(2, arguments.GetInt("dim", 128));
+    const int clusters = std::max(1, arguments.GetInt("clusters", 1000));
+    const int queryCount = std::max(1, arguments.GetInt("queries", 1000));
+    const int k = std::max(1, arguments.GetInt("k", 10));
+    const int maxConnections = arguments.GetInt("m", 16);
+    const int efConstruction = arguments.GetInt("ef-construction", 200);
+    const double removeFraction = std::min(0.99, std::max(0.0, atof(arguments.Get("remove", "0").c_str())));
+    const int searchThreads = fsdk::ResolveThreadCount(arguments.GetInt("search-threads", 0), queryCount);
+    std::vector<int> efs;
+    for (const std::string& value : Split(arguments.Get("ef", "32,64,128,256"), ','))
+        efs.push_back(std::max(k, atoi(value.c_str())));
+
+    const double matchFacesNs = arguments.Has("image") ? MeasureMatchFaces(arguments, arguments.Get("image")) : 0;
+    if (matchFacesNs > 0)
+        printf("FSDK_MatchFaces: %.0f ns per call\n", matchFacesNs);
+
+    Vectors templates, queries;
+    Generate(count, queryCount, dim, clusters, (uint64_t)arguments.GetInt("seed", 1), &templates, &queries);
+
+    fsdk::HNSWGraph graph(maxConnections, efConstruction);
+    long long start = Now();
+    for (uint32_t node = 0; node < (uint32_t)count; ++node) {
+        const float* inserted = templates[node];
+        graph.Insert([&](uint32_t other) { return templates.Similarity(inserted, templates[other]); },
+                     [&](uint32_t first, uint32_t second) { return templates.Similarity(templates[first], templates[second]); });
+        if ((node + 1) % 100000 == 0)
+            fprintf(stderr, "%u templates inserted\n", node + 1);
+    }
+    const double buildSeconds = (Now() - start) / 1e9;
+    printf("%d templates of %d dimensions inserted in %.1f s, %.0f per second\n", count, dim, buildSeconds, count / buildSeconds);
+
+    std::mt19937_64 random(7);
+    std::vector<char> removed(count, 0);
+    for (int i = 0; i < (int)(removeFraction * count); ++i)
+        removed[random() % count] = 1;
+
+    // Exact neighbours on all the cores, one query timed on a single core for the speedup
+    std::vector<std::vector<uint32_t>> exact(queryCount);
+    fsdk::ParallelFor(queryCount, 0, [&](int, int query) { exact[query] = BruteForce(templates, removed, queries[query], k); });
+    start = Now();
+    const int bruteQueries = std::min(queryCount, 20);
+    for (int query = 0; query < bruteQueries; ++query)
+        BruteForce(templates, removed, queries[query], k);
+    const double bruteMs = (Now() - start) / 1e6 / bruteQueries;
+    printf("brute force: %.2f ms per query on one core\n", bruteMs);
+
+    Table table({"ef", "recall", "qps_per_core", "qps", "threads", "mean_ms", "p50_ms", "p99_ms", "similarities", "speedup", "projected_ms"});
+    for (const int ef : efs) {
+        std::vector<double> latencies(queryCount);
+        std::vector<double> recalls(queryCount);
+        std::vector<long long> similarities(queryCount);
+        auto search = [&](int query) {
+            const float* vector = queries[query];
+            long long computed = 0;
+            const long long begin = Now();
+            const auto found = graph.Search(
+                [&](uint32_t node) {
+                    ++computed;
+                    return templates.Similarity(vector, templates[node]);
+                },
+                ef, [&](uint32_t node) { return !removed[node]; });
+            latencies[query] = (Now() - begin) / 1e6;
+            similarities[query] = computed;
+
+            const std::unordered_set<uint32_t> truth(exact[query].begin(), exact[query].end());
+            int hits = 0;
+            for (size_t i = 0; i < found.size() && (int)i < k; ++i)
+                hits += (int)truth.count(found[i].second);
+            recalls[query] = truth.empty() ? 1 : (double)hits / truth.size();
+        };
+
+        start = Now();
+        for (int query = 0; query < queryCount; ++query)
+            search(query);
+        const double qpsPerCore = queryCount / ((Now() - start) / 1e9);
+
+        start = Now();
+        fsdk::ParallelFor(queryCount, searchThreads, [&](int, int query) { search(query); });
+        const double qps = queryCount / ((Now() - start) / 1e9);
+
+        double recall = 0, computed = 0;
+        for (int query = 0; query < queryCount; ++query) {
+            recall += recalls[query] / queryCount;
+            computed += (double)similarities[query] / queryCount;
+        }
+        const Summary summary = Summarize(latencies);
+        const double projectedMs = computed * matchFacesNs / 1e6;
+
+        printf("ef %d: recall@%d %.4f, %.0f queries/s per core, %.0f queries/s on %d threads, p50 %.3f ms, p99 %.3f ms, "
+               "%.0f similarities per query, %.0fx faster than brute force", ef, k, recall, qpsPerCore, qps, searchThreads, summary.p50, summary.p99,
+               computed, bruteMs * qpsPerCore / 1000);
+        if (matchFacesNs > 0)
+            printf(", %.1f ms per query with FSDK_MatchFaces", projectedMs);
+        printf("\n");
+
+        table.AddRow({std::to_string(ef), Table::Number(recall), Table::Number(qpsPerCore, 1), Table::Number(qps, 1), std::to_string(searchThreads),
+                      Table::Number(summary.mean, 3), Table::Number(summary.p50, 3), Table::Number(summary.p99, 3), Table::Number(computed, 1),
+                      Table::Number(bruteMs * qpsPerCore / 1000, 1), matchFacesNs > 0 ? Table::Number(projectedMs, 3) : ""});
+    }
+
+    if (arguments.Has("csv") && !table.SaveCSV(arguments.Get("csv")))
+        fprintf(stderr, "Cannot write %s\n", arguments.Get("csv").c_str());
+    if (arguments.Has("json") && !table.SaveJSON(arguments.Get("json")))
+        fprintf(stderr, "Cannot write %s\n", arguments.Get("json").c_str());
+    return 0;
+}
@@ -0,0 +1,156 @@
+// Checks the YUV conversion of the frame plugins (cpp/FSDKFrameConversion.h) against the Kotlin conversion the
+// Android plugin used before it, on synthetic I420 and NV21 frames of gray and saturated colors.
+//
+// frame_conversion_test [--width 64] [--height 48]
+//
+// The Kotlin code copied the chroma into an NV21 array (V before U) and then read the first byte of every
+// pair as U, so red was computed from the blue difference and blue from the red difference, each with the
+// other's coefficient. Since it also wrote blue into byte 0 and red into byte 2, red still ended up in byte 0:
+// its output was in the R, G, B byte order, with distorted colors. The native conversion writes R, G, B with
+// the BT.601 coefficients. The test requires the two to be identical on gray, where chroma has no effect,
+// and to put the dominant channel of every saturated color into the same byte. The tool exits with 1 on a
+// mismatch.
+
+#include "BenchmarkUtils.h"
+#include "FSDKFrameConversion.h"
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+using namespace fsdk::benchmark;
+
+namespace {
+
+struct Color {
+    const char* name;
+    int r, g, b;
+};
+
+const Color COLORS[] = {
+    {"gray", 128, 128, 128}, {"black", 0, 0, 0}, {"white", 255, 255, 255},
+    {"red", 255, 0, 0},      {"green", 0, 255, 0}, {"blue", 0, 0, 255},
+};
+
+struct Frame {
+    int width;
+    int height;
+    std::vector<unsigned char> y;
+    std::vector<unsigned char> u;
+    std::vector<unsigned char> v;
+};
+
+// A frame filled with one color, in full range BT.601 YUV
+Frame MakeFrame(const Color& color, int width, int height) {
+    const double y = 0.299 * color.r + 0.587 * color.g + 0.114 * color.b;
+    const auto clamp = [](double value) { return (unsigned char)std::lround(std::min(255.0, std::max(0.0, value))); };
+
+    Frame frame{width, height, {}, {}, {}};
+    frame.y.assign((size_t)width * height, clamp(y));
+    frame.u.assign((size_t)(width / 2) * (height / 2), clamp(128 + (color.b - y) / 1.772));
+    frame.v.assign((size_t)(width / 2) * (height / 2), clamp(128 + (color.r - y) / 1.402));
+    return frame;
+}
+
+unsigned char ClampByte(int value) {
+    return (unsigned char)std::min(255, std::max(0, value));
+}
+
+// The Kotlin conversion (FrameToFSDKImagePlugin.createFromYUV) of an upright frame
+std::vector<unsigned char> KotlinConversion(const Frame& frame) {
+    const int width = frame.width, height = frame.height;
+    std::vector<unsigned char> nv21(frame.y);
+    for (size_t i = 0; i < frame.u.size(); ++i) {
+        nv21.push_back(frame.v[i]);
+        nv21.push_back(frame.u[i]);
+    }
+
+    std::vector<unsigned char> rgb((size_t)3 * width * height);
+    const auto fill = [&](int r, int g, int b, int y, int index) {
+        rgb[index + 2] = ClampByte(y + r);
+        rgb[index + 1] = ClampByte(y - g);
+        rgb[index] = ClampByte(y + b);
+    };
+
+    int cIndex = width * height;
+    for (int i = 0; i < height / 2; ++i) {
+        int yIndex = 2 * i * width;
+        int outIndex = 2 * i * 3 * width;
+        for (int j = 0; j < width / 2; ++j) {
+            const int u = nv21[cIndex];
+            const int v = nv21[cIndex + 1];
+            const int r = (91881 * v >> 16) - 179;
+            const int g = ((22544 * u + 46793 * v) >> 16) - 135;
+            const int b = (116129 * u >> 16) - 226;
+
+            fill(r, g, b, nv21[yIndex], outIndex);
+            fill(r, g, b, nv21[yIndex + 1], outIndex + 3);
+            fill(r, g, b, nv21[yIndex + width], outIndex + 3 * width);
+            fill(r, g, b, nv21[yIndex + width + 1], outIndex + 3 * width + 3);
+
+            yIndex += 2;
+            cIndex += 2;
+            outIndex += 6;
+        }
+    }
+    return rgb;
+}
+
+// The native conversion of the frame with planar (I420) or interleaved (NV21) chroma
+std::vector<unsigned char> NativeConversion(const Frame& frame, bool interleaved) {
+    const int chromaWidth = frame.width / 2;
+    std::vector<unsigned char> vu;
+    for (size_t i = 0; i < frame.u.size(); ++i) {
+        vu.push_back(frame.v[i]);
+        vu.push_back(frame.u[i]);
+    }
+
+    const fsdk::ImagePlane y = {frame.y.data(), (long long)frame.y.size(), frame.width, 1};
+    const fsdk::ImagePlane u = interleaved ? fsdk::ImagePlane{vu.data() + 1, (long long)vu.size() - 1, 2 * chromaWidth, 2}
+                                           : fsdk::ImagePlane{frame.u.data(), (long long)frame.u.size(), chromaWidth, 1};
+    const fsdk::ImagePlane v = interleaved ? fsdk::ImagePlane{vu.data(), (long long)vu.size(), 2 * chromaWidth, 2}
+                                           : fsdk::ImagePlane{frame.v.data(), (long long)frame.v.size(), chromaWidth, 1};
+
+    fsdk::OutputLayout layout;
+    Check(fsdk::GetOutputLayout(frame.width, frame.height, 0, false, &layout), "GetOutputLayout");
+    std::vector<unsigned char> rgb((size_t)3 * frame.width * frame.height);
+    Check(fsdk::ConvertYUV420(y, u, v, frame.width, frame.height, layout, rgb.data()), "ConvertYUV420");
+    return rgb;
+}
+
+int Dominant(const unsigned char* pixel) {
+    return pixel[0] >= pixel[1] && pixel[0] >= pixel[2] ? 0 : pixel[1] >= pixel[2] ? 1 : 2;
+}
+
+}
+
+int main(int argc, char** argv) {
+    const Arguments arguments(argc, argv);
+    const int width = std::max(2, arguments.GetInt("width", 64)) & ~1;
+    const int height = std::max(2, arguments.GetInt("height", 48)) & ~1;
+
+    int failures = 0;
+    for (const Color& color : COLORS) {
+        const Frame frame = MakeFrame(color, width, height);
+        const std::vector<unsigned char> kotlin = KotlinConversion(frame);
+        const bool gray = color.r == color.g && color.g == color.b;
+
+        for (const bool interleaved : {false, true}) {
+            const std::vector<unsigned char> native = NativeConversion(frame, interleaved);
+
+            int maxDifference = 0;
+            bool sameOrder = true;
+            for (size_t pixel = 0; pixel < native.size(); pixel += 3) {
+                for (int channel = 0; channel < 3; ++channel)
+                    maxDifference = std::max(maxDifference, std::abs(native[pixel + channel] - kotlin[pixel + channel]));
+                sameOrder = sameOrder && (gray || Dominant(&native[pixel]) == Dominant(&kotlin[pixel]));
+            }
+
+            const bool passed = sameOrder && (!gray || maxDifference == 0) && (gray || Dominant(&native[0]) == (color.r ? 0 : color.g ? 1 : 2));
+            printf("%-5s %-4s native %3d %3d %3d, kotlin %3d %3d %3d, max difference %3d: %s\n", color.name, interleaved ? "NV21" : "I420",
+                   native[0], native[1], native[2], kotlin[0], kotlin[1], kotlin[2], maxDifference, passed ? "ok" : "FAILED");
+            failures += !passed;
+        }
+    }
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,224 @@
+// Replays a frame recording made by the frame plugins (FSDK.StartFrameRecording) or a Motion JPEG file
+// through the same frame conversion and FSDK_FeedFrame pipeline as the application, either as fast as
+// possible or at the pace of the recorded timestamps, and reports fps and latency percentiles.
+//
+// frame_replay --input frames.rec [--realtime] [--fps 30] [--loops 1] [--warmup 10] [--keyframe-interval N]
+//              [--set "DetectionVersion=2"] [--csv summary.csv] [--json summary.json] [--frames frames.csv]
+//              [--license KEY] [--data PATH] [--threads N]
+//
+// In real-time mode a frame that arrives while the previous one is still being processed is dropped, as
+// the camera does, and the latency of a frame is measured from its arrival. --fps sets the frame rate of
+// Motion JPEG files, which have no timestamps.
+
+#include "BenchmarkUtils.h"
+#include "FSDKFrameRecording.h"
+#include "FSDKKeyframeTracker.h"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace fsdk::benchmark;
+
+namespace {
+
+const int MAX_FACES = 256;
+
+struct FrameResult {
+    long long index;
+    long long timestamp;
+    double convert;
+    double feed;
+    double latency;
+    long long faces;
+    bool keyframe;
+};
+
+// The tracker, optionally run on keyframes only.
+class Pipeline {
+public:
+    Pipeline(const std::string& parameters, int keyframeInterval) {
+        Check(FSDK_CreateTracker(&tracker), "FSDK_CreateTracker");
+        int errorPosition = 0;
+        if (FSDK_SetTrackerMultipleParameters(tracker, parameters.c_str(), &errorPosition) != FSDKE_OK) {
+            fprintf(stderr, "Cannot set tracker parameters \"%s\" at position %d\n", parameters.c_str(), errorPosition);
+            exit(1);
+        }
+        if (keyframeInterval > 0) {
+            fsdk::KeyframeTrackerParameters keyframeParameters;
+            keyframeParameters.keyframeInterval = keyframeInterval;
+            Check(fsdk::CreateKeyframeTracker(tracker, keyframeParameters, &keyframeTracker), "CreateKeyframeTracker");
+        }
+    }
+
+    ~Pipeline() {
+        if (keyframeTracker)
+            fsdk::FreeKeyframeTracker(keyframeTracker);
+        FSDK_FreeTracker(tracker);
+    }
+
+    int FeedFrame(HImage image, long long* count, bool* keyframe) {
+        *keyframe = true;
+        if (keyframeTracker)
+            return fsdk::KeyframeTrackerFeedFrame(keyframeTracker, 0, image, count, ids, sizeof(ids), keyframe);
+        return FSDK_FeedFrame(tracker, 0, image, count, ids, sizeof(ids));
+    }
+
+private:
+    HTracker tracker = 0;
+    fsdk::HKeyframeTracker keyframeTracker = 0;
+    long long ids[MAX_FACES];
+};
+
+// Converts and feeds one frame, returns false on errors.
+bool Process(Pipeline& pipeline, const fsdk::RecordedFrame& frame, FrameResult* result) {
+    const long long start = Now();
+    HImage image = 0;
+    int errorCode = fsdk::LoadImageFromRecordedFrame(&image, frame);
+    if (errorCode != FSDKE_OK) {
+        fprintf(stderr, "Cannot convert frame %lld: error %d\n", result->index, errorCode);
+        return false;
+    }
+    const long long converted = Now();
+
+    errorCode = pipeline.FeedFrame(image, &result->faces, &result->keyframe);
+    const long long end = Now();
+    FSDK_FreeImage(image);
+    if (errorCode != FSDKE_OK) {
+        fprintf(stderr, "FeedFrame failed on frame %lld: error %d\n", result->index, errorCode);
+        return false;
+    }
+
+    result->convert = (converted - start) / 1e6;
+    result->feed = (end - converted) / 1e6;
+    result->latency = (end - start) / 1e6;
+    return true;
+}
+
+}
+
+int main(int argc, char** argv) {
+    const Arguments arguments(argc, argv);
+    if (!arguments.Has("input") || arguments.Has("help")) {
+        fprintf(stderr,
+                "Usage: frame_replay --input FILE [--realtime] [--fps 30] [--loops 1] [--warmup 10] [--keyframe-interval N]\n"
+                "                    [--set \"Name=Value;...\"] [--csv FILE] [--json FILE] [--frames FILE]\n"
+                "                    [--license KEY] [--data PATH] [--threads N]\n");
+        return 1;
+    }
+
+    const std::string input = arguments.Get("input");
+    const bool realtime = arguments.Has("realtime");
+    const double fps = atof(arguments.Get("fps", "30").c_str());
+    const int loops = std::max(1, arguments.GetInt("loops", 1));
+    const int warmup = arguments.GetInt("warmup", 10);
+    const int keyframeInterval = arguments.GetInt("keyframe-interval", 0);
+    std::string parameters;
+    for (const auto& value : arguments.GetAll("set"))
+        parameters += value + (value.empty() || value.back() == ';' ? "" : ";");
+
+    InitializeFSDK(arguments);
+
+    // A separate tracker loads the models, so the measured tracker starts with an empty memory
+    if (warmup > 0) {
+        Pipeline pipeline(parameters, keyframeInterval);
+        int processed = 0;
+        const int errorCode = fsdk::ReadFrameRecording(input.c_str(), fps, [&](const fsdk::RecordedFrame& frame) {
+            FrameResult result = {};
+            return Process(pipeline, frame, &result) && ++processed < warmup;
+        });
+        Check(errorCode, "ReadFrameRecording");
+    }
+
+    Pipeline pipeline(parameters, keyframeInterval);
+    std::vector<FrameResult> results;
+    long long frames = 0, dropped = 0;
+    bool failed = false;
+    const long long start = Now();
+    // End of the processing of the last frame and the arrival time of the first frame of the loop
+    long long busyUntil = 0, loopStart = 0;
+
+    for (int loop = 0; loop < loops && !failed; ++loop) {
+        long long firstTimestamp = -1;
+        const int errorCode = fsdk::ReadFrameRecording(input.c_str(), fps, [&](const fsdk::RecordedFrame& frame) {
+            FrameResult result = {};
+            result.index = frames++;
+            result.timestamp = frame.timestamp;
+
+            long long arrival = 0;
+            if (realtime) {
+                if (firstTimestamp < 0) {
+                    firstTimestamp = frame.timestamp;
+                    loopStart = std::max(Now(), busyUntil);
+                }
+                arrival = loopStart + (frame.timestamp - firstTimestamp);
+                if (arrival < busyUntil) {
+                    ++dropped;
+                    return true;
+                }
+                const long long now = Now();
+                if (arrival > now)
+                    std::this_thread::sleep_for(std::chrono::nanoseconds(arrival - now));
+            }
+
+            if (!Process(pipeline, frame, &result)) {
+                failed = true;
+                return false;
+            }
+            busyUntil = Now();
+            if (realtime)
+                result.latency = (busyUntil - arrival) / 1e6;
+            results.push_back(result);
+            return true;
+        });
+        Check(errorCode, "ReadFrameRecording");
+    }
+    const double elapsed = (Now() - start) / 1e9;
+    if (failed)
+        return 1;
+
+    std::vector<double> convert, feed, latency;
+    long long keyframes = 0;
+    for (const auto& result : results) {
+        convert.push_back(result.convert);
+        feed.push_back(result.feed);
+        latency.push_back(result.latency);
+        keyframes += result.keyframe;
+    }
+
+    printf("%zu frames processed, %lld dropped, %lld keyframes in %.2f s: %.1f fps\n", results.size(), dropped, keyframes, elapsed,
+           elapsed > 0 ? results.size() / elapsed : 0);
+
+    Table table({"stage", "frames", "mean_ms", "p50_ms", "p90_ms", "p99_ms", "max_ms", "fps"});
+    const std::pair<const char*, std::vector<double>*> stages[] = {{"convert", &convert}, {"feed", &feed}, {"latency", &latency}};
+    for (const auto& stage : stages) {
+        const Summary summary = Summarize(*stage.second);
+        printf("    %-8s mean %.2f ms, p50 %.2f ms, p90 %.2f ms, p99 %.2f ms, max %.2f ms\n", stage.first, summary.mean, summary.p50, summary.p90,
+               summary.p99, summary.max);
+        std::vector<std::string> row = {stage.first, std::to_string(summary.count)};
+        for (const double value : {summary.mean, summary.p50, summary.p90, summary.p99, summary.max})
+            row.push_back(Table::Number(value, 3));
+        row.push_back(Table::Number(elapsed > 0 ? results.size() / elapsed : 0, 2));
+        table.AddRow(row);
+    }
+
+    if (arguments.Has("csv") && !table.SaveCSV(arguments.Get("csv")))
+        fprintf(stderr, "Cannot write %s\n", arguments.Get("csv").c_str());
+    if (arguments.Has("json") && !table.SaveJSON(arguments.Get("json")))
+        fprintf(stderr, "Cannot write %s\n", arguments.Get("json").c_str());
+
+    if (arguments.Has("frames")) {
+        Table frameTable({"frame", "timestamp_ms", "convert_ms", "feed_ms", "latency_ms", "faces", "keyframe"});
+        for (const auto& result : results)
+            frameTable.AddRow({std::to_string(result.index), Table::Number(result.timestamp / 1e6, 3), Table::Number(result.convert, 3),
+                               Table::Number(result.feed, 3), Table::Number(result.latency, 3), std::to_string(result.faces),
+                               result.keyframe ? "1" : "0"});
+        if (!frameTable.SaveCSV(arguments.Get("frames")))
+            fprintf(stderr, "Cannot write %s\n", arguments.Get("frames").c_str());
+    }
+
+    FSDK_Finalize();
+    return 0;
+}
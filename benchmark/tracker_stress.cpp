@@ -0,0 +1,382 @@
+// Runs several trackers at once, each fed from its own thread while other threads read and change it through
+// the same entry points as the module, to check the tracker locks (cpp/FSDKTrackerLock.h) and the functions
+// built on them under ThreadSanitizer, and to measure how feeding scales with the number of trackers.
+//
+// tracker_stress --images "a.jpg;b.jpg" [--trackers 4] [--seconds 10] [--readers 2] [--writers 1]
+//                [--keyframe-interval N] [--governor MAX_TEMPLATES] [--scaling] [--set "DetectionVersion=2"]
+//                [--csv summary.csv] [--json summary.json] [--license KEY] [--data PATH] [--threads N]
+//
+// Every tracker gets its own copies of the images, a result slot polled by a separate thread and optionally a
+// keyframe tracker and a memory governor. Readers list IDs and read names, faces, attributes and face images,
+// writers name, lock, unlock and purge IDs, set face images and parameters. With --scaling the trackers are
+// only fed, first one of them, then twice as many and so on, and the speedup over one tracker is reported.
+//
+// The tool exits with 1 when a call fails with an error other than the ones expected when IDs are merged or
+// purged by another thread. Configure with -DFSDK_TSAN=ON to build it with ThreadSanitizer.
+
+#include "BenchmarkUtils.h"
+#include "FSDKKeyframeTracker.h"
+#include "FSDKMemoryGovernor.h"
+#include "FSDKResultSlot.h"
+#include "FSDKThumbnailStore.h"
+#include "FSDKTrackerLock.h"
+
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace fsdk::benchmark;
+
+namespace {
+
+const int MAX_FACES = 64;
+
+std::atomic<bool> stopped{false};
+
+struct Options {
+    std::vector<std::string> images;
+    std::string parameters;
+    int readers = 2;
+    int writers = 1;
+    int keyframeInterval = 0;
+    long long governorTemplates = -1;
+    bool feedOnly = false;
+};
+
+// A tracker with everything attached to it. Only the feeding thread touches the latency samples.
+struct Stressed {
+    HTracker tracker = 0;
+    fsdk::HKeyframeTracker keyframeTracker = 0;
+    fsdk::HResultSlot slot = 0;
+    std::vector<HImage> images;
+
+    std::vector<double> feed;
+    std::atomic<long long> reads{0};
+    std::atomic<long long> writes{0};
+    std::atomic<long long> published{0};
+    std::atomic<long long> failures{0};
+};
+
+// Errors another thread may cause by merging, purging or replacing IDs between two calls.
+void Expect(Stressed& stressed, int errorCode, const char* what) {
+    switch (errorCode) {
+    case FSDKE_OK:
+    case FSDKE_ID_NOT_FOUND:
+    case FSDKE_FACEID_NOT_FOUND:
+    case FSDKE_FACEIMAGE_NOT_FOUND:
+    case FSDKE_ATTRIBUTE_NOT_DETECTED:
+    case FSDKE_INSUFFICIENT_TRACKER_MEMORY_LIMIT:
+        return;
+    }
+    if (stressed.failures++ < 10)
+        fprintf(stderr, "%s failed with error %d\n", what, errorCode);
+}
+
+std::vector<long long> ListIDs(Stressed& stressed) {
+    const fsdk::TrackerLock lock(stressed.tracker, fsdk::TrackerLock::SHARED);
+    long long count = 0;
+    Expect(stressed, FSDK_GetTrackerIDsCount(stressed.tracker, &count), "FSDK_GetTrackerIDsCount");
+    std::vector<long long> ids((size_t)count);
+    if (count > 0)
+        Expect(stressed, FSDK_GetTrackerAllIDs(stressed.tracker, ids.data(), count * (long long)sizeof(long long)), "FSDK_GetTrackerAllIDs");
+    return ids;
+}
+
+// The first face template of the ID, 0 when the ID is gone.
+long long FirstFaceID(Stressed& stressed, long long id) {
+    const fsdk::TrackerLock lock(stressed.tracker, fsdk::TrackerLock::SHARED);
+    long long count = 0;
+    int errorCode = FSDK_GetTrackerFaceIDsCountForID(stressed.tracker, id, &count);
+    Expect(stressed, errorCode, "FSDK_GetTrackerFaceIDsCountForID");
+    if (errorCode != FSDKE_OK || count < 1)
+        return 0;
+    std::vector<long long> faceIDs((size_t)count);
+    errorCode = FSDK_GetTrackerFaceIDsForID(stressed.tracker, id, faceIDs.data(), count * (long long)sizeof(long long));
+    Expect(stressed, errorCode, "FSDK_GetTrackerFaceIDsForID");
+    return errorCode == FSDKE_OK ? faceIDs[0] : 0;
+}
+
+void Feed(Stressed& stressed) {
+    long long ids[MAX_FACES];
+    for (size_t frame = 0; !stopped; ++frame) {
+        const HImage image = stressed.images[frame % stressed.images.size()];
+        long long count = 0;
+        const long long start = Now();
+        int errorCode;
+        if (stressed.keyframeTracker) {
+            bool keyframe = false;
+            errorCode = fsdk::KeyframeTrackerFeedFrame(stressed.keyframeTracker, 0, image, &count, ids, sizeof(ids), &keyframe);
+        } else {
+            {
+                const fsdk::TrackerLock lock(stressed.tracker, fsdk::TrackerLock::EXCLUSIVE);
+                errorCode = FSDK_FeedFrame(stressed.tracker, 0, image, &count, ids, sizeof(ids));
+            }
+            fsdk::MemoryGovernorFrameFed(stressed.tracker, errorCode, ids, count);
+            fsdk::ResultSlotFrameFed(stressed.tracker, 0, errorCode, ids, count);
+        }
+        stressed.feed.push_back((Now() - start) / 1e6);
+        Expect(stressed, errorCode, "FeedFrame");
+    }
+}
+
+void Read(Stressed& stressed, unsigned int seed) {
+    std::mt19937 random(seed);
+    while (!stopped) {
+        const std::vector<long long> ids = ListIDs(stressed);
+        for (size_t i = 0; i < ids.size() && i < 8 && !stopped; ++i) {
+            const long long id = ids[random() % ids.size()];
+            {
+                const fsdk::TrackerLock lock(stressed.tracker, fsdk::TrackerLock::SHARED);
+                char value[1024];
+                TFace face;
+                Expect(stressed, FSDK_GetName(stressed.tracker, id, value, sizeof(value)), "FSDK_GetName");
+                // IDs not seen on the last frame have no face and attributes, their errors are not checked
+                if (FSDK_GetTrackerFace(stressed.tracker, 0, id, &face) == FSDKE_OK)
+                    FSDK_GetTrackerFacialAttribute(stressed.tracker, 0, id, "Angles", value, sizeof(value));
+            }
+
+            const long long faceID = FirstFaceID(stressed, id);
+            if (!faceID)
+                continue;
+            HImage image = 0;
+            const int errorCode = fsdk::GetTrackerFaceImage(stressed.tracker, faceID, &image);
+            Expect(stressed, errorCode, "GetTrackerFaceImage");
+            if (errorCode == FSDKE_OK)
+                FSDK_FreeImage(image);
+            ++stressed.reads;
+        }
+        std::this_thread::yield();
+    }
+}
+
+void Write(Stressed& stressed, unsigned int seed) {
+    std::mt19937 random(seed);
+    char threshold[64] = {};
+    {
+        const fsdk::TrackerLock lock(stressed.tracker, fsdk::TrackerLock::SHARED);
+        Expect(stressed, FSDK_GetTrackerParameter(stressed.tracker, "Threshold", threshold, sizeof(threshold)), "FSDK_GetTrackerParameter");
+    }
+
+    for (long long iteration = 0; !stopped; ++iteration) {
+        const std::vector<long long> ids = ListIDs(stressed);
+        if (ids.empty()) {
+            std::this_thread::yield();
+            continue;
+        }
+        const long long id = ids[random() % ids.size()];
+        switch (iteration % 5) {
+        case 0:
+            Expect(stressed, fsdk::SetTrackerName(stressed.tracker, id, random() % 2 ? ("person " + std::to_string(id)).c_str() : ""),
+                   "SetTrackerName");
+            break;
+        case 1:
+            Expect(stressed, fsdk::LockTrackerID(stressed.tracker, id), "LockTrackerID");
+            Expect(stressed, fsdk::UnlockTrackerID(stressed.tracker, id), "UnlockTrackerID");
+            break;
+        case 2: {
+            const long long faceID = FirstFaceID(stressed, id);
+            if (faceID)
+                Expect(stressed, fsdk::SetTrackerFaceImage(stressed.tracker, faceID, stressed.images[random() % stressed.images.size()]),
+                       "SetTrackerFaceImage");
+            break;
+        }
+        case 3: {
+            const fsdk::TrackerLock lock(stressed.tracker, fsdk::TrackerLock::EXCLUSIVE);
+            Expect(stressed, FSDK_SetTrackerParameter(stressed.tracker, "Threshold", threshold), "FSDK_SetTrackerParameter");
+            break;
+        }
+        case 4:
+            if (random() % 4 == 0)
+                Expect(stressed, fsdk::PurgeID(stressed.tracker, id), "PurgeID");
+            break;
+        }
+        ++stressed.writes;
+        std::this_thread::yield();
+    }
+}
+
+// The single reader of the result slot, as the JavaScript thread.
+void Poll(Stressed& stressed) {
+    const auto slot = fsdk::GetResultSlot(stressed.slot);
+    long long sequence = 0;
+    while (!stopped) {
+        if (slot->Update()) {
+            const fsdk::ResultSnapshot& snapshot = slot->Front();
+            if (snapshot.sequence <= sequence && stressed.failures++ < 10)
+                fprintf(stderr, "Result slot went back from snapshot %lld to %lld\n", sequence, snapshot.sequence);
+            sequence = snapshot.sequence;
+            ++stressed.published;
+        }
+        std::this_thread::yield();
+    }
+}
+
+std::unique_ptr<Stressed> Create(const Options& options) {
+    auto stressed = std::make_unique<Stressed>();
+    Check(FSDK_CreateTracker(&stressed->tracker), "FSDK_CreateTracker");
+    int errorPosition = 0;
+    if (FSDK_SetTrackerMultipleParameters(stressed->tracker, options.parameters.c_str(), &errorPosition) != FSDKE_OK) {
+        fprintf(stderr, "Cannot set tracker parameters \"%s\" at position %d\n", options.parameters.c_str(), errorPosition);
+        exit(1);
+    }
+
+    for (const std::string& filename : options.images) {
+        HImage image = 0;
+        if (FSDK_LoadImageFromFile(&image, filename.c_str()) != FSDKE_OK) {
+            fprintf(stderr, "Cannot load %s\n", filename.c_str());
+            exit(1);
+        }
+        stressed->images.push_back(image);
+    }
+
+    if (options.keyframeInterval > 0) {
+        fsdk::KeyframeTrackerParameters parameters;
+        parameters.keyframeInterval = options.keyframeInterval;
+        Check(fsdk::CreateKeyframeTracker(stressed->tracker, parameters, &stressed->keyframeTracker), "CreateKeyframeTracker");
+    }
+    if (options.feedOnly)
+        return stressed;
+
+    Check(fsdk::CreateResultSlot(MAX_FACES, "Angles", &stressed->slot), "CreateResultSlot");
+    Check(fsdk::AttachResultSlot(stressed->tracker, stressed->slot), "AttachResultSlot");
+    if (options.governorTemplates >= 0) {
+        fsdk::MemoryGovernorParameters parameters;
+        parameters.maxTemplates = options.governorTemplates;
+        parameters.minIdleSeconds = 0.5;
+        parameters.intervalMs = 100;
+        Check(fsdk::AttachMemoryGovernor(stressed->tracker, parameters), "AttachMemoryGovernor");
+    }
+    return stressed;
+}
+
+// Frees the tracker as the module does: everything attached first, then the tracker under its lock.
+void Free(Stressed& stressed) {
+    if (stressed.keyframeTracker)
+        fsdk::FreeKeyframeTracker(stressed.keyframeTracker);
+    fsdk::ReleaseTrackerThumbnails(stressed.tracker);
+    fsdk::ReleaseTrackerMemoryGovernor(stressed.tracker);
+    fsdk::ReleaseTrackerResultSlot(stressed.tracker);
+    if (stressed.slot)
+        fsdk::FreeResultSlot(stressed.slot);
+    {
+        const fsdk::TrackerLock lock(stressed.tracker, fsdk::TrackerLock::EXCLUSIVE);
+        FSDK_FreeTracker(stressed.tracker);
+    }
+    fsdk::ReleaseTrackerLock(stressed.tracker);
+    for (const HImage image : stressed.images)
+        FSDK_FreeImage(image);
+}
+
+// Runs the trackers for the given time, returns the elapsed seconds.
+double Run(const std::vector<std::unique_ptr<Stressed>>& trackers, const Options& options, int seconds) {
+    stopped = false;
+    std::vector<std::thread> threads;
+    const long long start = Now();
+    for (size_t i = 0; i < trackers.size(); ++i) {
+        Stressed& stressed = *trackers[i];
+        threads.emplace_back(Feed, std::ref(stressed));
+        if (options.feedOnly)
+            continue;
+        threads.emplace_back(Poll, std::ref(stressed));
+        for (int r = 0; r < options.readers; ++r)
+            threads.emplace_back(Read, std::ref(stressed), (unsigned int)(i * 1000 + r));
+        for (int w = 0; w < options.writers; ++w)
+            threads.emplace_back(Write, std::ref(stressed), (unsigned int)(i * 1000 + 500 + w));
+    }
+
+    std::this_thread::sleep_for(std::chrono::seconds(seconds));
+    stopped = true;
+    for (std::thread& thread : threads)
+        thread.join();
+    return (Now() - start) / 1e9;
+}
+
+}
+
+int main(int argc, char** argv) {
+    const Arguments arguments(argc, argv);
+    if (!arguments.Has("images")) {
+        fprintf(stderr,
+                "Usage: tracker_stress --images \"a.jpg;b.jpg\" [--trackers 4] [--seconds 10] [--readers 2] [--writers 1]\n"
+                "                      [--keyframe-interval N] [--governor MAX_TEMPLATES] [--scaling] [--set \"Name=Value;...\"]\n"
+                "                      [--csv summary.csv] [--json summary.json] [--license KEY] [--data PATH] [--threads N]\n");
+        return 1;
+    }
+
+    InitializeFSDK(arguments);
+
+    Options options;
+    options.images = Split(arguments.Get("images"), ';');
+    for (const std::string& parameters : arguments.GetAll("set"))
+        options.parameters += parameters + ";";
+    options.readers = arguments.GetInt("readers", 2);
+    options.writers = arguments.GetInt("writers", 1);
+    options.keyframeInterval = arguments.GetInt("keyframe-interval", 0);
+    options.governorTemplates = arguments.Has("governor") ? atoll(arguments.Get("governor").c_str()) : -1;
+    options.feedOnly = arguments.Has("scaling");
+    const int trackerCount = std::max(1, arguments.GetInt("trackers", 4));
+    const int seconds = std::max(1, arguments.GetInt("seconds", 10));
+
+    Table table({"trackers", "tracker", "frames", "fps", "feed_mean_ms", "feed_p50_ms", "feed_p99_ms", "reads", "writes", "published", "failures"});
+    long long failures = 0;
+    double baseline = 0;
+
+    // Without --scaling all the trackers run once, with it 1, 2, 4... trackers are fed in turn
+    std::vector<int> counts = {trackerCount};
+    if (options.feedOnly) {
+        counts.clear();
+        for (int count = 1; count < trackerCount; count *= 2)
+            counts.push_back(count);
+        counts.push_back(trackerCount);
+    }
+
+    for (const int count : counts) {
+        std::vector<std::unique_ptr<Stressed>> trackers;
+        for (int i = 0; i < count; ++i)
+            trackers.push_back(Create(options));
+
+        const double elapsed = Run(trackers, options, seconds);
+
+        double total = 0;
+        for (size_t i = 0; i < trackers.size(); ++i) {
+            const Stressed& stressed = *trackers[i];
+            const Summary summary = Summarize(stressed.feed);
+            const double fps = elapsed > 0 ? summary.count / elapsed : 0;
+            total += fps;
+            failures += stressed.failures;
+            table.AddRow({std::to_string(count), std::to_string(i), std::to_string(summary.count), Table::Number(fps, 2),
+                          Table::Number(summary.mean, 3), Table::Number(summary.p50, 3), Table::Number(summary.p99, 3),
+                          std::to_string(stressed.reads), std::to_string(stressed.writes), std::to_string(stressed.published),
+                          std::to_string(stressed.failures)});
+            if (!options.feedOnly)
+                printf("tracker %zu: %zu frames, %.1f fps, feed p50 %.2f ms, p99 %.2f ms, %lld reads, %lld writes, %lld snapshots, %lld failures\n", i,
+                       summary.count, fps, summary.p50, summary.p99, stressed.reads.load(), stressed.writes.load(), stressed.published.load(),
+                       stressed.failures.load());
+        }
+        if (count == 1)
+            baseline = total;
+        if (options.feedOnly)
+            printf("%d trackers: %.1f fps in total, %.2fx of one tracker\n", count, total, baseline > 0 ? total / baseline : 0);
+        else
+            printf("%d trackers: %.1f fps in total\n", count, total);
+
+        for (const auto& stressed : trackers)
+            Free(*stressed);
+    }
+
+    if (arguments.Has("csv") && !table.SaveCSV(arguments.Get("csv")))
+        fprintf(stderr, "Cannot write %s\n", arguments.Get("csv").c_str());
+    if (arguments.Has("json") && !table.SaveJSON(arguments.Get("json")))
+        fprintf(stderr, "Cannot write %s\n", arguments.Get("json").c_str());
+
+    FSDK_Finalize();
+    if (failures > 0) {
+        fprintf(stderr, "%lld calls failed\n", failures);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,501 @@
+// Replays a labelled corpus of frames through the tracker (FSDK_FeedFrame) or the face detection
+// API for every combination of a parameter grid and reports throughput, latency percentiles,
+// detection recall and identification accuracy together with the Pareto frontier.
+//
+// tracker_sweep --corpus corpus.csv --grid "FaceDetection2PatchSize=256,320,640;Threshold=0.7,0.8"
+//               [--mode tracker|detection] [--set "DetectionVersion=2"] [--warmup 3] [--preload]
+//               [--csv results.csv] [--json results.json] [--license KEY] [--data PATH] [--threads N]
+//
+// The corpus is a CSV file with "sequence,frame,persons" lines. Frames of a sequence are fed in
+// order to the same camera of the tracker, frame paths are relative to the corpus file and persons
+// is a ';' separated list of the people visible on the frame (empty when there are no faces). A person
+// may be followed by the face box as "name@x1:y1:x2:y2"; detection recall is the share of boxed faces
+// overlapping a detected face with an intersection over union of at least 0.5, one face per detection.
+
+#include "BenchmarkUtils.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace fsdk::benchmark;
+
+namespace {
+
+const int MAX_FACES = 256;
+const double MIN_IOU = 0.5;
+
+struct Box {
+    bool valid = false;
+    int x1 = 0, y1 = 0, x2 = 0, y2 = 0;
+};
+
+struct Frame {
+    int sequence;
+    std::string path;
+    std::vector<std::string> persons;
+    // The face box of every person, if labelled
+    std::vector<Box> boxes;
+};
+
+struct Parameter {
+    std::string name;
+    std::vector<std::string> values;
+};
+
+typedef std::vector<std::pair<std::string, std::string>> Combination;
+
+struct Result {
+    int errorCode = FSDKE_OK;
+    int frames = 0;
+    long long faces = 0;
+    Summary latency;
+    double throughput = 0;
+    double recall = 0;
+    long long extraFaces = 0;
+    double idAccuracy = -1;
+    int identities = 0;
+};
+
+std::vector<Frame> LoadCorpus(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file) {
+        fprintf(stderr, "Cannot open corpus %s\n", filename.c_str());
+        exit(1);
+    }
+
+    const size_t slash = filename.find_last_of('/');
+    const std::string directory = slash == std::string::npos ? "" : filename.substr(0, slash + 1);
+
+    std::map<std::string, int> sequences;
+    std::vector<Frame> frames;
+    std::string line;
+    while (std::getline(file, line)) {
+        if (Trim(line).empty() || line[0] == '#')
+            continue;
+        const auto fields = Split(line, ',');
+        if (fields.size() < 2 || (frames.empty() && fields[0] == "sequence"))
+            continue;
+
+        Frame frame;
+        frame.sequence = sequences.emplace(fields[0], (int)sequences.size()).first->second;
+        frame.path = fields[1][0] == '/' ? fields[1] : directory + fields[1];
+        if (fields.size() > 2 && !fields[2].empty())
+            for (const auto& person : Split(fields[2], ';')) {
+                if (person.empty())
+                    continue;
+                const size_t at = person.find('@');
+                Box box;
+                if (at != std::string::npos) {
+                    const auto coordinates = Split(person.substr(at + 1), ':');
+                    box.valid = coordinates.size() == 4;
+                    if (box.valid) {
+                        box.x1 = atoi(coordinates[0].c_str());
+                        box.y1 = atoi(coordinates[1].c_str());
+                        box.x2 = atoi(coordinates[2].c_str());
+                        box.y2 = atoi(coordinates[3].c_str());
+                    } else {
+                        fprintf(stderr, "Invalid face box %s, expected name@x1:y1:x2:y2\n", person.c_str());
+                    }
+                }
+                frame.persons.push_back(person.substr(0, at));
+                frame.boxes.push_back(box);
+            }
+        frames.push_back(frame);
+    }
+    return frames;
+}
+
+std::vector<Parameter> ParseGrid(const std::vector<std::string>& specifications) {
+    std::vector<Parameter> grid;
+    for (const auto& specification : specifications) {
+        for (const auto& item : Split(specification, ';')) {
+            if (item.empty())
+                continue;
+            const size_t equals = item.find('=');
+            if (equals == std::string::npos) {
+                fprintf(stderr, "Invalid grid entry %s, expected Name=Value1,Value2\n", item.c_str());
+                exit(1);
+            }
+            grid.push_back({Trim(item.substr(0, equals)), Split(item.substr(equals + 1), ',')});
+        }
+    }
+    return grid;
+}
+
+std::vector<Combination> Combinations(const std::vector<Parameter>& grid) {
+    std::vector<Combination> combinations(1);
+    for (const auto& parameter : grid) {
+        std::vector<Combination> next;
+        for (const auto& combination : combinations) {
+            for (const auto& value : parameter.values) {
+                next.push_back(combination);
+                next.back().emplace_back(parameter.name, value);
+            }
+        }
+        combinations.swap(next);
+    }
+    return combinations;
+}
+
+std::string FormatParameters(const std::string& fixed, const Combination& combination) {
+    std::string parameters = fixed;
+    if (!parameters.empty() && parameters.back() != ';')
+        parameters += ';';
+    for (const auto& item : combination)
+        parameters += item.first + "=" + item.second + ";";
+    return parameters;
+}
+
+// Loads frames from disk on demand, or once for the whole sweep with --preload.
+class Images {
+public:
+    Images(const std::vector<Frame>& frames, bool preload) : frames(frames), preloaded(preload ? frames.size() : 0, 0) {
+        for (size_t i = 0; i < preloaded.size(); ++i)
+            preloaded[i] = Load(i);
+    }
+
+    ~Images() {
+        for (const HImage image : preloaded)
+            FSDK_FreeImage(image);
+    }
+
+    HImage Get(size_t index) const {
+        return preloaded.empty() ? Load(index) : preloaded[index];
+    }
+
+    void Release(HImage image) const {
+        if (preloaded.empty())
+            FSDK_FreeImage(image);
+    }
+
+private:
+    HImage Load(size_t index) const {
+        HImage image;
+        const int errorCode = FSDK_LoadImageFromFile(&image, frames[index].path.c_str());
+        if (errorCode != FSDKE_OK) {
+            fprintf(stderr, "Cannot load %s: error %d\n", frames[index].path.c_str(), errorCode);
+            exit(1);
+        }
+        return image;
+    }
+
+    const std::vector<Frame>& frames;
+    std::vector<HImage> preloaded;
+};
+
+// An ID is counted as correct when it is the most frequent ID of the person and the person is the most
+// frequent owner of the ID, so both a person split into several IDs and several people merged into one
+// ID lower the accuracy. Only frames with a single labelled person and a single face are considered.
+double IdentificationAccuracy(const std::vector<std::pair<std::string, long long>>& observations) {
+    if (observations.empty())
+        return -1;
+
+    std::map<std::string, std::map<long long, int>> idsOfPerson;
+    std::map<long long, std::map<std::string, int>> personsOfID;
+    for (const auto& observation : observations) {
+        ++idsOfPerson[observation.first][observation.second];
+        ++personsOfID[observation.second][observation.first];
+    }
+
+    const auto majority = [](const auto& counts) {
+        return std::max_element(counts.begin(), counts.end(), [](const auto& a, const auto& b) { return a.second < b.second; })->first;
+    };
+
+    int correct = 0;
+    for (const auto& observation : observations)
+        if (majority(idsOfPerson[observation.first]) == observation.second && majority(personsOfID[observation.second]) == observation.first)
+            ++correct;
+    return (double)correct / observations.size();
+}
+
+double IntersectionOverUnion(const Box& box, const TFace& face) {
+    const double width = std::min(box.x2, face.bbox.p1.x) - std::max(box.x1, face.bbox.p0.x);
+    const double height = std::min(box.y2, face.bbox.p1.y) - std::max(box.y1, face.bbox.p0.y);
+    if (width <= 0 || height <= 0)
+        return 0;
+    const double intersection = width * height;
+    const double area = (double)(box.x2 - box.x1) * (box.y2 - box.y1) + (double)(face.bbox.p1.x - face.bbox.p0.x) * (face.bbox.p1.y - face.bbox.p0.y);
+    return intersection / (area - intersection);
+}
+
+// The number of boxed faces matched to detected faces, greedily by decreasing intersection over union.
+int MatchBoxes(const std::vector<Box>& boxes, const TFace* faces, long long count) {
+    std::vector<std::tuple<double, size_t, long long>> pairs;
+    for (size_t i = 0; i < boxes.size(); ++i)
+        if (boxes[i].valid)
+            for (long long j = 0; j < count; ++j) {
+                const double iou = IntersectionOverUnion(boxes[i], faces[j]);
+                if (iou >= MIN_IOU)
+                    pairs.emplace_back(iou, i, j);
+            }
+    std::sort(pairs.begin(), pairs.end(), std::greater<std::tuple<double, size_t, long long>>());
+
+    std::vector<bool> boxUsed(boxes.size()), faceUsed(count);
+    int matched = 0;
+    for (const auto& pair : pairs) {
+        if (boxUsed[std::get<1>(pair)] || faceUsed[std::get<2>(pair)])
+            continue;
+        boxUsed[std::get<1>(pair)] = faceUsed[std::get<2>(pair)] = true;
+        ++matched;
+    }
+    return matched;
+}
+
+// Accumulates per frame detection results into a Result.
+class Evaluation {
+public:
+    // detectedFaces holds the boxes of faceCount of the count faces found
+    void Add(const Frame& frame, long long latency, long long count, const TFace* detectedFaces, long long faceCount, const long long* ids) {
+        latencies.push_back(latency / 1e6);
+        faces += count;
+        expected += std::count_if(frame.boxes.begin(), frame.boxes.end(), [](const Box& box) { return box.valid; });
+        detected += MatchBoxes(frame.boxes, detectedFaces, faceCount);
+        extra += std::max<long long>(0, count - (long long)frame.persons.size());
+        if (ids && count == 1 && frame.persons.size() == 1)
+            observations.emplace_back(frame.persons[0], ids[0]);
+    }
+
+    Result Finish(bool identification) const {
+        Result result;
+        result.frames = (int)latencies.size();
+        result.faces = faces;
+        result.latency = Summarize(latencies);
+        result.throughput = result.latency.total > 0 ? result.frames / (result.latency.total / 1000) : 0;
+        result.recall = expected ? (double)detected / expected : -1;
+        result.extraFaces = extra;
+        if (identification) {
+            result.idAccuracy = IdentificationAccuracy(observations);
+            std::map<long long, bool> ids;
+            for (const auto& observation : observations)
+                ids[observation.second] = true;
+            result.identities = (int)ids.size();
+        }
+        return result;
+    }
+
+private:
+    std::vector<double> latencies;
+    std::vector<std::pair<std::string, long long>> observations;
+    long long faces = 0;
+    long long expected = 0;
+    long long detected = 0;
+    long long extra = 0;
+};
+
+Result RunTracker(const std::vector<Frame>& frames, const Images& images, const std::string& parameters, int warmup) {
+    const auto createTracker = [&](HTracker* tracker) {
+        int errorCode = FSDK_CreateTracker(tracker);
+        if (errorCode != FSDKE_OK)
+            return errorCode;
+        int errorPosition = 0;
+        errorCode = FSDK_SetTrackerMultipleParameters(*tracker, parameters.c_str(), &errorPosition);
+        if (errorCode != FSDKE_OK) {
+            fprintf(stderr, "Cannot set tracker parameters \"%s\" at position %d\n", parameters.c_str(), errorPosition);
+            FSDK_FreeTracker(*tracker);
+        }
+        return errorCode;
+    };
+
+    long long count = 0;
+    long long ids[MAX_FACES];
+    TFace faces[MAX_FACES];
+    HTracker tracker;
+
+    // A separate tracker loads the models, so the measured tracker starts with an empty memory
+    Result result;
+    result.errorCode = createTracker(&tracker);
+    if (result.errorCode != FSDKE_OK)
+        return result;
+    for (int i = 0; i < std::min<int>(warmup, frames.size()); ++i) {
+        const HImage image = images.Get(i);
+        FSDK_FeedFrame(tracker, frames[i].sequence, image, &count, ids, sizeof(ids));
+        images.Release(image);
+    }
+    FSDK_FreeTracker(tracker);
+
+    result.errorCode = createTracker(&tracker);
+    if (result.errorCode != FSDKE_OK)
+        return result;
+
+    Evaluation evaluation;
+    for (size_t i = 0; i < frames.size(); ++i) {
+        const HImage image = images.Get(i);
+        const long long start = Now();
+        const int errorCode = FSDK_FeedFrame(tracker, frames[i].sequence, image, &count, ids, sizeof(ids));
+        const long long end = Now();
+        images.Release(image);
+
+        if (errorCode != FSDKE_OK) {
+            result.errorCode = errorCode;
+            break;
+        }
+        // IDs whose face box cannot be read do not count as detected
+        long long reported = 0;
+        for (long long face = 0; face < count; ++face)
+            if (FSDK_GetTrackerFace(tracker, frames[i].sequence, ids[face], &faces[reported]) == FSDKE_OK)
+                ++reported;
+        evaluation.Add(frames[i], end - start, count, faces, reported, ids);
+    }
+    FSDK_FreeTracker(tracker);
+
+    const int errorCode = result.errorCode;
+    result = evaluation.Finish(true);
+    result.errorCode = errorCode;
+    return result;
+}
+
+Result RunDetection(const std::vector<Frame>& frames, const Images& images, const std::string& parameters, int warmup) {
+    Result result;
+    int errorPosition = 0;
+    result.errorCode = FSDK_SetParameters(parameters.c_str(), &errorPosition);
+    if (result.errorCode != FSDKE_OK) {
+        fprintf(stderr, "Cannot set parameters \"%s\" at position %d\n", parameters.c_str(), errorPosition);
+        return result;
+    }
+
+    int count = 0;
+    TFace faces[MAX_FACES];
+    for (int i = 0; i < std::min<int>(warmup, frames.size()); ++i) {
+        const HImage image = images.Get(i);
+        FSDK_DetectMultipleFaces2(image, &count, faces, sizeof(faces));
+        images.Release(image);
+    }
+
+    Evaluation evaluation;
+    for (size_t i = 0; i < frames.size(); ++i) {
+        const HImage image = images.Get(i);
+        const long long start = Now();
+        int errorCode = FSDK_DetectMultipleFaces2(image, &count, faces, sizeof(faces));
+        const long long end = Now();
+        images.Release(image);
+
+        if (errorCode == FSDKE_FACE_NOT_FOUND) {
+            count = 0;
+            errorCode = FSDKE_OK;
+        }
+        if (errorCode != FSDKE_OK) {
+            result.errorCode = errorCode;
+            break;
+        }
+        evaluation.Add(frames[i], end - start, count, faces, count, nullptr);
+    }
+
+    const int errorCode = result.errorCode;
+    result = evaluation.Finish(false);
+    result.errorCode = errorCode;
+    return result;
+}
+
+}
+
+int main(int argc, char** argv) {
+    const Arguments arguments(argc, argv);
+    if (!arguments.Has("corpus") || arguments.Has("help")) {
+        fprintf(stderr,
+                "Usage: tracker_sweep --corpus corpus.csv --grid \"Name=Value1,Value2;...\" [--mode tracker|detection]\n"
+                "                     [--set \"Name=Value;...\"] [--warmup 3] [--preload] [--csv FILE] [--json FILE]\n"
+                "                     [--license KEY] [--data PATH] [--threads N]\n");
+        return 1;
+    }
+
+    const std::string mode = arguments.Get("mode", "tracker");
+    if (mode != "tracker" && mode != "detection") {
+        fprintf(stderr, "Unknown mode %s\n", mode.c_str());
+        return 1;
+    }
+    const bool tracker = mode == "tracker";
+
+    const auto frames = LoadCorpus(arguments.Get("corpus"));
+    if (frames.empty()) {
+        fprintf(stderr, "The corpus is empty\n");
+        return 1;
+    }
+
+    const auto grid = ParseGrid(arguments.GetAll("grid"));
+    const auto combinations = Combinations(grid);
+    std::string fixed;
+    for (const auto& parameters : arguments.GetAll("set"))
+        fixed += parameters + (parameters.empty() || parameters.back() == ';' ? "" : ";");
+    const int warmup = arguments.GetInt("warmup", 3);
+
+    InitializeFSDK(arguments);
+
+    const Images images(frames, arguments.Has("preload"));
+
+    std::vector<Result> results;
+    for (size_t i = 0; i < combinations.size(); ++i) {
+        const std::string parameters = FormatParameters(fixed, combinations[i]);
+        printf("[%zu/%zu] %s\n", i + 1, combinations.size(), parameters.empty() ? "(defaults)" : parameters.c_str());
+        fflush(stdout);
+
+        results.push_back(tracker ? RunTracker(frames, images, parameters, warmup) : RunDetection(frames, images, parameters, warmup));
+
+        const Result& result = results.back();
+        if (result.errorCode != FSDKE_OK)
+            printf("    failed with error %d\n", result.errorCode);
+        else
+            printf("    %.1f fps, p50 %.2f ms, p99 %.2f ms, recall %.4f, id accuracy %.4f\n",
+                   result.throughput, result.latency.p50, result.latency.p99, result.recall, result.idAccuracy);
+    }
+
+    // Configurations that failed are never part of the frontier
+    std::vector<std::vector<double>> objectives;
+    std::vector<size_t> succeeded;
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& result = results[i];
+        if (result.errorCode == FSDKE_OK) {
+            objectives.push_back({result.throughput, -result.latency.p99, result.recall, result.idAccuracy});
+            succeeded.push_back(i);
+        }
+    }
+    const auto succeededFrontier = ParetoFrontier(objectives);
+    std::vector<bool> frontier(results.size(), false);
+    for (size_t i = 0; i < succeeded.size(); ++i)
+        frontier[succeeded[i]] = succeededFrontier[i];
+
+    std::vector<std::string> columns;
+    for (const auto& parameter : grid)
+        columns.push_back(parameter.name);
+    for (const char* column : {"mode", "frames", "faces", "throughput_fps", "mean_ms", "p50_ms", "p90_ms", "p99_ms", "max_ms",
+                               "recall", "extra_faces", "id_accuracy", "identities", "error", "pareto"})
+        columns.push_back(column);
+
+    Table table(columns);
+    printf("\nPareto frontier (throughput, p99 latency, recall, id accuracy):\n");
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& result = results[i];
+        const bool failed = result.errorCode != FSDKE_OK;
+
+        std::vector<std::string> row;
+        for (const auto& item : combinations[i])
+            row.push_back(item.second);
+        row.push_back(mode);
+        row.push_back(std::to_string(result.frames));
+        row.push_back(std::to_string(result.faces));
+        for (const double value : {result.throughput, result.latency.mean, result.latency.p50, result.latency.p90, result.latency.p99, result.latency.max})
+            row.push_back(failed ? "" : Table::Number(value, 3));
+        row.push_back(failed || result.recall < 0 ? "" : Table::Number(result.recall));
+        row.push_back(std::to_string(result.extraFaces));
+        row.push_back(failed || result.idAccuracy < 0 ? "" : Table::Number(result.idAccuracy));
+        row.push_back(tracker ? std::to_string(result.identities) : "");
+        row.push_back(std::to_string(result.errorCode));
+        row.push_back(frontier[i] ? "1" : "0");
+        table.AddRow(row);
+
+        if (frontier[i])
+            printf("    %s\n", FormatParameters("", combinations[i]).c_str());
+    }
+
+    if (arguments.Has("csv") && !table.SaveCSV(arguments.Get("csv")))
+        fprintf(stderr, "Cannot write %s\n", arguments.Get("csv").c_str());
+    if (arguments.Has("json") && !table.SaveJSON(arguments.Get("json")))
+        fprintf(stderr, "Cannot write %s\n", arguments.Get("json").c_str());
+
+    FSDK_Finalize();
+    return 0;
+}
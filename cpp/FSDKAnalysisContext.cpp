@@ -0,0 +1,198 @@
+#include "FSDKAnalysisContext.h"
+#include "FSDKHandles.h"
+
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <string>
+
+namespace fsdk {
+
+namespace {
+
+template <typename T>
+struct Cached {
+    bool computed = false;
+    int errorCode = FSDKE_OK;
+    T value;
+};
+
+struct AnalysisContext {
+    std::mutex mutex;
+    HImage image;
+    bool released = false;
+
+    Cached<TFace> face;
+    Cached<FSDK_Features> features;
+    Cached<FSDK_FaceTemplate> faceTemplate;
+    std::map<std::string, Cached<std::string>> attributes;
+
+    explicit AnalysisContext(HImage image) : image(image) {}
+
+    void Reset() {
+        face = {};
+        features = {};
+        faceTemplate = {};
+        attributes.clear();
+    }
+
+    int Face() {
+        if (!face.computed) {
+            face.errorCode = FSDK_DetectFace2(image, &face.value);
+            face.computed = true;
+        }
+        return face.errorCode;
+    }
+
+    int Features() {
+        if (!features.computed) {
+            features.errorCode = Face();
+            if (features.errorCode == FSDKE_OK) {
+                const TFace& value = face.value;
+                const double dx = value.features[1].x - value.features[0].x;
+                const double dy = value.features[1].y - value.features[0].y;
+                const TFacePosition position = {
+                    (value.bbox.p0.x + value.bbox.p1.x) / 2,
+                    (value.bbox.p0.y + value.bbox.p1.y) / 2,
+                    value.bbox.p1.x - value.bbox.p0.x,
+                    0, // padding
+                    std::atan2(dy, dx) * 180.0 / M_PI
+                };
+                features.errorCode = FSDK_DetectFacialFeaturesInRegion(image, &position, &features.value);
+            }
+            features.computed = true;
+        }
+        return features.errorCode;
+    }
+
+    int Template() {
+        if (!faceTemplate.computed) {
+            faceTemplate.errorCode = Face();
+            if (faceTemplate.errorCode == FSDKE_OK)
+                faceTemplate.errorCode = FSDK_GetFaceTemplateInRegion2(image, &face.value, &faceTemplate.value);
+            faceTemplate.computed = true;
+        }
+        return faceTemplate.errorCode;
+    }
+
+    int Attribute(const std::string& name, std::string** value) {
+        auto& attribute = attributes[name];
+        if (!attribute.computed) {
+            attribute.errorCode = Features();
+            if (attribute.errorCode == FSDKE_OK) {
+                char buffer[1024] = {0};
+                attribute.errorCode = FSDK_DetectFacialAttributeUsingFeatures(image, &features.value, name.c_str(), buffer, sizeof(buffer));
+                if (attribute.errorCode == FSDKE_OK)
+                    attribute.value = buffer;
+            }
+            attribute.computed = true;
+        }
+        *value = &attribute.value;
+        return attribute.errorCode;
+    }
+};
+
+HandleRegistry<AnalysisContext>& Contexts() {
+    static HandleRegistry<AnalysisContext> contexts;
+    return contexts;
+}
+
+// Runs the function with the context locked, so concurrent callers wait for a single computation.
+template <typename Function>
+int WithContext(HAnalysisContext handle, Function&& function) {
+    const auto context = Contexts().Get(handle);
+    if (!context)
+        return FSDKE_INVALID_ARGUMENT;
+
+    std::lock_guard<std::mutex> lock(context->mutex);
+    if (context->released)
+        return FSDKE_INVALID_ARGUMENT;
+    return function(*context);
+}
+
+}
+
+int CreateAnalysisContext(HImage Image, HAnalysisContext* Context) {
+    if (!Context)
+        return FSDKE_INVALID_ARGUMENT;
+
+    int width = 0;
+    const int errorCode = FSDK_GetImageWidth(Image, &width);
+    if (errorCode != FSDKE_OK)
+        return errorCode;
+
+    *Context = Contexts().Add(std::make_shared<AnalysisContext>(Image));
+    return FSDKE_OK;
+}
+
+int FreeAnalysisContext(HAnalysisContext Context) {
+    return Contexts().Remove(Context) ? FSDKE_OK : FSDKE_INVALID_ARGUMENT;
+}
+
+int AnalysisContextDetectFace(HAnalysisContext Context, TFace* Face) {
+    if (!Face)
+        return FSDKE_INVALID_ARGUMENT;
+    return WithContext(Context, [&](AnalysisContext& context) {
+        const int errorCode = context.Face();
+        if (errorCode == FSDKE_OK)
+            *Face = context.face.value;
+        return errorCode;
+    });
+}
+
+int AnalysisContextDetectFacialFeatures(HAnalysisContext Context, FSDK_Features* FacialFeatures) {
+    if (!FacialFeatures)
+        return FSDKE_INVALID_ARGUMENT;
+    return WithContext(Context, [&](AnalysisContext& context) {
+        const int errorCode = context.Features();
+        if (errorCode == FSDKE_OK)
+            memcpy(*FacialFeatures, context.features.value, sizeof(FSDK_Features));
+        return errorCode;
+    });
+}
+
+int AnalysisContextDetectFacialAttribute(HAnalysisContext Context, const char* AttributeName, char* AttributeValues, long long MaxSizeInBytes) {
+    if (!AttributeName || !AttributeValues)
+        return FSDKE_INVALID_ARGUMENT;
+    return WithContext(Context, [&](AnalysisContext& context) {
+        std::string* value = nullptr;
+        const int errorCode = context.Attribute(AttributeName, &value);
+        if (errorCode != FSDKE_OK)
+            return errorCode;
+        if ((long long)value->size() >= MaxSizeInBytes)
+            return FSDKE_INSUFFICIENT_BUFFER_SIZE;
+        memcpy(AttributeValues, value->c_str(), value->size() + 1);
+        return FSDKE_OK;
+    });
+}
+
+int AnalysisContextGetFaceTemplate(HAnalysisContext Context, FSDK_FaceTemplate* FaceTemplate) {
+    if (!FaceTemplate)
+        return FSDKE_INVALID_ARGUMENT;
+    return WithContext(Context, [&](AnalysisContext& context) {
+        const int errorCode = context.Template();
+        if (errorCode == FSDKE_OK)
+            *FaceTemplate = context.faceTemplate.value;
+        return errorCode;
+    });
+}
+
+void InvalidateImageAnalysis(HImage Image) {
+    for (const auto& context : Contexts().All()) {
+        std::lock_guard<std::mutex> lock(context->mutex);
+        if (context->image == Image)
+            context->Reset();
+    }
+}
+
+void ReleaseImageAnalysis(HImage Image) {
+    for (const auto& context : Contexts().All()) {
+        std::lock_guard<std::mutex> lock(context->mutex);
+        if (context->image == Image) {
+            context->Reset();
+            context->released = true;
+        }
+    }
+}
+
+}
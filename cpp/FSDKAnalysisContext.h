@@ -0,0 +1,26 @@
+#pragma once
+
+#include "LuxandFaceSDK.h"
+
+namespace fsdk {
+
+typedef unsigned int HAnalysisContext;
+
+// An analysis context is bound to an image and lazily computes the face detection, the facial
+// features, facial attributes and the face template of the most confident face on it. Every
+// result (including an error) is computed once and shared by later calls, and each stage reuses
+// the results of the previous ones instead of detecting the face again.
+int CreateAnalysisContext(HImage Image, HAnalysisContext* Context);
+int FreeAnalysisContext(HAnalysisContext Context);
+
+int AnalysisContextDetectFace(HAnalysisContext Context, TFace* Face);
+int AnalysisContextDetectFacialFeatures(HAnalysisContext Context, FSDK_Features* FacialFeatures);
+int AnalysisContextDetectFacialAttribute(HAnalysisContext Context, const char* AttributeName, char* AttributeValues, long long MaxSizeInBytes);
+int AnalysisContextGetFaceTemplate(HAnalysisContext Context, FSDK_FaceTemplate* FaceTemplate);
+
+// Must be called after the image is modified in place: drops cached results of all contexts bound to the image.
+void InvalidateImageAnalysis(HImage Image);
+// Must be called when the image is freed: contexts bound to the image fail with FSDKE_INVALID_ARGUMENT afterwards.
+void ReleaseImageAnalysis(HImage Image);
+
+}
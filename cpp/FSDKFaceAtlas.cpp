@@ -0,0 +1,100 @@
+#include "FSDKFaceAtlas.h"
+#include "FSDKParallel.h"
+#include "FSDKTrace.h"
+
+#include <cstring>
+#include <vector>
+
+namespace fsdk {
+
+namespace {
+
+int Channels(FSDK_IMAGEMODE mode) {
+    switch (mode) {
+        case FSDK_IMAGE_GRAYSCALE_8BIT: return 1;
+        case FSDK_IMAGE_COLOR_24BIT:    return 3;
+        case FSDK_IMAGE_COLOR_32BIT:    return 4;
+    }
+    return 0;
+}
+
+// Copies the face image into its slot, converting it to the atlas mode if needed.
+int CopyFace(HImage face, int width, int height, FSDK_IMAGEMODE mode, const FaceAtlasLayout& layout, unsigned char* slot) {
+    unsigned char* data = nullptr;
+    int faceWidth = 0, faceHeight = 0, scanLine = 0;
+    FSDK_IMAGEMODE faceMode;
+    int errorCode = FSDK_GetImageData(face, &data, &faceWidth, &faceHeight, &scanLine, &faceMode);
+    if (errorCode != FSDKE_OK)
+        return errorCode;
+    if (faceWidth != width || faceHeight != height)
+        return FSDKE_FAILED;
+
+    const size_t rowSize = (size_t)width * layout.channels;
+    if (faceMode != mode) {
+        thread_local std::vector<unsigned char> converted;
+        int size = 0;
+        errorCode = FSDK_GetImageBufferSize(face, &size, mode);
+        if (errorCode != FSDKE_OK)
+            return errorCode;
+        converted.resize(size);
+        errorCode = FSDK_SaveImageToBuffer(face, converted.data(), mode);
+        if (errorCode != FSDKE_OK)
+            return errorCode;
+        data = converted.data();
+        scanLine = size / height;
+    }
+
+    for (int y = 0; y < height; ++y) {
+        unsigned char* row = slot + (long long)y * layout.stride;
+        memcpy(row, data + (long long)y * scanLine, rowSize);
+        memset(row + rowSize, 0, layout.stride - rowSize);
+    }
+    return FSDKE_OK;
+}
+
+}
+
+int GetFaceAtlasLayout(int Count, int Width, int Height, FSDK_IMAGEMODE ImageMode, FaceAtlasLayout* Layout) {
+    const int channels = Channels(ImageMode);
+    if (!Layout || Count < 0 || Width <= 0 || Height <= 0 || !channels)
+        return FSDKE_INVALID_ARGUMENT;
+
+    Layout->channels = channels;
+    Layout->stride = (Width * channels + FACE_ATLAS_ALIGNMENT - 1) / FACE_ATLAS_ALIGNMENT * FACE_ATLAS_ALIGNMENT;
+    Layout->faceSize = (long long)Layout->stride * Height;
+    Layout->size = Layout->faceSize * Count;
+    return FSDKE_OK;
+}
+
+int ExtractFaceAtlas(HImage Image, const FSDK_Features* FacialFeatures, int Count, int Width, int Height, FSDK_IMAGEMODE ImageMode,
+                     int Threads, unsigned char* Atlas, FSDK_Features* ResizedFeatures, int* ErrorCodes) {
+    FaceAtlasLayout layout;
+    const int errorCode = GetFaceAtlasLayout(Count, Width, Height, ImageMode, &layout);
+    if (errorCode != FSDKE_OK)
+        return errorCode;
+    if (Count > 0 && (!FacialFeatures || !Atlas || !ResizedFeatures || !ErrorCodes))
+        return FSDKE_INVALID_ARGUMENT;
+
+    trace::Span span("ExtractFaceAtlas");
+    ParallelFor(Count, Threads, [&](int, int index) {
+        unsigned char* slot = Atlas + layout.faceSize * index;
+        // FSDK_ExtractFaceImage takes non-const features
+        FSDK_Features features;
+        memcpy(features, FacialFeatures[index], sizeof(features));
+
+        HImage face = 0;
+        int result = FSDK_ExtractFaceImage(Image, &features, Width, Height, &face, &ResizedFeatures[index]);
+        if (result == FSDKE_OK) {
+            result = CopyFace(face, Width, Height, ImageMode, layout, slot);
+            FSDK_FreeImage(face);
+        }
+        if (result != FSDKE_OK) {
+            memset(slot, 0, layout.faceSize);
+            memset(ResizedFeatures[index], 0, sizeof(FSDK_Features));
+        }
+        ErrorCodes[index] = result;
+    });
+    return FSDKE_OK;
+}
+
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "LuxandFaceSDK.h"
+
+namespace fsdk {
+
+// Rows of every face are aligned to this number of bytes.
+const int FACE_ATLAS_ALIGNMENT = 64;
+
+struct FaceAtlasLayout {
+    int channels;
+    // Bytes between the starts of neighbouring rows of a face
+    int stride;
+    // Bytes between the starts of neighbouring faces
+    long long faceSize;
+    long long size;
+};
+
+int GetFaceAtlasLayout(int Count, int Width, int Height, FSDK_IMAGEMODE ImageMode, FaceAtlasLayout* Layout);
+
+// Extracts Count aligned faces with FSDK_ExtractFaceImage in parallel and writes them one after another
+// into the Atlas, which must hold Layout.size bytes. ResizedFeatures receives the features of every face in
+// the coordinates of its crop. The result of every face is written to ErrorCodes, the slots of faces that
+// failed are filled with zeros, and the function itself fails only on invalid arguments.
+int ExtractFaceAtlas(HImage Image, const FSDK_Features* FacialFeatures, int Count, int Width, int Height, FSDK_IMAGEMODE ImageMode,
+                     int Threads, unsigned char* Atlas, FSDK_Features* ResizedFeatures, int* ErrorCodes);
+
+}
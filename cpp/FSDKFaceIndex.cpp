@@ -0,0 +1,422 @@
+#include "FSDKFaceIndex.h"
+#include "FSDKHandles.h"
+#include "FSDKHNSW.h"
+#include "FSDKTrackerLock.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unistd.h>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace fsdk {
+
+namespace {
+
+const char FILE_MAGIC[8] = {'F', 'S', 'D', 'K', 'F', 'I', 'D', 'X'};
+const uint32_t FILE_VERSION = 1;
+
+// The number of templates FaceIndexAddTrackerFaces inserts while holding the index lock
+const size_t ADD_BATCH_SIZE = 64;
+
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t templateSize;
+    uint64_t count;
+};
+
+struct Node {
+    long long id;
+    bool removed;
+    FSDK_FaceTemplate faceTemplate;
+};
+
+float Match(const FSDK_FaceTemplate& first, const FSDK_FaceTemplate& second) {
+    float similarity = 0;
+    return FSDK_MatchFaces(&first, &second, &similarity) == FSDKE_OK ? similarity : 0;
+}
+
+class FaceIndex {
+public:
+    FaceIndex(const char* filename, const FaceIndexParameters& parameters)
+        : filename(filename ? filename : ""), parameters(parameters), graph(parameters.maxConnections, parameters.efConstruction) {}
+
+    int Add(long long id, const FSDK_FaceTemplate& faceTemplate) {
+        const int errorCode = Validate(faceTemplate);
+        if (errorCode != FSDKE_OK)
+            return errorCode;
+
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        uint32_t node;
+        return InsertLocked(id, faceTemplate, false, &node);
+    }
+
+    // Replaces the templates of every ID in templates. The new templates are inserted hidden, a batch at a time
+    // so searches go on in between, and replace the old ones of their IDs at once when all of them are in. A
+    // failure leaves the old templates in place.
+    int AddAll(const std::vector<std::pair<long long, FSDK_FaceTemplate>>& templates) {
+        for (const auto& item : templates) {
+            const int errorCode = Validate(item.second);
+            if (errorCode != FSDKE_OK)
+                return errorCode;
+        }
+
+        std::unordered_map<long long, std::vector<uint32_t>> inserted;
+        for (size_t begin = 0; begin < templates.size(); begin += ADD_BATCH_SIZE) {
+            std::unique_lock<std::shared_mutex> lock(mutex);
+            const size_t end = std::min(templates.size(), begin + ADD_BATCH_SIZE);
+            for (size_t i = begin; i < end; ++i) {
+                uint32_t node;
+                const int errorCode = InsertLocked(templates[i].first, templates[i].second, true, &node);
+                if (errorCode != FSDKE_OK)
+                    return errorCode;
+                inserted[templates[i].first].push_back(node);
+            }
+        }
+
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        for (auto& item : inserted) {
+            RemoveLocked(item.first);
+            for (const uint32_t node : item.second)
+                nodes[node].removed = false;
+            removed -= (long long)item.second.size();
+            ids[item.first] = std::move(item.second);
+        }
+        dirty = true;
+        return FSDKE_OK;
+    }
+
+    int Remove(long long id) {
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        return RemoveLocked(id) ? FSDKE_OK : FSDKE_ID_NOT_FOUND;
+    }
+
+    void Match(const FSDK_FaceTemplate& faceTemplate, float threshold, long long capacity, std::vector<IDSimilarity>* result) {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        long long comparisons = 0;
+        const auto candidates = graph.Search(
+            [&](uint32_t node) {
+                ++comparisons;
+                return fsdk::Match(faceTemplate, nodes[node].faceTemplate);
+            },
+            (int)std::min<long long>(std::max<long long>(parameters.efSearch, capacity), std::numeric_limits<int>::max()),
+            [&](uint32_t node) { return !nodes[node].removed; });
+
+        // Re-ranks the candidate IDs by their most similar template, the graph may have reached only some of them
+        std::unordered_map<uint32_t, float> known;
+        std::unordered_map<long long, float> best;
+        for (const auto& candidate : candidates) {
+            known[candidate.second] = candidate.first;
+            best.emplace(nodes[candidate.second].id, -1.0f);
+        }
+        for (auto& item : best) {
+            // Match holds a shared lock only, so ids must not be modified by a lookup
+            const auto nodesOfID = ids.find(item.first);
+            if (nodesOfID == ids.end())
+                continue;
+            for (const uint32_t node : nodesOfID->second) {
+                const auto it = known.find(node);
+                float similarity;
+                if (it != known.end()) {
+                    similarity = it->second;
+                } else {
+                    similarity = fsdk::Match(faceTemplate, nodes[node].faceTemplate);
+                    ++comparisons;
+                }
+                item.second = std::max(item.second, similarity);
+            }
+        }
+
+        for (const auto& item : best)
+            if (item.second >= threshold)
+                result->push_back({item.first, item.second});
+        std::sort(result->begin(), result->end(), [](const IDSimilarity& a, const IDSimilarity& b) {
+            return a.similarity > b.similarity || (a.similarity == b.similarity && a.ID < b.ID);
+        });
+        if ((long long)result->size() > capacity)
+            result->resize((size_t)capacity);
+
+        ++statistics.searches;
+        statistics.comparisons += comparisons;
+    }
+
+    FaceIndexStatistics Statistics() {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        FaceIndexStatistics result;
+        result.templates = (long long)nodes.size() - removed;
+        result.ids = (long long)ids.size();
+        result.removed = removed;
+        result.searches = statistics.searches;
+        result.comparisons = statistics.comparisons;
+        return result;
+    }
+
+    // A missing, damaged or outdated file leaves the index empty.
+    void Load() {
+        if (filename.empty())
+            return;
+        FILE* file = fopen(filename.c_str(), "rb");
+        if (!file)
+            return;
+        std::vector<unsigned char> buffer;
+        unsigned char chunk[65536];
+        size_t read;
+        while ((read = fread(chunk, 1, sizeof(chunk), file)) > 0)
+            buffer.insert(buffer.end(), chunk, chunk + read);
+        fclose(file);
+
+        const size_t recordSize = sizeof(long long) + 1 + sizeof(FSDK_FaceTemplate);
+        const unsigned char* data = buffer.data();
+        const unsigned char* end = data + buffer.size();
+        FileHeader header;
+        if (buffer.size() < sizeof(header))
+            return;
+        memcpy(&header, data, sizeof(header));
+        data += sizeof(header);
+        if (memcmp(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC)) || header.version != FILE_VERSION || header.templateSize != sizeof(FSDK_FaceTemplate) ||
+            (size_t)(end - data) / recordSize < header.count)
+            return;
+
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        for (uint64_t i = 0; i < header.count; ++i, data += recordSize) {
+            Node node;
+            memcpy(&node.id, data, sizeof(node.id));
+            node.removed = data[sizeof(node.id)] != 0;
+            memcpy(&node.faceTemplate, data + sizeof(node.id) + 1, sizeof(node.faceTemplate));
+            nodes.push_back(node);
+        }
+
+        if (!graph.Load(data, end) || graph.Size() != nodes.size()) {
+            graph = HNSWGraph(parameters.maxConnections, parameters.efConstruction);
+            nodes.clear();
+            return;
+        }
+        for (uint32_t node = 0; node < nodes.size(); ++node) {
+            if (nodes[node].removed)
+                ++removed;
+            else
+                ids[nodes[node].id].push_back(node);
+        }
+    }
+
+    int Save() {
+        if (filename.empty())
+            return FSDKE_OK;
+
+        std::lock_guard<std::mutex> saveLock(saveMutex);
+        std::vector<unsigned char> buffer;
+        {
+            // Searches go on while the index is serialized
+            std::shared_lock<std::shared_mutex> lock(mutex);
+            if (!dirty)
+                return FSDKE_OK;
+
+            FileHeader header = {};
+            memcpy(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+            header.version = FILE_VERSION;
+            header.templateSize = sizeof(FSDK_FaceTemplate);
+            header.count = nodes.size();
+
+            buffer.reserve(sizeof(header) + nodes.size() * (sizeof(long long) + 1 + sizeof(FSDK_FaceTemplate)));
+            const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&header);
+            buffer.insert(buffer.end(), bytes, bytes + sizeof(header));
+            for (const Node& node : nodes) {
+                bytes = reinterpret_cast<const unsigned char*>(&node.id);
+                buffer.insert(buffer.end(), bytes, bytes + sizeof(node.id));
+                buffer.push_back(node.removed ? 1 : 0);
+                bytes = reinterpret_cast<const unsigned char*>(&node.faceTemplate);
+                buffer.insert(buffer.end(), bytes, bytes + sizeof(node.faceTemplate));
+            }
+            graph.Save(&buffer);
+            dirty = false;
+        }
+
+        // Readers of the file never observe a partially written index
+        const std::string temporary = filename + ".tmp";
+        FILE* file = fopen(temporary.c_str(), "wb");
+        if (!file) {
+            MarkDirty();
+            return FSDKE_CANNOT_CREATE_FILE;
+        }
+        bool written = fwrite(buffer.data(), 1, buffer.size(), file) == buffer.size() && fflush(file) == 0 && fsync(fileno(file)) == 0;
+        written = fclose(file) == 0 && written;
+        if (!written || rename(temporary.c_str(), filename.c_str()) != 0) {
+            remove(temporary.c_str());
+            MarkDirty();
+            return FSDKE_IO_ERROR;
+        }
+        return FSDKE_OK;
+    }
+
+private:
+    // A template FSDK_MatchFaces cannot compare would make every similarity to it 0 and break the graph
+    static int Validate(const FSDK_FaceTemplate& faceTemplate) {
+        float similarity;
+        return FSDK_MatchFaces(&faceTemplate, &faceTemplate, &similarity);
+    }
+
+    // A hidden node is linked in the graph but counted and skipped as a removed one until it is unhidden.
+    int InsertLocked(long long id, const FSDK_FaceTemplate& faceTemplate, bool hidden, uint32_t* node) {
+        if (nodes.size() >= std::numeric_limits<uint32_t>::max())
+            return FSDKE_OUT_OF_MEMORY;
+
+        *node = (uint32_t)nodes.size();
+        nodes.push_back({id, hidden, faceTemplate});
+        const FSDK_FaceTemplate& inserted = nodes.back().faceTemplate;
+        graph.Insert([&](uint32_t other) { return fsdk::Match(inserted, nodes[other].faceTemplate); },
+                     [&](uint32_t first, uint32_t second) { return fsdk::Match(nodes[first].faceTemplate, nodes[second].faceTemplate); });
+        if (hidden)
+            ++removed;
+        else
+            ids[id].push_back(*node);
+        dirty = true;
+        return FSDKE_OK;
+    }
+
+    bool RemoveLocked(long long id) {
+        const auto it = ids.find(id);
+        if (it == ids.end())
+            return false;
+        for (const uint32_t node : it->second)
+            nodes[node].removed = true;
+        removed += (long long)it->second.size();
+        ids.erase(it);
+        dirty = true;
+        return true;
+    }
+
+    void MarkDirty() {
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        dirty = true;
+    }
+
+    const std::string filename;
+    const FaceIndexParameters parameters;
+
+    std::shared_mutex mutex;
+    std::mutex saveMutex;
+    HNSWGraph graph;
+    // A deque does not copy the templates when it grows
+    std::deque<Node> nodes;
+    std::unordered_map<long long, std::vector<uint32_t>> ids;
+    long long removed = 0;
+    bool dirty = false;
+
+    // Updated by concurrent searches
+    struct {
+        std::atomic<long long> searches{0};
+        std::atomic<long long> comparisons{0};
+    } statistics;
+};
+
+HandleRegistry<FaceIndex>& Indexes() {
+    static HandleRegistry<FaceIndex> indexes;
+    return indexes;
+}
+
+}
+
+int CreateFaceIndex(const char* FileName, const FaceIndexParameters& Parameters, HFaceIndex* Index) {
+    if (!Index || Parameters.maxConnections < 2 || Parameters.efConstruction < 1 || Parameters.efSearch < 1)
+        return FSDKE_INVALID_ARGUMENT;
+
+    auto index = std::make_shared<FaceIndex>(FileName, Parameters);
+    index->Load();
+
+    *Index = Indexes().Add(std::move(index));
+    return FSDKE_OK;
+}
+
+int FreeFaceIndex(HFaceIndex Index) {
+    const auto index = Indexes().Remove(Index);
+    if (!index)
+        return FSDKE_INVALID_ARGUMENT;
+    return index->Save();
+}
+
+int SaveFaceIndex(HFaceIndex Index) {
+    const auto index = Indexes().Get(Index);
+    return index ? index->Save() : FSDKE_INVALID_ARGUMENT;
+}
+
+int FaceIndexAddFaceTemplate(HFaceIndex Index, long long ID, const FSDK_FaceTemplate* FaceTemplate) {
+    const auto index = Indexes().Get(Index);
+    if (!index || !FaceTemplate)
+        return FSDKE_INVALID_ARGUMENT;
+    return index->Add(ID, *FaceTemplate);
+}
+
+int FaceIndexAddTrackerFaces(HFaceIndex Index, HTracker Tracker, long long* Count) {
+    const auto index = Indexes().Get(Index);
+    if (!index)
+        return FSDKE_INVALID_ARGUMENT;
+
+    // The templates are copied out first, so the tracker is not locked while the graph is built
+    std::vector<std::pair<long long, FSDK_FaceTemplate>> templates;
+    {
+        const TrackerLock lock(Tracker, TrackerLock::SHARED);
+        long long count = 0;
+        int errorCode = FSDK_GetTrackerIDsCount(Tracker, &count);
+        if (errorCode != FSDKE_OK)
+            return errorCode;
+        std::vector<long long> ids((size_t)count);
+        if (count > 0 && (errorCode = FSDK_GetTrackerAllIDs(Tracker, ids.data(), count * (long long)sizeof(long long))) != FSDKE_OK)
+            return errorCode;
+
+        for (const long long id : ids) {
+            if ((errorCode = FSDK_GetTrackerFaceIDsCountForID(Tracker, id, &count)) != FSDKE_OK)
+                return errorCode;
+            std::vector<long long> faceIDs((size_t)count);
+            if (count > 0 && (errorCode = FSDK_GetTrackerFaceIDsForID(Tracker, id, faceIDs.data(), count * (long long)sizeof(long long))) != FSDKE_OK)
+                return errorCode;
+
+            for (const long long faceID : faceIDs) {
+                FSDK_FaceTemplate faceTemplate;
+                if ((errorCode = FSDK_GetTrackerFaceTemplate(Tracker, faceID, &faceTemplate)) != FSDKE_OK)
+                    return errorCode;
+                templates.emplace_back(id, faceTemplate);
+            }
+        }
+    }
+
+    const int errorCode = index->AddAll(templates);
+    if (errorCode == FSDKE_OK && Count)
+        *Count = (long long)templates.size();
+    return errorCode;
+}
+
+int FaceIndexRemoveID(HFaceIndex Index, long long ID) {
+    const auto index = Indexes().Get(Index);
+    return index ? index->Remove(ID) : FSDKE_INVALID_ARGUMENT;
+}
+
+int FaceIndexMatchFaces(HFaceIndex Index, const FSDK_FaceTemplate* FaceTemplate, float Threshold, IDSimilarity* Buffer, long long* Count,
+                        long long MaxSizeInBytes) {
+    const auto index = Indexes().Get(Index);
+    if (!index || !FaceTemplate || !Buffer || !Count || MaxSizeInBytes < (long long)sizeof(IDSimilarity))
+        return FSDKE_INVALID_ARGUMENT;
+
+    std::vector<IDSimilarity> result;
+    index->Match(*FaceTemplate, Threshold, MaxSizeInBytes / (long long)sizeof(IDSimilarity), &result);
+    std::copy(result.begin(), result.end(), Buffer);
+    *Count = (long long)result.size();
+    return FSDKE_OK;
+}
+
+int GetFaceIndexStatistics(HFaceIndex Index, FaceIndexStatistics* Statistics) {
+    const auto index = Indexes().Get(Index);
+    if (!index || !Statistics)
+        return FSDKE_INVALID_ARGUMENT;
+    *Statistics = index->Statistics();
+    return FSDKE_OK;
+}
+
+}
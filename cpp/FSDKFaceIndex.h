@@ -0,0 +1,54 @@
+#pragma once
+
+#include "LuxandFaceSDK.h"
+
+namespace fsdk {
+
+typedef unsigned int HFaceIndex;
+
+struct FaceIndexParameters {
+    // Links per node of the graph. More links raise the recall and the memory use (8 bytes per link on layer 0).
+    int maxConnections = 16;
+    // Candidates considered when a template is inserted. Higher values build a better graph more slowly.
+    int efConstruction = 200;
+    // Candidates collected by a search. Higher values raise the recall, the search time grows about linearly.
+    int efSearch = 128;
+};
+
+struct FaceIndexStatistics {
+    long long templates;
+    long long ids;
+    // Removed templates still linked in the graph
+    long long removed;
+    long long searches;
+    // FSDK_MatchFaces calls made by the searches
+    long long comparisons;
+};
+
+// An approximate nearest neighbour index of face templates for identification among more IDs than
+// FSDK_TrackerMatchFaces can compare exhaustively in time. Templates are nodes of an HNSW graph
+// (FSDKHNSW.h) navigated with FSDK_MatchFaces, so a search compares the template with a few thousand
+// templates instead of all of them; an ID may have several templates. A search collects efSearch candidates
+// and re-ranks the IDs among them exactly, by matching the template with every template of these IDs.
+//
+// Templates are added and removed incrementally. Removed templates stay in the graph to keep it navigable
+// and are skipped in the results; rebuild an index where most of the templates were removed. An index with
+// a FileName is loaded from the file when created and written to it (atomically, through a temporary file)
+// by SaveFaceIndex. Searches run in parallel with each other, changes wait for the searches.
+int CreateFaceIndex(const char* FileName, const FaceIndexParameters& Parameters, HFaceIndex* Index);
+int FreeFaceIndex(HFaceIndex Index);
+int SaveFaceIndex(HFaceIndex Index);
+int FaceIndexAddFaceTemplate(HFaceIndex Index, long long ID, const FSDK_FaceTemplate* FaceTemplate);
+// Adds the templates of every ID of the tracker, replacing the templates indexed for these IDs before. The
+// old templates are replaced only once all the new ones are in the graph, which is built in batches so
+// searches are not held up; on failure the index keeps the old templates. Count is set to the number of
+// templates added.
+int FaceIndexAddTrackerFaces(HFaceIndex Index, HTracker Tracker, long long* Count);
+int FaceIndexRemoveID(HFaceIndex Index, long long ID);
+// Fills Buffer with the IDs matching the template with at least the Threshold similarity, the most similar
+// first, and sets Count to their number, like FSDK_TrackerMatchFaces.
+int FaceIndexMatchFaces(HFaceIndex Index, const FSDK_FaceTemplate* FaceTemplate, float Threshold, IDSimilarity* Buffer, long long* Count,
+                        long long MaxSizeInBytes);
+int GetFaceIndexStatistics(HFaceIndex Index, FaceIndexStatistics* Statistics);
+
+}
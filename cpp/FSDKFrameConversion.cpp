@@ -0,0 +1,258 @@
+#include "FSDKFrameConversion.h"
+#include "FSDKTrace.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define FSDK_NEON 1
+#endif
+
+namespace fsdk {
+
+namespace {
+
+// Rows converted at once when the output is rotated, so that every output row receives a run of pixels.
+const int ROW_BLOCK = 16;
+
+bool PlaneFits(const ImagePlane& plane, int columns, int rows) {
+    if (!plane.data || plane.rowStride <= 0 || plane.pixelStride <= 0)
+        return false;
+    return (long long)(rows - 1) * plane.rowStride + (long long)(columns - 1) * plane.pixelStride < plane.size;
+}
+
+inline unsigned char Clamp(int value) {
+    return (unsigned char)std::min(255, std::max(0, value));
+}
+
+inline void YUVToRGB(int y, int u, int v, unsigned char* rgb) {
+    const int r = (91881 * v >> 16) - 179;
+    const int g = ((22544 * u + 46793 * v) >> 16) - 135;
+    const int b = (116129 * u >> 16) - 226;
+    rgb[0] = Clamp(y + r);
+    rgb[1] = Clamp(y - g);
+    rgb[2] = Clamp(y + b);
+}
+
+#ifdef FSDK_NEON
+
+// Chroma terms of 8 samples, computed in 32 bits to match the scalar code exactly.
+inline int16x8_t ChromaTerm(uint16x8_t first, int firstFactor, uint16x8_t second, int secondFactor, int bias) {
+    uint32x4_t low = vmulq_n_u32(vmovl_u16(vget_low_u16(first)), firstFactor);
+    uint32x4_t high = vmulq_n_u32(vmovl_u16(vget_high_u16(first)), firstFactor);
+    if (secondFactor) {
+        low = vmlaq_n_u32(low, vmovl_u16(vget_low_u16(second)), secondFactor);
+        high = vmlaq_n_u32(high, vmovl_u16(vget_high_u16(second)), secondFactor);
+    }
+    const uint16x8_t term = vcombine_u16(vshrn_n_u32(low, 16), vshrn_n_u32(high, 16));
+    return vsubq_s16(vreinterpretq_s16_u16(term), vdupq_n_s16(bias));
+}
+
+// Converts 16 pixels sharing 8 chroma samples.
+inline void YUVToRGB16(uint8x16_t y, uint8x8_t u, uint8x8_t v, unsigned char* rgb) {
+    const uint16x8_t u16 = vmovl_u8(u);
+    const uint16x8_t v16 = vmovl_u8(v);
+
+    // Every chroma sample covers two neighbouring pixels
+    const int16x8_t red = ChromaTerm(v16, 91881, v16, 0, 179);
+    const int16x8_t green = ChromaTerm(u16, 22544, v16, 46793, 135);
+    const int16x8_t blue = ChromaTerm(u16, 116129, u16, 0, 226);
+    const int16x8x2_t r = vzipq_s16(red, red);
+    const int16x8x2_t g = vzipq_s16(green, green);
+    const int16x8x2_t b = vzipq_s16(blue, blue);
+
+    const int16x8_t yLow = vreinterpretq_s16_u16(vmovl_u8(vget_low_u8(y)));
+    const int16x8_t yHigh = vreinterpretq_s16_u16(vmovl_u8(vget_high_u8(y)));
+
+    uint8x16x3_t pixels;
+    pixels.val[0] = vcombine_u8(vqmovun_s16(vaddq_s16(yLow, r.val[0])), vqmovun_s16(vaddq_s16(yHigh, r.val[1])));
+    pixels.val[1] = vcombine_u8(vqmovun_s16(vsubq_s16(yLow, g.val[0])), vqmovun_s16(vsubq_s16(yHigh, g.val[1])));
+    pixels.val[2] = vcombine_u8(vqmovun_s16(vaddq_s16(yLow, b.val[0])), vqmovun_s16(vaddq_s16(yHigh, b.val[1])));
+    vst3q_u8(rgb, pixels);
+}
+
+#endif
+
+void ConvertYUVRow(const unsigned char* y, int yStride, const unsigned char* u, const unsigned char* v, int chromaStride, int width, unsigned char* rgb) {
+    int x = 0;
+
+#ifdef FSDK_NEON
+    if (yStride == 1 && (chromaStride == 1 || chromaStride == 2)) {
+        // Interleaved chroma is loaded in pairs, stop early so the last load stays inside the plane
+        const int vectorWidth = chromaStride == 2 ? width - 2 : width;
+        for (; x + 16 <= vectorWidth; x += 16) {
+            const uint8x16_t luma = vld1q_u8(y + x);
+            if (chromaStride == 1)
+                YUVToRGB16(luma, vld1_u8(u + x / 2), vld1_u8(v + x / 2), rgb + 3 * x);
+            else
+                YUVToRGB16(luma, vld2_u8(u + x).val[0], vld2_u8(v + x).val[0], rgb + 3 * x);
+        }
+    }
+#endif
+
+    for (; x < width; ++x) {
+        const int chroma = (x >> 1) * chromaStride;
+        YUVToRGB(y[x * yStride], u[chroma], v[chroma], rgb + 3 * x);
+    }
+}
+
+void ConvertColorRow(const unsigned char* first, const unsigned char* second, const unsigned char* third, int pixelStride, int width, unsigned char* rgb) {
+    int x = 0;
+
+    if (pixelStride == 3 && second == first + 1 && third == first + 2) {
+        memcpy(rgb, first, 3 * width);
+        return;
+    }
+
+#ifdef FSDK_NEON
+    if (pixelStride == 4 && second == first + 1 && third == first + 2) {
+        for (; x + 16 <= width; x += 16) {
+            const uint8x16x4_t source = vld4q_u8(first + 4 * x);
+            uint8x16x3_t pixels;
+            pixels.val[0] = source.val[0];
+            pixels.val[1] = source.val[1];
+            pixels.val[2] = source.val[2];
+            vst3q_u8(rgb + 3 * x, pixels);
+        }
+    }
+#endif
+
+    for (; x < width; ++x) {
+        const int index = x * pixelStride;
+        rgb[3 * x] = first[index];
+        rgb[3 * x + 1] = second[index];
+        rgb[3 * x + 2] = third[index];
+    }
+}
+
+// Calls convertRow(row, pixels) for every source row and places the pixels according to the layout.
+template <typename ConvertRow>
+void Convert(int width, int height, const OutputLayout& layout, unsigned char* output, ConvertRow&& convertRow) {
+    if (layout.pixelStride == 3) {
+        for (int row = 0; row < height; ++row)
+            convertRow(row, output + layout.offset + row * layout.rowStride);
+        return;
+    }
+
+    thread_local std::vector<unsigned char> lines;
+    lines.resize((size_t)3 * width * ROW_BLOCK);
+
+    for (int first = 0; first < height; first += ROW_BLOCK) {
+        const int count = std::min(ROW_BLOCK, height - first);
+        for (int i = 0; i < count; ++i)
+            convertRow(first + i, lines.data() + (size_t)3 * width * i);
+
+        for (int x = 0; x < width; ++x) {
+            unsigned char* pixel = output + layout.offset + x * layout.pixelStride + first * layout.rowStride;
+            const unsigned char* source = lines.data() + 3 * x;
+            for (int i = 0; i < count; ++i, pixel += layout.rowStride, source += 3 * width) {
+                pixel[0] = source[0];
+                pixel[1] = source[1];
+                pixel[2] = source[2];
+            }
+        }
+    }
+}
+
+template <typename ConvertFunction>
+int LoadImage(HImage* Image, int Width, int Height, int RotationDegrees, bool Mirrored, ConvertFunction&& convert) {
+    if (!Image)
+        return FSDKE_INVALID_ARGUMENT;
+
+    OutputLayout layout;
+    int errorCode = GetOutputLayout(Width, Height, RotationDegrees, Mirrored, &layout);
+    if (errorCode != FSDKE_OK)
+        return errorCode;
+
+    // FSDK_LoadImageFromBuffer copies the pixels, so the buffer is reused by the next frame
+    thread_local std::vector<unsigned char> buffer;
+    buffer.resize((size_t)3 * Width * Height);
+
+    {
+        trace::Span span("ConvertFrame");
+        errorCode = convert(layout, buffer.data());
+    }
+    if (errorCode != FSDKE_OK)
+        return errorCode;
+
+    trace::Span span("LoadImageFromBuffer");
+    return FSDK_LoadImageFromBuffer(Image, buffer.data(), layout.width, layout.height, 3 * layout.width, FSDK_IMAGE_COLOR_24BIT);
+}
+
+}
+
+int GetOutputLayout(int Width, int Height, int RotationDegrees, bool Mirrored, OutputLayout* Layout) {
+    if (!Layout || Width <= 0 || Height <= 0)
+        return FSDKE_INVALID_ARGUMENT;
+
+    const int rotation = (RotationDegrees % 360 + 360) % 360;
+    if (rotation % 90 != 0)
+        return FSDKE_INVALID_ARGUMENT;
+
+    const bool transposed = rotation == 90 || rotation == 270;
+    Layout->width = transposed ? Height : Width;
+    Layout->height = transposed ? Width : Height;
+
+    // The mapping is linear in x and y, so the strides are the differences between neighbouring pixels
+    const auto index = [&](long long x, long long y) {
+        long long column = x, row = y;
+        switch (rotation) {
+            case 90:  column = Height - 1 - y; row = x; break;
+            case 180: column = Width - 1 - x;  row = Height - 1 - y; break;
+            case 270: column = y;              row = Width - 1 - x; break;
+        }
+        if (Mirrored)
+            column = Layout->width - 1 - column;
+        return 3 * (row * Layout->width + column);
+    };
+
+    Layout->offset = index(0, 0);
+    Layout->pixelStride = index(1, 0) - Layout->offset;
+    Layout->rowStride = index(0, 1) - Layout->offset;
+    return FSDKE_OK;
+}
+
+int ConvertYUV420(const ImagePlane& Y, const ImagePlane& U, const ImagePlane& V, int Width, int Height, const OutputLayout& Layout, unsigned char* Output) {
+    const int chromaWidth = (Width + 1) / 2;
+    const int chromaHeight = (Height + 1) / 2;
+    if (!Output || Width <= 0 || Height <= 0 || U.pixelStride != V.pixelStride ||
+        !PlaneFits(Y, Width, Height) || !PlaneFits(U, chromaWidth, chromaHeight) || !PlaneFits(V, chromaWidth, chromaHeight))
+        return FSDKE_INVALID_ARGUMENT;
+
+    Convert(Width, Height, Layout, Output, [&](int row, unsigned char* rgb) {
+        ConvertYUVRow(Y.data + (long long)row * Y.rowStride, Y.pixelStride,
+                      U.data + (long long)(row / 2) * U.rowStride, V.data + (long long)(row / 2) * V.rowStride, U.pixelStride,
+                      Width, rgb);
+    });
+    return FSDKE_OK;
+}
+
+int ConvertColorPlanes(const ImagePlane Planes[3], int Width, int Height, const OutputLayout& Layout, unsigned char* Output) {
+    if (!Planes || !Output || Width <= 0 || Height <= 0)
+        return FSDKE_INVALID_ARGUMENT;
+    for (int i = 0; i < 3; ++i)
+        if (!PlaneFits(Planes[i], Width, Height) || Planes[i].pixelStride != Planes[0].pixelStride)
+            return FSDKE_INVALID_ARGUMENT;
+
+    Convert(Width, Height, Layout, Output, [&](int row, unsigned char* rgb) {
+        ConvertColorRow(Planes[0].data + (long long)row * Planes[0].rowStride, Planes[1].data + (long long)row * Planes[1].rowStride,
+                        Planes[2].data + (long long)row * Planes[2].rowStride, Planes[0].pixelStride, Width, rgb);
+    });
+    return FSDKE_OK;
+}
+
+int LoadImageFromYUV420(HImage* Image, const ImagePlane& Y, const ImagePlane& U, const ImagePlane& V, int Width, int Height, int RotationDegrees, bool Mirrored) {
+    return LoadImage(Image, Width, Height, RotationDegrees, Mirrored, [&](const OutputLayout& layout, unsigned char* output) {
+        return ConvertYUV420(Y, U, V, Width, Height, layout, output);
+    });
+}
+
+int LoadImageFromColorPlanes(HImage* Image, const ImagePlane Planes[3], int Width, int Height, int RotationDegrees, bool Mirrored) {
+    return LoadImage(Image, Width, Height, RotationDegrees, Mirrored, [&](const OutputLayout& layout, unsigned char* output) {
+        return ConvertColorPlanes(Planes, Width, Height, layout, output);
+    });
+}
+
+}
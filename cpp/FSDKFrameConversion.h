@@ -0,0 +1,40 @@
+#pragma once
+
+#include "LuxandFaceSDK.h"
+
+// Conversion of camera frames into 24-bit FaceSDK images. Planes are read in place using their
+// row and pixel strides, rotation and mirroring are applied while writing the converted pixels,
+// and the intermediate buffer is reused by later frames converted on the same thread.
+namespace fsdk {
+
+struct ImagePlane {
+    const unsigned char* data;
+    long long size;     // number of bytes readable from data
+    int rowStride;
+    int pixelStride;
+};
+
+// The source pixel (x, y) is written to offset + y * rowStride + x * pixelStride of the output buffer.
+struct OutputLayout {
+    int width;
+    int height;
+    long long offset;
+    long long rowStride;
+    long long pixelStride;
+};
+
+// Layout of a frame that must be rotated clockwise by RotationDegrees (0, 90, 180 or 270) and then
+// optionally mirrored horizontally to appear upright.
+int GetOutputLayout(int Width, int Height, int RotationDegrees, bool Mirrored, OutputLayout* Layout);
+
+// Converts a YUV 4:2:0 frame (I420, NV12, NV21, Android YUV_420_888) with the BT.601 full range
+// coefficients used by the frame plugins. Output pixels are in the R, G, B byte order.
+int ConvertYUV420(const ImagePlane& Y, const ImagePlane& U, const ImagePlane& V, int Width, int Height, const OutputLayout& Layout, unsigned char* Output);
+
+// Copies three color channels stored in separate planes or interleaved in one buffer (RGB, RGBA, BGRA).
+int ConvertColorPlanes(const ImagePlane Planes[3], int Width, int Height, const OutputLayout& Layout, unsigned char* Output);
+
+int LoadImageFromYUV420(HImage* Image, const ImagePlane& Y, const ImagePlane& U, const ImagePlane& V, int Width, int Height, int RotationDegrees, bool Mirrored);
+int LoadImageFromColorPlanes(HImage* Image, const ImagePlane Planes[3], int Width, int Height, int RotationDegrees, bool Mirrored);
+
+}
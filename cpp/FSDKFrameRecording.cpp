@@ -0,0 +1,436 @@
+#include "FSDKFrameRecording.h"
+#include "FSDKTrace.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace fsdk {
+
+namespace {
+
+const char FILE_MAGIC[8] = {'F', 'S', 'D', 'K', 'F', 'R', 'M', 'S'};
+const uint32_t FILE_VERSION = 1;
+
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+};
+
+// Plane offsets are relative to the frame data following the frame header.
+struct PlaneHeader {
+    uint32_t offset;
+    uint32_t size;
+    int32_t rowStride;
+    int32_t pixelStride;
+};
+
+struct FrameHeader {
+    uint32_t size;
+    uint8_t format;
+    uint8_t mirrored;
+    uint16_t rotationDegrees;
+    int32_t width;
+    int32_t height;
+    int64_t timestamp;
+    PlaneHeader planes[3];
+};
+
+// Bytes of the plane actually read by the conversion of a columns x rows frame.
+long long UsedSize(const ImagePlane& plane, int columns, int rows) {
+    const long long used = (long long)(rows - 1) * plane.rowStride + (long long)(columns - 1) * plane.pixelStride + 1;
+    return std::min(used, plane.size);
+}
+
+struct Range {
+    const unsigned char* begin;
+    const unsigned char* end;
+    uint32_t offset;
+};
+
+class Recorder {
+public:
+    Recorder(FILE* file, const std::string& fileName, bool compressed) : file(file), temporary(fileName + ".jpg"), compressed(compressed) {}
+
+    ~Recorder() {
+        fclose(file);
+    }
+
+    int AddPlanes(FrameFormat format, const ImagePlane planes[3], const int columns[3], const int rows[3], int width, int height,
+                  int rotationDegrees, bool mirrored, long long timestamp) {
+        // Planes sharing memory (i.e. interleaved chroma or color channels) are written once
+        std::vector<Range> ranges;
+        for (int i = 0; i < 3; ++i)
+            ranges.push_back({planes[i].data, planes[i].data + UsedSize(planes[i], columns[i], rows[i]), 0});
+        std::sort(ranges.begin(), ranges.end(), [](const Range& a, const Range& b) { return a.begin < b.begin; });
+
+        std::vector<Range> merged;
+        for (const Range& range : ranges) {
+            if (!merged.empty() && range.begin < merged.back().end)
+                merged.back().end = std::max(merged.back().end, range.end);
+            else
+                merged.push_back(range);
+        }
+
+        FrameHeader header = {};
+        header.format = (uint8_t)format;
+        header.mirrored = mirrored;
+        header.rotationDegrees = (uint16_t)((rotationDegrees % 360 + 360) % 360);
+        header.width = width;
+        header.height = height;
+        header.timestamp = timestamp;
+
+        long long size = 0;
+        for (Range& range : merged) {
+            range.offset = (uint32_t)size;
+            size += range.end - range.begin;
+        }
+        header.size = (uint32_t)size;
+
+        for (int i = 0; i < 3; ++i) {
+            const Range& range = *std::find_if(merged.rbegin(), merged.rend(), [&](const Range& r) { return r.begin <= planes[i].data; });
+            header.planes[i] = {range.offset + (uint32_t)(planes[i].data - range.begin), (uint32_t)UsedSize(planes[i], columns[i], rows[i]),
+                                planes[i].rowStride, planes[i].pixelStride};
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        bool written = fwrite(&header, sizeof(header), 1, file) == 1;
+        for (const Range& range : merged)
+            written = written && fwrite(range.begin, 1, range.end - range.begin, file) == (size_t)(range.end - range.begin);
+        return Written(written, sizeof(header) + size);
+    }
+
+    int AddImage(HImage image, long long timestamp) {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        int width = 0, height = 0;
+        int errorCode = FSDK_GetImageWidth(image, &width);
+        if (errorCode == FSDKE_OK)
+            errorCode = FSDK_GetImageHeight(image, &height);
+        if (errorCode == FSDKE_OK)
+            errorCode = Encode(image);
+        if (errorCode != FSDKE_OK)
+            return Failed(errorCode);
+
+        FrameHeader header = {};
+        header.size = (uint32_t)jpeg.size();
+        header.format = FRAME_FORMAT_JPEG;
+        header.width = width;
+        header.height = height;
+        header.timestamp = timestamp;
+        header.planes[0] = {0, header.size, 0, 0};
+
+        const bool written = fwrite(&header, sizeof(header), 1, file) == 1 && fwrite(jpeg.data(), 1, jpeg.size(), file) == jpeg.size();
+        return Written(written, sizeof(header) + jpeg.size());
+    }
+
+    bool Compressed() const {
+        return compressed;
+    }
+
+    FrameRecordingStatistics Statistics() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return {frames, bytes};
+    }
+
+    // Returns the first error of the recording, since the plugins do not fail frames that were not recorded.
+    int Close() {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (fflush(file) != 0)
+            Failed(FSDKE_IO_ERROR);
+        return firstError;
+    }
+
+private:
+    int Failed(int result) {
+        if (firstError == FSDKE_OK)
+            firstError = result;
+        return result;
+    }
+
+    int Written(bool written, long long size) {
+        if (!written)
+            return Failed(FSDKE_IO_ERROR);
+        ++frames;
+        bytes += size;
+        return FSDKE_OK;
+    }
+
+    // FaceSDK encodes images only to files, so the JPEG is written to a temporary file next to the recording.
+    int Encode(HImage image) {
+        trace::Span span("EncodeFrame");
+        const int errorCode = FSDK_SaveImageToFile(image, temporary.c_str());
+        if (errorCode != FSDKE_OK)
+            return errorCode;
+
+        FILE* encoded = fopen(temporary.c_str(), "rb");
+        if (!encoded)
+            return FSDKE_CANNOT_OPEN_FILE;
+        jpeg.clear();
+        unsigned char chunk[65536];
+        size_t read;
+        while ((read = fread(chunk, 1, sizeof(chunk), encoded)) > 0)
+            jpeg.insert(jpeg.end(), chunk, chunk + read);
+        const bool failed = ferror(encoded) || jpeg.empty();
+        fclose(encoded);
+        remove(temporary.c_str());
+        return failed ? FSDKE_IO_ERROR : FSDKE_OK;
+    }
+
+    FILE* const file;
+    const std::string temporary;
+    const bool compressed;
+
+    std::mutex mutex;
+    std::vector<unsigned char> jpeg;
+    int firstError = FSDKE_OK;
+    long long frames = 0;
+    long long bytes = sizeof(FileHeader);
+};
+
+std::mutex recorderMutex;
+std::shared_ptr<Recorder> recorder;
+// Checked by the plugins on every frame without taking the mutex
+std::atomic<bool> recording(false);
+
+std::shared_ptr<Recorder> ActiveRecorder() {
+    if (!recording.load(std::memory_order_relaxed))
+        return nullptr;
+    std::lock_guard<std::mutex> lock(recorderMutex);
+    return recorder;
+}
+
+// Returns the size of the JPEG image at the start of data, 0 if more data is needed and -1 if data
+// does not start with a JPEG image.
+long long JpegSize(const unsigned char* data, size_t size) {
+    if (size < 2)
+        return 0;
+    if (data[0] != 0xFF || data[1] != 0xD8)
+        return -1;
+
+    size_t position = 2;
+    while (true) {
+        if (position + 1 >= size)
+            return 0;
+        if (data[position] != 0xFF)
+            return -1;
+
+        const unsigned char marker = data[position + 1];
+        if (marker == 0xFF) {
+            ++position;
+            continue;
+        }
+        if (marker == 0xD9)
+            return (long long)position + 2;
+        if (marker == 0x01 || (marker >= 0xD0 && marker <= 0xD7)) {
+            position += 2;
+            continue;
+        }
+
+        if (position + 3 >= size)
+            return 0;
+        position += 2 + (data[position + 2] << 8 | data[position + 3]);
+        if (marker != 0xDA)
+            continue;
+
+        // Entropy coded data ends at the first marker other than a stuffed byte or a restart marker
+        while (position + 1 < size && !(data[position] == 0xFF && data[position + 1] != 0x00 && (data[position + 1] < 0xD0 || data[position + 1] > 0xD7)))
+            ++position;
+    }
+}
+
+int ReadMotionJpeg(FILE* file, double fps, const std::function<bool(const RecordedFrame&)>& callback) {
+    if (fps <= 0)
+        return FSDKE_INVALID_ARGUMENT;
+
+    std::vector<unsigned char> buffer;
+    size_t start = 0;
+    bool end = false;
+    long long index = 0;
+    while (true) {
+        // Skip anything between the images
+        while (start + 1 < buffer.size() && !(buffer[start] == 0xFF && buffer[start + 1] == 0xD8))
+            ++start;
+
+        const long long size = start < buffer.size() ? JpegSize(buffer.data() + start, buffer.size() - start) : 0;
+        if (size < 0) {
+            ++start;
+            continue;
+        }
+        if (size == 0) {
+            if (end)
+                return FSDKE_OK;
+            buffer.erase(buffer.begin(), buffer.begin() + start);
+            start = 0;
+            const size_t used = buffer.size();
+            buffer.resize(used + (1 << 20));
+            const size_t read = fread(buffer.data() + used, 1, 1 << 20, file);
+            buffer.resize(used + read);
+            end = read == 0;
+            if (end && ferror(file))
+                return FSDKE_IO_ERROR;
+            continue;
+        }
+
+        RecordedFrame frame = {};
+        frame.format = FRAME_FORMAT_JPEG;
+        frame.timestamp = (long long)(index++ * 1e9 / fps);
+        frame.planes[0] = {buffer.data() + start, size, 0, 0};
+        if (!callback(frame))
+            return FSDKE_OK;
+        start += (size_t)size;
+    }
+}
+
+}
+
+int StartFrameRecording(const char* FileName, bool Compressed) {
+    if (!FileName)
+        return FSDKE_INVALID_ARGUMENT;
+
+    FILE* file = fopen(FileName, "wb");
+    if (!file)
+        return FSDKE_CANNOT_OPEN_FILE;
+    // Raw frames take several megabytes each
+    setvbuf(file, nullptr, _IOFBF, 1 << 20);
+
+    FileHeader header = {};
+    memcpy(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+    header.version = FILE_VERSION;
+    if (fwrite(&header, sizeof(header), 1, file) != 1) {
+        fclose(file);
+        return FSDKE_IO_ERROR;
+    }
+
+    std::lock_guard<std::mutex> lock(recorderMutex);
+    recorder = std::make_shared<Recorder>(file, FileName, Compressed);
+    recording = true;
+    return FSDKE_OK;
+}
+
+int StopFrameRecording(FrameRecordingStatistics* Statistics) {
+    std::shared_ptr<Recorder> stopped;
+    {
+        std::lock_guard<std::mutex> lock(recorderMutex);
+        stopped.swap(recorder);
+        recording = false;
+    }
+    if (!stopped)
+        return FSDKE_INVALID_ARGUMENT;
+
+    // Frames being written by other threads finish before the file is closed by the last reference
+    if (Statistics)
+        *Statistics = stopped->Statistics();
+    return stopped->Close();
+}
+
+bool FrameRecordingActive() {
+    return recording.load(std::memory_order_relaxed);
+}
+
+int RecordYUV420Frame(const ImagePlane& Y, const ImagePlane& U, const ImagePlane& V, int Width, int Height, int RotationDegrees, bool Mirrored,
+                      long long Timestamp, HImage Image) {
+    const auto active = ActiveRecorder();
+    if (!active)
+        return FSDKE_OK;
+    if (active->Compressed())
+        return active->AddImage(Image, Timestamp);
+
+    trace::Span span("RecordFrame");
+    const ImagePlane planes[3] = {Y, U, V};
+    const int columns[3] = {Width, (Width + 1) / 2, (Width + 1) / 2};
+    const int rows[3] = {Height, (Height + 1) / 2, (Height + 1) / 2};
+    return active->AddPlanes(FRAME_FORMAT_YUV420, planes, columns, rows, Width, Height, RotationDegrees, Mirrored, Timestamp);
+}
+
+int RecordColorPlanesFrame(const ImagePlane Planes[3], int Width, int Height, int RotationDegrees, bool Mirrored, long long Timestamp, HImage Image) {
+    const auto active = ActiveRecorder();
+    if (!active)
+        return FSDKE_OK;
+    if (active->Compressed())
+        return active->AddImage(Image, Timestamp);
+
+    trace::Span span("RecordFrame");
+    const int columns[3] = {Width, Width, Width};
+    const int rows[3] = {Height, Height, Height};
+    return active->AddPlanes(FRAME_FORMAT_COLOR_PLANES, Planes, columns, rows, Width, Height, RotationDegrees, Mirrored, Timestamp);
+}
+
+int ReadFrameRecording(const char* FileName, double Fps, const std::function<bool(const RecordedFrame&)>& Callback) {
+    if (!FileName || !Callback)
+        return FSDKE_INVALID_ARGUMENT;
+
+    FILE* file = fopen(FileName, "rb");
+    if (!file)
+        return FSDKE_CANNOT_OPEN_FILE;
+    setvbuf(file, nullptr, _IOFBF, 1 << 20);
+
+    FileHeader header = {};
+    const size_t headerSize = fread(&header, 1, sizeof(header), file);
+    if (headerSize < sizeof(header) || memcmp(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0) {
+        rewind(file);
+        const int errorCode = ReadMotionJpeg(file, Fps, Callback);
+        fclose(file);
+        return errorCode;
+    }
+    if (header.version != FILE_VERSION) {
+        fclose(file);
+        return FSDKE_UNSUPPORTED_FILE_VERSION;
+    }
+
+    std::vector<unsigned char> data;
+    FrameHeader frameHeader;
+    int errorCode = FSDKE_OK;
+    while (fread(&frameHeader, sizeof(frameHeader), 1, file) == 1) {
+        data.resize(frameHeader.size);
+        if (fread(data.data(), 1, data.size(), file) != data.size())
+            break;
+
+        RecordedFrame frame = {};
+        frame.format = (FrameFormat)frameHeader.format;
+        frame.width = frameHeader.width;
+        frame.height = frameHeader.height;
+        frame.rotationDegrees = frameHeader.rotationDegrees;
+        frame.mirrored = frameHeader.mirrored;
+        frame.timestamp = frameHeader.timestamp;
+        bool valid = frame.format <= FRAME_FORMAT_JPEG;
+        for (int i = 0; i < 3 && valid; ++i) {
+            const PlaneHeader& plane = frameHeader.planes[i];
+            valid = (unsigned long long)plane.offset + plane.size <= data.size();
+            frame.planes[i] = {data.data() + (valid ? plane.offset : 0), plane.size, plane.rowStride, plane.pixelStride};
+        }
+        if (!valid) {
+            errorCode = FSDKE_BAD_FILE_FORMAT;
+            break;
+        }
+        if (!Callback(frame))
+            break;
+    }
+    if (errorCode == FSDKE_OK && ferror(file))
+        errorCode = FSDKE_IO_ERROR;
+    fclose(file);
+    return errorCode;
+}
+
+int LoadImageFromRecordedFrame(HImage* Image, const RecordedFrame& Frame) {
+    switch (Frame.format) {
+        case FRAME_FORMAT_YUV420:
+            return LoadImageFromYUV420(Image, Frame.planes[0], Frame.planes[1], Frame.planes[2], Frame.width, Frame.height, Frame.rotationDegrees,
+                                       Frame.mirrored);
+        case FRAME_FORMAT_COLOR_PLANES:
+            return LoadImageFromColorPlanes(Image, Frame.planes, Frame.width, Frame.height, Frame.rotationDegrees, Frame.mirrored);
+        case FRAME_FORMAT_JPEG: {
+            trace::Span span("DecodeFrame");
+            return FSDK_LoadImageFromJpegBuffer(Image, Frame.planes[0].data, (unsigned int)Frame.planes[0].size);
+        }
+    }
+    return FSDKE_INVALID_ARGUMENT;
+}
+
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "FSDKFrameConversion.h"
+
+#include <functional>
+
+// Recording of camera frames as they arrive in the frame plugins, and reading them back for offline replay.
+// A recording is a file starting with the "FSDKFRMS" magic followed by one record per frame. Raw frames keep
+// their planes, strides, rotation, mirroring and timestamp, so replay goes through the same conversion as the
+// live frames. Compressed recordings store every converted frame as a JPEG image instead, which makes them a
+// Motion JPEG stream with a header per frame.
+namespace fsdk {
+
+enum FrameFormat {
+    FRAME_FORMAT_YUV420 = 0,
+    FRAME_FORMAT_COLOR_PLANES = 1,
+    FRAME_FORMAT_JPEG = 2
+};
+
+struct RecordedFrame {
+    FrameFormat format;
+    // The size of the source frame, before rotation
+    int width;
+    int height;
+    int rotationDegrees;
+    bool mirrored;
+    long long timestamp;
+    // Y, U and V planes, or the three color planes. JPEG data is in planes[0], which is read as is.
+    ImagePlane planes[3];
+};
+
+struct FrameRecordingStatistics {
+    long long frames;
+    long long bytes;
+};
+
+// Starts recording the frames passed to the frame plugins into the file, replacing a recording in progress.
+int StartFrameRecording(const char* FileName, bool Compressed);
+int StopFrameRecording(FrameRecordingStatistics* Statistics);
+bool FrameRecordingActive();
+
+// Append a frame to the recording in progress and do nothing otherwise. Image is the frame converted by
+// the plugin, it is only used by compressed recordings.
+int RecordYUV420Frame(const ImagePlane& Y, const ImagePlane& U, const ImagePlane& V, int Width, int Height, int RotationDegrees, bool Mirrored,
+                      long long Timestamp, HImage Image);
+int RecordColorPlanesFrame(const ImagePlane Planes[3], int Width, int Height, int RotationDegrees, bool Mirrored, long long Timestamp, HImage Image);
+
+// Streams the frames of a recording or of a Motion JPEG file (concatenated JPEG images) to the callback,
+// which returns false to stop. Frame data is valid during the call only. Frames of Motion JPEG files are
+// timestamped Fps frames per second, in nanoseconds. A record torn at the end of a recording is ignored.
+int ReadFrameRecording(const char* FileName, double Fps, const std::function<bool(const RecordedFrame&)>& Callback);
+
+// Converts the frame into an upright 24-bit image the way the frame plugins do.
+int LoadImageFromRecordedFrame(HImage* Image, const RecordedFrame& Frame);
+
+}
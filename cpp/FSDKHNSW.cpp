@@ -0,0 +1,82 @@
+#include "FSDKHNSW.h"
+
+#include <cstring>
+
+namespace fsdk {
+
+namespace {
+
+template <typename T>
+void Append(std::vector<unsigned char>* buffer, const T* values, size_t count) {
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(values);
+    buffer->insert(buffer->end(), bytes, bytes + count * sizeof(T));
+}
+
+template <typename T>
+bool Take(const unsigned char*& data, const unsigned char* end, T* values, size_t count) {
+    if ((size_t)(end - data) / sizeof(T) < count)
+        return false;
+    if (count > 0)
+        memcpy(values, data, count * sizeof(T));
+    data += count * sizeof(T);
+    return true;
+}
+
+}
+
+// Written in the native byte order: the header, the levels, layer 0 links and the upper layer links of every
+// node above layer 0.
+void HNSWGraph::Save(std::vector<unsigned char>* Buffer) const {
+    const uint32_t header[4] = {(uint32_t)maxConnections, Size(), entryPoint, (uint32_t)maxLevel};
+    Append(Buffer, header, 4);
+    Append(Buffer, levels.data(), levels.size());
+    Append(Buffer, base.data(), base.size());
+    for (const auto& links : upper)
+        Append(Buffer, links.data(), links.size());
+}
+
+bool HNSWGraph::Load(const unsigned char*& Data, const unsigned char* End) {
+    uint32_t header[4];
+    bool loaded = Take(Data, End, header, 4) && header[0] >= 2 && header[0] <= 1024;
+    if (loaded) {
+        maxConnections = (int)header[0];
+        efConstruction = std::max(efConstruction, maxConnections);
+        levels.resize(header[1]);
+        loaded = Take(Data, End, levels.data(), levels.size()) && (size_t)(End - Data) / BaseStride() / sizeof(uint32_t) >= levels.size();
+    }
+    if (loaded) {
+        base.resize(levels.size() * BaseStride());
+        loaded = Take(Data, End, base.data(), base.size());
+    }
+
+    upper.clear();
+    for (size_t node = 0; loaded && node < levels.size(); ++node) {
+        upper.emplace_back((size_t)levels[node] * UpperStride(), 0);
+        loaded = levels[node] <= 15 && Take(Data, End, upper.back().data(), upper.back().size());
+    }
+
+    // Every link must point to an existing node, so a corrupted file cannot make a search read out of bounds
+    for (size_t node = 0; loaded && node < levels.size(); ++node)
+        for (int layer = 0; loaded && layer <= levels[node]; ++layer) {
+            const uint32_t* links = Links((uint32_t)node, layer);
+            loaded = (int)links[0] <= MaxLinks(layer);
+            for (uint32_t i = 1; loaded && i <= links[0]; ++i)
+                loaded = links[i] < levels.size() && levels[links[i]] >= layer;
+        }
+
+    if (loaded) {
+        entryPoint = header[2];
+        maxLevel = (int)header[3];
+        loaded = levels.empty() ? maxLevel == -1 : entryPoint < levels.size() && levels[entryPoint] == maxLevel;
+    }
+    if (!loaded) {
+        levels.clear();
+        base.clear();
+        upper.clear();
+        entryPoint = 0;
+        maxLevel = -1;
+    }
+    return loaded;
+}
+
+}
@@ -0,0 +1,262 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <queue>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace fsdk {
+
+// A hierarchical navigable small world graph (Malkov, Yashunin, 2016) over nodes numbered from 0 in the order
+// they are inserted. The graph keeps the links only, similarities are computed by the caller (higher is
+// closer), so the same graph indexes FaceSDK templates compared with FSDK_MatchFaces and plain vectors.
+// Nodes are never unlinked: removed nodes are still traversed and filtered out of the results by the caller.
+// The graph is not synchronized, searches may run in parallel with each other but not with Insert.
+class HNSWGraph {
+public:
+    // The similarity and the node
+    typedef std::pair<float, uint32_t> Candidate;
+
+    // Every node is linked to up to MaxConnections nodes on the upper layers and twice as many on layer 0.
+    // EfConstruction is the number of candidates considered when linking a new node.
+    HNSWGraph(int MaxConnections, int EfConstruction, uint64_t Seed = 1)
+        : maxConnections(std::max(2, MaxConnections)), efConstruction(std::max(maxConnections, EfConstruction)), random(Seed) {}
+
+    uint32_t Size() const {
+        return (uint32_t)levels.size();
+    }
+
+    int MaxConnections() const {
+        return maxConnections;
+    }
+
+    // Links node Size(). similarity(node) returns the similarity of the new node to an inserted node,
+    // pairSimilarity(a, b) the similarity of two inserted nodes.
+    template <typename Similarity, typename PairSimilarity>
+    void Insert(Similarity&& similarity, PairSimilarity&& pairSimilarity) {
+        const uint32_t node = Size();
+        const int level = std::min(RandomLevel(), 15);
+        levels.push_back((uint8_t)level);
+        base.resize(base.size() + BaseStride(), 0);
+        upper.emplace_back(level > 0 ? (size_t)level * UpperStride() : 0, 0);
+
+        if (node == 0) {
+            entryPoint = 0;
+            maxLevel = level;
+            return;
+        }
+
+        Candidate nearest(similarity(entryPoint), entryPoint);
+        for (int layer = maxLevel; layer > level; --layer)
+            nearest = Greedy(similarity, nearest, layer);
+
+        for (int layer = std::min(level, maxLevel); layer >= 0; --layer) {
+            std::vector<Candidate> candidates = SearchLayer(similarity, {nearest}, efConstruction, layer, [](uint32_t) { return true; });
+            nearest = candidates.front();
+
+            const std::vector<Candidate> neighbors = SelectNeighbors(std::move(candidates), maxConnections, pairSimilarity);
+            uint32_t* links = Links(node, layer);
+            links[0] = (uint32_t)neighbors.size();
+            for (size_t i = 0; i < neighbors.size(); ++i)
+                links[i + 1] = neighbors[i].second;
+
+            for (const Candidate& neighbor : neighbors)
+                Connect(neighbor.second, node, neighbor.first, layer, pairSimilarity);
+        }
+
+        if (level > maxLevel) {
+            entryPoint = node;
+            maxLevel = level;
+        }
+    }
+
+    // Returns up to Ef accepted nodes closest to the query, closest first. similarity(node) returns the
+    // similarity of the query to a node, accept(node) filters the results without affecting the traversal.
+    // Larger Ef finds the true neighbours more often and takes proportionally longer.
+    template <typename Similarity, typename Accept>
+    std::vector<Candidate> Search(Similarity&& similarity, int Ef, Accept&& accept) const {
+        if (levels.empty())
+            return {};
+
+        Candidate nearest(similarity(entryPoint), entryPoint);
+        for (int layer = maxLevel; layer > 0; --layer)
+            nearest = Greedy(similarity, nearest, layer);
+        return SearchLayer(similarity, {nearest}, std::max(1, Ef), 0, accept);
+    }
+
+    void Save(std::vector<unsigned char>* Buffer) const;
+    // Returns false if the data is truncated or inconsistent, the graph is left empty then.
+    bool Load(const unsigned char*& Data, const unsigned char* End);
+
+private:
+    size_t BaseStride() const {
+        return 2 * (size_t)maxConnections + 1;
+    }
+
+    size_t UpperStride() const {
+        return (size_t)maxConnections + 1;
+    }
+
+    int MaxLinks(int layer) const {
+        return layer == 0 ? 2 * maxConnections : maxConnections;
+    }
+
+    // The number of links followed by the linked nodes
+    uint32_t* Links(uint32_t node, int layer) {
+        return layer == 0 ? &base[node * BaseStride()] : &upper[node][(layer - 1) * UpperStride()];
+    }
+
+    const uint32_t* Links(uint32_t node, int layer) const {
+        return layer == 0 ? &base[node * BaseStride()] : &upper[node][(layer - 1) * UpperStride()];
+    }
+
+    int RandomLevel() {
+        const double uniform = std::uniform_real_distribution<double>(0, 1)(random);
+        return (int)(-std::log(std::max(uniform, 1e-12)) / std::log((double)maxConnections));
+    }
+
+    // Marks visited nodes with the number of the search, so the marks are not cleared between searches
+    struct Visited {
+        std::vector<uint32_t> marks;
+        uint32_t search = 0;
+
+        void Reset(size_t size) {
+            if (marks.size() < size)
+                marks.resize(size, 0);
+            if (++search == 0) {
+                std::fill(marks.begin(), marks.end(), 0);
+                search = 1;
+            }
+        }
+
+        bool Visit(uint32_t node) {
+            if (marks[node] == search)
+                return false;
+            marks[node] = search;
+            return true;
+        }
+    };
+
+    static Visited& ThreadVisited() {
+        static thread_local Visited visited;
+        return visited;
+    }
+
+    template <typename Similarity>
+    Candidate Greedy(Similarity& similarity, Candidate nearest, int layer) const {
+        for (bool changed = true; changed;) {
+            changed = false;
+            const uint32_t* links = Links(nearest.second, layer);
+            for (uint32_t i = 1; i <= links[0]; ++i) {
+                const float value = similarity(links[i]);
+                if (value > nearest.first) {
+                    nearest = Candidate(value, links[i]);
+                    changed = true;
+                }
+            }
+        }
+        return nearest;
+    }
+
+    // Best first search of one layer. Rejected nodes are expanded but not returned, the search stops when
+    // the closest unexpanded node is farther than the farthest of ef accepted nodes found.
+    template <typename Similarity, typename Accept>
+    std::vector<Candidate> SearchLayer(Similarity& similarity, const std::vector<Candidate>& entries, int ef, int layer, Accept&& accept) const {
+        Visited& visited = ThreadVisited();
+        visited.Reset(levels.size());
+
+        std::priority_queue<Candidate> candidates;
+        std::priority_queue<Candidate, std::vector<Candidate>, std::greater<Candidate>> results;
+        for (const Candidate& entry : entries) {
+            visited.Visit(entry.second);
+            candidates.push(entry);
+            if (accept(entry.second))
+                results.push(entry);
+        }
+
+        while (!candidates.empty()) {
+            const Candidate current = candidates.top();
+            if ((int)results.size() >= ef && current.first < results.top().first)
+                break;
+            candidates.pop();
+
+            const uint32_t* links = Links(current.second, layer);
+            for (uint32_t i = 1; i <= links[0]; ++i) {
+                const uint32_t node = links[i];
+                if (!visited.Visit(node))
+                    continue;
+                const float value = similarity(node);
+                if ((int)results.size() < ef || value > results.top().first) {
+                    candidates.emplace(value, node);
+                    if (accept(node)) {
+                        results.emplace(value, node);
+                        if ((int)results.size() > ef)
+                            results.pop();
+                    }
+                }
+            }
+        }
+
+        std::vector<Candidate> result(results.size());
+        for (size_t i = result.size(); i-- > 0; results.pop())
+            result[i] = results.top();
+        return result;
+    }
+
+    // The heuristic of the paper: a candidate closer to an already selected neighbour than to the base node
+    // is skipped, so the links point in different directions and the graph stays navigable between clusters.
+    template <typename PairSimilarity>
+    std::vector<Candidate> SelectNeighbors(std::vector<Candidate> candidates, int count, PairSimilarity& pairSimilarity) const {
+        std::sort(candidates.begin(), candidates.end(), std::greater<Candidate>());
+        std::vector<Candidate> selected;
+        for (const Candidate& candidate : candidates) {
+            if ((int)selected.size() >= count)
+                break;
+            bool diverse = true;
+            for (const Candidate& other : selected)
+                if (pairSimilarity(candidate.second, other.second) > candidate.first) {
+                    diverse = false;
+                    break;
+                }
+            if (diverse)
+                selected.push_back(candidate);
+        }
+        return selected;
+    }
+
+    template <typename PairSimilarity>
+    void Connect(uint32_t node, uint32_t neighbor, float value, int layer, PairSimilarity& pairSimilarity) {
+        uint32_t* links = Links(node, layer);
+        if ((int)links[0] < MaxLinks(layer)) {
+            links[++links[0]] = neighbor;
+            return;
+        }
+
+        std::vector<Candidate> candidates;
+        candidates.reserve(links[0] + 1);
+        candidates.emplace_back(value, neighbor);
+        for (uint32_t i = 1; i <= links[0]; ++i)
+            candidates.emplace_back(pairSimilarity(node, links[i]), links[i]);
+
+        const std::vector<Candidate> neighbors = SelectNeighbors(std::move(candidates), MaxLinks(layer), pairSimilarity);
+        links[0] = (uint32_t)neighbors.size();
+        for (size_t i = 0; i < neighbors.size(); ++i)
+            links[i + 1] = neighbors[i].second;
+    }
+
+    int maxConnections;
+    int efConstruction;
+    std::mt19937_64 random;
+
+    std::vector<uint8_t> levels;
+    // Layer 0 links of all the nodes with a fixed stride, upper layer links of the few nodes having them
+    std::vector<uint32_t> base;
+    std::vector<std::vector<uint32_t>> upper;
+    uint32_t entryPoint = 0;
+    int maxLevel = -1;
+};
+
+}
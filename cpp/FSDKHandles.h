@@ -0,0 +1,54 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace fsdk {
+
+// Maps integer handles passed through JavaScript to native objects, the same way FaceSDK
+// refers to images and trackers. Objects are reference counted, so a handle freed on one
+// thread does not invalidate an object another thread is still using.
+template <typename T>
+class HandleRegistry {
+public:
+    unsigned int Add(std::shared_ptr<T> object) {
+        std::lock_guard<std::mutex> lock(mutex);
+        const unsigned int handle = next++;
+        objects[handle] = std::move(object);
+        return handle;
+    }
+
+    std::shared_ptr<T> Get(unsigned int handle) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        const auto it = objects.find(handle);
+        return it == objects.end() ? nullptr : it->second;
+    }
+
+    std::shared_ptr<T> Remove(unsigned int handle) {
+        std::lock_guard<std::mutex> lock(mutex);
+        const auto it = objects.find(handle);
+        if (it == objects.end())
+            return nullptr;
+        auto object = std::move(it->second);
+        objects.erase(it);
+        return object;
+    }
+
+    std::vector<std::shared_ptr<T>> All() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::vector<std::shared_ptr<T>> result;
+        result.reserve(objects.size());
+        for (const auto& item : objects)
+            result.push_back(item.second);
+        return result;
+    }
+
+private:
+    mutable std::mutex mutex;
+    std::unordered_map<unsigned int, std::shared_ptr<T>> objects;
+    unsigned int next = 1;
+};
+
+}
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace fsdk {
+
+// MurmurHash64A by Austin Appleby (public domain). Fast non-cryptographic hash used to address cached data by content.
+inline uint64_t MurmurHash64A(const void* key, size_t length, uint64_t seed) {
+    const uint64_t m = 0xc6a4a7935bd1e995ull;
+    const int r = 47;
+
+    uint64_t h = seed ^ (length * m);
+
+    const unsigned char* data = static_cast<const unsigned char*>(key);
+    const unsigned char* end = data + length / 8 * 8;
+
+    for (; data != end; data += 8) {
+        uint64_t k;
+        memcpy(&k, data, sizeof(k));
+
+        k *= m;
+        k ^= k >> r;
+        k *= m;
+
+        h ^= k;
+        h *= m;
+    }
+
+    switch (length & 7) {
+        case 7: h ^= uint64_t(data[6]) << 48; [[fallthrough]];
+        case 6: h ^= uint64_t(data[5]) << 40; [[fallthrough]];
+        case 5: h ^= uint64_t(data[4]) << 32; [[fallthrough]];
+        case 4: h ^= uint64_t(data[3]) << 24; [[fallthrough]];
+        case 3: h ^= uint64_t(data[2]) << 16; [[fallthrough]];
+        case 2: h ^= uint64_t(data[1]) << 8;  [[fallthrough]];
+        case 1: h ^= uint64_t(data[0]);
+                h *= m;
+    }
+
+    h ^= h >> r;
+    h *= m;
+    h ^= h >> r;
+
+    return h;
+}
+
+// SHA-256 (FIPS 180-4), computed incrementally. Used where a cached result must not be returned for different
+// content, since collisions of the hash above can be produced on purpose.
+class SHA256 {
+public:
+    typedef std::array<unsigned char, 32> Digest;
+
+    SHA256() {
+        static const uint32_t initial[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+        memcpy(state, initial, sizeof(state));
+    }
+
+    void Update(const void* data, size_t length) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        total += length;
+        if (buffered) {
+            const size_t count = std::min(length, sizeof(block) - buffered);
+            memcpy(block + buffered, bytes, count);
+            buffered += count;
+            bytes += count;
+            length -= count;
+            if (buffered < sizeof(block))
+                return;
+            Transform(block);
+            buffered = 0;
+        }
+        for (; length >= sizeof(block); bytes += sizeof(block), length -= sizeof(block))
+            Transform(bytes);
+        memcpy(block, bytes, length);
+        buffered = length;
+    }
+
+    Digest Finish() {
+        const uint64_t bits = (uint64_t)total * 8;
+        const unsigned char one = 0x80, zero = 0;
+        Update(&one, 1);
+        while (buffered != sizeof(block) - 8)
+            Update(&zero, 1);
+        unsigned char length[8];
+        for (int i = 0; i < 8; ++i)
+            length[i] = (unsigned char)(bits >> (56 - 8 * i));
+        Update(length, sizeof(length));
+
+        Digest digest;
+        for (int i = 0; i < 8; ++i)
+            for (int j = 0; j < 4; ++j)
+                digest[4 * i + j] = (unsigned char)(state[i] >> (24 - 8 * j));
+        return digest;
+    }
+
+private:
+    static uint32_t Rotate(uint32_t value, int bits) {
+        return (value >> bits) | (value << (32 - bits));
+    }
+
+    void Transform(const unsigned char* data) {
+        static const uint32_t k[64] = {
+            0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be,
+            0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa,
+            0x5cb0a9dc, 0x76f988da, 0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967, 0x27b70a85,
+            0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3,
+            0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070, 0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f,
+            0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+        uint32_t w[64];
+        for (int i = 0; i < 16; ++i)
+            w[i] = (uint32_t)data[4 * i] << 24 | (uint32_t)data[4 * i + 1] << 16 | (uint32_t)data[4 * i + 2] << 8 | data[4 * i + 3];
+        for (int i = 16; i < 64; ++i) {
+            const uint32_t s0 = Rotate(w[i - 15], 7) ^ Rotate(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            const uint32_t s1 = Rotate(w[i - 2], 17) ^ Rotate(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+
+        uint32_t a = state[0], b = state[1], c = state[2], d = state[3], e = state[4], f = state[5], g = state[6], h = state[7];
+        for (int i = 0; i < 64; ++i) {
+            const uint32_t t1 = h + (Rotate(e, 6) ^ Rotate(e, 11) ^ Rotate(e, 25)) + ((e & f) ^ (~e & g)) + k[i] + w[i];
+            const uint32_t t2 = (Rotate(a, 2) ^ Rotate(a, 13) ^ Rotate(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + t2;
+        }
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        state[5] += f;
+        state[6] += g;
+        state[7] += h;
+    }
+
+    uint32_t state[8];
+    unsigned char block[64];
+    size_t buffered = 0;
+    unsigned long long total = 0;
+};
+
+}
@@ -0,0 +1,245 @@
+#include "FSDKInitialization.h"
+#include "FSDKParallel.h"
+#include "FSDKTrace.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace fsdk {
+
+namespace {
+
+const int WARMUP_WIDTH = 640;
+const int WARMUP_HEIGHT = 480;
+
+// Never destroyed, so the detached initialization thread may outlive static destructors at exit.
+struct Initialization {
+    std::mutex mutex;
+    InitializationStatus status;
+};
+
+Initialization& State() {
+    static Initialization* state = new Initialization;
+    return *state;
+}
+
+void Update(void (*update)(InitializationStatus&, double), double value) {
+    std::lock_guard<std::mutex> lock(State().mutex);
+    update(State().status, value);
+}
+
+double Seconds(long long start) {
+    return (trace::Now() - start) / 1e9;
+}
+
+void ListFiles(const std::string& directory, std::vector<std::string>* files) {
+    DIR* dir = opendir(directory.c_str());
+    if (!dir)
+        return;
+
+    while (const dirent* entry = readdir(dir)) {
+        const std::string name = entry->d_name;
+        if (name == "." || name == "..")
+            continue;
+
+        const std::string path = directory + "/" + name;
+        struct stat info;
+        if (stat(path.c_str(), &info) != 0)
+            continue;
+        if (S_ISDIR(info.st_mode))
+            ListFiles(path, files);
+        else if (S_ISREG(info.st_mode) && info.st_size > 0)
+            files->push_back(path);
+    }
+    closedir(dir);
+}
+
+// Maps the file and touches every page, so it is in the page cache when FaceSDK reads it. Returns the
+// number of bytes read, 0 if the file could not be mapped.
+long long PrefetchFile(const std::string& path) {
+    const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return 0;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+        close(fd);
+        return 0;
+    }
+
+    const size_t size = (size_t)info.st_size;
+    void* address = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (address == MAP_FAILED)
+        return 0;
+
+    madvise(address, size, MADV_WILLNEED);
+    const long pageSize = sysconf(_SC_PAGESIZE);
+    const volatile unsigned char* bytes = static_cast<const unsigned char*>(address);
+    unsigned char sum = 0;
+    for (size_t offset = 0; offset < size; offset += (size_t)pageSize)
+        sum += bytes[offset];
+    (void)sum;
+
+    munmap(address, size);
+    return (long long)size;
+}
+
+void Prefetch(const InitializationParameters& parameters) {
+    trace::Span span("PrefetchModels");
+    const long long start = trace::Now();
+
+    std::vector<std::string> files;
+    size_t begin = 0;
+    while (begin <= parameters.prefetchDirectories.size()) {
+        size_t end = parameters.prefetchDirectories.find(';', begin);
+        if (end == std::string::npos)
+            end = parameters.prefetchDirectories.size();
+        if (end > begin)
+            ListFiles(parameters.prefetchDirectories.substr(begin, end - begin), &files);
+        begin = end + 1;
+    }
+
+    std::atomic<long long> bytes{0};
+    std::atomic<long long> prefetched{0};
+    ParallelFor((int)files.size(), parameters.prefetchThreads, [&](int, int index) {
+        const long long size = PrefetchFile(files[index]);
+        if (size > 0) {
+            bytes += size;
+            ++prefetched;
+        }
+    });
+
+    std::lock_guard<std::mutex> lock(State().mutex);
+    State().status.prefetchedFiles = prefetched;
+    State().status.prefetchedBytes = bytes;
+    State().status.prefetchSeconds = Seconds(start);
+}
+
+// A gray image with a darker oval where the warm-up face is placed.
+int CreateWarmUpImage(HImage* image) {
+    std::vector<unsigned char> pixels((size_t)WARMUP_WIDTH * WARMUP_HEIGHT * 3);
+    for (int y = 0; y < WARMUP_HEIGHT; ++y)
+        for (int x = 0; x < WARMUP_WIDTH; ++x) {
+            const double dx = (x - WARMUP_WIDTH / 2) / 100.0;
+            const double dy = (y - WARMUP_HEIGHT / 2) / 130.0;
+            const unsigned char value = dx * dx + dy * dy < 1 ? 150 : 200;
+            unsigned char* pixel = &pixels[((size_t)y * WARMUP_WIDTH + x) * 3];
+            pixel[0] = pixel[1] = pixel[2] = value;
+        }
+    return FSDK_LoadImageFromBuffer(image, pixels.data(), WARMUP_WIDTH, WARMUP_HEIGHT, WARMUP_WIDTH * 3, FSDK_IMAGE_COLOR_24BIT);
+}
+
+// There is no face on the warm-up image, so the stages may fail to find one, but still run their models.
+bool WarmUpFailed(int errorCode) {
+    return errorCode != FSDKE_OK && errorCode != FSDKE_FACE_NOT_FOUND;
+}
+
+int WarmUp(const InitializationParameters& parameters) {
+    trace::Span span("WarmUp");
+
+    HImage image = 0;
+    int errorCode = CreateWarmUpImage(&image);
+    if (errorCode != FSDKE_OK)
+        return errorCode;
+
+    long long start = trace::Now();
+    TFace face;
+    errorCode = FSDK_DetectFace2(image, &face);
+    Update([](InitializationStatus& status, double value) { status.detectionSeconds = value; }, Seconds(start));
+
+    if (!WarmUpFailed(errorCode)) {
+        const int cx = WARMUP_WIDTH / 2, cy = WARMUP_HEIGHT / 2;
+        face = {{{cx - 100, cy - 130}, {cx + 100, cy + 130}},
+                {{cx - 40, cy - 30}, {cx + 40, cy - 30}, {cx, cy + 15}, {cx - 30, cy + 60}, {cx + 30, cy + 60}}};
+        FSDK_FaceTemplate faceTemplate;
+        start = trace::Now();
+        errorCode = FSDK_GetFaceTemplateInRegion2(image, &face, &faceTemplate);
+        Update([](InitializationStatus& status, double value) { status.templateSeconds = value; }, Seconds(start));
+    }
+
+    if (!WarmUpFailed(errorCode)) {
+        start = trace::Now();
+        HTracker tracker = 0;
+        errorCode = FSDK_CreateTracker(&tracker);
+        if (errorCode == FSDKE_OK) {
+            int errorPosition = 0;
+            if (!parameters.trackerParameters.empty())
+                errorCode = FSDK_SetTrackerMultipleParameters(tracker, parameters.trackerParameters.c_str(), &errorPosition);
+            long long count = 0, id = 0;
+            if (errorCode == FSDKE_OK)
+                errorCode = FSDK_FeedFrame(tracker, 0, image, &count, &id, sizeof(id));
+            FSDK_FreeTracker(tracker);
+        }
+        Update([](InitializationStatus& status, double value) { status.trackerSeconds = value; }, Seconds(start));
+    }
+
+    FSDK_FreeImage(image);
+    return WarmUpFailed(errorCode) ? errorCode : FSDKE_OK;
+}
+
+int Initialize(const InitializationParameters& parameters) {
+    if (!parameters.prefetchDirectories.empty())
+        Prefetch(parameters);
+
+    long long start = trace::Now();
+    int errorCode;
+    {
+        trace::Span span("Initialize");
+        errorCode = FSDK_Initialize(nullptr);
+    }
+    Update([](InitializationStatus& status, double value) { status.initializeSeconds = value; }, Seconds(start));
+    if (errorCode != FSDKE_OK)
+        return errorCode;
+
+    if (!parameters.livenessModel.empty()) {
+        trace::Span span("LoadLivenessModel");
+        start = trace::Now();
+        errorCode = FSDK_SetParameter("LivenessModel", parameters.livenessModel.c_str());
+        Update([](InitializationStatus& status, double value) { status.livenessSeconds = value; }, Seconds(start));
+        if (errorCode != FSDKE_OK)
+            return errorCode;
+    }
+
+    return parameters.warmUp ? WarmUp(parameters) : FSDKE_OK;
+}
+
+}
+
+int StartInitialization(const InitializationParameters& Parameters) {
+    {
+        std::lock_guard<std::mutex> lock(State().mutex);
+        if (State().status.state == INITIALIZATION_RUNNING)
+            return FSDKE_FAILED;
+        if (State().status.state == INITIALIZATION_READY)
+            return FSDKE_OK;
+        State().status = InitializationStatus();
+        State().status.state = INITIALIZATION_RUNNING;
+    }
+
+    std::thread([Parameters] {
+        const long long start = trace::Now();
+        const int errorCode = Initialize(Parameters);
+
+        std::lock_guard<std::mutex> lock(State().mutex);
+        State().status.state = errorCode == FSDKE_OK ? INITIALIZATION_READY : INITIALIZATION_FAILED;
+        State().status.errorCode = errorCode;
+        State().status.totalSeconds = Seconds(start);
+    }).detach();
+    return FSDKE_OK;
+}
+
+void GetInitializationStatus(InitializationStatus* Status) {
+    std::lock_guard<std::mutex> lock(State().mutex);
+    *Status = State().status;
+}
+
+}
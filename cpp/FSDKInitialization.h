@@ -0,0 +1,56 @@
+#pragma once
+
+#include "LuxandFaceSDK.h"
+
+#include <string>
+
+namespace fsdk {
+
+struct InitializationParameters {
+    // Directories whose files (models and pipelines) are read into the page cache before FSDK_Initialize,
+    // separated by ';'. Directories that do not exist are skipped.
+    std::string prefetchDirectories;
+    // Threads reading the files, 0 for one per core.
+    int prefetchThreads = 0;
+    // Set as the LivenessModel parameter after FSDK_Initialize when not empty (the iBeta liveness addon).
+    std::string livenessModel;
+    // Runs face detection, template extraction and a tracker frame on a synthetic image, so the first real
+    // frame does not pay for the lazy initialization of the models.
+    bool warmUp = true;
+    // Parameters of the warm-up tracker. Should match the parameters of the application trackers
+    // (i.e. DetectionVersion, DetectLiveness), so the same models are warmed up.
+    std::string trackerParameters;
+};
+
+enum InitializationState {
+    INITIALIZATION_IDLE,
+    INITIALIZATION_RUNNING,
+    INITIALIZATION_READY,
+    INITIALIZATION_FAILED
+};
+
+// Stage durations are in seconds, 0 for stages not run (yet).
+struct InitializationStatus {
+    int state = INITIALIZATION_IDLE;
+    // The error of the failed stage
+    int errorCode = FSDKE_OK;
+    long long prefetchedFiles = 0;
+    long long prefetchedBytes = 0;
+    double prefetchSeconds = 0;
+    double initializeSeconds = 0;
+    double livenessSeconds = 0;
+    double detectionSeconds = 0;
+    double templateSeconds = 0;
+    double trackerSeconds = 0;
+    double totalSeconds = 0;
+};
+
+// Runs FSDK_Initialize and the stages around it on a background thread and returns immediately. Files are
+// prefetched by mapping them and touching every page on several threads, the SDK itself is initialized
+// and warmed up on one thread, since its loaders are not documented to be thread safe. Other FaceSDK
+// functions must not be called until the state is INITIALIZATION_READY. Returns FSDKE_FAILED while an
+// initialization is running; once it succeeded, later calls return FSDKE_OK without running it again.
+int StartInitialization(const InitializationParameters& Parameters);
+void GetInitializationStatus(InitializationStatus* Status);
+
+}
@@ -0,0 +1,389 @@
+#include "FSDKKeyframeTracker.h"
+#include "FSDKHandles.h"
+#include "FSDKMemoryGovernor.h"
+#include "FSDKResultSlot.h"
+#include "FSDKTrace.h"
+#include "FSDKTrackerLock.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace fsdk {
+
+namespace {
+
+// The appearance of a face is sampled on a GRID x GRID lattice over its bounding box.
+const int GRID = 16;
+
+struct Plane {
+    int width = 0;
+    int height = 0;
+    int factor = 1;
+    std::vector<unsigned char> data;
+
+    unsigned char At(int x, int y) const { return data[(size_t)y * width + x]; }
+};
+
+// Converts the image to luma, averaging factor x factor blocks.
+int LoadLuma(HImage image, int workingWidth, Plane* plane, int* imageWidth, int* imageHeight) {
+    unsigned char* data = nullptr;
+    int width = 0, height = 0, scanLine = 0;
+    FSDK_IMAGEMODE mode;
+    const int errorCode = FSDK_GetImageData(image, &data, &width, &height, &scanLine, &mode);
+    if (errorCode != FSDKE_OK)
+        return errorCode;
+
+    const int channels = mode == FSDK_IMAGE_GRAYSCALE_8BIT ? 1 : mode == FSDK_IMAGE_COLOR_24BIT ? 3 : 4;
+    const int factor = std::max(1, (width + workingWidth / 2) / std::max(1, workingWidth));
+    *imageWidth = width;
+    *imageHeight = height;
+    plane->factor = factor;
+    plane->width = width / factor;
+    plane->height = height / factor;
+    plane->data.resize((size_t)plane->width * plane->height);
+    if (plane->width == 0 || plane->height == 0)
+        return FSDKE_IMAGE_TOO_SMALL;
+
+    std::vector<unsigned int> sums(plane->width);
+    for (int y = 0; y < plane->height; ++y) {
+        std::fill(sums.begin(), sums.end(), 0u);
+        for (int row = 0; row < factor; ++row) {
+            const unsigned char* pixel = data + (long long)(y * factor + row) * scanLine;
+            for (int x = 0; x < plane->width; ++x) {
+                unsigned int sum = 0;
+                for (int column = 0; column < factor; ++column, pixel += channels)
+                    sum += channels == 1 ? pixel[0] : (77u * pixel[0] + 150u * pixel[1] + 29u * pixel[2]) >> 8;
+                sums[x] += sum;
+            }
+        }
+        for (int x = 0; x < plane->width; ++x)
+            plane->data[(size_t)y * plane->width + x] = (unsigned char)(sums[x] / (factor * factor));
+    }
+    return FSDKE_OK;
+}
+
+struct TrackedFace {
+    long long id;
+    // Position on the keyframe in image coordinates
+    TFace face;
+    FSDK_Features features;
+    bool hasFeatures;
+
+    // Keyframe appearance: zero mean, unit norm samples at the given offsets from the box origin
+    bool trackable;
+    int originX, originY, boxWidth, boxHeight;
+    int sampleX[GRID * GRID], sampleY[GRID * GRID];
+    float appearance[GRID * GRID];
+
+    // Displacement since the keyframe and per frame velocity, in plane pixels
+    float dx, dy;
+    float vx, vy;
+};
+
+void Shift(TPoint* point, float dx, float dy, int factor) {
+    point->x += (int)std::lround(dx * factor);
+    point->y += (int)std::lround(dy * factor);
+}
+
+// Samples the keyframe appearance of the face. Faces too small or too flat to be matched stay in place.
+void CaptureAppearance(const Plane& plane, TrackedFace* face) {
+    const int x0 = std::max(0, face->face.bbox.p0.x / plane.factor);
+    const int y0 = std::max(0, face->face.bbox.p0.y / plane.factor);
+    const int x1 = std::min(plane.width, face->face.bbox.p1.x / plane.factor);
+    const int y1 = std::min(plane.height, face->face.bbox.p1.y / plane.factor);
+
+    face->trackable = x1 - x0 >= 4 && y1 - y0 >= 4;
+    if (!face->trackable)
+        return;
+
+    face->originX = x0;
+    face->originY = y0;
+    face->boxWidth = x1 - x0;
+    face->boxHeight = y1 - y0;
+
+    float mean = 0;
+    for (int i = 0; i < GRID; ++i)
+        for (int j = 0; j < GRID; ++j) {
+            const int index = i * GRID + j;
+            face->sampleX[index] = (int)((j + 0.5f) * face->boxWidth / GRID);
+            face->sampleY[index] = (int)((i + 0.5f) * face->boxHeight / GRID);
+            face->appearance[index] = plane.At(x0 + face->sampleX[index], y0 + face->sampleY[index]);
+            mean += face->appearance[index];
+        }
+    mean /= GRID * GRID;
+
+    float norm = 0;
+    for (float& value : face->appearance) {
+        value -= mean;
+        norm += value * value;
+    }
+    norm = std::sqrt(norm);
+    face->trackable = norm > 1.0f;
+    for (float& value : face->appearance)
+        value /= norm;
+}
+
+// Normalized cross correlation of the keyframe appearance with the face shifted by (tx, ty). Returns -2 if
+// the shifted box leaves the plane.
+float Correlation(const Plane& plane, const TrackedFace& face, int tx, int ty) {
+    const int x = face.originX + tx, y = face.originY + ty;
+    if (x < 0 || y < 0 || x + face.boxWidth > plane.width || y + face.boxHeight > plane.height)
+        return -2;
+
+    // The appearance has zero mean, so its product with the samples does not depend on their mean
+    float sum = 0, squares = 0, product = 0;
+    for (int i = 0; i < GRID * GRID; ++i) {
+        const float value = plane.At(x + face.sampleX[i], y + face.sampleY[i]);
+        sum += value;
+        squares += value * value;
+        product += face.appearance[i] * value;
+    }
+    const float variance = squares - sum * sum / (GRID * GRID);
+    return variance > 1.0f ? product / std::sqrt(variance) : 0;
+}
+
+// Offset of the extremum of a parabola through three equally spaced values.
+float Subpixel(float left, float center, float right) {
+    const float curvature = left - 2 * center + right;
+    return left > -2 && right > -2 && curvature < 0 ? std::max(-0.5f, std::min(0.5f, 0.5f * (left - right) / curvature)) : 0;
+}
+
+// Searches around the predicted position, coarsely first, and returns the best correlation.
+float Locate(const Plane& plane, TrackedFace* face, int radius) {
+    const int px = (int)std::lround(face->dx + face->vx);
+    const int py = (int)std::lround(face->dy + face->vy);
+
+    float best = -2;
+    int bx = px, by = py;
+    for (int ty = py - radius; ty <= py + radius; ty += 2)
+        for (int tx = px - radius; tx <= px + radius; tx += 2) {
+            const float correlation = Correlation(plane, *face, tx, ty);
+            if (correlation > best) {
+                best = correlation;
+                bx = tx;
+                by = ty;
+            }
+        }
+
+    const int cx = bx, cy = by;
+    for (int ty = cy - 1; ty <= cy + 1; ++ty)
+        for (int tx = cx - 1; tx <= cx + 1; ++tx) {
+            if (tx == cx && ty == cy)
+                continue;
+            const float correlation = Correlation(plane, *face, tx, ty);
+            if (correlation > best) {
+                best = correlation;
+                bx = tx;
+                by = ty;
+            }
+        }
+    if (best <= -2)
+        return best;
+
+    const float x = bx + Subpixel(Correlation(plane, *face, bx - 1, by), best, Correlation(plane, *face, bx + 1, by));
+    const float y = by + Subpixel(Correlation(plane, *face, bx, by - 1), best, Correlation(plane, *face, bx, by + 1));
+    face->vx = x - face->dx;
+    face->vy = y - face->dy;
+    face->dx = x;
+    face->dy = y;
+    return best;
+}
+
+struct Camera {
+    bool initialized = false;
+    int imageWidth = 0;
+    int imageHeight = 0;
+    int framesSinceKeyframe = 0;
+    Plane plane;
+    std::vector<TrackedFace> faces;
+};
+
+class KeyframeTracker {
+public:
+    KeyframeTracker(HTracker tracker, const KeyframeTrackerParameters& parameters) : tracker(tracker), parameters(parameters) {}
+
+    int FeedFrame(long long cameraIdx, HImage image, long long* faceCount, long long* ids, long long maxSizeInBytes, bool* keyframe) {
+        std::lock_guard<std::mutex> lock(mutex);
+        Camera& camera = cameras[cameraIdx];
+
+        int width = 0, height = 0;
+        int errorCode;
+        {
+            trace::Span span("LoadLuma");
+            errorCode = LoadLuma(image, parameters.workingWidth, &camera.plane, &width, &height);
+        }
+        if (errorCode != FSDKE_OK)
+            return errorCode;
+
+        *keyframe = !camera.initialized || width != camera.imageWidth || height != camera.imageHeight ||
+                    camera.framesSinceKeyframe + 1 >= parameters.keyframeInterval || !Propagate(&camera);
+
+        if (*keyframe) {
+            errorCode = Keyframe(cameraIdx, image, &camera, maxSizeInBytes);
+            if (errorCode != FSDKE_OK) {
+                camera.initialized = false;
+                return errorCode;
+            }
+            camera.imageWidth = width;
+            camera.imageHeight = height;
+        } else {
+            ++camera.framesSinceKeyframe;
+        }
+
+        const long long capacity = maxSizeInBytes / (long long)sizeof(long long);
+        *faceCount = std::min((long long)camera.faces.size(), capacity);
+        for (long long i = 0; i < *faceCount; ++i)
+            ids[i] = camera.faces[i].id;
+        return FSDKE_OK;
+    }
+
+    int GetFace(long long cameraIdx, long long id, TFace* face, FSDK_Features* features) {
+        std::lock_guard<std::mutex> lock(mutex);
+        const auto camera = cameras.find(cameraIdx);
+        if (camera == cameras.end())
+            return FSDKE_ID_NOT_FOUND;
+
+        for (const TrackedFace& tracked : camera->second.faces) {
+            if (tracked.id != id)
+                continue;
+            const int factor = camera->second.plane.factor;
+            if (face) {
+                *face = tracked.face;
+                Shift(&face->bbox.p0, tracked.dx, tracked.dy, factor);
+                Shift(&face->bbox.p1, tracked.dx, tracked.dy, factor);
+                for (TPoint& point : face->features)
+                    Shift(&point, tracked.dx, tracked.dy, factor);
+            }
+            if (features) {
+                if (!tracked.hasFeatures)
+                    return FSDKE_ATTRIBUTE_NOT_DETECTED;
+                memcpy(*features, tracked.features, sizeof(FSDK_Features));
+                for (TPoint& point : *features)
+                    Shift(&point, tracked.dx, tracked.dy, factor);
+            }
+            return FSDKE_OK;
+        }
+        return FSDKE_ID_NOT_FOUND;
+    }
+
+    HTracker Tracker() const { return tracker; }
+
+private:
+    // Locates every face on the current plane. Fails when any of them is lost.
+    bool Propagate(Camera* camera) {
+        trace::Span span("PropagateFaces");
+        std::vector<TrackedFace> faces = camera->faces;
+        for (TrackedFace& face : faces)
+            if (face.trackable && Locate(camera->plane, &face, parameters.searchRadius) < parameters.minCorrelation)
+                return false;
+        camera->faces = std::move(faces);
+        return true;
+    }
+
+    int Keyframe(long long cameraIdx, HImage image, Camera* camera, long long maxSizeInBytes) {
+        std::vector<long long> ids((size_t)std::max(0LL, maxSizeInBytes / (long long)sizeof(long long)));
+        long long count = 0;
+        std::vector<TrackedFace> faces;
+        {
+            // Faces are read under the same lock, so another thread feeding the tracker cannot replace them
+            const TrackerLock lock(tracker, TrackerLock::EXCLUSIVE);
+            int errorCode;
+            {
+                trace::Span span("FeedFrame");
+                errorCode = FSDK_FeedFrame(tracker, cameraIdx, image, &count, ids.data(), maxSizeInBytes);
+            }
+            if (errorCode != FSDKE_OK)
+                return errorCode;
+
+            faces.reserve((size_t)count);
+            for (long long i = 0; i < count && i < (long long)ids.size(); ++i) {
+                TrackedFace face = {};
+                face.id = ids[i];
+                if (FSDK_GetTrackerFace(tracker, cameraIdx, face.id, &face.face) != FSDKE_OK) {
+                    // Trackers using the original detection report face positions only
+                    TFacePosition position;
+                    if (FSDK_GetTrackerFacePosition(tracker, cameraIdx, face.id, &position) != FSDKE_OK)
+                        continue;
+                    face.face.bbox.p0 = {position.xc - position.w / 2, position.yc - position.w * 6 / 10};
+                    face.face.bbox.p1 = {position.xc + position.w / 2, position.yc + position.w * 6 / 10};
+                }
+                face.hasFeatures = FSDK_GetTrackerFacialFeatures(tracker, cameraIdx, face.id, &face.features) == FSDKE_OK;
+                faces.push_back(face);
+            }
+        }
+
+        for (TrackedFace& face : faces) {
+            CaptureAppearance(camera->plane, &face);
+
+            // Motion of a face that keeps its ID carries over to the next frames
+            for (const TrackedFace& previous : camera->faces)
+                if (previous.id == face.id) {
+                    face.vx = previous.vx;
+                    face.vy = previous.vy;
+                }
+        }
+
+        camera->faces = std::move(faces);
+        camera->framesSinceKeyframe = 0;
+        camera->initialized = true;
+        return FSDKE_OK;
+    }
+
+    const HTracker tracker;
+    const KeyframeTrackerParameters parameters;
+
+    std::mutex mutex;
+    std::map<long long, Camera> cameras;
+};
+
+HandleRegistry<KeyframeTracker>& KeyframeTrackers() {
+    static HandleRegistry<KeyframeTracker> trackers;
+    return trackers;
+}
+
+}
+
+int CreateKeyframeTracker(HTracker Tracker, const KeyframeTrackerParameters& Parameters, HKeyframeTracker* KeyframeTracker) {
+    if (!KeyframeTracker || Parameters.keyframeInterval < 1 || Parameters.workingWidth < 16 || Parameters.searchRadius < 1)
+        return FSDKE_INVALID_ARGUMENT;
+
+    *KeyframeTracker = KeyframeTrackers().Add(std::make_shared<class KeyframeTracker>(Tracker, Parameters));
+    return FSDKE_OK;
+}
+
+int FreeKeyframeTracker(HKeyframeTracker KeyframeTracker) {
+    return KeyframeTrackers().Remove(KeyframeTracker) ? FSDKE_OK : FSDKE_INVALID_ARGUMENT;
+}
+
+int KeyframeTrackerFeedFrame(HKeyframeTracker KeyframeTracker, long long CameraIdx, HImage Image, long long* FaceCount, long long* IDs,
+                             long long MaxSizeInBytes, bool* Keyframe) {
+    const auto tracker = KeyframeTrackers().Get(KeyframeTracker);
+    if (!tracker || !FaceCount || !Keyframe || (!IDs && MaxSizeInBytes > 0))
+        return FSDKE_INVALID_ARGUMENT;
+    const int errorCode = tracker->FeedFrame(CameraIdx, Image, FaceCount, IDs, MaxSizeInBytes, Keyframe);
+    // Faces moved between keyframes are seen as well
+    MemoryGovernorFrameFed(tracker->Tracker(), errorCode, IDs, *FaceCount);
+    ResultSlotFrameFed(tracker->Tracker(), CameraIdx, errorCode, IDs, *FaceCount,
+                       [&](long long id, TFace* face) { return tracker->GetFace(CameraIdx, id, face, nullptr); });
+    return errorCode;
+}
+
+int KeyframeTrackerGetFace(HKeyframeTracker KeyframeTracker, long long CameraIdx, long long ID, TFace* Face) {
+    const auto tracker = KeyframeTrackers().Get(KeyframeTracker);
+    if (!tracker || !Face)
+        return FSDKE_INVALID_ARGUMENT;
+    return tracker->GetFace(CameraIdx, ID, Face, nullptr);
+}
+
+int KeyframeTrackerGetFacialFeatures(HKeyframeTracker KeyframeTracker, long long CameraIdx, long long ID, FSDK_Features* FacialFeatures) {
+    const auto tracker = KeyframeTrackers().Get(KeyframeTracker);
+    if (!tracker || !FacialFeatures)
+        return FSDKE_INVALID_ARGUMENT;
+    return tracker->GetFace(CameraIdx, ID, nullptr, FacialFeatures);
+}
+
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "LuxandFaceSDK.h"
+
+namespace fsdk {
+
+typedef unsigned int HKeyframeTracker;
+
+struct KeyframeTrackerParameters {
+    // FSDK_FeedFrame runs on every KeyframeInterval-th frame, faces are propagated on the frames in between.
+    int keyframeInterval = 5;
+    // Faces are matched on the luma plane downscaled by an integer factor to about this width.
+    int workingWidth = 320;
+    // The maximal displacement of a face between two frames in pixels of the downscaled plane.
+    int searchRadius = 12;
+    // A frame where the correlation of any face with its keyframe appearance drops below the threshold
+    // becomes a keyframe.
+    float minCorrelation = 0.7f;
+};
+
+// Runs the full tracker on keyframes only. On the frames in between the faces found on the last keyframe
+// are located by normalized cross correlation of their keyframe appearance on the luma plane, and their
+// bounding boxes and facial features are shifted accordingly. Face IDs only change on keyframes.
+int CreateKeyframeTracker(HTracker Tracker, const KeyframeTrackerParameters& Parameters, HKeyframeTracker* KeyframeTracker);
+int FreeKeyframeTracker(HKeyframeTracker KeyframeTracker);
+
+// Follows FSDK_FeedFrame. Keyframe tells whether FSDK_FeedFrame was run on the frame.
+int KeyframeTrackerFeedFrame(HKeyframeTracker KeyframeTracker, long long CameraIdx, HImage Image, long long* FaceCount, long long* IDs,
+                             long long MaxSizeInBytes, bool* Keyframe);
+// Return the face and the facial features of the ID on the last frame fed to the camera.
+int KeyframeTrackerGetFace(HKeyframeTracker KeyframeTracker, long long CameraIdx, long long ID, TFace* Face);
+int KeyframeTrackerGetFacialFeatures(HKeyframeTracker KeyframeTracker, long long CameraIdx, long long ID, FSDK_Features* FacialFeatures);
+
+}
@@ -0,0 +1,348 @@
+#include "FSDKMemoryGovernor.h"
+#include "FSDKThumbnailStore.h"
+#include "FSDKTrace.h"
+#include "FSDKTrackerLock.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace fsdk {
+
+namespace {
+
+// Serializes locking and naming of IDs with their eviction. Taken after the tracker lock.
+std::mutex idsMutex;
+std::unordered_map<HTracker, std::unordered_set<long long>> lockedIDs;
+
+// Must be called with the tracker lock and idsMutex held.
+bool IsProtected(HTracker tracker, long long id) {
+    const auto locked = lockedIDs.find(tracker);
+    if (locked != lockedIDs.end() && locked->second.count(id))
+        return true;
+    // An ID whose name cannot be read is kept as well
+    char name[1024] = {};
+    return FSDK_GetName(tracker, id, name, sizeof(name)) != FSDKE_OK || name[0];
+}
+
+long long TemplateBudget(HTracker tracker, long long maxTemplates) {
+    if (maxTemplates > 0)
+        return maxTemplates;
+    char value[64] = {};
+    const TrackerLock lock(tracker, TrackerLock::SHARED);
+    if (FSDK_GetTrackerParameter(tracker, "MemoryLimit", value, sizeof(value)) != FSDKE_OK)
+        return 0;
+    return atoll(value) * 9 / 10;
+}
+
+struct TrackedID {
+    long long id;
+    long long templates;
+    long long lastSeen;
+    bool isProtected;
+};
+
+class MemoryGovernor {
+public:
+    MemoryGovernor(HTracker tracker, const MemoryGovernorParameters& parameters)
+        : tracker(tracker), parameters(parameters), thread([this] { Run(); }) {}
+
+    ~MemoryGovernor() { Stop(); }
+
+    void SetParameters(const MemoryGovernorParameters& value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        parameters = value;
+        wake = true;
+        condition.notify_one();
+    }
+
+    void FrameFed(int errorCode, const long long* ids, long long count) {
+        const long long now = trace::Now();
+        std::lock_guard<std::mutex> lock(mutex);
+        for (long long i = 0; i < count; ++i)
+            lastSeen[ids[i]] = now;
+        if (errorCode == FSDKE_INSUFFICIENT_TRACKER_MEMORY_LIMIT) {
+            wake = true;
+            condition.notify_one();
+        }
+    }
+
+    void Clear() {
+        std::lock_guard<std::mutex> lock(mutex);
+        lastSeen.clear();
+    }
+
+    MemoryGovernorStatistics Statistics() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return statistics;
+    }
+
+    // Joins the thread, so the tracker is never accessed after the governor is stopped.
+    void Stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopped = true;
+            condition.notify_one();
+        }
+        if (thread.joinable())
+            thread.join();
+    }
+
+private:
+    void Run() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (!stopped) {
+            condition.wait_for(lock, std::chrono::milliseconds(parameters.intervalMs), [this] { return stopped || wake; });
+            if (stopped)
+                break;
+            wake = false;
+            const MemoryGovernorParameters current = parameters;
+            lock.unlock();
+            Sweep(current);
+            lock.lock();
+        }
+    }
+
+    void Sweep(const MemoryGovernorParameters& parameters) {
+        trace::Span span("MemoryGovernorSweep");
+
+        std::vector<TrackedID> tracked;
+        long long templates = 0;
+        {
+            // Frames are not fed while the IDs are listed, so they are consistent with each other
+            const TrackerLock trackerLock(tracker, TrackerLock::SHARED);
+            long long count = 0;
+            if (FSDK_GetTrackerIDsCount(tracker, &count) != FSDKE_OK)
+                return;
+            std::vector<long long> ids((size_t)count);
+            if (count > 0 && FSDK_GetTrackerAllIDs(tracker, ids.data(), count * (long long)sizeof(long long)) != FSDKE_OK)
+                return;
+
+            tracked.reserve(ids.size());
+            for (const long long id : ids) {
+                TrackedID item = {id, 0, 0, false};
+                if (FSDK_GetTrackerFaceIDsCountForID(tracker, id, &item.templates) != FSDKE_OK)
+                    continue;
+                templates += item.templates;
+                tracked.push_back(item);
+            }
+
+            std::lock_guard<std::mutex> lock(idsMutex);
+            for (TrackedID& item : tracked)
+                item.isProtected = IsProtected(tracker, item.id);
+        }
+
+        UpdateLastSeen(&tracked);
+
+        const long long budget = TemplateBudget(tracker, parameters.maxTemplates);
+        long long evictedIDs = 0, evictedTemplates = 0;
+        if (budget > 0 && templates > budget) {
+            const long long target = (long long)(budget * parameters.targetRatio);
+            const long long idleSince = trace::Now() - (long long)(parameters.minIdleSeconds * 1e9);
+
+            std::vector<const TrackedID*> candidates;
+            for (const TrackedID& item : tracked)
+                if (!item.isProtected && item.lastSeen <= idleSince)
+                    candidates.push_back(&item);
+            // IDs seen at the same time are evicted from the oldest one
+            std::sort(candidates.begin(), candidates.end(), [](const TrackedID* a, const TrackedID* b) {
+                return a->lastSeen != b->lastSeen ? a->lastSeen < b->lastSeen : a->id < b->id;
+            });
+
+            // IDs the tracker merged since they were listed fail to purge and are skipped
+            std::vector<long long> faceIDs;
+            for (const TrackedID* item : candidates) {
+                if (templates <= target)
+                    break;
+                {
+                    const TrackerLock trackerLock(tracker, TrackerLock::EXCLUSIVE);
+                    std::lock_guard<std::mutex> lock(idsMutex);
+                    if (IsProtected(tracker, item->id) || GetTrackerFaceIDs(tracker, item->id, &faceIDs) != FSDKE_OK ||
+                        FSDK_PurgeID(tracker, item->id) != FSDKE_OK)
+                        continue;
+                }
+                // The faces are gone from the tracker, so their thumbnails would never be read again
+                DeleteTrackerThumbnails(tracker, faceIDs);
+                templates -= item->templates;
+                ++evictedIDs;
+                evictedTemplates += item->templates;
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        statistics.ids = (long long)tracked.size() - evictedIDs;
+        statistics.templates = templates;
+        statistics.protectedIDs = std::count_if(tracked.begin(), tracked.end(), [](const TrackedID& item) { return item.isProtected; });
+        statistics.evictedIDs += evictedIDs;
+        statistics.evictedTemplates += evictedTemplates;
+        ++statistics.sweeps;
+    }
+
+    // Carries the last seen time of IDs merged by the tracker over to the IDs they were merged into and
+    // stamps IDs the governor did not know with the current time.
+    void UpdateLastSeen(std::vector<TrackedID>* tracked) {
+        std::unordered_map<long long, long long> seen;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            seen.swap(lastSeen);
+        }
+
+        std::unordered_set<long long> present;
+        for (const TrackedID& item : *tracked)
+            present.insert(item.id);
+        std::unordered_map<long long, long long> reassigned;
+        const TrackerLock trackerLock(tracker, TrackerLock::SHARED);
+        for (const auto& entry : seen) {
+            long long id = entry.first;
+            if (present.count(id) || FSDK_GetIDReassignment(tracker, entry.first, &id) != FSDKE_OK || !present.count(id))
+                continue;
+            reassigned[id] = std::max(reassigned[id], entry.second);
+        }
+
+        const long long now = trace::Now();
+        std::lock_guard<std::mutex> lock(mutex);
+        // Frames fed during the sweep were recorded into the emptied map and are the most recent
+        for (TrackedID& item : *tracked) {
+            const auto fed = lastSeen.find(item.id);
+            const auto known = seen.find(item.id);
+            const auto merged = reassigned.find(item.id);
+            if (fed != lastSeen.end()) {
+                item.lastSeen = fed->second;
+                continue;
+            }
+            item.lastSeen = known != seen.end() ? known->second : merged != reassigned.end() ? 0 : now;
+            if (merged != reassigned.end())
+                item.lastSeen = std::max(item.lastSeen, merged->second);
+            lastSeen[item.id] = item.lastSeen;
+        }
+    }
+
+    const HTracker tracker;
+    MemoryGovernorParameters parameters;
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool stopped = false;
+    bool wake = true;
+    std::unordered_map<long long, long long> lastSeen;
+    MemoryGovernorStatistics statistics = {};
+
+    std::thread thread;
+};
+
+std::mutex governorsMutex;
+std::unordered_map<HTracker, std::shared_ptr<MemoryGovernor>> governors;
+
+std::shared_ptr<MemoryGovernor> TrackerGovernor(HTracker tracker) {
+    std::lock_guard<std::mutex> lock(governorsMutex);
+    const auto it = governors.find(tracker);
+    return it == governors.end() ? nullptr : it->second;
+}
+
+}
+
+int AttachMemoryGovernor(HTracker Tracker, const MemoryGovernorParameters& Parameters) {
+    if (Parameters.maxTemplates < 0 || !(Parameters.targetRatio > 0 && Parameters.targetRatio <= 1) || Parameters.minIdleSeconds < 0 ||
+        Parameters.intervalMs < 1)
+        return FSDKE_INVALID_ARGUMENT;
+
+    long long count = 0;
+    int errorCode;
+    {
+        const TrackerLock lock(Tracker, TrackerLock::SHARED);
+        errorCode = FSDK_GetTrackerIDsCount(Tracker, &count);
+    }
+    if (errorCode != FSDKE_OK)
+        return errorCode;
+
+    std::lock_guard<std::mutex> lock(governorsMutex);
+    auto& governor = governors[Tracker];
+    if (governor)
+        governor->SetParameters(Parameters);
+    else
+        governor = std::make_shared<MemoryGovernor>(Tracker, Parameters);
+    return FSDKE_OK;
+}
+
+int DetachMemoryGovernor(HTracker Tracker) {
+    std::shared_ptr<MemoryGovernor> governor;
+    {
+        std::lock_guard<std::mutex> lock(governorsMutex);
+        const auto it = governors.find(Tracker);
+        if (it == governors.end())
+            return FSDKE_INVALID_ARGUMENT;
+        governor = std::move(it->second);
+        governors.erase(it);
+    }
+    // Frame callbacks may still hold the governor, but its thread must not outlive the tracker
+    governor->Stop();
+    return FSDKE_OK;
+}
+
+int GetMemoryGovernorStatistics(HTracker Tracker, MemoryGovernorStatistics* Statistics) {
+    if (!Statistics)
+        return FSDKE_INVALID_ARGUMENT;
+    const auto governor = TrackerGovernor(Tracker);
+    if (!governor)
+        return FSDKE_INVALID_ARGUMENT;
+    *Statistics = governor->Statistics();
+    return FSDKE_OK;
+}
+
+void MemoryGovernorFrameFed(HTracker Tracker, int ErrorCode, const long long* IDs, long long Count) {
+    const auto governor = TrackerGovernor(Tracker);
+    if (governor)
+        governor->FrameFed(ErrorCode, IDs, ErrorCode == FSDKE_OK ? Count : 0);
+}
+
+int LockTrackerID(HTracker Tracker, long long ID) {
+    const TrackerLock trackerLock(Tracker, TrackerLock::EXCLUSIVE);
+    std::lock_guard<std::mutex> lock(idsMutex);
+    const int errorCode = FSDK_LockID(Tracker, ID);
+    if (errorCode == FSDKE_OK)
+        lockedIDs[Tracker].insert(ID);
+    return errorCode;
+}
+
+int UnlockTrackerID(HTracker Tracker, long long ID) {
+    const TrackerLock trackerLock(Tracker, TrackerLock::EXCLUSIVE);
+    std::lock_guard<std::mutex> lock(idsMutex);
+    const int errorCode = FSDK_UnlockID(Tracker, ID);
+    const auto locked = lockedIDs.find(Tracker);
+    if (errorCode == FSDKE_OK && locked != lockedIDs.end()) {
+        locked->second.erase(ID);
+        if (locked->second.empty())
+            lockedIDs.erase(locked);
+    }
+    return errorCode;
+}
+
+int SetTrackerName(HTracker Tracker, long long ID, const char* Name) {
+    const TrackerLock trackerLock(Tracker, TrackerLock::EXCLUSIVE);
+    std::lock_guard<std::mutex> lock(idsMutex);
+    return FSDK_SetName(Tracker, ID, Name);
+}
+
+void ClearTrackerIDs(HTracker Tracker) {
+    {
+        std::lock_guard<std::mutex> lock(idsMutex);
+        lockedIDs.erase(Tracker);
+    }
+    const auto governor = TrackerGovernor(Tracker);
+    if (governor)
+        governor->Clear();
+}
+
+void ReleaseTrackerMemoryGovernor(HTracker Tracker) {
+    DetachMemoryGovernor(Tracker);
+    std::lock_guard<std::mutex> lock(idsMutex);
+    lockedIDs.erase(Tracker);
+}
+
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "LuxandFaceSDK.h"
+
+namespace fsdk {
+
+struct MemoryGovernorParameters {
+    // The number of face templates the tracker may keep. 0 takes 90% of the MemoryLimit tracker parameter,
+    // so eviction starts before FSDK_FeedFrame fails with FSDKE_INSUFFICIENT_TRACKER_MEMORY_LIMIT.
+    long long maxTemplates = 0;
+    // Once over the budget, IDs are evicted until the tracker keeps this share of it.
+    float targetRatio = 0.8f;
+    // IDs seen more recently than this are never evicted, even if the tracker stays over the budget.
+    double minIdleSeconds = 10;
+    // How often the tracker memory is checked in the background.
+    int intervalMs = 1000;
+};
+
+struct MemoryGovernorStatistics {
+    long long ids;
+    long long templates;
+    // Named and locked IDs, which are never evicted
+    long long protectedIDs;
+    long long evictedIDs;
+    long long evictedTemplates;
+    long long sweeps;
+};
+
+// Keeps the tracker memory within a budget of face templates. A background thread periodically counts the
+// templates of every ID and, when there are too many, purges the least recently seen IDs that have no name
+// and are not locked. IDs are seen when they are returned by FSDK_FeedFrame, which is reported with
+// MemoryGovernorFrameFed, IDs already in the tracker when the governor is attached count as seen at that
+// time. Attaching a governor to a tracker that has one replaces its parameters.
+int AttachMemoryGovernor(HTracker Tracker, const MemoryGovernorParameters& Parameters);
+int DetachMemoryGovernor(HTracker Tracker);
+int GetMemoryGovernorStatistics(HTracker Tracker, MemoryGovernorStatistics* Statistics);
+
+// Must be called after every FSDK_FeedFrame on the tracker with its result. Wakes the governor at once
+// when the tracker runs out of memory.
+void MemoryGovernorFrameFed(HTracker Tracker, int ErrorCode, const long long* IDs, long long Count);
+
+// Follow FSDK_LockID, FSDK_UnlockID and FSDK_SetName. FaceSDK cannot tell whether an ID is locked, so
+// IDs must be locked through these functions to be kept by the governor. They are serialized with
+// evictions, so an ID is never purged after it was locked or named.
+int LockTrackerID(HTracker Tracker, long long ID);
+int UnlockTrackerID(HTracker Tracker, long long ID);
+int SetTrackerName(HTracker Tracker, long long ID, const char* Name);
+
+// Must be called when the tracker is cleared (forgets its locked IDs) and before it is freed (also stops
+// its governor).
+void ClearTrackerIDs(HTracker Tracker);
+void ReleaseTrackerMemoryGovernor(HTracker Tracker);
+
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace fsdk {
+
+inline int ResolveThreadCount(int threads, int tasks) {
+    if (threads <= 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    return std::max(1, std::min(threads, tasks));
+}
+
+// Runs function(worker, index) for every index in [0, count) on up to `threads` threads.
+// Indices are handed out dynamically, so uneven tasks are balanced between the workers.
+// The calling thread participates as worker 0.
+template <typename Function>
+void ParallelFor(int count, int threads, Function&& function) {
+    if (count <= 0)
+        return;
+
+    const int workers = ResolveThreadCount(threads, count);
+    std::atomic<int> next{0};
+    auto run = [&](int worker) {
+        for (int index = next++; index < count; index = next++)
+            function(worker, index);
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(workers - 1);
+    for (int worker = 1; worker < workers; ++worker)
+        pool.emplace_back(run, worker);
+    run(0);
+    for (auto& thread : pool)
+        thread.join();
+}
+
+}
@@ -0,0 +1,101 @@
+#include "FSDKParameters.h"
+#include "FSDKHash.h"
+
+#include <algorithm>
+#include <cctype>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace fsdk {
+
+namespace {
+
+std::mutex mutex;
+std::map<std::string, std::string> parameters;
+uint64_t parametersHash = 0;
+
+std::string Trim(const std::string& text) {
+    const size_t begin = text.find_first_not_of(" \t\r\n");
+    const size_t end = text.find_last_not_of(" \t\r\n");
+    return begin == std::string::npos ? std::string() : text.substr(begin, end - begin + 1);
+}
+
+void RecordLocked(const std::string& name, const std::string& value) {
+    std::string key = Trim(name);
+    for (char& c : key)
+        c = (char)std::tolower((unsigned char)c);
+    if (!key.empty())
+        parameters[key] = Trim(value);
+}
+
+// The map is ordered, so the text and its hash do not depend on the order parameters were set in
+void UpdateHashLocked() {
+    std::string text;
+    for (const auto& item : parameters)
+        text += item.first + "=" + item.second + "\n";
+    parametersHash = MurmurHash64A(text.data(), text.size(), 0);
+}
+
+void Record(const std::string& name, const std::string& value) {
+    std::lock_guard<std::mutex> lock(mutex);
+    RecordLocked(name, value);
+    UpdateHashLocked();
+}
+
+}
+
+int SetParameter(const char* Name, const char* Value) {
+    const int errorCode = FSDK_SetParameter(Name, Value);
+    if (errorCode == FSDKE_OK)
+        Record(Name, Value);
+    return errorCode;
+}
+
+int SetParameters(const char* Parameters, int* ErrorPosition) {
+    if (!Parameters || !ErrorPosition)
+        return FSDK_SetParameters(Parameters, ErrorPosition);
+
+    *ErrorPosition = 0;
+    const int errorCode = FSDK_SetParameters(Parameters, ErrorPosition);
+    const std::string text(Parameters);
+    const size_t applied = errorCode == FSDKE_OK ? text.size() : (size_t)std::max(0, std::min(*ErrorPosition, (int)text.size()));
+
+    std::lock_guard<std::mutex> lock(mutex);
+    for (size_t begin = 0; begin < text.size();) {
+        size_t end = text.find(';', begin);
+        if (end == std::string::npos)
+            end = text.size();
+        if (end > applied)
+            break;
+        const std::string pair = text.substr(begin, end - begin);
+        const size_t separator = pair.find('=');
+        if (separator != std::string::npos)
+            RecordLocked(pair.substr(0, separator), pair.substr(separator + 1));
+        begin = end + 1;
+    }
+    UpdateHashLocked();
+    return errorCode;
+}
+
+int SetFaceDetectionParameters(bool HandleArbitraryRotations, bool DetermineFaceRotationAngle, int InternalResizeWidth) {
+    const int errorCode = FSDK_SetFaceDetectionParameters(HandleArbitraryRotations, DetermineFaceRotationAngle, InternalResizeWidth);
+    if (errorCode == FSDKE_OK)
+        Record("FaceDetectionParameters", std::to_string(HandleArbitraryRotations) + "," + std::to_string(DetermineFaceRotationAngle) + "," +
+                                              std::to_string(InternalResizeWidth));
+    return errorCode;
+}
+
+int SetFaceDetectionThreshold(int Threshold) {
+    const int errorCode = FSDK_SetFaceDetectionThreshold(Threshold);
+    if (errorCode == FSDKE_OK)
+        Record("FaceDetectionThreshold", std::to_string(Threshold));
+    return errorCode;
+}
+
+uint64_t ParametersHash() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return parametersHash;
+}
+
+}
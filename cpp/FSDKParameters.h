@@ -0,0 +1,24 @@
+#pragma once
+
+#include "LuxandFaceSDK.h"
+
+#include <cstdint>
+
+// FaceSDK cannot report its global parameters back, so the module sets them through these wrappers, which
+// record every value set successfully. Results computed natively (i.e. by the template cache) use the
+// recorded values to tell which parameters they were computed with. Parameters set by calling the FSDK_
+// functions directly are not seen.
+namespace fsdk {
+
+int SetParameter(const char* Name, const char* Value);
+// Parameters is a ';' separated list of Name=Value pairs, as FSDK_SetParameters takes. When setting fails,
+// the pairs before ErrorPosition are still recorded.
+int SetParameters(const char* Parameters, int* ErrorPosition);
+int SetFaceDetectionParameters(bool HandleArbitraryRotations, bool DetermineFaceRotationAngle, int InternalResizeWidth);
+int SetFaceDetectionThreshold(int Threshold);
+
+// A hash of the last value of every recorded parameter, 0 until a parameter is set. Names are compared
+// case-insensitively and the order parameters were set in does not matter.
+uint64_t ParametersHash();
+
+}
@@ -0,0 +1,211 @@
+#include "FSDKQualityFilter.h"
+#include "FSDKHandles.h"
+#include "FSDKTrace.h"
+#include "FSDKTrackerLock.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace fsdk {
+
+namespace {
+
+// The face is resampled to SAMPLE_SIZE x SAMPLE_SIZE cells for brightness and clipping, so they do not depend on the face size.
+const int SAMPLE_SIZE = 64;
+// At most READS_PER_CELL x READS_PER_CELL pixels are averaged into a cell.
+const int READS_PER_CELL = 4;
+// The Laplacian is computed on neighbouring pixels at up to LAPLACIAN_SIZE x LAPLACIAN_SIZE points of the face.
+const int LAPLACIAN_SIZE = 128;
+// The part of the bounding box cut off at each side, so the background contributes less.
+const double MARGIN = 0.1;
+const int DARK_LUMA = 16;
+const int BRIGHT_LUMA = 239;
+// The offset of the nose from the middle of the eyes, relative to the eye distance, of a face turned by 90 degrees.
+const double PROFILE_NOSE_OFFSET = 0.6;
+
+struct QualityFilter {
+    explicit QualityFilter(const QualityFilterParameters& parameters) : parameters(parameters) {}
+
+    const QualityFilterParameters parameters;
+};
+
+HandleRegistry<QualityFilter>& QualityFilters() {
+    static HandleRegistry<QualityFilter> filters;
+    return filters;
+}
+
+// The central part of the face bounding box, read in place from the image.
+struct FaceRegion {
+    const unsigned char* data;
+    int scanLine;
+    int channels;
+    int left, top, right, bottom;
+
+    int Luma(int x, int y) const {
+        const unsigned char* pixel = data + (long long)y * scanLine + x * channels;
+        return channels == 1 ? pixel[0] : (77 * pixel[0] + 150 * pixel[1] + 29 * pixel[2]) >> 8;
+    }
+};
+
+int GetFaceRegion(HImage image, const TFace& face, FaceRegion* region) {
+    unsigned char* data = nullptr;
+    int width = 0, height = 0, scanLine = 0;
+    FSDK_IMAGEMODE mode;
+    const int errorCode = FSDK_GetImageData(image, &data, &width, &height, &scanLine, &mode);
+    if (errorCode != FSDKE_OK)
+        return errorCode;
+
+    const int faceWidth = face.bbox.p1.x - face.bbox.p0.x;
+    const int faceHeight = face.bbox.p1.y - face.bbox.p0.y;
+    region->data = data;
+    region->scanLine = scanLine;
+    region->channels = mode == FSDK_IMAGE_GRAYSCALE_8BIT ? 1 : mode == FSDK_IMAGE_COLOR_24BIT ? 3 : 4;
+    region->left = std::max(0, face.bbox.p0.x + (int)(faceWidth * MARGIN));
+    region->top = std::max(0, face.bbox.p0.y + (int)(faceHeight * MARGIN));
+    region->right = std::min(width, face.bbox.p1.x - (int)(faceWidth * MARGIN));
+    region->bottom = std::min(height, face.bbox.p1.y - (int)(faceHeight * MARGIN));
+    return region->right > region->left && region->bottom > region->top ? FSDKE_OK : FSDKE_INVALID_ARGUMENT;
+}
+
+// Resamples the region into SAMPLE_SIZE x SAMPLE_SIZE luma cells.
+void SampleLuma(const FaceRegion& region, float* samples) {
+    const int left = region.left, top = region.top, right = region.right, bottom = region.bottom;
+    for (int cellY = 0; cellY < SAMPLE_SIZE; ++cellY) {
+        const int y0 = top + (bottom - top) * cellY / SAMPLE_SIZE;
+        const int y1 = std::max(y0 + 1, top + (bottom - top) * (cellY + 1) / SAMPLE_SIZE);
+        const int stepY = std::max(1, (y1 - y0) / READS_PER_CELL);
+        for (int cellX = 0; cellX < SAMPLE_SIZE; ++cellX) {
+            const int x0 = left + (right - left) * cellX / SAMPLE_SIZE;
+            const int x1 = std::max(x0 + 1, left + (right - left) * (cellX + 1) / SAMPLE_SIZE);
+            const int stepX = std::max(1, (x1 - x0) / READS_PER_CELL);
+
+            unsigned int sum = 0, count = 0;
+            for (int y = y0; y < y1; y += stepY)
+                for (int x = x0; x < x1; x += stepX, ++count)
+                    sum += region.Luma(x, y);
+            samples[cellY * SAMPLE_SIZE + cellX] = (float)sum / count;
+        }
+    }
+}
+
+// The variance of the Laplacian of the full resolution luma. Averaging or resampling first would remove the
+// highest frequencies, where blur shows first, so every Laplacian reads the pixel and its four neighbours and
+// only the points it is computed at are spread over the region.
+double LaplacianVariance(const FaceRegion& region) {
+    const int width = region.right - region.left - 2, height = region.bottom - region.top - 2;
+    if (width <= 0 || height <= 0)
+        return 0;
+
+    const int columns = std::min(width, LAPLACIAN_SIZE), rows = std::min(height, LAPLACIAN_SIZE);
+    double laplacianSum = 0, laplacianSquares = 0;
+    for (int row = 0; row < rows; ++row) {
+        const int y = region.top + 1 + (int)((long long)height * row / rows);
+        for (int column = 0; column < columns; ++column) {
+            const int x = region.left + 1 + (int)((long long)width * column / columns);
+            const double laplacian = 4.0 * region.Luma(x, y) - region.Luma(x - 1, y) - region.Luma(x + 1, y) - region.Luma(x, y - 1) - region.Luma(x, y + 1);
+            laplacianSum += laplacian;
+            laplacianSquares += laplacian * laplacian;
+        }
+    }
+    const double laplacians = (double)columns * rows;
+    const double laplacianMean = laplacianSum / laplacians;
+    return laplacianSquares / laplacians - laplacianMean * laplacianMean;
+}
+
+int Evaluate(const QualityFilterParameters& parameters, HImage image, const TFace& face, QualityScores* scores) {
+    trace::Span span("EvaluateFaceQuality");
+
+    FaceRegion region;
+    const int errorCode = GetFaceRegion(image, face, &region);
+    if (errorCode != FSDKE_OK)
+        return errorCode;
+
+    float samples[SAMPLE_SIZE * SAMPLE_SIZE];
+    SampleLuma(region, samples);
+
+    double sum = 0;
+    int dark = 0, bright = 0;
+    for (const float sample : samples) {
+        sum += sample;
+        dark += sample < DARK_LUMA;
+        bright += sample > BRIGHT_LUMA;
+    }
+
+    // The eyes are the first two landmarks and the nose tip the third one
+    const double eyesX = face.features[1].x - face.features[0].x;
+    const double eyesY = face.features[1].y - face.features[0].y;
+    const double eyeDistance = std::sqrt(eyesX * eyesX + eyesY * eyesY);
+    const double noseX = face.features[2].x - (face.features[0].x + face.features[1].x) / 2.0;
+    const double noseY = face.features[2].y - (face.features[0].y + face.features[1].y) / 2.0;
+    const double noseOffset = eyeDistance > 0 ? (noseX * eyesX + noseY * eyesY) / (eyeDistance * eyeDistance) : 0;
+
+    scores->sharpness = LaplacianVariance(region);
+    scores->brightness = sum / (SAMPLE_SIZE * SAMPLE_SIZE);
+    scores->darkFraction = (double)dark / (SAMPLE_SIZE * SAMPLE_SIZE);
+    scores->brightFraction = (double)bright / (SAMPLE_SIZE * SAMPLE_SIZE);
+    scores->eyeDistance = eyeDistance;
+    scores->roll = std::atan2(eyesY, eyesX) * 180.0 / M_PI;
+    scores->yaw = std::asin(std::max(-1.0, std::min(1.0, noseOffset / PROFILE_NOSE_OFFSET))) * 180.0 / M_PI;
+
+    scores->failed = 0;
+    if (scores->sharpness < parameters.minSharpness)
+        scores->failed |= QUALITY_SHARPNESS;
+    if (scores->brightness < parameters.minBrightness || scores->brightness > parameters.maxBrightness)
+        scores->failed |= QUALITY_BRIGHTNESS;
+    if (scores->darkFraction > parameters.maxClippedFraction || scores->brightFraction > parameters.maxClippedFraction)
+        scores->failed |= QUALITY_CLIPPING;
+    if (eyeDistance < parameters.minEyeDistance)
+        scores->failed |= QUALITY_FACE_SIZE;
+    if (std::fabs(scores->roll) > parameters.maxRoll || std::fabs(scores->yaw) > parameters.maxYaw)
+        scores->failed |= QUALITY_POSE;
+    return FSDKE_OK;
+}
+
+}
+
+int CreateQualityFilter(const QualityFilterParameters& Parameters, HQualityFilter* Filter) {
+    if (!Filter || Parameters.minBrightness > Parameters.maxBrightness || Parameters.maxClippedFraction < 0)
+        return FSDKE_INVALID_ARGUMENT;
+
+    *Filter = QualityFilters().Add(std::make_shared<QualityFilter>(Parameters));
+    return FSDKE_OK;
+}
+
+int FreeQualityFilter(HQualityFilter Filter) {
+    return QualityFilters().Remove(Filter) ? FSDKE_OK : FSDKE_INVALID_ARGUMENT;
+}
+
+int QualityFilterEvaluate(HQualityFilter Filter, HImage Image, const TFace* Face, QualityScores* Scores) {
+    const auto filter = QualityFilters().Get(Filter);
+    if (!filter || !Face || !Scores)
+        return FSDKE_INVALID_ARGUMENT;
+    return Evaluate(filter->parameters, Image, *Face, Scores);
+}
+
+int QualityFilterEvaluateTrackerFace(HQualityFilter Filter, HTracker Tracker, long long CameraIdx, long long ID, HImage Image, QualityScores* Scores) {
+    const auto filter = QualityFilters().Get(Filter);
+    if (!filter || !Scores)
+        return FSDKE_INVALID_ARGUMENT;
+
+    TFace face;
+    {
+        const TrackerLock lock(Tracker, TrackerLock::SHARED);
+        const int errorCode = FSDK_GetTrackerFace(Tracker, CameraIdx, ID, &face);
+        if (errorCode != FSDKE_OK)
+            return errorCode;
+    }
+    return Evaluate(filter->parameters, Image, face, Scores);
+}
+
+int QualityFilterGetFaceTemplate(HQualityFilter Filter, HImage Image, const TFace* Face, FSDK_FaceTemplate* FaceTemplate, QualityScores* Scores) {
+    const auto filter = QualityFilters().Get(Filter);
+    if (!filter || !Face || !FaceTemplate || !Scores)
+        return FSDKE_INVALID_ARGUMENT;
+
+    const int errorCode = Evaluate(filter->parameters, Image, *Face, Scores);
+    if (errorCode != FSDKE_OK || Scores->failed)
+        return errorCode;
+    return FSDK_GetFaceTemplateInRegion2(Image, Face, FaceTemplate);
+}
+
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "LuxandFaceSDK.h"
+
+namespace fsdk {
+
+typedef unsigned int HQualityFilter;
+
+struct QualityFilterParameters {
+    // The variance of the Laplacian of the full resolution face luma. Blurred faces score
+    // low, 0 disables the check.
+    double minSharpness = 0;
+    // The mean luma of the face, 0..255.
+    double minBrightness = 0;
+    double maxBrightness = 255;
+    // The maximal fraction of face samples with luma below 16 or above 239.
+    double maxClippedFraction = 1;
+    // The distance between the eyes in image pixels.
+    double minEyeDistance = 0;
+    // Head roll and estimated yaw in degrees.
+    double maxRoll = 180;
+    double maxYaw = 90;
+};
+
+// Bits of QualityScores::failed
+enum QualityCheck {
+    QUALITY_SHARPNESS = 1,
+    QUALITY_BRIGHTNESS = 2,
+    QUALITY_CLIPPING = 4,
+    QUALITY_FACE_SIZE = 8,
+    QUALITY_POSE = 16
+};
+
+struct QualityScores {
+    double sharpness;
+    double brightness;
+    double darkFraction;
+    double brightFraction;
+    double eyeDistance;
+    double roll;
+    double yaw;
+    // The checks the face failed, 0 when it passed
+    int failed;
+};
+
+// A quality filter scores a face found on an image before the expensive work on it (templates, liveness
+// and other facial attributes) is done. Scores are computed on the luma of the central part of the face
+// bounding box, read in place from the image, and from the five TFace landmarks; evaluating a face takes
+// well under a millisecond. Yaw is estimated from the offset of the nose from the middle of the eyes, so
+// it is only good for rejecting faces turned away.
+int CreateQualityFilter(const QualityFilterParameters& Parameters, HQualityFilter* Filter);
+int FreeQualityFilter(HQualityFilter Filter);
+
+int QualityFilterEvaluate(HQualityFilter Filter, HImage Image, const TFace* Face, QualityScores* Scores);
+// Evaluates the face of the ID on Image, which must be the last frame fed to the camera of the tracker.
+int QualityFilterEvaluateTrackerFace(HQualityFilter Filter, HTracker Tracker, long long CameraIdx, long long ID, HImage Image, QualityScores* Scores);
+// Follows FSDK_GetFaceTemplateInRegion2 for faces that pass the filter. For faces that fail it returns
+// FSDKE_OK without computing the template: check Scores->failed.
+int QualityFilterGetFaceTemplate(HQualityFilter Filter, HImage Image, const TFace* Face, FSDK_FaceTemplate* FaceTemplate, QualityScores* Scores);
+
+}
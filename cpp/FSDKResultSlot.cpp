@@ -0,0 +1,193 @@
+#include "FSDKResultSlot.h"
+#include "FSDKHandles.h"
+#include "FSDKTrace.h"
+#include "FSDKTrackerLock.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <unordered_map>
+
+namespace fsdk {
+
+namespace {
+
+// Copies at most size - 1 bytes of the value, not cutting a UTF-8 sequence.
+void CopyText(char* destination, int size, const char* value, size_t length) {
+    if (length >= (size_t)size) {
+        length = (size_t)size - 1;
+        while (length > 0 && ((unsigned char)value[length] & 0xC0) == 0x80)
+            --length;
+    }
+    memcpy(destination, value, length);
+    destination[length] = 0;
+}
+
+// Attribute values come as "Name=Value;" pairs. The value of the pair named after the attribute is
+// taken, or the first one for attributes with several values (i.e. "Angles").
+void ParseAttribute(const std::string& name, const char* values, double* number, char* text) {
+    *number = NAN;
+    const char* value = nullptr;
+    size_t length = 0;
+    for (const char* pair = values; *pair;) {
+        const char* end = strchr(pair, ';');
+        if (!end)
+            end = pair + strlen(pair);
+        const char* equals = (const char*)memchr(pair, '=', end - pair);
+        const bool named = equals && name.compare(0, std::string::npos, pair, equals - pair) == 0;
+        if (equals && (named || !value)) {
+            value = equals + 1;
+            length = end - value;
+        }
+        if (named)
+            break;
+        pair = *end ? end + 1 : end;
+    }
+
+    if (!value) {
+        text[0] = 0;
+        return;
+    }
+    CopyText(text, ResultSlot::TEXT_SIZE, value, length);
+    char* parsed = nullptr;
+    const double result = strtod(text, &parsed);
+    if (parsed != text && !*parsed)
+        *number = result;
+}
+
+void FillFace(HTracker tracker, long long cameraIdx, long long id, const std::vector<std::string>& attributes,
+              const std::function<int(long long, TFace*)>& getFace, double* numbers, char* text) {
+    numbers[0] = (double)id;
+    // GetFace may take locks of its own, so it is called without the tracker lock
+    TFace face = {};
+    int errorCode = getFace ? getFace(id, &face) : FSDKE_OK;
+    const TrackerLock lock(tracker, TrackerLock::SHARED);
+    if (!getFace)
+        errorCode = FSDK_GetTrackerFace(tracker, cameraIdx, id, &face);
+    numbers[1] = errorCode == FSDKE_OK ? face.bbox.p0.x : NAN;
+    numbers[2] = errorCode == FSDKE_OK ? face.bbox.p0.y : NAN;
+    numbers[3] = errorCode == FSDKE_OK ? face.bbox.p1.x : NAN;
+    numbers[4] = errorCode == FSDKE_OK ? face.bbox.p1.y : NAN;
+
+    char value[1024];
+    value[0] = 0;
+    if (FSDK_GetName(tracker, id, value, sizeof(value)) != FSDKE_OK)
+        value[0] = 0;
+    CopyText(text, ResultSlot::TEXT_SIZE, value, strlen(value));
+
+    for (size_t i = 0; i < attributes.size(); ++i) {
+        if (FSDK_GetTrackerFacialAttribute(tracker, cameraIdx, id, attributes[i].c_str(), value, sizeof(value)) != FSDKE_OK)
+            value[0] = 0;
+        ParseAttribute(attributes[i], value, &numbers[ResultSlot::NUMBERS + i], text + (i + 1) * ResultSlot::TEXT_SIZE);
+    }
+}
+
+HandleRegistry<ResultSlot>& Slots() {
+    static HandleRegistry<ResultSlot> slots;
+    return slots;
+}
+
+std::mutex trackersMutex;
+std::unordered_map<HTracker, std::shared_ptr<ResultSlot>> trackerSlots;
+
+std::shared_ptr<ResultSlot> TrackerSlot(HTracker tracker) {
+    std::lock_guard<std::mutex> lock(trackersMutex);
+    const auto it = trackerSlots.find(tracker);
+    return it == trackerSlots.end() ? nullptr : it->second;
+}
+
+}
+
+ResultSlot::ResultSlot(int maxFaces, std::vector<std::string> attributes) : maxFaces(maxFaces), attributes(std::move(attributes)) {
+    for (ResultSnapshot& buffer : buffers) {
+        buffer.numbers.resize((size_t)maxFaces * NumberStride());
+        buffer.text.resize((size_t)maxFaces * TextStride());
+    }
+}
+
+void ResultSlot::Publish(const std::function<void(ResultSnapshot&)>& fill) {
+    std::lock_guard<std::mutex> lock(writer);
+    ResultSnapshot& snapshot = buffers[back];
+    fill(snapshot);
+    snapshot.sequence = ++sequence;
+    back = middle.exchange(back | FRESH, std::memory_order_acq_rel) & ~FRESH;
+}
+
+bool ResultSlot::Update() {
+    if (!(middle.load(std::memory_order_relaxed) & FRESH))
+        return false;
+    front = middle.exchange(front, std::memory_order_acq_rel) & ~FRESH;
+    return true;
+}
+
+int CreateResultSlot(int MaxFaces, const char* Attributes, HResultSlot* Slot) {
+    if (MaxFaces < 1 || !Slot)
+        return FSDKE_INVALID_ARGUMENT;
+
+    std::vector<std::string> attributes;
+    for (const char* name = Attributes ? Attributes : ""; *name;) {
+        const char* end = strchr(name, ';');
+        if (!end)
+            end = name + strlen(name);
+        if (end != name)
+            attributes.emplace_back(name, end);
+        name = *end ? end + 1 : end;
+    }
+
+    *Slot = Slots().Add(std::make_shared<ResultSlot>(MaxFaces, std::move(attributes)));
+    return FSDKE_OK;
+}
+
+int FreeResultSlot(HResultSlot Slot) {
+    const auto slot = Slots().Remove(Slot);
+    if (!slot)
+        return FSDKE_INVALID_ARGUMENT;
+
+    std::lock_guard<std::mutex> lock(trackersMutex);
+    for (auto it = trackerSlots.begin(); it != trackerSlots.end();)
+        it = it->second == slot ? trackerSlots.erase(it) : std::next(it);
+    return FSDKE_OK;
+}
+
+std::shared_ptr<ResultSlot> GetResultSlot(HResultSlot Slot) {
+    return Slots().Get(Slot);
+}
+
+int AttachResultSlot(HTracker Tracker, HResultSlot Slot) {
+    const auto slot = Slot ? Slots().Get(Slot) : nullptr;
+    if (Slot && !slot)
+        return FSDKE_INVALID_ARGUMENT;
+
+    std::lock_guard<std::mutex> lock(trackersMutex);
+    if (slot)
+        trackerSlots[Tracker] = slot;
+    else
+        trackerSlots.erase(Tracker);
+    return FSDKE_OK;
+}
+
+void ResultSlotFrameFed(HTracker Tracker, long long CameraIdx, int ErrorCode, const long long* IDs, long long Count,
+                        const std::function<int(long long, TFace*)>& GetFace) {
+    if (ErrorCode != FSDKE_OK)
+        return;
+    const auto slot = TrackerSlot(Tracker);
+    if (!slot)
+        return;
+
+    trace::Span span("PublishResults");
+    slot->Publish([&](ResultSnapshot& snapshot) {
+        snapshot.timestamp = trace::FrameTimestamp();
+        snapshot.count = (int)std::min<long long>(Count, slot->MaxFaces());
+        for (int i = 0; i < snapshot.count; ++i)
+            FillFace(Tracker, CameraIdx, IDs[i], slot->Attributes(), GetFace, &snapshot.numbers[(size_t)i * slot->NumberStride()],
+                     &snapshot.text[(size_t)i * slot->TextStride()]);
+    });
+}
+
+void ReleaseTrackerResultSlot(HTracker Tracker) {
+    AttachResultSlot(Tracker, 0);
+}
+
+}
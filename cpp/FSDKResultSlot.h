@@ -0,0 +1,91 @@
+#pragma once
+
+#include "LuxandFaceSDK.h"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace fsdk {
+
+typedef unsigned int HResultSlot;
+
+// The faces found on one frame in a packed layout. Numbers hold NUMBERS values per face (the ID and the
+// bounding box x0, y0, x1, y1) followed by the value of every attribute, NaN when the tracker has no value
+// or it is not a number. Text holds TEXT_SIZE bytes per face for the name followed by the raw value of
+// every attribute, zero terminated and truncated if longer.
+struct ResultSnapshot {
+    long long sequence = 0;
+    long long timestamp = 0;
+    int count = 0;
+    std::vector<double> numbers;
+    std::vector<char> text;
+};
+
+// A triple buffer of tracker results. The frame pipeline fills the back buffer and publishes it by swapping
+// it with the middle one, the reader takes the latest published snapshot by swapping the front buffer with
+// the middle one. Neither side waits for the other or allocates memory, the reader always sees a complete
+// snapshot, and snapshots published faster than they are read are skipped. There may be one reader only, claimed with AcquireReader.
+class ResultSlot {
+public:
+    static const int NUMBERS = 5;
+    static const int TEXT_SIZE = 128;
+
+    ResultSlot(int maxFaces, std::vector<std::string> attributes);
+
+    int MaxFaces() const { return maxFaces; }
+    const std::vector<std::string>& Attributes() const { return attributes; }
+    int NumberStride() const { return NUMBERS + (int)attributes.size(); }
+    int TextStride() const { return (1 + (int)attributes.size()) * TEXT_SIZE; }
+
+    // Fills the back buffer with the callback and publishes it with the next sequence number. Writers are
+    // serialized.
+    void Publish(const std::function<void(ResultSnapshot&)>& fill);
+
+    // Takes the latest published snapshot into the front buffer, returns false if nothing was published
+    // since the last call. Wait-free.
+    bool Update();
+    const ResultSnapshot& Front() const { return buffers[front]; }
+
+    // Claims the reading side of the slot, returns false if another reader holds it.
+    bool AcquireReader() { return !hasReader.exchange(true); }
+    void ReleaseReader() { hasReader = false; }
+
+private:
+    static const int FRESH = 4;
+
+    const int maxFaces;
+    const std::vector<std::string> attributes;
+
+    ResultSnapshot buffers[3];
+    std::mutex writer;
+    int back = 0;
+    long long sequence = 0;
+    // The index of the middle buffer, with FRESH set when it holds a snapshot the reader has not taken
+    std::atomic<int> middle{1};
+    int front = 2;
+    std::atomic<bool> hasReader{false};
+};
+
+// Attributes is a ';' separated list of tracker facial attributes (i.e. "Liveness;ImageQuality") stored
+// for every face.
+int CreateResultSlot(int MaxFaces, const char* Attributes, HResultSlot* Slot);
+int FreeResultSlot(HResultSlot Slot);
+std::shared_ptr<ResultSlot> GetResultSlot(HResultSlot Slot);
+
+// The faces found by FSDK_FeedFrame on a tracker with an attached slot are published into it. Passing 0
+// as the slot detaches it.
+int AttachResultSlot(HTracker Tracker, HResultSlot Slot);
+
+// Must be called after every FSDK_FeedFrame on the tracker with its result. Faces are taken from
+// FSDK_GetTrackerFace unless GetFace is given. Frames that failed are not published.
+void ResultSlotFrameFed(HTracker Tracker, long long CameraIdx, int ErrorCode, const long long* IDs, long long Count,
+                        const std::function<int(long long ID, TFace* Face)>& GetFace = nullptr);
+
+// Must be called when the tracker is freed: detaches its slot.
+void ReleaseTrackerResultSlot(HTracker Tracker);
+
+}
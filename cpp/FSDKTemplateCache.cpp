@@ -0,0 +1,385 @@
+#include "FSDKTemplateCache.h"
+#include "FSDKHandles.h"
+#include "FSDKHash.h"
+#include "FSDKParameters.h"
+
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <list>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+namespace fsdk {
+
+namespace {
+
+const char FILE_MAGIC[8] = {'F', 'S', 'D', 'K', 'T', 'C', 'A', 'C'};
+const uint32_t FILE_VERSION = 2;
+
+// The size and the SHA-256 digest of the hashed content. Two images are only treated as the same one when
+// both match, the 64-bit key merely addresses the entry.
+struct Content {
+    uint64_t size;
+    SHA256::Digest digest;
+
+    bool operator==(const Content& other) const {
+        return size == other.size && digest == other.digest;
+    }
+};
+
+struct Entry {
+    uint64_t key;
+    Content content;
+    int32_t errorCode;
+    TFace face;
+    FSDK_FaceTemplate faceTemplate;
+};
+
+// Entries are stored as packed fixed size records, most recently used first.
+const uint32_t RECORD_SIZE = sizeof(uint64_t) + sizeof(uint64_t) + sizeof(SHA256::Digest) + sizeof(int32_t) + sizeof(TFace) + sizeof(FSDK_FaceTemplate);
+
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t recordSize;
+    uint64_t configuration;
+    uint64_t count;
+};
+
+// Only results that do not depend on transient conditions are cached.
+bool Cacheable(int errorCode) {
+    return errorCode == FSDKE_OK || errorCode == FSDKE_FACE_NOT_FOUND;
+}
+
+class TemplateCache {
+public:
+    TemplateCache(const char* filename, long long maxEntries, uint64_t configuration)
+        : filename(filename ? filename : ""), maxEntries(maxEntries), configuration(configuration) {}
+
+    // Parameters is the hash of the global SDK parameters the entry is computed with. Entries of other
+    // parameters are kept in the file, they stop matching and are evicted as the least recently used ones.
+    uint64_t Key(const Content& content, uint64_t parameters) const {
+        return MurmurHash64A(content.digest.data(), content.digest.size(), (configuration ^ content.size) + parameters);
+    }
+
+    // An entry stored under the key for different content is a miss, and is replaced by the caller
+    bool Find(uint64_t key, const Content& content, Entry* entry) {
+        std::lock_guard<std::mutex> lock(mutex);
+        const auto it = index.find(key);
+        if (it == index.end() || !(it->second->content == content)) {
+            ++statistics.misses;
+            return false;
+        }
+        ++statistics.hits;
+        entries.splice(entries.begin(), entries, it->second);
+        *entry = *it->second;
+        return true;
+    }
+
+    void Insert(const Entry& entry) {
+        std::lock_guard<std::mutex> lock(mutex);
+        InsertLocked(entry);
+        dirty = true;
+    }
+
+    void Clear() {
+        std::lock_guard<std::mutex> lock(mutex);
+        entries.clear();
+        index.clear();
+        dirty = true;
+    }
+
+    TemplateCacheStatistics Statistics() {
+        std::lock_guard<std::mutex> lock(mutex);
+        TemplateCacheStatistics result = statistics;
+        result.entries = (long long)entries.size();
+        return result;
+    }
+
+    // A missing, damaged or outdated file leaves the cache empty.
+    void Load() {
+        if (filename.empty())
+            return;
+        FILE* file = fopen(filename.c_str(), "rb");
+        if (!file)
+            return;
+
+        FileHeader header;
+        if (fread(&header, sizeof(header), 1, file) == 1 && !memcmp(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC)) &&
+            header.version == FILE_VERSION && header.recordSize == RECORD_SIZE && header.configuration == configuration) {
+            std::lock_guard<std::mutex> lock(mutex);
+            std::vector<char> record(RECORD_SIZE);
+            for (uint64_t i = 0; i < header.count && (long long)entries.size() < maxEntries; ++i) {
+                if (fread(record.data(), RECORD_SIZE, 1, file) != 1)
+                    break;
+                Entry entry;
+                const char* data = record.data();
+                memcpy(&entry.key, data, sizeof(entry.key));
+                memcpy(&entry.content.size, data += sizeof(entry.key), sizeof(entry.content.size));
+                memcpy(entry.content.digest.data(), data += sizeof(entry.content.size), entry.content.digest.size());
+                memcpy(&entry.errorCode, data += entry.content.digest.size(), sizeof(entry.errorCode));
+                memcpy(&entry.face, data += sizeof(entry.errorCode), sizeof(entry.face));
+                memcpy(&entry.faceTemplate, data += sizeof(entry.face), sizeof(entry.faceTemplate));
+                // Records are stored most recently used first, so appending keeps the LRU order
+                if (!index.count(entry.key)) {
+                    entries.push_back(entry);
+                    index[entry.key] = std::prev(entries.end());
+                }
+            }
+        }
+        fclose(file);
+    }
+
+    int Save() {
+        if (filename.empty())
+            return FSDKE_OK;
+
+        std::lock_guard<std::mutex> saveLock(saveMutex);
+        std::vector<char> buffer;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!dirty)
+                return FSDKE_OK;
+
+            FileHeader header = {};
+            memcpy(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+            header.version = FILE_VERSION;
+            header.recordSize = RECORD_SIZE;
+            header.configuration = configuration;
+            header.count = entries.size();
+
+            buffer.resize(sizeof(header) + entries.size() * RECORD_SIZE);
+            memcpy(buffer.data(), &header, sizeof(header));
+            char* data = buffer.data() + sizeof(header);
+            for (const Entry& entry : entries) {
+                memcpy(data, &entry.key, sizeof(entry.key));
+                memcpy(data += sizeof(entry.key), &entry.content.size, sizeof(entry.content.size));
+                memcpy(data += sizeof(entry.content.size), entry.content.digest.data(), entry.content.digest.size());
+                memcpy(data += entry.content.digest.size(), &entry.errorCode, sizeof(entry.errorCode));
+                memcpy(data += sizeof(entry.errorCode), &entry.face, sizeof(entry.face));
+                memcpy(data += sizeof(entry.face), &entry.faceTemplate, sizeof(entry.faceTemplate));
+                data += sizeof(entry.faceTemplate);
+            }
+            dirty = false;
+        }
+
+        // Readers of the file never observe a partially written cache
+        const std::string temporary = filename + ".tmp";
+        FILE* file = fopen(temporary.c_str(), "wb");
+        if (!file) {
+            MarkDirty();
+            return FSDKE_CANNOT_CREATE_FILE;
+        }
+        bool written = fwrite(buffer.data(), 1, buffer.size(), file) == buffer.size() && fflush(file) == 0 && fsync(fileno(file)) == 0;
+        written = fclose(file) == 0 && written;
+        if (!written || rename(temporary.c_str(), filename.c_str()) != 0) {
+            remove(temporary.c_str());
+            MarkDirty();
+            return FSDKE_IO_ERROR;
+        }
+        return FSDKE_OK;
+    }
+
+private:
+    void InsertLocked(const Entry& entry) {
+        const auto it = index.find(entry.key);
+        if (it != index.end()) {
+            *it->second = entry;
+            entries.splice(entries.begin(), entries, it->second);
+            return;
+        }
+        entries.push_front(entry);
+        index[entry.key] = entries.begin();
+        while ((long long)entries.size() > maxEntries) {
+            index.erase(entries.back().key);
+            entries.pop_back();
+            ++statistics.evictions;
+        }
+    }
+
+    void MarkDirty() {
+        std::lock_guard<std::mutex> lock(mutex);
+        dirty = true;
+    }
+
+    const std::string filename;
+    const long long maxEntries;
+    const uint64_t configuration;
+
+    std::mutex mutex;
+    std::mutex saveMutex;
+    std::list<Entry> entries;
+    std::unordered_map<uint64_t, std::list<Entry>::iterator> index;
+    TemplateCacheStatistics statistics = {};
+    bool dirty = false;
+};
+
+HandleRegistry<TemplateCache>& Caches() {
+    static HandleRegistry<TemplateCache> caches;
+    return caches;
+}
+
+int ComputeEntry(HImage image, Entry* entry) {
+    entry->errorCode = FSDK_DetectFace2(image, &entry->face);
+    if (entry->errorCode == FSDKE_OK)
+        entry->errorCode = FSDK_GetFaceTemplateInRegion2(image, &entry->face, &entry->faceTemplate);
+    return entry->errorCode;
+}
+
+// Decodes a JPEG or PNG image. Returns FSDKE_UNSUPPORTED_IMAGE_EXTENSION for other formats.
+int LoadEncodedImage(HImage* image, const unsigned char* buffer, long long size) {
+    if (size >= 8 && !memcmp(buffer, "\x89PNG\r\n\x1a\n", 8))
+        return FSDK_LoadImageFromPngBuffer(image, buffer, (unsigned int)size);
+    if (size >= 3 && buffer[0] == 0xFF && buffer[1] == 0xD8 && buffer[2] == 0xFF)
+        return FSDK_LoadImageFromJpegBuffer(image, buffer, (unsigned int)size);
+    return FSDKE_UNSUPPORTED_IMAGE_EXTENSION;
+}
+
+Content BufferContent(const unsigned char* buffer, size_t size) {
+    SHA256 hash;
+    hash.Update(buffer, size);
+    return {size, hash.Finish()};
+}
+
+// Returns the cached entry for the content or calls compute(Entry*) with a freshly loaded image on a miss.
+template <typename Compute>
+int GetFaceTemplate(HTemplateCache handle, const Content& content, FSDK_FaceTemplate* faceTemplate, TFace* face, Compute&& compute) {
+    if (!faceTemplate)
+        return FSDKE_INVALID_ARGUMENT;
+    const auto cache = Caches().Get(handle);
+    if (!cache)
+        return FSDKE_INVALID_ARGUMENT;
+
+    Entry entry = {};
+    entry.key = cache->Key(content, ParametersHash());
+    entry.content = content;
+    if (!cache->Find(entry.key, content, &entry)) {
+        const int errorCode = compute(&entry);
+        if (!Cacheable(errorCode))
+            return errorCode;
+        cache->Insert(entry);
+    }
+
+    if (entry.errorCode == FSDKE_OK) {
+        *faceTemplate = entry.faceTemplate;
+        if (face)
+            *face = entry.face;
+    }
+    return entry.errorCode;
+}
+
+int ComputeFromBuffer(const unsigned char* buffer, long long size, const char* filename, Entry* entry) {
+    HImage image;
+    int errorCode = LoadEncodedImage(&image, buffer, size);
+    if (errorCode == FSDKE_UNSUPPORTED_IMAGE_EXTENSION && filename)
+        errorCode = FSDK_LoadImageFromFile(&image, filename);
+    if (errorCode != FSDKE_OK)
+        return errorCode;
+
+    errorCode = ComputeEntry(image, entry);
+    FSDK_FreeImage(image);
+    return errorCode;
+}
+
+}
+
+int CreateTemplateCache(const char* FileName, long long MaxEntries, const char* Configuration, HTemplateCache* Cache) {
+    if (!Cache || MaxEntries <= 0)
+        return FSDKE_INVALID_ARGUMENT;
+
+    // Results of a different configuration or a different template format are never returned. The global
+    // parameters set through FSDKParameters are added to every key on lookup.
+    const std::string configuration = std::string(Configuration ? Configuration : "") + "\n" + std::to_string(sizeof(FSDK_FaceTemplate));
+    auto cache = std::make_shared<TemplateCache>(FileName, MaxEntries, MurmurHash64A(configuration.data(), configuration.size(), FILE_VERSION));
+    cache->Load();
+
+    *Cache = Caches().Add(std::move(cache));
+    return FSDKE_OK;
+}
+
+int FreeTemplateCache(HTemplateCache Cache) {
+    const auto cache = Caches().Remove(Cache);
+    if (!cache)
+        return FSDKE_INVALID_ARGUMENT;
+    return cache->Save();
+}
+
+int SaveTemplateCache(HTemplateCache Cache) {
+    const auto cache = Caches().Get(Cache);
+    return cache ? cache->Save() : FSDKE_INVALID_ARGUMENT;
+}
+
+int ClearTemplateCache(HTemplateCache Cache) {
+    const auto cache = Caches().Get(Cache);
+    if (!cache)
+        return FSDKE_INVALID_ARGUMENT;
+    cache->Clear();
+    return FSDKE_OK;
+}
+
+int GetTemplateCacheStatistics(HTemplateCache Cache, TemplateCacheStatistics* Statistics) {
+    const auto cache = Caches().Get(Cache);
+    if (!cache || !Statistics)
+        return FSDKE_INVALID_ARGUMENT;
+    *Statistics = cache->Statistics();
+    return FSDKE_OK;
+}
+
+int TemplateCacheGetFaceTemplateFromFile(HTemplateCache Cache, const char* FileName, FSDK_FaceTemplate* FaceTemplate, TFace* Face) {
+    if (!FileName)
+        return FSDKE_INVALID_ARGUMENT;
+
+    FILE* file = fopen(FileName, "rb");
+    if (!file)
+        return FSDKE_FILE_NOT_FOUND;
+
+    std::vector<unsigned char> buffer;
+    unsigned char chunk[65536];
+    size_t read;
+    while ((read = fread(chunk, 1, sizeof(chunk), file)) > 0)
+        buffer.insert(buffer.end(), chunk, chunk + read);
+    const bool failed = ferror(file);
+    fclose(file);
+    if (failed)
+        return FSDKE_IO_ERROR;
+
+    return GetFaceTemplate(Cache, BufferContent(buffer.data(), buffer.size()), FaceTemplate, Face, [&](Entry* entry) {
+        return ComputeFromBuffer(buffer.data(), (long long)buffer.size(), FileName, entry);
+    });
+}
+
+int TemplateCacheGetFaceTemplateFromBuffer(HTemplateCache Cache, const unsigned char* Buffer, long long Size, FSDK_FaceTemplate* FaceTemplate, TFace* Face) {
+    if (!Buffer || Size <= 0)
+        return FSDKE_INVALID_ARGUMENT;
+
+    return GetFaceTemplate(Cache, BufferContent(Buffer, (size_t)Size), FaceTemplate, Face, [&](Entry* entry) {
+        return ComputeFromBuffer(Buffer, Size, nullptr, entry);
+    });
+}
+
+int TemplateCacheGetFaceTemplate(HTemplateCache Cache, HImage Image, FSDK_FaceTemplate* FaceTemplate, TFace* Face) {
+    unsigned char* data = nullptr;
+    int width = 0, height = 0, scanLine = 0;
+    FSDK_IMAGEMODE mode;
+    const int errorCode = FSDK_GetImageData(Image, &data, &width, &height, &scanLine, &mode);
+    if (errorCode != FSDKE_OK)
+        return errorCode;
+
+    // Pixels are hashed row by row, so padding at the end of rows does not affect the key. The shape is hashed
+    // first, so images of the same pixels in a different shape differ.
+    const int channels = mode == FSDK_IMAGE_GRAYSCALE_8BIT ? 1 : mode == FSDK_IMAGE_COLOR_24BIT ? 3 : 4;
+    const int shape[3] = {width, height, (int)mode};
+    SHA256 hash;
+    hash.Update(shape, sizeof(shape));
+    for (int y = 0; y < height; ++y)
+        hash.Update(data + (long long)y * scanLine, (size_t)width * channels);
+    const Content content = {sizeof(shape) + (uint64_t)width * height * channels, hash.Finish()};
+
+    return GetFaceTemplate(Cache, content, FaceTemplate, Face, [&](Entry* entry) {
+        return ComputeEntry(Image, entry);
+    });
+}
+
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "LuxandFaceSDK.h"
+
+namespace fsdk {
+
+typedef unsigned int HTemplateCache;
+
+struct TemplateCacheStatistics {
+    long long hits;
+    long long misses;
+    long long entries;
+    long long evictions;
+};
+
+// A content addressed cache of face templates. Entries are keyed by the size and the SHA-256 digest of the
+// encoded image (or of the pixels of an HImage), both compared on lookup, by a hash of the global parameters
+// recorded by FSDKParameters when the entry is looked up and by a hash of the Configuration string, which
+// only needs to describe anything else that affects the result. Each entry stores the face template and the face found by FSDK_DetectFace2, or
+// FSDKE_FACE_NOT_FOUND for images without faces.
+// The least recently used entries are evicted when the cache holds more than MaxEntries. A cache with a
+// FileName is loaded from the file when created and written to it (atomically, through a temporary file)
+// by SaveTemplateCache and FreeTemplateCache.
+int CreateTemplateCache(const char* FileName, long long MaxEntries, const char* Configuration, HTemplateCache* Cache);
+int FreeTemplateCache(HTemplateCache Cache);
+int SaveTemplateCache(HTemplateCache Cache);
+int ClearTemplateCache(HTemplateCache Cache);
+int GetTemplateCacheStatistics(HTemplateCache Cache, TemplateCacheStatistics* Statistics);
+
+// Return the cached face template or decode the image, detect the face and extract its template on a miss.
+int TemplateCacheGetFaceTemplateFromFile(HTemplateCache Cache, const char* FileName, FSDK_FaceTemplate* FaceTemplate, TFace* Face);
+int TemplateCacheGetFaceTemplateFromBuffer(HTemplateCache Cache, const unsigned char* Buffer, long long Size, FSDK_FaceTemplate* FaceTemplate, TFace* Face);
+int TemplateCacheGetFaceTemplate(HTemplateCache Cache, HImage Image, FSDK_FaceTemplate* FaceTemplate, TFace* Face);
+
+}
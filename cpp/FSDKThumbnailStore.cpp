@@ -0,0 +1,771 @@
+#include "FSDKThumbnailStore.h"
+#include "FSDKHandles.h"
+#include "FSDKHash.h"
+#include "FSDKTrackerLock.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace fsdk {
+
+namespace {
+
+const char FILE_MAGIC[8] = {'F', 'S', 'D', 'K', 'T', 'H', 'M', 'B'};
+const uint32_t FILE_VERSION = 2;
+
+// Clearing the tracker starts a new generation, which is rewritten in place: records of other
+// generations belong to faces the tracker no longer has and are skipped.
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t generation;
+};
+
+// Every thumbnail is appended as a record header followed by the JPEG data. A record with no data
+// deletes the thumbnail. The checksum detects records torn by a crash in the middle of a write.
+struct RecordHeader {
+    int64_t faceID;
+    uint32_t generation;
+    uint32_t size;
+    uint32_t checksum;
+    uint32_t reserved;
+};
+
+uint32_t Checksum(long long faceID, uint32_t generation, const unsigned char* data, size_t size) {
+    return (uint32_t)MurmurHash64A(data, size, (uint64_t)faceID * 0x9E3779B97F4A7C15ull + generation);
+}
+
+struct Record {
+    long long offset;
+    long long size;
+    // Changes whenever the thumbnail is replaced, so stale decoded images are never cached
+    unsigned long long version;
+};
+
+class Mapping {
+public:
+    Mapping(void* address, size_t size) : address(address), size(size) {}
+    ~Mapping() { munmap(address, size); }
+
+    const unsigned char* Data() const { return static_cast<const unsigned char*>(address); }
+    size_t Size() const { return size; }
+
+private:
+    void* const address;
+    const size_t size;
+};
+
+std::shared_ptr<Mapping> Map(int fd, long long size) {
+    void* address = mmap(nullptr, (size_t)size, PROT_READ, MAP_SHARED, fd, 0);
+    return address == MAP_FAILED ? nullptr : std::make_shared<Mapping>(address, (size_t)size);
+}
+
+// Maps the pages holding the range copy-on-write, so the caller may change the data without changing the file.
+std::shared_ptr<Mapping> MapPrivate(int fd, long long offset, long long size) {
+    const long long start = offset - offset % sysconf(_SC_PAGESIZE);
+    void* address = mmap(nullptr, (size_t)(offset + size - start), PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, start);
+    return address == MAP_FAILED ? nullptr : std::make_shared<Mapping>(address, (size_t)(offset + size - start));
+}
+
+bool WriteAll(int fd, const void* data, size_t size, long long offset) {
+    const char* bytes = static_cast<const char*>(data);
+    while (size > 0) {
+        const ssize_t written = pwrite(fd, bytes, size, offset);
+        if (written <= 0)
+            return false;
+        bytes += written;
+        offset += written;
+        size -= (size_t)written;
+    }
+    return true;
+}
+
+// FaceSDK encodes images only to files, so the JPEG is written to a temporary file next to the store.
+int EncodeThumbnail(HImage image, int maxSize, const std::string& temporary, std::vector<unsigned char>* jpeg) {
+    int width = 0, height = 0;
+    int errorCode = FSDK_GetImageWidth(image, &width);
+    if (errorCode == FSDKE_OK)
+        errorCode = FSDK_GetImageHeight(image, &height);
+    if (errorCode != FSDKE_OK)
+        return errorCode;
+
+    HImage resized = 0;
+    if (std::max(width, height) > maxSize) {
+        errorCode = FSDK_CreateEmptyImage(&resized);
+        if (errorCode == FSDKE_OK)
+            errorCode = FSDK_ResizeImage(image, (double)maxSize / std::max(width, height), resized);
+        if (errorCode != FSDKE_OK) {
+            if (resized)
+                FSDK_FreeImage(resized);
+            return errorCode;
+        }
+    }
+
+    errorCode = FSDK_SaveImageToFile(resized ? resized : image, temporary.c_str());
+    if (resized)
+        FSDK_FreeImage(resized);
+    if (errorCode != FSDKE_OK)
+        return errorCode;
+
+    FILE* file = fopen(temporary.c_str(), "rb");
+    if (!file)
+        return FSDKE_CANNOT_OPEN_FILE;
+    jpeg->clear();
+    unsigned char chunk[65536];
+    size_t read;
+    while ((read = fread(chunk, 1, sizeof(chunk), file)) > 0)
+        jpeg->insert(jpeg->end(), chunk, chunk + read);
+    const bool failed = ferror(file) || jpeg->empty();
+    fclose(file);
+    remove(temporary.c_str());
+    return failed ? FSDKE_IO_ERROR : FSDKE_OK;
+}
+
+int CopyImage(HImage source, HImage* image) {
+    int errorCode = FSDK_CreateEmptyImage(image);
+    if (errorCode != FSDKE_OK)
+        return errorCode;
+    errorCode = FSDK_CopyImage(source, *image);
+    if (errorCode != FSDKE_OK)
+        FSDK_FreeImage(*image);
+    return errorCode;
+}
+
+class ThumbnailStore {
+public:
+    ThumbnailStore(const char* filename, int maxSize, long long maxCachedImages)
+        : filename(filename), maxSize(maxSize), maxCachedImages(maxCachedImages) {}
+
+    ~ThumbnailStore() {
+        for (const CachedImage& cached : images)
+            FSDK_FreeImage(cached.image);
+        if (fd >= 0)
+            close(fd);
+    }
+
+    // Opens or creates the file and indexes its records. A torn record at the end is truncated.
+    int Open() {
+        std::lock_guard<std::mutex> lock(mutex);
+        fd = open(filename.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (fd < 0)
+            return FSDKE_CANNOT_OPEN_FILE;
+
+        struct stat status;
+        if (fstat(fd, &status) != 0)
+            return FSDKE_IO_ERROR;
+        fileSize = status.st_size;
+
+        if (fileSize == 0) {
+            const FileHeader header = Header();
+            if (!WriteAll(fd, &header, sizeof(header), 0))
+                return FSDKE_IO_ERROR;
+            fileSize = sizeof(header);
+        }
+        if (fileSize < (long long)sizeof(FileHeader) || !(mapping = Map(fd, fileSize)))
+            return FSDKE_BAD_FILE_FORMAT;
+
+        FileHeader header;
+        memcpy(&header, mapping->Data(), sizeof(header));
+        if (memcmp(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC)))
+            return FSDKE_BAD_FILE_FORMAT;
+        if (header.version != FILE_VERSION)
+            return FSDKE_UNSUPPORTED_FILE_VERSION;
+        generation = header.generation;
+
+        long long offset = sizeof(FileHeader);
+        while (offset + (long long)sizeof(RecordHeader) <= fileSize) {
+            RecordHeader record;
+            memcpy(&record, mapping->Data() + offset, sizeof(record));
+            const long long data = offset + (long long)sizeof(record);
+            if (data + record.size > fileSize || record.checksum != Checksum(record.faceID, record.generation, mapping->Data() + data, record.size))
+                break;
+            if (record.generation == generation && record.size)
+                index[record.faceID] = Record{data, record.size, ++version};
+            else if (record.generation == generation)
+                index.erase(record.faceID);
+            offset = data + record.size;
+        }
+
+        if (offset < fileSize) {
+            if (ftruncate(fd, offset) != 0)
+                return FSDKE_IO_ERROR;
+            fileSize = offset;
+            if (!(mapping = Map(fd, fileSize)))
+                return FSDKE_IO_ERROR;
+        }
+        garbageSize = fileSize - (long long)sizeof(FileHeader) - LiveSize();
+        return FSDKE_OK;
+    }
+
+    int Set(long long faceID, HImage image) {
+        std::vector<unsigned char> jpeg;
+        const std::string temporary = filename + "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".jpg";
+        const int errorCode = EncodeThumbnail(image, maxSize, temporary, &jpeg);
+        if (errorCode != FSDKE_OK)
+            return errorCode;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        return Append(faceID, jpeg.data(), jpeg.size());
+    }
+
+    int Delete(long long faceID) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!index.count(faceID))
+            return FSDKE_FACEIMAGE_NOT_FOUND;
+        return Append(faceID, nullptr, 0);
+    }
+
+    // Faces without a thumbnail are skipped.
+    int Delete(const std::vector<long long>& faceIDs) {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const long long faceID : faceIDs) {
+            const int errorCode = index.count(faceID) ? Append(faceID, nullptr, 0) : FSDKE_OK;
+            if (errorCode != FSDKE_OK)
+                return errorCode;
+        }
+        return FSDKE_OK;
+    }
+
+    // Deletes every thumbnail by starting a new generation.
+    int Clear() {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++generation;
+        const FileHeader header = Header();
+        if (!WriteAll(fd, &header, sizeof(header), 0)) {
+            --generation;
+            return FSDKE_IO_ERROR;
+        }
+        index.clear();
+        for (const CachedImage& cached : images)
+            FSDK_FreeImage(cached.image);
+        images.clear();
+        garbageSize = fileSize - (long long)sizeof(FileHeader);
+        return FSDKE_OK;
+    }
+
+    std::vector<long long> FaceIDs() {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::vector<long long> faceIDs;
+        faceIDs.reserve(index.size());
+        for (const auto& item : index)
+            faceIDs.push_back(item.first);
+        return faceIDs;
+    }
+
+    int GetThumbnail(long long faceID, Thumbnail* thumbnail) {
+        std::lock_guard<std::mutex> lock(mutex);
+        return GetThumbnailLocked(faceID, thumbnail, nullptr);
+    }
+
+    int MapThumbnail(long long faceID, Thumbnail* thumbnail) {
+        std::lock_guard<std::mutex> lock(mutex);
+        const auto it = index.find(faceID);
+        if (it == index.end())
+            return FSDKE_FACEIMAGE_NOT_FOUND;
+        const auto mapped = MapPrivate(fd, it->second.offset, it->second.size);
+        if (!mapped)
+            return FSDKE_IO_ERROR;
+        thumbnail->data = mapped->Data() + mapped->Size() - it->second.size;
+        thumbnail->size = it->second.size;
+        thumbnail->mapping = mapped;
+        return FSDKE_OK;
+    }
+
+    // Decoded images are cached, the caller receives a copy it owns.
+    int Get(long long faceID, HImage* image) {
+        Thumbnail thumbnail;
+        unsigned long long recordVersion = 0;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (auto it = images.begin(); it != images.end(); ++it) {
+                if (it->faceID == faceID) {
+                    images.splice(images.begin(), images, it);
+                    return CopyImage(it->image, image);
+                }
+            }
+            const int errorCode = GetThumbnailLocked(faceID, &thumbnail, &recordVersion);
+            if (errorCode != FSDKE_OK)
+                return errorCode;
+        }
+
+        // The mapping held by the thumbnail stays valid while the store is modified by other threads
+        HImage decoded;
+        int errorCode = FSDK_LoadImageFromJpegBuffer(&decoded, thumbnail.data, (unsigned int)thumbnail.size);
+        if (errorCode != FSDKE_OK)
+            return errorCode;
+        if (maxCachedImages <= 0) {
+            *image = decoded;
+            return FSDKE_OK;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        errorCode = CopyImage(decoded, image);
+        const auto it = index.find(faceID);
+        if (errorCode == FSDKE_OK && it != index.end() && it->second.version == recordVersion) {
+            Uncache(faceID);
+            images.push_front(CachedImage{faceID, decoded});
+            while ((long long)images.size() > maxCachedImages) {
+                FSDK_FreeImage(images.back().image);
+                images.pop_back();
+            }
+        } else {
+            FSDK_FreeImage(decoded);
+        }
+        return errorCode;
+    }
+
+    // Rewrites the live records to a temporary file and replaces the store file with it.
+    int Compact() {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (garbageSize == 0)
+            return FSDKE_OK;
+        if ((long long)mapping->Size() < fileSize) {
+            auto remapped = Map(fd, fileSize);
+            if (!remapped)
+                return FSDKE_IO_ERROR;
+            mapping = std::move(remapped);
+        }
+
+        std::vector<std::pair<long long, Record*>> records;
+        records.reserve(index.size());
+        for (auto& item : index)
+            records.emplace_back(item.first, &item.second);
+        std::sort(records.begin(), records.end(), [](const auto& a, const auto& b) { return a.second->offset < b.second->offset; });
+
+        const std::string temporary = filename + ".tmp";
+        const int temporaryFd = open(temporary.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (temporaryFd < 0)
+            return FSDKE_CANNOT_CREATE_FILE;
+
+        std::vector<long long> offsets;
+        offsets.reserve(records.size());
+        long long offset = sizeof(FileHeader);
+        const FileHeader header = Header();
+        bool written = WriteAll(temporaryFd, &header, sizeof(header), 0);
+        for (const auto& item : records) {
+            if (!written)
+                break;
+            const Record& record = *item.second;
+            const long long size = (long long)sizeof(RecordHeader) + record.size;
+            written = WriteAll(temporaryFd, mapping->Data() + record.offset - sizeof(RecordHeader), (size_t)size, offset);
+            offsets.push_back(offset + (long long)sizeof(RecordHeader));
+            offset += size;
+        }
+
+        std::shared_ptr<Mapping> compacted;
+        written = written && fsync(temporaryFd) == 0 && (compacted = Map(temporaryFd, offset)) && rename(temporary.c_str(), filename.c_str()) == 0;
+        if (!written) {
+            close(temporaryFd);
+            remove(temporary.c_str());
+            return FSDKE_IO_ERROR;
+        }
+
+        close(fd);
+        fd = temporaryFd;
+        fileSize = offset;
+        garbageSize = 0;
+        mapping = std::move(compacted);
+        for (size_t i = 0; i < records.size(); ++i)
+            records[i].second->offset = offsets[i];
+        return FSDKE_OK;
+    }
+
+    bool NeedsCompaction() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return garbageSize > 0 && 2 * garbageSize > fileSize;
+    }
+
+    ThumbnailStoreStatistics Statistics() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return ThumbnailStoreStatistics{(long long)index.size(), fileSize, garbageSize, (long long)images.size()};
+    }
+
+private:
+    struct CachedImage {
+        long long faceID;
+        HImage image;
+    };
+
+    FileHeader Header() const {
+        FileHeader header = {};
+        memcpy(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+        header.version = FILE_VERSION;
+        header.generation = generation;
+        return header;
+    }
+
+    long long LiveSize() const {
+        long long size = 0;
+        for (const auto& item : index)
+            size += (long long)sizeof(RecordHeader) + item.second.size;
+        return size;
+    }
+
+    int GetThumbnailLocked(long long faceID, Thumbnail* thumbnail, unsigned long long* recordVersion) {
+        const auto it = index.find(faceID);
+        if (it == index.end())
+            return FSDKE_FACEIMAGE_NOT_FOUND;
+        // Records appended since the file was mapped are mapped on first access
+        if (it->second.offset + it->second.size > (long long)mapping->Size()) {
+            auto remapped = Map(fd, fileSize);
+            if (!remapped)
+                return FSDKE_IO_ERROR;
+            mapping = std::move(remapped);
+        }
+        thumbnail->data = mapping->Data() + it->second.offset;
+        thumbnail->size = it->second.size;
+        thumbnail->mapping = mapping;
+        if (recordVersion)
+            *recordVersion = it->second.version;
+        return FSDKE_OK;
+    }
+
+    int Append(long long faceID, const unsigned char* data, size_t size) {
+        RecordHeader header = {faceID, generation, (uint32_t)size, Checksum(faceID, generation, data, size), 0};
+        std::vector<unsigned char> record(sizeof(header) + size);
+        memcpy(record.data(), &header, sizeof(header));
+        if (size)
+            memcpy(record.data() + sizeof(header), data, size);
+
+        if (!WriteAll(fd, record.data(), record.size(), fileSize)) {
+            // Drop a partially written record, so the next append does not follow garbage
+            const bool truncated = ftruncate(fd, fileSize) == 0;
+            return truncated ? FSDKE_IO_ERROR : FSDKE_FAILED;
+        }
+
+        const long long offset = fileSize + (long long)sizeof(header);
+        fileSize += (long long)record.size();
+
+        const auto it = index.find(faceID);
+        if (it != index.end())
+            garbageSize += (long long)sizeof(RecordHeader) + it->second.size;
+        if (size) {
+            index[faceID] = Record{offset, (long long)size, ++version};
+        } else {
+            garbageSize += (long long)sizeof(RecordHeader);
+            index.erase(faceID);
+        }
+        Uncache(faceID);
+        return FSDKE_OK;
+    }
+
+    void Uncache(long long faceID) {
+        for (auto it = images.begin(); it != images.end(); ++it) {
+            if (it->faceID == faceID) {
+                FSDK_FreeImage(it->image);
+                images.erase(it);
+                return;
+            }
+        }
+    }
+
+    const std::string filename;
+    const int maxSize;
+    const long long maxCachedImages;
+
+    std::mutex mutex;
+    int fd = -1;
+    long long fileSize = 0;
+    long long garbageSize = 0;
+    uint32_t generation = 0;
+    unsigned long long version = 0;
+    std::shared_ptr<Mapping> mapping;
+    std::unordered_map<long long, Record> index;
+    // Decoded images, most recently used first. The list is short, so it is searched linearly.
+    std::list<CachedImage> images;
+};
+
+HandleRegistry<ThumbnailStore>& Stores() {
+    static HandleRegistry<ThumbnailStore> stores;
+    return stores;
+}
+
+std::mutex trackersMutex;
+std::unordered_map<HTracker, HThumbnailStore> trackerStores;
+
+// Returns 0 if the tracker has no store attached.
+HThumbnailStore TrackerStore(HTracker tracker) {
+    std::lock_guard<std::mutex> lock(trackersMutex);
+    const auto it = trackerStores.find(tracker);
+    return it == trackerStores.end() ? 0 : it->second;
+}
+
+// Thumbnails of faces the tracker no longer has (i.e. removed by FSDK_ calls made directly) are deleted when
+// they are accessed, so a face ID reused by the tracker never gets the thumbnail of another face.
+int CheckTrackerFace(HTracker tracker, HThumbnailStore store, long long faceID) {
+    long long id = 0;
+    int errorCode;
+    {
+        const TrackerLock lock(tracker, TrackerLock::SHARED);
+        errorCode = FSDK_GetTrackerIDByFaceID(tracker, faceID, &id);
+    }
+    if (errorCode != FSDKE_OK)
+        ThumbnailStoreDeleteImage(store, faceID);
+    return errorCode;
+}
+
+// Deletes the thumbnails of faces unknown to the tracker, all of them at once if the tracker knows none.
+int DeleteUnknownFaces(HTracker tracker, HThumbnailStore store) {
+    const auto thumbnails = Stores().Get(store);
+    if (!thumbnails)
+        return FSDKE_INVALID_ARGUMENT;
+
+    const std::vector<long long> faceIDs = thumbnails->FaceIDs();
+    std::vector<long long> unknown;
+    {
+        const TrackerLock lock(tracker, TrackerLock::SHARED);
+        long long id = 0;
+        for (const long long faceID : faceIDs)
+            if (FSDK_GetTrackerIDByFaceID(tracker, faceID, &id) != FSDKE_OK)
+                unknown.push_back(faceID);
+    }
+    if (unknown.empty())
+        return FSDKE_OK;
+
+    const int errorCode = unknown.size() == faceIDs.size() ? thumbnails->Clear() : thumbnails->Delete(unknown);
+    if (errorCode == FSDKE_OK && thumbnails->NeedsCompaction())
+        return thumbnails->Compact();
+    return errorCode;
+}
+
+}
+
+int CreateThumbnailStore(const char* FileName, int MaxSize, long long MaxCachedImages, HThumbnailStore* Store) {
+    if (!FileName || !*FileName || MaxSize <= 0 || MaxCachedImages < 0 || !Store)
+        return FSDKE_INVALID_ARGUMENT;
+
+    auto store = std::make_shared<ThumbnailStore>(FileName, MaxSize, MaxCachedImages);
+    const int errorCode = store->Open();
+    if (errorCode != FSDKE_OK)
+        return errorCode;
+
+    *Store = Stores().Add(std::move(store));
+    return FSDKE_OK;
+}
+
+int FreeThumbnailStore(HThumbnailStore Store) {
+    const auto store = Stores().Remove(Store);
+    if (!store)
+        return FSDKE_INVALID_ARGUMENT;
+
+    {
+        std::lock_guard<std::mutex> lock(trackersMutex);
+        for (auto it = trackerStores.begin(); it != trackerStores.end();)
+            it = it->second == Store ? trackerStores.erase(it) : std::next(it);
+    }
+    return store->NeedsCompaction() ? store->Compact() : FSDKE_OK;
+}
+
+int CompactThumbnailStore(HThumbnailStore Store) {
+    const auto store = Stores().Get(Store);
+    return store ? store->Compact() : FSDKE_INVALID_ARGUMENT;
+}
+
+int GetThumbnailStoreStatistics(HThumbnailStore Store, ThumbnailStoreStatistics* Statistics) {
+    const auto store = Stores().Get(Store);
+    if (!store || !Statistics)
+        return FSDKE_INVALID_ARGUMENT;
+    *Statistics = store->Statistics();
+    return FSDKE_OK;
+}
+
+int ThumbnailStoreSetImage(HThumbnailStore Store, long long FaceID, HImage Image) {
+    const auto store = Stores().Get(Store);
+    if (!store)
+        return FSDKE_INVALID_ARGUMENT;
+    const int errorCode = store->Set(FaceID, Image);
+    if (errorCode == FSDKE_OK && store->NeedsCompaction())
+        return store->Compact();
+    return errorCode;
+}
+
+int ThumbnailStoreGetImage(HThumbnailStore Store, long long FaceID, HImage* Image) {
+    const auto store = Stores().Get(Store);
+    if (!store || !Image)
+        return FSDKE_INVALID_ARGUMENT;
+    return store->Get(FaceID, Image);
+}
+
+int ThumbnailStoreGetThumbnail(HThumbnailStore Store, long long FaceID, Thumbnail* Thumbnail) {
+    const auto store = Stores().Get(Store);
+    if (!store || !Thumbnail)
+        return FSDKE_INVALID_ARGUMENT;
+    return store->GetThumbnail(FaceID, Thumbnail);
+}
+
+int ThumbnailStoreDeleteImage(HThumbnailStore Store, long long FaceID) {
+    const auto store = Stores().Get(Store);
+    if (!store)
+        return FSDKE_INVALID_ARGUMENT;
+    const int errorCode = store->Delete(FaceID);
+    if (errorCode == FSDKE_OK && store->NeedsCompaction())
+        return store->Compact();
+    return errorCode;
+}
+
+int AttachThumbnailStore(HTracker Tracker, HThumbnailStore Store) {
+    if (Store && !Stores().Get(Store))
+        return FSDKE_INVALID_ARGUMENT;
+
+    {
+        std::lock_guard<std::mutex> lock(trackersMutex);
+        if (Store)
+            trackerStores[Tracker] = Store;
+        else
+            trackerStores.erase(Tracker);
+    }
+    // The store may hold thumbnails of another tracker memory, i.e. one saved before them or a new one
+    return Store ? DeleteUnknownFaces(Tracker, Store) : FSDKE_OK;
+}
+
+int SetTrackerFaceImage(HTracker Tracker, long long FaceID, HImage Image) {
+    const HThumbnailStore store = TrackerStore(Tracker);
+    if (!store) {
+        const TrackerLock lock(Tracker, TrackerLock::EXCLUSIVE);
+        return FSDK_SetTrackerFaceImage(Tracker, FaceID, Image);
+    }
+
+    // Images are only stored for faces known to the tracker, as in tracker memory
+    long long id = 0;
+    int errorCode;
+    {
+        const TrackerLock lock(Tracker, TrackerLock::SHARED);
+        errorCode = FSDK_GetTrackerIDByFaceID(Tracker, FaceID, &id);
+    }
+    if (errorCode != FSDKE_OK)
+        return errorCode;
+
+    // The thumbnail is encoded and written without the tracker lock, so frames are not held up by the disk
+    errorCode = ThumbnailStoreSetImage(store, FaceID, Image);
+    if (errorCode != FSDKE_OK)
+        return errorCode;
+
+    // The face may have been removed meanwhile, its new thumbnail must not outlive it
+    const TrackerLock lock(Tracker, TrackerLock::EXCLUSIVE);
+    errorCode = FSDK_GetTrackerIDByFaceID(Tracker, FaceID, &id);
+    if (errorCode != FSDKE_OK) {
+        ThumbnailStoreDeleteImage(store, FaceID);
+        return errorCode;
+    }
+    FSDK_DeleteTrackerFaceImage(Tracker, FaceID);
+    return FSDKE_OK;
+}
+
+int GetTrackerFaceImage(HTracker Tracker, long long FaceID, HImage* Image) {
+    const HThumbnailStore store = TrackerStore(Tracker);
+    if (store) {
+        int errorCode = CheckTrackerFace(Tracker, store, FaceID);
+        if (errorCode == FSDKE_OK)
+            errorCode = ThumbnailStoreGetImage(store, FaceID, Image);
+        if (errorCode != FSDKE_FACEIMAGE_NOT_FOUND)
+            return errorCode;
+    }
+    const TrackerLock lock(Tracker, TrackerLock::SHARED);
+    return FSDK_GetTrackerFaceImage(Tracker, FaceID, Image);
+}
+
+int DeleteTrackerFaceImage(HTracker Tracker, long long FaceID) {
+    const HThumbnailStore store = TrackerStore(Tracker);
+    const TrackerLock lock(Tracker, TrackerLock::EXCLUSIVE);
+    if (!store)
+        return FSDK_DeleteTrackerFaceImage(Tracker, FaceID);
+
+    // The image may still be in tracker memory if it was set before the store was attached
+    const int errorCode = ThumbnailStoreDeleteImage(store, FaceID);
+    const int trackerErrorCode = FSDK_DeleteTrackerFaceImage(Tracker, FaceID);
+    return errorCode == FSDKE_FACEIMAGE_NOT_FOUND ? trackerErrorCode : errorCode;
+}
+
+int GetTrackerFaceThumbnail(HTracker Tracker, long long FaceID, Thumbnail* Thumbnail) {
+    const HThumbnailStore store = TrackerStore(Tracker);
+    if (!store)
+        return FSDKE_FACEIMAGE_NOT_FOUND;
+    const int errorCode = CheckTrackerFace(Tracker, store, FaceID);
+    return errorCode == FSDKE_OK ? ThumbnailStoreGetThumbnail(store, FaceID, Thumbnail) : errorCode;
+}
+
+int MapTrackerFaceThumbnail(HTracker Tracker, long long FaceID, Thumbnail* Thumbnail) {
+    if (!Thumbnail)
+        return FSDKE_INVALID_ARGUMENT;
+    const HThumbnailStore store = TrackerStore(Tracker);
+    const auto thumbnails = Stores().Get(store);
+    if (!thumbnails)
+        return FSDKE_FACEIMAGE_NOT_FOUND;
+    const int errorCode = CheckTrackerFace(Tracker, store, FaceID);
+    return errorCode == FSDKE_OK ? thumbnails->MapThumbnail(FaceID, Thumbnail) : errorCode;
+}
+
+int GetTrackerFaceIDs(HTracker Tracker, long long ID, std::vector<long long>* FaceIDs) {
+    long long count = 0;
+    int errorCode = FSDK_GetTrackerFaceIDsCountForID(Tracker, ID, &count);
+    if (errorCode != FSDKE_OK)
+        return errorCode;
+    FaceIDs->resize((size_t)count);
+    if (count > 0)
+        errorCode = FSDK_GetTrackerFaceIDsForID(Tracker, ID, FaceIDs->data(), count * (long long)sizeof(long long));
+    return errorCode;
+}
+
+int DeleteTrackerThumbnails(HTracker Tracker, const std::vector<long long>& FaceIDs) {
+    const auto store = Stores().Get(TrackerStore(Tracker));
+    if (!store || FaceIDs.empty())
+        return FSDKE_OK;
+    const int errorCode = store->Delete(FaceIDs);
+    if (errorCode == FSDKE_OK && store->NeedsCompaction())
+        return store->Compact();
+    return errorCode;
+}
+
+int PurgeID(HTracker Tracker, long long ID) {
+    const bool hasStore = TrackerStore(Tracker) != 0;
+    std::vector<long long> faceIDs;
+    int errorCode;
+    {
+        const TrackerLock lock(Tracker, TrackerLock::EXCLUSIVE);
+        errorCode = hasStore ? GetTrackerFaceIDs(Tracker, ID, &faceIDs) : FSDKE_OK;
+        if (errorCode == FSDKE_OK)
+            errorCode = FSDK_PurgeID(Tracker, ID);
+    }
+    return errorCode == FSDKE_OK ? DeleteTrackerThumbnails(Tracker, faceIDs) : errorCode;
+}
+
+int DeleteTrackerFace(HTracker Tracker, long long FaceID) {
+    int errorCode;
+    {
+        const TrackerLock lock(Tracker, TrackerLock::EXCLUSIVE);
+        errorCode = FSDK_DeleteTrackerFace(Tracker, FaceID);
+    }
+    return errorCode == FSDKE_OK ? DeleteTrackerThumbnails(Tracker, {FaceID}) : errorCode;
+}
+
+int ClearTracker(HTracker Tracker) {
+    int errorCode;
+    {
+        const TrackerLock lock(Tracker, TrackerLock::EXCLUSIVE);
+        errorCode = FSDK_ClearTracker(Tracker);
+    }
+    const auto store = Stores().Get(TrackerStore(Tracker));
+    if (errorCode != FSDKE_OK || !store)
+        return errorCode;
+    errorCode = store->Clear();
+    if (errorCode == FSDKE_OK && store->NeedsCompaction())
+        return store->Compact();
+    return errorCode;
+}
+
+void ReleaseTrackerThumbnails(HTracker Tracker) {
+    AttachThumbnailStore(Tracker, 0);
+}
+
+}
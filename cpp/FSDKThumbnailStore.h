@@ -0,0 +1,77 @@
+#pragma once
+
+#include "LuxandFaceSDK.h"
+
+#include <memory>
+#include <vector>
+
+namespace fsdk {
+
+typedef unsigned int HThumbnailStore;
+
+struct ThumbnailStoreStatistics {
+    long long thumbnails;
+    long long fileSize;
+    long long garbageSize;
+    long long cachedImages;
+};
+
+// An encoded thumbnail. The data points into the memory mapped store file and stays valid while the
+// thumbnail holds the mapping, even if the store is compacted or freed in the meantime. It is read-only
+// unless the thumbnail was mapped with MapTrackerFaceThumbnail.
+struct Thumbnail {
+    const unsigned char* data;
+    long long size;
+    std::shared_ptr<const void> mapping;
+};
+
+// A store of face thumbnails kept outside of tracker memory. Images are downscaled so that their larger
+// side does not exceed MaxSize and are kept as JPEG files (encoded with the quality set by
+// FSDK_SetJpegCompressionQuality) appended to a memory mapped file, which is compacted when more than
+// half of it is taken by replaced or deleted thumbnails. Up to MaxCachedImages decoded images are kept
+// in memory, the least recently used are freed first. Thumbnails are keyed by face ID, so a store holds
+// the faces of one tracker.
+int CreateThumbnailStore(const char* FileName, int MaxSize, long long MaxCachedImages, HThumbnailStore* Store);
+int FreeThumbnailStore(HThumbnailStore Store);
+int CompactThumbnailStore(HThumbnailStore Store);
+int GetThumbnailStoreStatistics(HThumbnailStore Store, ThumbnailStoreStatistics* Statistics);
+
+int ThumbnailStoreSetImage(HThumbnailStore Store, long long FaceID, HImage Image);
+// Creates a new image which must be freed by the caller, the same way FSDK_GetTrackerFaceImage does.
+int ThumbnailStoreGetImage(HThumbnailStore Store, long long FaceID, HImage* Image);
+int ThumbnailStoreGetThumbnail(HThumbnailStore Store, long long FaceID, Thumbnail* Thumbnail);
+int ThumbnailStoreDeleteImage(HThumbnailStore Store, long long FaceID);
+
+// Face images of a tracker with an attached store are kept in the store instead of tracker memory.
+// Passing 0 as the store detaches it. Images set before the store was attached are still returned
+// from tracker memory until they are replaced or deleted. Attaching deletes the thumbnails of faces
+// the tracker does not have, so a store outlives the tracker only together with its saved memory.
+int AttachThumbnailStore(HTracker Tracker, HThumbnailStore Store);
+int SetTrackerFaceImage(HTracker Tracker, long long FaceID, HImage Image);
+int GetTrackerFaceImage(HTracker Tracker, long long FaceID, HImage* Image);
+int DeleteTrackerFaceImage(HTracker Tracker, long long FaceID);
+// Fails with FSDKE_FACEIMAGE_NOT_FOUND if the tracker has no store attached or the face has no thumbnail.
+int GetTrackerFaceThumbnail(HTracker Tracker, long long FaceID, Thumbnail* Thumbnail);
+// Maps the thumbnail copy-on-write, so the data may be handed out as writable memory (i.e. a JavaScript
+// ArrayBuffer) without copying it and without letting writes reach the store.
+int MapTrackerFaceThumbnail(HTracker Tracker, long long FaceID, Thumbnail* Thumbnail);
+
+// FSDK_PurgeID, FSDK_DeleteTrackerFace and FSDK_ClearTracker leave the thumbnails of the removed faces in
+// the store, so the module goes through these instead: they call the FSDK_ function under the tracker lock
+// and delete the thumbnails. Clearing starts a new generation of the store, so thumbnails are never
+// returned for the face IDs the tracker hands out again. Thumbnails of faces removed otherwise are
+// deleted when they are read.
+int PurgeID(HTracker Tracker, long long ID);
+int DeleteTrackerFace(HTracker Tracker, long long FaceID);
+int ClearTracker(HTracker Tracker);
+
+// For callers purging IDs under their own tracker lock (the memory governor): the face IDs of the ID are
+// taken with the tracker locked, and their thumbnails deleted after the purge with DeleteTrackerThumbnails,
+// which does not lock the tracker.
+int GetTrackerFaceIDs(HTracker Tracker, long long ID, std::vector<long long>* FaceIDs);
+int DeleteTrackerThumbnails(HTracker Tracker, const std::vector<long long>& FaceIDs);
+
+// Must be called when the tracker is freed: detaches its store.
+void ReleaseTrackerThumbnails(HTracker Tracker);
+
+}
@@ -0,0 +1,188 @@
+#include "FSDKTiledDetection.h"
+#include "FSDKParallel.h"
+
+#include <algorithm>
+#include <climits>
+#include <vector>
+
+namespace fsdk {
+
+namespace {
+
+struct Tile {
+    int x, y, width, height;
+    bool whole;
+};
+
+struct Candidate {
+    TFace face;
+    // Distance from the box to the nearest tile edge lying inside the image. Boxes close to such
+    // an edge are likely truncated, so duplicates prefer the detection with the largest margin.
+    int margin;
+};
+
+std::vector<int> TileOrigins(int length, int tileSize, int step) {
+    std::vector<int> origins;
+    if (length <= tileSize) {
+        origins.push_back(0);
+        return origins;
+    }
+    for (int origin = 0; origin + tileSize < length; origin += step)
+        origins.push_back(origin);
+    origins.push_back(length - tileSize);
+    return origins;
+}
+
+long long Area(const TFace& face) {
+    return (long long)std::max(0, face.bbox.p1.x - face.bbox.p0.x) * std::max(0, face.bbox.p1.y - face.bbox.p0.y);
+}
+
+int Margin(const TFace& face, const Tile& tile, int imageWidth, int imageHeight) {
+    if (tile.whole)
+        return INT_MAX;
+    int margin = INT_MAX;
+    if (tile.x > 0)
+        margin = std::min(margin, face.bbox.p0.x - tile.x);
+    if (tile.y > 0)
+        margin = std::min(margin, face.bbox.p0.y - tile.y);
+    if (tile.x + tile.width < imageWidth)
+        margin = std::min(margin, tile.x + tile.width - face.bbox.p1.x);
+    if (tile.y + tile.height < imageHeight)
+        margin = std::min(margin, tile.y + tile.height - face.bbox.p1.y);
+    return margin;
+}
+
+bool Overlaps(const TFace& a, const TFace& b, float iouThreshold) {
+    const int width = std::min(a.bbox.p1.x, b.bbox.p1.x) - std::max(a.bbox.p0.x, b.bbox.p0.x);
+    const int height = std::min(a.bbox.p1.y, b.bbox.p1.y) - std::max(a.bbox.p0.y, b.bbox.p0.y);
+    if (width <= 0 || height <= 0)
+        return false;
+
+    const double intersection = (double)width * height;
+    const double areaA = (double)Area(a);
+    const double areaB = (double)Area(b);
+    const double smaller = std::min(areaA, areaB);
+    // A face cut by a tile border is mostly contained in the complete detection from the neighbouring tile.
+    if (smaller > 0 && intersection / smaller > 0.8)
+        return true;
+    return intersection / (areaA + areaB - intersection) > iouThreshold;
+}
+
+}
+
+int DetectMultipleFacesTiled(HImage Image, const TiledDetectionParameters& Parameters, int* DetectedCount, TFace* FaceArray, int MaxSize) {
+    if (!DetectedCount || !FaceArray)
+        return FSDKE_INVALID_ARGUMENT;
+    *DetectedCount = 0;
+
+    const int maxFaces = MaxSize / (int)sizeof(TFace);
+    if (maxFaces <= 0)
+        return FSDKE_INSUFFICIENT_BUFFER_SIZE;
+    if (Parameters.tileSize <= 0 || Parameters.overlap < 0 || Parameters.overlap >= Parameters.tileSize)
+        return FSDKE_INVALID_ARGUMENT;
+
+    int width = 0, height = 0;
+    int errorCode = FSDK_GetImageWidth(Image, &width);
+    if (errorCode == FSDKE_OK)
+        errorCode = FSDK_GetImageHeight(Image, &height);
+    if (errorCode != FSDKE_OK)
+        return errorCode;
+
+    if (width <= Parameters.tileSize && height <= Parameters.tileSize)
+        return FSDK_DetectMultipleFaces2(Image, DetectedCount, FaceArray, MaxSize);
+
+    const int step = Parameters.tileSize - Parameters.overlap;
+    std::vector<Tile> tiles;
+    for (int y : TileOrigins(height, Parameters.tileSize, step))
+        for (int x : TileOrigins(width, Parameters.tileSize, step))
+            tiles.push_back({x, y, std::min(Parameters.tileSize, width - x), std::min(Parameters.tileSize, height - y), false});
+    if (Parameters.fullImagePass)
+        tiles.push_back({0, 0, width, height, true});
+
+    const int tileCount = (int)tiles.size();
+    const int workers = ResolveThreadCount(Parameters.threads, tileCount);
+
+    // Tile images are reused by each worker to avoid allocating a new image per tile.
+    std::vector<HImage> tileImages(workers, 0);
+    std::vector<int> tileImageErrors(workers, FSDKE_OK);
+    for (int worker = 0; worker < workers; ++worker)
+        tileImageErrors[worker] = FSDK_CreateEmptyImage(&tileImages[worker]);
+
+    std::vector<std::vector<Candidate>> detections(tileCount);
+    std::vector<int> errors(tileCount, FSDKE_OK);
+
+    ParallelFor(tileCount, workers, [&](int worker, int index) {
+        const Tile& tile = tiles[index];
+        if (tileImageErrors[worker] != FSDKE_OK) {
+            errors[index] = tileImageErrors[worker];
+            return;
+        }
+
+        HImage source = Image;
+        if (!tile.whole) {
+            errors[index] = FSDK_CopyRect(Image, tile.x, tile.y, tile.x + tile.width - 1, tile.y + tile.height - 1, tileImages[worker]);
+            if (errors[index] != FSDKE_OK)
+                return;
+            source = tileImages[worker];
+        }
+
+        std::vector<TFace> faces(maxFaces);
+        int count = 0;
+        const int error = FSDK_DetectMultipleFaces2(source, &count, faces.data(), (int)(sizeof(TFace) * faces.size()));
+        if (error == FSDKE_FACE_NOT_FOUND)
+            return;
+        if (error != FSDKE_OK) {
+            errors[index] = error;
+            return;
+        }
+
+        auto& result = detections[index];
+        result.reserve(count);
+        for (int i = 0; i < count; ++i) {
+            TFace face = faces[i];
+            face.bbox.p0.x += tile.x;
+            face.bbox.p0.y += tile.y;
+            face.bbox.p1.x += tile.x;
+            face.bbox.p1.y += tile.y;
+            for (auto& point : face.features) {
+                point.x += tile.x;
+                point.y += tile.y;
+            }
+            result.push_back({face, Margin(face, tile, width, height)});
+        }
+    });
+
+    for (HImage tileImage : tileImages)
+        if (tileImage)
+            FSDK_FreeImage(tileImage);
+
+    for (int error : errors)
+        if (error != FSDKE_OK)
+            return error;
+
+    std::vector<Candidate> candidates;
+    for (auto& result : detections)
+        candidates.insert(candidates.end(), result.begin(), result.end());
+
+    std::stable_sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+        if (a.margin != b.margin)
+            return a.margin > b.margin;
+        return Area(a.face) > Area(b.face);
+    });
+
+    int count = 0;
+    for (const auto& candidate : candidates) {
+        if (count == maxFaces)
+            break;
+        bool duplicate = false;
+        for (int i = 0; i < count && !duplicate; ++i)
+            duplicate = Overlaps(candidate.face, FaceArray[i], Parameters.iouThreshold);
+        if (!duplicate)
+            FaceArray[count++] = candidate.face;
+    }
+
+    *DetectedCount = count;
+    return count > 0 ? FSDKE_OK : FSDKE_FACE_NOT_FOUND;
+}
+
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "LuxandFaceSDK.h"
+
+namespace fsdk {
+
+struct TiledDetectionParameters {
+    // Side of a square tile in pixels. Images that fit into a single tile are detected directly.
+    int tileSize = 1024;
+    // Number of pixels shared by neighbouring tiles. Should be at least the size of the smallest
+    // face of interest, otherwise faces lying on a tile border may be missed.
+    int overlap = 128;
+    // Number of worker threads, 0 selects the number of hardware threads.
+    int threads = 0;
+    // Also run detection on the whole image to catch faces larger than a tile.
+    bool fullImagePass = true;
+    // Detections overlapping with IoU above the threshold, or mostly contained in another one, are merged.
+    float iouThreshold = 0.4f;
+};
+
+// Splits the image into overlapping tiles, runs FSDK_DetectMultipleFaces2 on the tiles in parallel,
+// maps the detections back to image coordinates and merges duplicates found in several tiles.
+// The signature follows FSDK_DetectMultipleFaces2: MaxSize is the size of FaceArray in bytes.
+int DetectMultipleFacesTiled(HImage Image, const TiledDetectionParameters& Parameters, int* DetectedCount, TFace* FaceArray, int MaxSize);
+
+}
@@ -0,0 +1,223 @@
+#include "FSDKTrace.h"
+
+#include "LuxandFaceSDK.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+namespace fsdk::trace {
+
+namespace {
+
+// A slot is guarded by a sequence number: odd while a writer fills it, 2 * (index + 1) once span
+// number `index` is complete. Readers skip slots whose sequence changes while they are copied.
+struct Slot {
+    std::atomic<unsigned long long> sequence{0};
+    std::atomic<const char*> name{nullptr};
+    std::atomic<long long> frameTimestamp{0};
+    std::atomic<long long> start{0};
+    std::atomic<long long> end{0};
+    std::atomic<int> thread{0};
+};
+
+struct Ring {
+    explicit Ring(int capacity) : slots(capacity), mask(capacity - 1) {}
+
+    std::vector<Slot> slots;
+    const unsigned long long mask;
+    std::atomic<unsigned long long> head{0};
+    // Spans numbered below base were recorded before the last Clear() and are not exported
+    std::atomic<unsigned long long> base{0};
+};
+
+std::atomic<bool> enabled{false};
+std::atomic<Ring*> ring{nullptr};
+// Record() calls that may hold the current ring, so a ring replaced by Enable() is freed once none does
+std::atomic<int> writers{0};
+
+std::mutex& Mutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+std::unique_ptr<Ring>& OwnedRing() {
+    static std::unique_ptr<Ring> owned;
+    return owned;
+}
+
+std::unordered_set<std::string>& Names() {
+    static std::unordered_set<std::string> names;
+    return names;
+}
+
+int ThreadIndex() {
+    static std::atomic<int> next{1};
+    thread_local const int index = next++;
+    return index;
+}
+
+thread_local long long frameTimestamp = -1;
+
+void AppendEscaped(std::string& out, const char* value) {
+    for (; *value; ++value) {
+        const char c = *value;
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if ((unsigned char)c < 0x20) {
+            out += ' ';
+        } else {
+            out += c;
+        }
+    }
+}
+
+}
+
+bool Enabled() {
+    return enabled.load(std::memory_order_relaxed);
+}
+
+void Enable(int capacity) {
+    int size = 1;
+    while (size < std::max(capacity, 16))
+        size <<= 1;
+
+    std::lock_guard<std::mutex> lock(Mutex());
+    Ring* current = ring.load();
+    if (!current || (int)current->slots.size() != size) {
+        std::unique_ptr<Ring> retired = std::move(OwnedRing());
+        OwnedRing() = std::make_unique<Ring>(size);
+        ring.store(OwnedRing().get());
+        // A writer that loaded the retired ring incremented writers first
+        while (retired && writers.load() != 0)
+            std::this_thread::yield();
+    }
+    enabled.store(true);
+}
+
+void Disable() {
+    enabled.store(false);
+}
+
+void Clear() {
+    std::lock_guard<std::mutex> lock(Mutex());
+    Ring* current = ring.load();
+    if (current)
+        current->base.store(current->head.load());
+}
+
+long long Now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void SetFrameTimestamp(long long timestamp) {
+    frameTimestamp = timestamp;
+}
+
+long long FrameTimestamp() {
+    return frameTimestamp;
+}
+
+void Record(const char* name, long long frameTimestamp, long long start, long long end) {
+    if (!Enabled())
+        return;
+    writers.fetch_add(1);
+    Ring* current = ring.load();
+    if (!current) {
+        writers.fetch_sub(1, std::memory_order_release);
+        return;
+    }
+    if (frameTimestamp < 0)
+        frameTimestamp = trace::frameTimestamp;
+
+    const unsigned long long index = current->head.fetch_add(1, std::memory_order_relaxed);
+    Slot& slot = current->slots[index & current->mask];
+
+    slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.frameTimestamp.store(frameTimestamp, std::memory_order_relaxed);
+    slot.start.store(start, std::memory_order_relaxed);
+    slot.end.store(end, std::memory_order_relaxed);
+    slot.thread.store(ThreadIndex(), std::memory_order_relaxed);
+    slot.sequence.store(2 * (index + 1), std::memory_order_release);
+    writers.fetch_sub(1, std::memory_order_release);
+}
+
+void RecordCopy(const std::string& name, long long frameTimestamp, long long start, long long end) {
+    if (!Enabled())
+        return;
+    const char* interned;
+    {
+        std::lock_guard<std::mutex> lock(Mutex());
+        interned = Names().insert(name).first->c_str();
+    }
+    Record(interned, frameTimestamp, start, end);
+}
+
+std::string Dump() {
+    std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    // Holding the mutex keeps Enable() from freeing the ring while it is read
+    std::lock_guard<std::mutex> lock(Mutex());
+    Ring* current = ring.load(std::memory_order_acquire);
+    if (current) {
+        const unsigned long long head = current->head.load(std::memory_order_acquire);
+        const unsigned long long size = current->slots.size();
+        const unsigned long long first = std::max(current->base.load(std::memory_order_acquire), head > size ? head - size : 0);
+
+        bool comma = false;
+        char buffer[256];
+        for (unsigned long long index = first; index < head; ++index) {
+            const Slot& slot = current->slots[index & current->mask];
+            const unsigned long long sequence = slot.sequence.load(std::memory_order_acquire);
+            if (sequence != 2 * (index + 1))
+                continue;
+
+            const char* name = slot.name.load(std::memory_order_relaxed);
+            const long long frame = slot.frameTimestamp.load(std::memory_order_relaxed);
+            const long long start = slot.start.load(std::memory_order_relaxed);
+            const long long end = slot.end.load(std::memory_order_relaxed);
+            const int thread = slot.thread.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_relaxed) != sequence || !name)
+                continue;
+
+            if (comma)
+                json += ',';
+            comma = true;
+
+            json += "{\"name\":\"";
+            AppendEscaped(json, name);
+            snprintf(buffer, sizeof(buffer), "\",\"cat\":\"fsdk\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"frame\":%lld}}",
+                     thread, start / 1000.0, std::max(0ll, end - start) / 1000.0, frame);
+            json += buffer;
+        }
+    }
+
+    json += "]}";
+    return json;
+}
+
+int Save(const char* filename) {
+    if (!filename)
+        return FSDKE_INVALID_ARGUMENT;
+
+    FILE* file = fopen(filename, "wb");
+    if (!file)
+        return FSDKE_CANNOT_CREATE_FILE;
+
+    const std::string json = Dump();
+    const bool written = fwrite(json.data(), 1, json.size(), file) == json.size();
+    return fclose(file) == 0 && written ? FSDKE_OK : FSDKE_IO_ERROR;
+}
+
+}
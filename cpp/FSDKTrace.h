@@ -0,0 +1,51 @@
+#pragma once
+
+#include <string>
+
+// Frame latency tracing. Spans are written into a fixed size lock-free ring buffer and can be
+// exported in the Chrome trace event format (chrome://tracing, https://ui.perfetto.dev).
+// Every span carries the timestamp of the camera frame it belongs to, so the stages of one
+// frame can be followed across threads. When tracing is disabled recording a span costs a
+// single relaxed atomic load.
+namespace fsdk::trace {
+
+bool Enabled();
+
+// Enables tracing into a ring buffer holding the last `capacity` spans (rounded up to a power of two).
+void Enable(int capacity);
+void Disable();
+void Clear();
+
+// Monotonic time in nanoseconds used for span timestamps.
+long long Now();
+
+// The camera frame timestamp attached to spans recorded on the calling thread without an explicit timestamp.
+void SetFrameTimestamp(long long frameTimestamp);
+long long FrameTimestamp();
+
+// Records a finished span. Names passed to Record must outlive the trace, RecordCopy interns the name.
+// A negative frame timestamp attributes the span to the frame set on the calling thread.
+void Record(const char* name, long long frameTimestamp, long long start, long long end);
+void RecordCopy(const std::string& name, long long frameTimestamp, long long start, long long end);
+
+// Writes the recorded spans as a Chrome trace event JSON document.
+std::string Dump();
+int Save(const char* filename);
+
+class Span {
+public:
+    explicit Span(const char* name) : name(Enabled() ? name : nullptr), start(this->name ? Now() : 0) {}
+    ~Span() {
+        if (name)
+            Record(name, FrameTimestamp(), start, Now());
+    }
+
+    Span(const Span&) = delete;
+    Span& operator=(const Span&) = delete;
+
+private:
+    const char* name;
+    long long start;
+};
+
+}
@@ -0,0 +1,105 @@
+#include "FSDKTrackerLock.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace fsdk {
+
+// A phase-fair reader/writer lock. std::shared_mutex prefers readers on glibc and bionic, so a tracker read
+// continuously from several threads would never be fed. Here a waiting writer stops new readers, and the
+// readers that were waiting when a writer unlocks go before the next writer, so neither side starves.
+class TrackerMutex {
+public:
+    void Lock() {
+        std::unique_lock<std::mutex> lock(mutex);
+        ++waitingWriters;
+        writerCondition.wait(lock, [this] { return !writer && readers == 0 && !readerPhase; });
+        --waitingWriters;
+        writer = true;
+    }
+
+    void Unlock() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            writer = false;
+            readerPhase = waitingReaders > 0;
+        }
+        readerCondition.notify_all();
+        writerCondition.notify_one();
+    }
+
+    void LockShared() {
+        std::unique_lock<std::mutex> lock(mutex);
+        ++waitingReaders;
+        readerCondition.wait(lock, [this] { return !writer && (waitingWriters == 0 || readerPhase); });
+        if (--waitingReaders == 0)
+            readerPhase = false;
+        ++readers;
+    }
+
+    void UnlockShared() {
+        bool last;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            last = --readers == 0;
+        }
+        if (last)
+            writerCondition.notify_one();
+    }
+
+private:
+    std::mutex mutex;
+    std::condition_variable readerCondition;
+    std::condition_variable writerCondition;
+    int readers = 0;
+    int waitingReaders = 0;
+    int waitingWriters = 0;
+    bool writer = false;
+    // Set when a writer unlocks with readers waiting, until all of them are in
+    bool readerPhase = false;
+};
+
+namespace {
+
+// Lookups of existing trackers only read the map, so locking different trackers does not contend
+std::shared_mutex trackersMutex;
+std::unordered_map<HTracker, std::shared_ptr<TrackerMutex>> trackerMutexes;
+
+std::shared_ptr<TrackerMutex> GetTrackerMutex(HTracker tracker) {
+    {
+        std::shared_lock<std::shared_mutex> lock(trackersMutex);
+        const auto it = trackerMutexes.find(tracker);
+        if (it != trackerMutexes.end())
+            return it->second;
+    }
+    std::unique_lock<std::shared_mutex> lock(trackersMutex);
+    auto& mutex = trackerMutexes[tracker];
+    if (!mutex)
+        mutex = std::make_shared<TrackerMutex>();
+    return mutex;
+}
+
+}
+
+TrackerLock::TrackerLock(HTracker Tracker, Mode Mode) : mutex(GetTrackerMutex(Tracker)), mode(Mode) {
+    if (mode == EXCLUSIVE)
+        mutex->Lock();
+    else
+        mutex->LockShared();
+}
+
+TrackerLock::~TrackerLock() {
+    if (mode == EXCLUSIVE)
+        mutex->Unlock();
+    else
+        mutex->UnlockShared();
+}
+
+void ReleaseTrackerLock(HTracker Tracker) {
+    std::unique_lock<std::shared_mutex> lock(trackersMutex);
+    trackerMutexes.erase(Tracker);
+}
+
+}
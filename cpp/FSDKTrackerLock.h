@@ -0,0 +1,38 @@
+#pragma once
+
+#include "LuxandFaceSDK.h"
+
+#include <memory>
+
+// Every tracker has a reader/writer lock. Calls changing the tracker (FSDK_FeedFrame, setting parameters,
+// names, templates and face images, locking, purging and clearing IDs, freeing) hold it exclusively, calls
+// reading it (faces, features, attributes, names, IDs, templates, parameters, matching and saving) hold it
+// shared. Trackers do not share locks, so trackers fed from different threads run in parallel.
+//
+// The module methods lock around the FSDK_ calls they make. Functions of this folder taking an HTracker
+// (thumbnails, memory governor, keyframe tracker, result slot) lock the tracker themselves and must be
+// called without holding its lock: the locks are not recursive.
+namespace fsdk {
+
+class TrackerMutex;
+
+class TrackerLock {
+public:
+    enum Mode { SHARED, EXCLUSIVE };
+
+    TrackerLock(HTracker Tracker, Mode Mode);
+    ~TrackerLock();
+
+    TrackerLock(const TrackerLock&) = delete;
+    TrackerLock& operator=(const TrackerLock&) = delete;
+
+private:
+    // Kept alive by the lock, so ReleaseTrackerLock does not pull the mutex from under its holders
+    const std::shared_ptr<TrackerMutex> mutex;
+    const Mode mode;
+};
+
+// Must be called after the tracker is freed.
+void ReleaseTrackerLock(HTracker Tracker);
+
+}
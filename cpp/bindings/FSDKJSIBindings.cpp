@@ -0,0 +1,253 @@
+#include "FSDKJSIBindings.h"
+#include "FSDKFaceAtlas.h"
+#include "FSDKResultSlot.h"
+#include "FSDKThumbnailStore.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+
+namespace jsi = facebook::jsi;
+
+namespace fsdk {
+
+namespace {
+
+// Reads the latest snapshot of a result slot. Reading only touches the front buffer of the slot, so it
+// takes no locks and does not allocate except for the strings it returns. The slot pointer holds the reader
+// claim of the slot, which is released when the reader and all of its methods are gone.
+class ResultSlotReader : public jsi::HostObject {
+public:
+    explicit ResultSlotReader(std::shared_ptr<ResultSlot> slot) : slot(std::move(slot)) {}
+
+    jsi::Value get(jsi::Runtime& runtime, const jsi::PropNameID& propertyName) override {
+        const std::string name = propertyName.utf8(runtime);
+        const ResultSnapshot& snapshot = slot->Front();
+
+        if (name == "sequence")
+            return (double)snapshot.sequence;
+        if (name == "timestamp")
+            return (double)snapshot.timestamp;
+        if (name == "count")
+            return snapshot.count;
+        if (name == "stride")
+            return slot->NumberStride();
+
+        // Takes the latest published snapshot, returns false if there is nothing new
+        if (name == "update")
+            return Method(runtime, propertyName, updateMethod, 0, [](ResultSlot& slot, jsi::Runtime&, const jsi::Value*, size_t) {
+                return jsi::Value(slot.Update());
+            });
+
+        // Copies the numbers of the snapshot into a Float64Array, returns the number of faces copied
+        if (name == "read")
+            return Method(runtime, propertyName, readMethod, 1, [](ResultSlot& slot, jsi::Runtime& runtime, const jsi::Value* arguments, size_t count) {
+                if (count < 1 || !arguments[0].isObject())
+                    throw jsi::JSError(runtime, "read expects a Float64Array");
+                const jsi::Object array = arguments[0].getObject(runtime);
+                const jsi::Value buffer = array.getProperty(runtime, "buffer");
+                if (!buffer.isObject() || !buffer.getObject(runtime).isArrayBuffer(runtime))
+                    throw jsi::JSError(runtime, "read expects a Float64Array");
+
+                const size_t offset = (size_t)array.getProperty(runtime, "byteOffset").asNumber();
+                const size_t length = (size_t)array.getProperty(runtime, "byteLength").asNumber();
+                uint8_t* data = buffer.getObject(runtime).getArrayBuffer(runtime).data(runtime) + offset;
+
+                const ResultSnapshot& snapshot = slot.Front();
+                const int stride = slot.NumberStride();
+                const int faces = std::min(snapshot.count, (int)(length / sizeof(double) / stride));
+                memcpy(data, snapshot.numbers.data(), (size_t)faces * stride * sizeof(double));
+                return jsi::Value(faces);
+            });
+
+        // The name of the face
+        if (name == "name")
+            return Method(runtime, propertyName, nameMethod, 1, [](ResultSlot& slot, jsi::Runtime& runtime, const jsi::Value* arguments, size_t count) {
+                const char* text = Text(slot, runtime, arguments, count, 0);
+                return text ? jsi::Value(jsi::String::createFromUtf8(runtime, (const uint8_t*)text, strlen(text))) : jsi::Value::undefined();
+            });
+
+        // The raw value of an attribute of the face
+        if (name == "attribute")
+            return Method(runtime, propertyName, attributeMethod, 2, [](ResultSlot& slot, jsi::Runtime& runtime, const jsi::Value* arguments, size_t count) {
+                const int attribute = count > 1 && arguments[1].isNumber() ? (int)arguments[1].getNumber() : -1;
+                if (attribute < 0 || attribute >= (int)slot.Attributes().size())
+                    return jsi::Value::undefined();
+                const char* text = Text(slot, runtime, arguments, count, attribute + 1);
+                return text ? jsi::Value(jsi::String::createFromUtf8(runtime, (const uint8_t*)text, strlen(text))) : jsi::Value::undefined();
+            });
+
+        return jsi::Value::undefined();
+    }
+
+    std::vector<jsi::PropNameID> getPropertyNames(jsi::Runtime& runtime) override {
+        std::vector<jsi::PropNameID> names;
+        for (const char* name : {"sequence", "timestamp", "count", "stride", "update", "read", "name", "attribute"})
+            names.push_back(jsi::PropNameID::forAscii(runtime, name));
+        return names;
+    }
+
+private:
+    typedef jsi::Value (*MethodFunction)(ResultSlot& slot, jsi::Runtime& runtime, const jsi::Value* arguments, size_t count);
+
+    // Methods are created on first access and returned from the cache afterwards. They keep the slot alive, so
+    // they stay valid when kept apart from the reader.
+    jsi::Value Method(jsi::Runtime& runtime, const jsi::PropNameID& name, std::unique_ptr<jsi::Function>& cache, unsigned int parameters,
+                      MethodFunction function) {
+        if (!cache) {
+            auto target = slot;
+            cache = std::make_unique<jsi::Function>(jsi::Function::createFromHostFunction(
+                runtime, name, parameters, [target, function](jsi::Runtime& runtime, const jsi::Value&, const jsi::Value* arguments, size_t count) {
+                    return function(*target, runtime, arguments, count);
+                }));
+        }
+        return jsi::Value(runtime, *cache);
+    }
+
+    // The text of a face in the front snapshot, nullptr for an invalid face index.
+    static const char* Text(ResultSlot& slot, jsi::Runtime&, const jsi::Value* arguments, size_t count, int column) {
+        const ResultSnapshot& snapshot = slot.Front();
+        const int face = count > 0 && arguments[0].isNumber() ? (int)arguments[0].getNumber() : -1;
+        if (face < 0 || face >= snapshot.count)
+            return nullptr;
+        return &snapshot.text[(size_t)face * slot.TextStride() + (size_t)column * ResultSlot::TEXT_SIZE];
+    }
+
+    const std::shared_ptr<ResultSlot> slot;
+    std::unique_ptr<jsi::Function> updateMethod, readMethod, nameMethod, attributeMethod;
+};
+
+// A thumbnail mapped copy-on-write, so JavaScript gets it without a copy and may write into the buffer
+// without changing the store. The mapping is released when the ArrayBuffer is collected.
+class ThumbnailBuffer : public jsi::MutableBuffer {
+public:
+    explicit ThumbnailBuffer(Thumbnail thumbnail) : thumbnail(std::move(thumbnail)) {}
+
+    size_t size() const override { return (size_t)thumbnail.size; }
+    uint8_t* data() override { return const_cast<uint8_t*>(thumbnail.data); }
+
+private:
+    const Thumbnail thumbnail;
+};
+
+// Zero filled native memory aligned like the rows of a face atlas, which the native code writes into and
+// JavaScript reads without a copy. It is freed when the ArrayBuffer is collected.
+class AlignedBuffer : public jsi::MutableBuffer {
+public:
+    explicit AlignedBuffer(size_t size) : length(size) {
+        void* memory = nullptr;
+        if (posix_memalign(&memory, FACE_ATLAS_ALIGNMENT, std::max<size_t>(size, 1)) != 0)
+            throw std::bad_alloc();
+        memset(memory, 0, size);
+        bytes = static_cast<uint8_t*>(memory);
+    }
+    ~AlignedBuffer() override { free(bytes); }
+
+    AlignedBuffer(const AlignedBuffer&) = delete;
+    AlignedBuffer& operator=(const AlignedBuffer&) = delete;
+
+    size_t size() const override { return length; }
+    uint8_t* data() override { return bytes; }
+
+private:
+    const size_t length;
+    uint8_t* bytes;
+};
+
+// A typed array view of the global Type constructor over Length elements of Buffer starting at Offset bytes
+jsi::Value TypedArray(jsi::Runtime& runtime, const char* type, const jsi::ArrayBuffer& buffer, size_t offset, size_t length) {
+    return runtime.global().getPropertyAsFunction(runtime, type).callAsConstructor(runtime, buffer, (double)offset, (double)length);
+}
+
+// Arguments are image, features, count, width, height, imageMode and threads. Features is an Int32Array of
+// x, y pairs, FSDK_FACIAL_FEATURE_COUNT points per face, which is the layout of FSDK_Features, so it is
+// passed to ExtractFaceAtlas as it is. The atlas, the resized features and the error codes are written
+// straight into the native memory of the returned ArrayBuffers.
+jsi::Value ExtractFaceAtlasArrays(jsi::Runtime& runtime, const jsi::Value* arguments, size_t count) {
+    if (count < 7 || !arguments[1].isObject())
+        return jsi::Value(FSDKE_INVALID_ARGUMENT);
+    for (const size_t argument : {0, 2, 3, 4, 5, 6})
+        if (!arguments[argument].isNumber())
+            return jsi::Value(FSDKE_INVALID_ARGUMENT);
+    const int faces = (int)arguments[2].getNumber();
+    const int width = (int)arguments[3].getNumber();
+    const int height = (int)arguments[4].getNumber();
+    const FSDK_IMAGEMODE imageMode = (FSDK_IMAGEMODE)arguments[5].getNumber();
+
+    FaceAtlasLayout layout = {};
+    const int errorCode = GetFaceAtlasLayout(faces, width, height, imageMode, &layout);
+    if (errorCode != FSDKE_OK)
+        return jsi::Value(errorCode);
+
+    const jsi::Object features = arguments[1].getObject(runtime);
+    const jsi::Value buffer = features.getProperty(runtime, "buffer");
+    const jsi::Value elementSize = features.getProperty(runtime, "BYTES_PER_ELEMENT");
+    if (!buffer.isObject() || !buffer.getObject(runtime).isArrayBuffer(runtime) || !elementSize.isNumber() || elementSize.getNumber() != sizeof(int) ||
+        (size_t)features.getProperty(runtime, "byteLength").asNumber() < (size_t)faces * sizeof(FSDK_Features))
+        return jsi::Value(FSDKE_INVALID_ARGUMENT);
+    static_assert(sizeof(FSDK_Features) == FSDK_FACIAL_FEATURE_COUNT * 2 * sizeof(int), "features are packed as x, y pairs");
+    const size_t offset = (size_t)features.getProperty(runtime, "byteOffset").asNumber();
+    const auto* inputFeatures = reinterpret_cast<const FSDK_Features*>(buffer.getObject(runtime).getArrayBuffer(runtime).data(runtime) + offset);
+
+    const auto atlas = std::make_shared<AlignedBuffer>((size_t)layout.size);
+    const auto resizedFeatures = std::make_shared<AlignedBuffer>((size_t)faces * sizeof(FSDK_Features));
+    const auto errorCodes = std::make_shared<AlignedBuffer>((size_t)faces * sizeof(int));
+    ExtractFaceAtlas((HImage)arguments[0].getNumber(), inputFeatures, faces, width, height, imageMode, (int)arguments[6].getNumber(),
+                           atlas->data(), reinterpret_cast<FSDK_Features*>(resizedFeatures->data()), reinterpret_cast<int*>(errorCodes->data()));
+
+    const jsi::ArrayBuffer atlasBuffer(runtime, atlas);
+    jsi::Array views(runtime, (size_t)faces);
+    for (int face = 0; face < faces; ++face)
+        views.setValueAtIndex(runtime, (size_t)face, TypedArray(runtime, "Uint8Array", atlasBuffer, (size_t)(face * layout.faceSize), (size_t)layout.faceSize));
+
+    jsi::Object result(runtime);
+    result.setProperty(runtime, "buffer", jsi::Value(runtime, atlasBuffer));
+    result.setProperty(runtime, "faces", jsi::Value(std::move(views)));
+    result.setProperty(runtime, "features", TypedArray(runtime, "Int32Array", jsi::ArrayBuffer(runtime, resizedFeatures), 0,
+                                                       (size_t)faces * FSDK_FACIAL_FEATURE_COUNT * 2));
+    result.setProperty(runtime, "errorCodes", TypedArray(runtime, "Int32Array", jsi::ArrayBuffer(runtime, errorCodes), 0, (size_t)faces));
+    result.setProperty(runtime, "channels", jsi::Value(layout.channels));
+    result.setProperty(runtime, "stride", jsi::Value(layout.stride));
+    result.setProperty(runtime, "faceSize", jsi::Value((double)layout.faceSize));
+    return jsi::Value(std::move(result));
+}
+
+}
+
+void InstallJSIBindings(jsi::Runtime& Runtime) {
+    auto createReader = jsi::Function::createFromHostFunction(
+        Runtime, jsi::PropNameID::forAscii(Runtime, "__FSDKCreateResultSlotReader"), 1,
+        [](jsi::Runtime& runtime, const jsi::Value&, const jsi::Value* arguments, size_t count) {
+            const auto slot = count > 0 && arguments[0].isNumber() ? GetResultSlot((HResultSlot)arguments[0].getNumber()) : nullptr;
+            if (!slot)
+                return jsi::Value::undefined();
+            // A slot has a single front buffer, so a second reader would take snapshots from under the first one
+            if (!slot->AcquireReader())
+                return jsi::Value::null();
+            const std::shared_ptr<ResultSlot> claimed(slot.get(), [slot](ResultSlot*) { slot->ReleaseReader(); });
+            return jsi::Value(jsi::Object::createFromHostObject(runtime, std::make_shared<ResultSlotReader>(claimed)));
+        });
+    Runtime.global().setProperty(Runtime, "__FSDKCreateResultSlotReader", std::move(createReader));
+
+    auto getThumbnail = jsi::Function::createFromHostFunction(
+        Runtime, jsi::PropNameID::forAscii(Runtime, "__FSDKGetTrackerFaceThumbnail"), 2,
+        [](jsi::Runtime& runtime, const jsi::Value&, const jsi::Value* arguments, size_t count) {
+            if (count < 2 || !arguments[0].isNumber() || !arguments[1].isNumber())
+                return jsi::Value(FSDKE_INVALID_ARGUMENT);
+            Thumbnail thumbnail = {};
+            const int errorCode = MapTrackerFaceThumbnail((HTracker)arguments[0].getNumber(), (long long)arguments[1].getNumber(), &thumbnail);
+            if (errorCode != FSDKE_OK)
+                return jsi::Value(errorCode);
+            return jsi::Value(jsi::ArrayBuffer(runtime, std::make_shared<ThumbnailBuffer>(std::move(thumbnail))));
+        });
+    Runtime.global().setProperty(Runtime, "__FSDKGetTrackerFaceThumbnail", std::move(getThumbnail));
+
+    auto extractFaceAtlas = jsi::Function::createFromHostFunction(
+        Runtime, jsi::PropNameID::forAscii(Runtime, "__FSDKExtractFaceAtlas"), 7,
+        [](jsi::Runtime& runtime, const jsi::Value&, const jsi::Value* arguments, size_t count) { return ExtractFaceAtlasArrays(runtime, arguments, count); });
+    Runtime.global().setProperty(Runtime, "__FSDKExtractFaceAtlas", std::move(extractFaceAtlas));
+}
+
+}
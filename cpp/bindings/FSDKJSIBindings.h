@@ -0,0 +1,20 @@
+#pragma once
+
+#include <jsi/jsi.h>
+
+// JSI bindings installed into the main JavaScript runtime. They are kept apart from the rest of the shared
+// code, which does not depend on React Native.
+namespace fsdk {
+
+// Defines global.__FSDKCreateResultSlotReader(slot), which returns a host object reading the result slot
+// (see FSDKResultSlot.h) straight from the JavaScript thread, or undefined for an invalid handle, and
+// global.__FSDKGetTrackerFaceThumbnail(tracker, faceID), which returns the JPEG thumbnail of the face
+// (see FSDKThumbnailStore.h) as an ArrayBuffer over the store file, or the error code, and
+// global.__FSDKExtractFaceAtlas(image, features, count, width, height, imageMode, threads), which extracts a face
+// atlas (see FSDKFaceAtlas.h) into native memory and returns it as an ArrayBuffer with a Uint8Array view of every
+// face, and the resized features and the error codes of the faces as Int32Arrays, or the error code.
+// __FSDKExtractFaceAtlas only uses the runtime it is called with, so worklets may call it from their own runtime.
+// Must be called on the JavaScript thread.
+void InstallJSIBindings(facebook::jsi::Runtime& Runtime);
+
+}
@@ -3,7 +3,7 @@ import RNFS from 'react-native-fs';
 import { createFrameProcessor, runAsync, type ReadonlyFrameProcessor } from 'react-native-vision-camera';
 import { Worklets } from 'react-native-worklets-core';
 
-import FSDK, { FSDKError, Tracker } from "react-native-face-sdk";
+import FSDK, { FSDKError, ResultSlot, Tracker, type ResultSlotFace, type ResultSlotReader } from "react-native-face-sdk";
 
 
 /** Use an improved version of face detection and recognition */
@@ -21,6 +21,14 @@ const USE_IBETA_LIVENESS_ADDON = true;
 /** Internal image size for face detection */
 const IMAGE_SIZE = 256;
 
+
+/** Record frame latency trace. Use FacesProcessor.saveTrace to save it and open in https://ui.perfetto.dev */
+const ENABLE_TRACING = false;
+
+
+/** Read detected faces from a result slot on every animation frame instead of sending face ids from the frame processor with runOnJS */
+const USE_RESULT_SLOT = true;
+
 export class BoundingBox {
 
   constructor(
@@ -49,7 +57,27 @@ export class Face {
   public readonly imageQuality: number = -1;
   public readonly livenessError: string | undefined = undefined;
 
-  constructor(private readonly id: number, private readonly tracker: Tracker) {
+  constructor(public readonly id: number, private readonly tracker: Tracker, result?: ResultSlotFace) {
+
+    //** Faces read from the result slot already have everything */
+    if (result !== undefined) {
+      this._name = result.name;
+      this.bbox = new BoundingBox(result.bbox.p0.x, result.bbox.p0.y, result.bbox.p1.x, result.bbox.p1.y);
+
+      if (FacesProcessor.livenessEnabled) {
+        this.liveness = result.attributes.Liveness ?? NaN;
+        if (isNaN(this.liveness))
+          this.liveness = 0.0;
+
+        if (USE_IBETA_LIVENESS_ADDON) {
+          this.livenessError = result.rawAttributes.LivenessError || undefined;
+          this.imageQuality = result.attributes.ImageQuality ?? NaN;
+          if (isNaN(this.imageQuality))
+            this.imageQuality = -1;
+        }
+      }
+      return;
+    }
 
     tracker.lockID(id);
     this._name = tracker.getName(id);
@@ -133,7 +161,9 @@ export default class FacesProcessor {
 
   private static _tracker: Tracker;
   private static _frameProcessor: ReadonlyFrameProcessor;
-  private static _onFaceIDsReady: ((ids: number[]) => void) | undefined;
+  private static _resultSlot: ResultSlot | undefined;
+  private static _resultSlotReader: ResultSlotReader | undefined;
+  private static _onFacesReady: ((faces: Face[]) => void) | undefined;
   private static _livenessEnabled: boolean = false;
   private static _initializeAlreadyRequested: boolean = false;
 
@@ -146,7 +176,16 @@ export default class FacesProcessor {
     this._initializeAlreadyRequested = true;
 
     FSDK.ActivateLibrary('INSERT YOUR LICENSE KEY HERE');
-    FSDK.Initialize();
+
+    if (ENABLE_TRACING)
+      FSDK.SetTraceEnabled(true);
+
+    /** Initialize on a background thread, the models are loaded and warmed up with the detection version used by the tracker,
+      * so the first camera frame is not slowed down. The iBeta addon is initialized here as well. */
+    await FSDK.InitializeAsync({
+      iBeta: USE_IBETA_LIVENESS_ADDON,
+      trackerParameters: USE_NEW_FACE_DETECTION ? { DetectionVersion: 2, FaceDetection2PatchSize: IMAGE_SIZE } : {}
+    });
 
     
     /** Try to load tracker memory from the saved file */
@@ -174,13 +213,32 @@ export default class FacesProcessor {
 
     this.setTrackerParameters();
 
-    if (USE_IBETA_LIVENESS_ADDON)
-      await FSDK.InitializeIBeta();
-    
+    if (USE_RESULT_SLOT) {
+      this._resultSlot = ResultSlot.Create(MAX_FACES, ['Liveness', 'LivenessError', 'ImageQuality']);
+      this._tracker.attachResultSlot(this._resultSlot);
+      this._resultSlotReader = this._resultSlot.reader();
+      requestAnimationFrame(() => this.readResultSlot());
+    }
+
     this._frameProcessor = this.createFrameProcessor();
   }
 
 
+  /** Pass the faces published since the last animation frame to the callback */
+  private static readResultSlot(): void {
+    const reader = this._resultSlotReader!;
+    if (reader.update() && this._onFacesReady !== undefined) {
+      const start = ENABLE_TRACING ? FSDK.GetTraceTime() : 0;
+      this._onFacesReady(reader.faces().map(face => new Face(face.id, this._tracker, face)));
+
+      if (ENABLE_TRACING)
+        FSDK.RecordTraceSpan('onFacesReady', reader.timestamp, start);
+    }
+
+    requestAnimationFrame(() => this.readResultSlot());
+  }
+
+
   /** Get the path to tracker memory file */
   private static get trackerFilename(): string {
     return `${RNFS.DocumentDirectoryPath}/tracker70`;
@@ -191,9 +249,17 @@ export default class FacesProcessor {
   private static createFrameProcessor(): ReadonlyFrameProcessor {
     const tracker = this._tracker.handle;
 
-    const onFaceIDsReady = Worklets.createRunOnJS((ids: number[]) => {
-      if (this._onFaceIDsReady !== undefined)
-        this._onFaceIDsReady(ids);
+    const onFaceIDsReady = Worklets.createRunOnJS((ids: number[], frameTimestamp: number, sent: number) => {
+      /** Time between the frame processor and JS thread */
+      if (ENABLE_TRACING)
+        FSDK.RecordTraceSpan('runOnJS', frameTimestamp, sent);
+
+      const start = ENABLE_TRACING ? FSDK.GetTraceTime() : 0;
+      if (this._onFacesReady !== undefined)
+        this._onFacesReady(ids.map(id => new Face(id, this._tracker)));
+
+      if (ENABLE_TRACING)
+        FSDK.RecordTraceSpan('onFacesReady', frameTimestamp, start);
     });    
 
     return createFrameProcessor(frame => {
@@ -206,7 +272,10 @@ export default class FacesProcessor {
         /** Due to the limitations of using worklets, use FSDK library functions from Worklets namespace */
         const image = FSDK.Worklets.LoadImageFromFrame(frame);
         const result = FSDK.Worklets.FeedFrame(tracker, image, MAX_FACES);
-        onFaceIDsReady(result);
+
+        /** With the result slot the faces are published natively by FeedFrame */
+        if (!USE_RESULT_SLOT)
+          onFaceIDsReady(result, frame.timestamp, ENABLE_TRACING ? FSDK.Worklets.GetTraceTime() : 0);
         FSDK.Worklets.FreeImage(image);
       });
       
@@ -268,15 +337,23 @@ export default class FacesProcessor {
   }
 
 
+  //** Save frame latency trace to a file */
+  public static saveTrace(): string {
+    const filename = `${RNFS.DocumentDirectoryPath}/trace.json`;
+    FSDK.SaveTrace(filename);
+    return filename;
+  }
+
+
   //** Obtain a frame processor for face detection */
   public static get frameProcessor(): ReadonlyFrameProcessor {
     return this._frameProcessor;
   }
 
 
-  //** Set callback function for detected ids */
-  public static onFaceIDsReady(func: ((ids: number[]) => void) | undefined): void {
-    this._onFaceIDsReady = func;
+  //** Set callback function for detected faces */
+  public static onFacesReady(func: ((faces: Face[]) => void) | undefined): void {
+    this._onFacesReady = func;
   }
 
 
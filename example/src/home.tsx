@@ -9,7 +9,7 @@ import { useNavigation } from '@react-navigation/native';
 import type { NativeStackNavigationProp } from '@react-navigation/native-stack';
 
 import FSDK, { FSDKError } from 'react-native-face-sdk';
-import FacesProcessor from './faces_processor';
+import FacesProcessor, { type Face } from './faces_processor';
 
 
 interface FaceScaleAndOffset {
@@ -145,15 +145,15 @@ export default function Home(_: HomeProps): ReactNode {
   }, [toggleCameraPosition, setShouldClearTracker, livenessEnabled, toggleLiveness]);
 
 
-  /** Given a list of face ids creates a ReactNode to show the face bounding box for each id */
-  const renderFaces = useCallback((ids: number[]): void => {
+  /** Given a list of faces creates a ReactNode to show the bounding box for each face */
+  const renderFaces = useCallback((faces: Face[]): void => {
     if (faceScaleAndOffset === undefined)
       return;
 
     const windowWidth = Dimensions.get('window').width;
     setFaces(
-      ids.map((faceID, index) => {
-        const face = FacesProcessor.getFace(faceID);
+      faces.map((face, index) => {
+        const faceID = face.id;
 
         var [x0, y0, x1, y1] = face.bbox.scaled(faceScaleAndOffset.scale).values;
 
@@ -219,10 +219,10 @@ export default function Home(_: HomeProps): ReactNode {
   }, [shouldClearTracker, setShouldClearTracker]);
 
 
-  /** Set the callback to handle detected face ids from FacesProcessor */
+  /** Set the callback to handle detected faces from FacesProcessor */
   useEffect((): (() => void) => {
-    FacesProcessor.onFaceIDsReady(renderFaces);
-    return () => FacesProcessor.onFaceIDsReady(undefined);
+    FacesProcessor.onFacesReady(renderFaces);
+    return () => FacesProcessor.onFacesReady(undefined);
   }, [renderFaces]);
 
 
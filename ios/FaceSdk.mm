@@ -1,15 +1,35 @@
 #import "FaceSDK.h"
 
 #import <Foundation/Foundation.h>
+#import <React/RCTBridge+Private.h>
 
 #include <cmath>
 #include <algorithm>
+#include <vector>
 
 #include "LuxandFaceSDK.h"
+#include "FSDKTiledDetection.h"
+#include "FSDKAnalysisContext.h"
+#include "FSDKTrace.h"
+#include "FSDKTemplateCache.h"
+#include "FSDKThumbnailStore.h"
+#include "FSDKFaceAtlas.h"
+#include "FSDKKeyframeTracker.h"
+#include "FSDKFrameRecording.h"
+#include "FSDKMemoryGovernor.h"
+#include "FSDKResultSlot.h"
+#include "FSDKTrackerLock.h"
+#include "FSDKQualityFilter.h"
+#include "FSDKInitialization.h"
+#include "FSDKFaceIndex.h"
+#include "FSDKParameters.h"
+#include "bindings/FSDKJSIBindings.h"
 
 @implementation LuxandFaceSDK
 RCT_EXPORT_MODULE()
 
+@synthesize bridge = _bridge;
+
 - (std::shared_ptr<facebook::react::TurboModule>)getTurboModule:
     (const facebook::react::ObjCTurboModule::InitParams &)params
 {
@@ -316,6 +336,19 @@ TFace JSFaceToFace(const JS::NativeFaceSDK::Face &face) {
     return result;
 }
 
+NSDictionary *QualityScoresToNSDictionary(const fsdk::QualityScores& scores) {
+    NSMutableDictionary *result = [NSMutableDictionary new];
+    result[@"sharpness"]      = @(scores.sharpness);
+    result[@"brightness"]     = @(scores.brightness);
+    result[@"darkFraction"]   = @(scores.darkFraction);
+    result[@"brightFraction"] = @(scores.brightFraction);
+    result[@"eyeDistance"]    = @(scores.eyeDistance);
+    result[@"roll"]           = @(scores.roll);
+    result[@"yaw"]            = @(scores.yaw);
+    result[@"failed"]         = @(scores.failed);
+    return result;
+}
+
 typedef int (^SDKFunction)(NSMutableDictionary*);
 typedef int (^StringResultSDKFunction)(char*);
 typedef int (^IntegerResultSDKFunction)(int*);
@@ -329,6 +362,7 @@ typedef int (^FacePositionResultSDKFunction)(TFacePosition*);
 typedef int (^FaceResultSDKFunction)(TFace*);
 typedef int (^FacialFeaturesResultSDKFunction)(FSDK_Features*);
 typedef int (^FaceTemplateResultSDKFunction)(FSDK_FaceTemplate*);
+typedef int (^CachedFaceTemplateResultSDKFunction)(FSDK_FaceTemplate*, TFace*);
 typedef int (^LongArrayResultSDKFunction)(long long*);
 typedef int (^TrackerIDResultSDKFunction)(long long*, long long*);
 typedef int (^IDSimilaritiesResultSDKFunction)(IDSimilarity*, long long*);
@@ -539,6 +573,19 @@ NSDictionary *ExecuteFaceTemplateResultSDKFunction(FaceTemplateResultSDKFunction
     return ExecuteFaceTemplateResultSDKFunction(function, @"value");
 }
 
+NSDictionary *ExecuteCachedFaceTemplateResultSDKFunction(CachedFaceTemplateResultSDKFunction function) {
+    return ExecuteSDKFunction(^(NSMutableDictionary *map) {
+        FSDK_FaceTemplate faceTemplate = {};
+        TFace face = {};
+        const int errorCode = function(&faceTemplate, &face);
+
+        map[@"value"] = FaceTemplateToBase64(faceTemplate);
+        map[@"face"] = FaceToNSDictionary(face);
+
+        return errorCode;
+    });
+}
+
 NSDictionary *ExecuteLongArrayResultSDKFunction(LongArrayResultSDKFunction function, const int maxSize, const NSString* name) {
     return ExecuteSDKFunction(^(NSMutableDictionary *map) {
         long long* value = new long long[maxSize];
@@ -655,6 +702,7 @@ NSDictionary *ExecuteCreateCameraSDKFunction(CameraResultSDKFunction function) {
 
 - (NSDictionary *)FreeImage:(double)image {
     return ExecuteSDKFunction(^(NSMutableDictionary *) {
+        fsdk::ReleaseImageAnalysis(image);
         return FSDK_FreeImage(image);
     });
 }
@@ -781,7 +829,9 @@ NSDictionary *ExecuteCreateCameraSDKFunction(CameraResultSDKFunction function) {
 
 - (NSDictionary *)MirrorImage:(double)image vertical:(BOOL)vertical {
     return ExecuteSDKFunction(^(NSMutableDictionary *) {
-        return FSDK_MirrorImage(image, vertical);
+        const int errorCode = FSDK_MirrorImage(image, vertical);
+        fsdk::InvalidateImageAnalysis(image);
+        return errorCode;
     });
 }
 
@@ -806,6 +856,54 @@ NSDictionary *ExecuteCreateCameraSDKFunction(CameraResultSDKFunction function) {
     });
 }
 
+- (NSDictionary *)ExtractFaceAtlas:(double)image
+                          features:(NSArray *)features
+                             count:(double)count
+                             width:(double)width
+                            height:(double)height
+                         imageMode:(double)imageMode
+                           threads:(double)threads {
+    return ExecuteSDKFunction(^(NSMutableDictionary *map) {
+        fsdk::FaceAtlasLayout layout = {};
+        int errorCode = fsdk::GetFaceAtlasLayout(count, width, height, (FSDK_IMAGEMODE)imageMode, &layout);
+        if (errorCode != FSDKE_OK || features.count < (NSUInteger)count * FSDK_FACIAL_FEATURE_COUNT * 2)
+            return errorCode != FSDKE_OK ? errorCode : FSDKE_INVALID_ARGUMENT;
+
+        // Features are packed as x, y pairs, FSDK_FACIAL_FEATURE_COUNT points per face
+        std::vector<FSDK_Features> inputFeatures((size_t)count);
+        for (int face = 0; face < (int)count; ++face)
+            for (int i = 0; i < FSDK_FACIAL_FEATURE_COUNT; ++i) {
+                const NSUInteger index = ((NSUInteger)face * FSDK_FACIAL_FEATURE_COUNT + i) * 2;
+                inputFeatures[face][i].x = [features[index] intValue];
+                inputFeatures[face][i].y = [features[index + 1] intValue];
+            }
+
+        NSMutableData *atlas = [NSMutableData dataWithLength:layout.size];
+        std::vector<FSDK_Features> resultFeatures((size_t)count);
+        std::vector<int> errorCodes((size_t)count);
+        errorCode = fsdk::ExtractFaceAtlas(image, inputFeatures.data(), count, width, height, (FSDK_IMAGEMODE)imageMode, threads,
+                                           (unsigned char *)atlas.mutableBytes, resultFeatures.data(), errorCodes.data());
+
+        NSMutableArray *packedFeatures = [NSMutableArray arrayWithCapacity:(NSUInteger)count * FSDK_FACIAL_FEATURE_COUNT * 2];
+        NSMutableArray *faceErrorCodes = [NSMutableArray arrayWithCapacity:(NSUInteger)count];
+        for (int face = 0; face < (int)count; ++face) {
+            for (int i = 0; i < FSDK_FACIAL_FEATURE_COUNT; ++i) {
+                [packedFeatures addObject:@(resultFeatures[face][i].x)];
+                [packedFeatures addObject:@(resultFeatures[face][i].y)];
+            }
+            [faceErrorCodes addObject:@(errorCodes[face])];
+        }
+
+        map[@"value"] = [atlas base64EncodedStringWithOptions:0];
+        map[@"features"] = packedFeatures;
+        map[@"errorCodes"] = faceErrorCodes;
+        map[@"stride"] = @(layout.stride);
+        map[@"faceSize"] = @(layout.faceSize);
+
+        return errorCode;
+    });
+}
+
 - (NSDictionary *)DetectFace:(double)image {
     return ExecuteFacePositionResultSDKFunction(^(TFacePosition *value) {
         return FSDK_DetectFace(image, value);
@@ -854,17 +952,49 @@ NSDictionary *ExecuteCreateCameraSDKFunction(CameraResultSDKFunction function) {
     });
 }
 
+- (NSDictionary *)DetectMultipleFacesTiled:(double)image
+                                  maxFaces:(double)maxFaces
+                                  tileSize:(double)tileSize
+                                   overlap:(double)overlap
+                                   threads:(double)threads
+                             fullImagePass:(BOOL)fullImagePass
+                              iouThreshold:(double)iouThreshold {
+    return ExecuteSDKFunction(^(NSMutableDictionary *map) {
+        fsdk::trace::Span span("DetectMultipleFacesTiled");
+        fsdk::TiledDetectionParameters parameters;
+        parameters.tileSize = tileSize;
+        parameters.overlap = overlap;
+        parameters.threads = threads;
+        parameters.fullImagePass = fullImagePass;
+        parameters.iouThreshold = iouThreshold;
+
+        int count = 0;
+        TFace* faces = new TFace[maxFaces];
+        const int errorCode = fsdk::DetectMultipleFacesTiled(image, parameters, &count, faces, sizeof(TFace) * maxFaces);
+
+        NSMutableArray *value = [NSMutableArray arrayWithCapacity:count];
+        for (int i = 0; i < count; ++i)
+            [value addObject:FaceToNSDictionary(faces[i])];
+
+        map[@"value"] = value;
+
+        delete[] faces;
+
+        return errorCode;
+    });
+}
+
 - (NSDictionary *)SetFaceDetectionParameters:(BOOL)handleArbitraryRotations
                   determineFaceRotationAngle:(BOOL)determineFaceRotationAngle
                          internalResizeWidth:(double)internalResizeWidth {
     return ExecuteSDKFunction(^(NSMutableDictionary *map) {
-        return FSDK_SetFaceDetectionParameters(handleArbitraryRotations, determineFaceRotationAngle, internalResizeWidth);
+        return fsdk::SetFaceDetectionParameters(handleArbitraryRotations, determineFaceRotationAngle, internalResizeWidth);
     });
 }
 
 - (NSDictionary *)SetFaceDetectionThreshold:(double)threshold {
     return ExecuteSDKFunction(^(NSMutableDictionary *map) {
-        return FSDK_SetFaceDetectionThreshold(threshold);
+        return fsdk::SetFaceDetectionThreshold(threshold);
     }); 
 }
 
@@ -990,25 +1120,39 @@ NSDictionary *ExecuteCreateCameraSDKFunction(CameraResultSDKFunction function) {
 
 - (NSDictionary *)FreeTracker:(double)tracker {
     return ExecuteSDKFunction(^(NSMutableDictionary*) {
-        return FSDK_FreeTracker(tracker);
+        fsdk::ReleaseTrackerThumbnails(tracker);
+        fsdk::ReleaseTrackerMemoryGovernor(tracker);
+        fsdk::ReleaseTrackerResultSlot(tracker);
+        int errorCode;
+        {
+            const fsdk::TrackerLock lock(tracker, fsdk::TrackerLock::EXCLUSIVE);
+            errorCode = FSDK_FreeTracker(tracker);
+        }
+        fsdk::ReleaseTrackerLock(tracker);
+        return errorCode;
     });
 }
 
 - (NSDictionary *)ClearTracker:(double)tracker {
     return ExecuteSDKFunction(^(NSMutableDictionary*) {
-        return FSDK_ClearTracker(tracker);
+        const int errorCode = fsdk::ClearTracker(tracker);
+        if (errorCode == FSDKE_OK)
+            fsdk::ClearTrackerIDs(tracker);
+        return errorCode;
     });
 }
 
 - (NSDictionary *)SaveTrackerMemoryToFile:(double)tracker
                                  filename:(NSString *)filename {
     return ExecuteSDKFunction(^(NSMutableDictionary*) {
+        const fsdk::TrackerLock lock(tracker, fsdk::TrackerLock::SHARED);
         return FSDK_SaveTrackerMemoryToFile(tracker, [filename UTF8String]);
     });
 }
 
 - (NSDictionary *)GetTrackerMemoryBufferSize:(double)tracker {
     return ExecuteLongResultSDKFunction(^(long long* value) {
+        const fsdk::TrackerLock lock(tracker, fsdk::TrackerLock::SHARED);
         return FSDK_GetTrackerMemoryBufferSize(tracker, value);
     });
 }
@@ -1016,6 +1160,7 @@ NSDictionary *ExecuteCreateCameraSDKFunction(CameraResultSDKFunction function) {
 - (NSDictionary *)SaveTrackerMemoryToBuffer:(double)tracker
                                  bufferSize:(double)bufferSize {
     return ExecuteByteBufferResultSDKFunction(^(unsigned char *value) {
+        const fsdk::TrackerLock lock(tracker, fsdk::TrackerLock::SHARED);
         return FSDK_SaveTrackerMemoryToBuffer(tracker, value, bufferSize);
     }, bufferSize);
 }
@@ -1024,6 +1169,7 @@ NSDictionary *ExecuteCreateCameraSDKFunction(CameraResultSDKFunction function) {
                                  name:(NSString *)name
                                 value:(NSString *)value {
     return ExecuteSDKFunction(^(NSMutableDictionary*) {
+        const fsdk::TrackerLock lock(tracker, fsdk::TrackerLock::EXCLUSIVE);
         return FSDK_SetTrackerParameter(tracker, [name UTF8String], [value UTF8String]);
     });
 }
@@ -1031,6 +1177,7 @@ NSDictionary *ExecuteCreateCameraSDKFunction(CameraResultSDKFunction function) {
 - (NSDictionary *)SetTrackerMultipleParameters:(double)tracker
                                     parameters:(NSString *)parameters {
     return ExecuteIntegerResultSDKFunction(^(int* value) {
+        const fsdk::TrackerLock lock(tracker, fsdk::TrackerLock::EXCLUSIVE);
         return FSDK_SetTrackerMultipleParameters(tracker, [parameters UTF8String], value);
     });
 }
@@ -1039,6 +1186,7 @@ NSDictionary *ExecuteCreateCameraSDKFunction(CameraResultSDKFunction function) {
                                  name:(NSString *)name
                               maxSize:(double)maxSize {
     return ExecuteStringResultSDKFunction(^(char* value) {
+        const fsdk::TrackerLock lock(tracker, fsdk::TrackerLock::SHARED);
         return FSDK_GetTrackerParameter(tracker, [name UTF8String], value, maxSize);
     }, maxSize);
 }
@@ -1050,7 +1198,14 @@ NSDictionary *ExecuteCreateCameraSDKFunction(CameraResultSDKFunction function) {
     return ExecuteSDKFunction(^(NSMutableDictionary *map) {
         long long *ids = new long long[(int)maxFaces];
         long long count = 0;
-        const int errorCode = FSDK_FeedFrame(tracker, index, image, &count, ids, maxFaces * sizeof(long long));
+        int errorCode;
+        {
+            fsdk::trace::Span span("FeedFrame");
+            const fsdk::TrackerLock lock(tracker, fsdk::TrackerLock::EXCLUSIVE);
+            errorCode = FSDK_FeedFrame(tracker, index, image, &count, ids, maxFaces * sizeof(long long));
+        }
+        fsdk::MemoryGovernorFrameFed(tracker, errorCode, ids, count);
+        fsdk::ResultSlotFrameFed(tracker, index, errorCode, ids, count);
 
         NSMutableArray *result = [NSMutableArray arrayWithCapacity:count];
         for (int i = 0; i < count; ++i)
@@ -1068,6 +1223,7 @@ NSDictionary *ExecuteCreateCameraSDKFunction(CameraResultSDKFunction function) {
                            index:(double)index
                               id:(double)id {
     return ExecuteFeaturesResultSDKFunction(^(FSDK_Features* value) {
+        const fsdk::TrackerLock lock(tracker, fsdk::TrackerLock::SHARED);
         return FSDK_GetTrackerEyes(tracker, index, id, value);
     }, 2);
 }
@@ -1076,6 +1232,7 @@ NSDictionary *ExecuteCreateCameraSDKFunction(CameraResultSDKFunction function) {
                                      index:(double)index
                                         id:(double)id {
     return ExecuteFeaturesResultSDKFunction(^(FSDK_Features* value) {
+        const fsdk::TrackerLock lock(tracker, fsdk::TrackerLock::SHARED);
         return FSDK_GetTrackerFacialFeatures(tracker, index, id, value);
     }, 2);
 }
@@ -1084,6 +1241,7 @@ NSDictionary *ExecuteCreateCameraSDKFunction(CameraResultSDKFunction function) {
                                    index:(double)index
                                       id:(double)id {
     return ExecuteFacePositionResultSDKFunction(^(TFacePosition *value) {
+        const fsdk::TrackerLock lock(tracker, fsdk::TrackerLock::SHARED);
         return FSDK_GetTrackerFacePosition(tracker, index, id, value);
     });
 }
@@ -1092,6 +1250,7 @@ NSDictionary *ExecuteCreateCameraSDKFunction(CameraResultSDKFunction function) {
                            index:(double)index
                               id:(double)id {
     return ExecuteFaceResultSDKFunction(^(TFace *value) {
+        const fsdk::TrackerLock lock(tracker, fsdk::TrackerLock::SHARED);
         return FSDK_GetTrackerFace(tracker, index, id, value);
     });
 }
@@ -1099,21 +1258,21 @@ NSDictionary *ExecuteCreateCameraSDKFunction(CameraResultSDKFunction function) {
 - (NSDictionary *)LockID:(double)tracker
                       id:(double)id {
     return ExecuteSDKFunction(^(NSMutableDictionary*) {
-        return FSDK_LockID(tracker, id);
+        return fsdk::LockTrackerID(tracker, id);
     });
 }
 
 - (NSDictionary *)UnlockID:(double)tracker
                       id:(double)id {
     return ExecuteSDKFunction(^(NSMutableDictionary*) {
-        return FSDK_UnlockID(tracker, id);
+        return fsdk::UnlockTrackerID(tracker, id);
     });
 }
 
 - (NSDictionary *)PurgeID:(double)tracker
                       id:(double)id {
     return ExecuteSDKFunction(^(NSMutableDictionary*) {
-        return FSDK_PurgeID(tracker, id);
+        return fsdk::PurgeID(tracker, id);
     });
 }
 
@@ -1121,7 +1280,7 @@ NSDictionary *ExecuteCreateCameraSDKFunction(CameraResultSDKFunction function) {
                        id:(double)id
                      name:(NSString *)name {
     return ExecuteSDKFunction(^(NSMutableDictionary*) {
-        return FSDK_SetName(tracker, id, [name UTF8String]);
+        return fsdk::SetTrackerName(tracker, id, [name UTF8String]);
     });
 }
 
@@ -1129,6 +1288,7 @@ NSDictionary *ExecuteCreateCameraSDKFunction(CameraResultSDKFunction function) {
                        id:(double)id
                   maxSize:(double)maxSize {
     return ExecuteStringResultSDKFunction(^(char *value) {
+        const fsdk::TrackerLock lock(tracker, fsdk::TrackerLock::SHARED);
         return FSDK_GetName(tracker, id, value, maxSize);
     }, maxSize);
 }
@@ -1137,6 +1297,7 @@ NSDictionary *ExecuteCreateCameraSDKFunction(CameraResultSDKFunction function) {
                            id:(double)id
                       maxSize:(double)maxSize {
     return ExecuteStringResultSDKFunction(^(char *value) {
+        const fsdk::TrackerLock lock(tracker, fsdk::TrackerLock::SHARED);
         return FSDK_GetAllNames(tracker, id, value, maxSize);
     }, maxSize);
 }
@@ -1144,6 +1305,7 @@ NSDictionary *ExecuteCreateCameraSDKFunction(CameraResultSDKFunction function) {
 - (NSDictionary *)GetIDReassignment:(double)tracker
                                  id:(double)id {
     return ExecuteLongResultSDKFunction(^(long long *value) {
+        const fsdk::TrackerLock lock(tracker, fsdk::TrackerLock::SHARED);
         return FSDK_GetIDReassignment(tracker, id, value);
     });
 }
@@ -1151,6 +1313,7 @@ NSDictionary *ExecuteCreateCameraSDKFunction(CameraResultSDKFunction function) {
 - (NSDictionary *)GetSimilarIDCount:(double)tracker
                                  id:(double)id {
     return ExecuteLongResultSDKFunction(^(long long *value) {
+        const fsdk::TrackerLock lock(tracker, fsdk::TrackerLock::SHARED);
         return FSDK_GetSimilarIDCount(tracker, id, value);
     });
 }
@@ -1159,12 +1322,14 @@ NSDictionary *ExecuteCreateCameraSDKFunction(CameraResultSDKFunction function) {
                                 id:(double)id
                              count:(double)count {
     return ExecuteLongArrayResultSDKFunction(^(long long *value) {
+        const fsdk::TrackerLock lock(tracker, fsdk::TrackerLock::SHARED);
         return FSDK_GetSimilarIDList(tracker, id, value, count);
     }, count);
 }
 
 - (NSDictionary *)GetTrackerIDsCount:(double)tracker {
     return ExecuteLongResultSDKFunction(^(long long *value) {
+        const fsdk::TrackerLock lock(tracker, fsdk::TrackerLock::SHARED);
         return FSDK_GetTrackerIDsCount(tracker, value);
     });
 }
@@ -1172,6 +1337,7 @@ NSDictionary *ExecuteCreateCameraSDKFunction(CameraResultSDKFunction function) {
 - (NSDictionary *)GetTrackerAllIDs:(double)tracker
                              count:(double)count {
     return ExecuteLongArrayResultSDKFunction(^(long long *value) {
+        const fsdk::TrackerLock lock(tracker, fsdk::TrackerLock::SHARED);
         return FSDK_GetTrackerAllIDs(tracker, value, count);
     }, count);
 }
@@ -1179,6 +1345,7 @@ NSDictionary *ExecuteCreateCameraSDKFunction(CameraResultSDKFunction function) {
 - (NSDictionary *)GetTrackerFaceIDsCountForID:(double)tracker
                                            id:(double)id {
     return ExecuteLongResultSDKFunction(^(long long *value) {
+        const fsdk::TrackerLock lock(tracker, fsdk::TrackerLock::SHARED);
         return FSDK_GetTrackerFaceIDsCountForID(tracker, id, value);
     });
 }
@@ -1187,6 +1354,7 @@ NSDictionary *ExecuteCreateCameraSDKFunction(CameraResultSDKFunction function) {
                                       id:(double)id
                                    count:(double)count {
     return ExecuteLongArrayResultSDKFunction(^(long long *value) {
+        const fsdk::TrackerLock lock(tracker, fsdk::TrackerLock::SHARED);
         return FSDK_GetTrackerAllIDs(tracker, value, count);
     }, count);
 }
@@ -1194,6 +1362,7 @@ NSDictionary *ExecuteCreateCameraSDKFunction(CameraResultSDKFunction function) {
 - (NSDictionary *)GetTrackerIDByFaceID:(double)tracker
                                 faceID:(double)faceID {
     return ExecuteLongResultSDKFunction(^(long long* value) {
+        const fsdk::TrackerLock lock(tracker, fsdk::TrackerLock::SHARED);
         return FSDK_GetTrackerIDByFaceID(tracker, faceID, value);
     });
 }
@@ -1201,6 +1370,7 @@ NSDictionary *ExecuteCreateCameraSDKFunction(CameraResultSDKFunction function) {
 - (NSDictionary *)GetTrackerFaceTemplate:(double)tracker
                                   faceID:(double)faceID {
     return ExecuteFaceTemplateResultSDKFunction(^(FSDK_FaceTemplate *value) {
+        const fsdk::TrackerLock lock(tracker, fsdk::TrackerLock::SHARED);
         return FSDK_GetTrackerFaceTemplate(tracker, faceID, value);
     });
 };
@@ -1208,7 +1378,7 @@ NSDictionary *ExecuteCreateCameraSDKFunction(CameraResultSDKFunction function) {
 - (NSDictionary *)GetTrackerFaceImage:(double)tracker
                                faceID:(double)faceID {
     return ExecuteCreateImageSDKFunction(^(HImage *value) {
-        return FSDK_GetTrackerFaceImage(tracker, faceID, value);
+        return fsdk::GetTrackerFaceImage(tracker, faceID, value);
     });
 }
 
@@ -1216,14 +1386,14 @@ NSDictionary *ExecuteCreateCameraSDKFunction(CameraResultSDKFunction function) {
                                faceID:(double)faceID
                                 image:(double)image {
     return ExecuteSDKFunction(^(NSMutableDictionary*) {
-        return FSDK_SetTrackerFaceImage(tracker, faceID, image);
+        return fsdk::SetTrackerFaceImage(tracker, faceID, image);
     });
 }
 
 - (NSDictionary *)DeleteTrackerFaceImage:(double)tracker
                                   faceID:(double)faceID {
     return ExecuteSDKFunction(^(NSMutableDictionary*) {
-        return FSDK_DeleteTrackerFaceImage(tracker, faceID);
+        return fsdk::DeleteTrackerFaceImage(tracker, faceID);
     });
 }
 
@@ -1231,6 +1401,7 @@ NSDictionary *ExecuteCreateCameraSDKFunction(CameraResultSDKFunction function) {
                      faceTemplate:(NSString *)faceTemplate {
     return ExecuteTrackerIDResultSDKFunction(^(long long* id, long long *faceID) {
         const FSDK_FaceTemplate value = Base64ToFaceTemplate(faceTemplate);
+        const fsdk::TrackerLock lock(tracker, fsdk::TrackerLock::EXCLUSIVE);
         return FSDK_TrackerCreateID(tracker, &value, id, faceID);
     });
 }
@@ -1240,6 +1411,7 @@ NSDictionary *ExecuteCreateCameraSDKFunction(CameraResultSDKFunction function) {
                             faceTemplate:(NSString *)faceTemplate {
     return ExecuteLongResultSDKFunction(^(long long* value) {
         const FSDK_FaceTemplate tmplt = Base64ToFaceTemplate(faceTemplate);
+        const fsdk::TrackerLock lock(tracker, fsdk::TrackerLock::EXCLUSIVE);
         return FSDK_AddTrackerFaceTemplate(tracker, id, &tmplt, value);
     });
 }
@@ -1247,7 +1419,7 @@ NSDictionary *ExecuteCreateCameraSDKFunction(CameraResultSDKFunction function) {
 - (NSDictionary *)DeleteTrackerFace:(double)tracker
                              faceID:(double)faceID {
     return ExecuteSDKFunction(^(NSMutableDictionary*) {
-        return FSDK_DeleteTrackerFace(tracker, faceID);
+        return fsdk::DeleteTrackerFace(tracker, faceID);
     });
 }
 
@@ -1257,6 +1429,7 @@ NSDictionary *ExecuteCreateCameraSDKFunction(CameraResultSDKFunction function) {
                             maxSize:(double)maxSize {
     return ExecuteIDSimilaritiesSDKFunction(^(IDSimilarity *similarities, long long *count) {
         const FSDK_FaceTemplate tmplt = Base64ToFaceTemplate(faceTemplate);
+        const fsdk::TrackerLock lock(tracker, fsdk::TrackerLock::SHARED);
         return FSDK_TrackerMatchFaces(tracker, &tmplt, threshold, similarities, count, maxSize * sizeof(IDSimilarity));
     }, maxSize);
 }
@@ -1267,6 +1440,7 @@ NSDictionary *ExecuteCreateCameraSDKFunction(CameraResultSDKFunction function) {
                                        name:(NSString *)name
                                     maxSize:(double)maxSize {
     return ExecuteStringResultSDKFunction(^(char *value) {
+        const fsdk::TrackerLock lock(tracker, fsdk::TrackerLock::SHARED);
         return FSDK_GetTrackerFacialAttribute(tracker, index, id, [name UTF8String], value, maxSize);
     }, maxSize);
 }
@@ -1335,16 +1509,587 @@ NSDictionary *ExecuteCreateCameraSDKFunction(CameraResultSDKFunction function) {
 - (NSDictionary *)SetParameter:(NSString *)name
                          value:(NSString *)value {
     return ExecuteSDKFunction(^(NSMutableDictionary*) {
-        return FSDK_SetParameter([name UTF8String], [value UTF8String]);
+        return fsdk::SetParameter([name UTF8String], [value UTF8String]);
     });
 }
 
 - (NSDictionary *)SetParameters:(NSString *)parameters {
     return ExecuteIntegerResultSDKFunction(^(int* value) {
-        return FSDK_SetParameters([parameters UTF8String], value);
+        return fsdk::SetParameters([parameters UTF8String], value);
     });
 }
 
+- (NSDictionary *)CreateAnalysisContext:(double)image {
+    return ExecuteSDKFunction(^(NSMutableDictionary *map) {
+        fsdk::HAnalysisContext value = 0;
+        const int errorCode = fsdk::CreateAnalysisContext(image, &value);
+
+        map[@"value"] = @(value);
+
+        return errorCode;
+    });
+}
+
+- (NSDictionary *)FreeAnalysisContext:(double)context {
+    return ExecuteSDKFunction(^(NSMutableDictionary *) {
+        return fsdk::FreeAnalysisContext(context);
+    });
+}
+
+- (NSDictionary *)AnalysisContextDetectFace:(double)context {
+    return ExecuteFaceResultSDKFunction(^(TFace *value) {
+        return fsdk::AnalysisContextDetectFace(context, value);
+    });
+}
+
+- (NSDictionary *)AnalysisContextDetectFacialFeatures:(double)context {
+    return ExecuteFeaturesResultSDKFunction(^(FSDK_Features *features) {
+        return fsdk::AnalysisContextDetectFacialFeatures(context, features);
+    });
+}
+
+- (NSDictionary *)AnalysisContextDetectFacialAttribute:(double)context
+                                                  name:(NSString *)name
+                                               maxSize:(double)maxSize {
+    return ExecuteStringResultSDKFunction(^(char *value) {
+        return fsdk::AnalysisContextDetectFacialAttribute(context, [name UTF8String], value, maxSize);
+    }, maxSize);
+}
+
+- (NSDictionary *)AnalysisContextGetFaceTemplate:(double)context {
+    return ExecuteFaceTemplateResultSDKFunction(^(FSDK_FaceTemplate *value) {
+        return fsdk::AnalysisContextGetFaceTemplate(context, value);
+    });
+}
+
+- (NSDictionary *)SetTraceEnabled:(BOOL)enabled capacity:(double)capacity {
+    return ExecuteSDKFunction(^(NSMutableDictionary *) {
+        if (enabled)
+            fsdk::trace::Enable(capacity);
+        else
+            fsdk::trace::Disable();
+        return FSDKE_OK;
+    });
+}
+
+- (NSDictionary *)ClearTrace {
+    return ExecuteSDKFunction(^(NSMutableDictionary *) {
+        fsdk::trace::Clear();
+        return FSDKE_OK;
+    });
+}
+
+- (NSDictionary *)GetTraceTime {
+    return ExecuteLongResultSDKFunction(^(long long *value) {
+        *value = fsdk::trace::Now();
+        return FSDKE_OK;
+    });
+}
+
+- (NSDictionary *)SetTraceFrameTimestamp:(double)frameTimestamp {
+    return ExecuteSDKFunction(^(NSMutableDictionary *) {
+        fsdk::trace::SetFrameTimestamp(frameTimestamp);
+        return FSDKE_OK;
+    });
+}
+
+- (NSDictionary *)RecordTraceSpan:(NSString *)name
+                   frameTimestamp:(double)frameTimestamp
+                            start:(double)start
+                              end:(double)end {
+    return ExecuteSDKFunction(^(NSMutableDictionary *) {
+        fsdk::trace::RecordCopy([name UTF8String], frameTimestamp, start, end);
+        return FSDKE_OK;
+    });
+}
+
+- (NSDictionary *)DumpTrace {
+    return ExecuteSDKFunction(^(NSMutableDictionary *map) {
+        map[@"value"] = [NSString stringWithUTF8String:fsdk::trace::Dump().c_str()];
+        return FSDKE_OK;
+    });
+}
+
+- (NSDictionary *)SaveTrace:(NSString *)filename {
+    return ExecuteSDKFunction(^(NSMutableDictionary *) {
+        return fsdk::trace::Save([filename UTF8String]);
+    });
+}
+
+- (NSDictionary *)CreateTemplateCache:(NSString *)filename
+                           maxEntries:(double)maxEntries
+                        configuration:(NSString *)configuration {
+    return ExecuteSDKFunction(^(NSMutableDictionary *map) {
+        fsdk::HTemplateCache value = 0;
+        const int errorCode = fsdk::CreateTemplateCache([filename UTF8String], maxEntries, [configuration UTF8String], &value);
+
+        map[@"value"] = @(value);
+
+        return errorCode;
+    });
+}
+
+- (NSDictionary *)FreeTemplateCache:(double)cache {
+    return ExecuteSDKFunction(^(NSMutableDictionary *) {
+        return fsdk::FreeTemplateCache(cache);
+    });
+}
+
+- (NSDictionary *)SaveTemplateCache:(double)cache {
+    return ExecuteSDKFunction(^(NSMutableDictionary *) {
+        return fsdk::SaveTemplateCache(cache);
+    });
+}
+
+- (NSDictionary *)ClearTemplateCache:(double)cache {
+    return ExecuteSDKFunction(^(NSMutableDictionary *) {
+        return fsdk::ClearTemplateCache(cache);
+    });
+}
+
+- (NSDictionary *)GetTemplateCacheStatistics:(double)cache {
+    return ExecuteLongArrayResultSDKFunction(^(long long *value) {
+        fsdk::TemplateCacheStatistics statistics = {};
+        const int errorCode = fsdk::GetTemplateCacheStatistics(cache, &statistics);
+
+        value[0] = statistics.hits;
+        value[1] = statistics.misses;
+        value[2] = statistics.entries;
+        value[3] = statistics.evictions;
+
+        return errorCode;
+    }, 4);
+}
+
+- (NSDictionary *)TemplateCacheGetFaceTemplateFromFile:(double)cache filename:(NSString *)filename {
+    return ExecuteCachedFaceTemplateResultSDKFunction(^(FSDK_FaceTemplate *faceTemplate, TFace *face) {
+        return fsdk::TemplateCacheGetFaceTemplateFromFile(cache, [filename UTF8String], faceTemplate, face);
+    });
+}
+
+- (NSDictionary *)TemplateCacheGetFaceTemplateFromBuffer:(double)cache buffer:(NSString *)buffer {
+    return ExecuteCachedFaceTemplateResultSDKFunction(^(FSDK_FaceTemplate *faceTemplate, TFace *face) {
+        const NSData *data = [[NSData alloc] initWithBase64EncodedString:buffer options:0];
+        return fsdk::TemplateCacheGetFaceTemplateFromBuffer(cache, (const unsigned char*)data.bytes, data.length, faceTemplate, face);
+    });
+}
+
+- (NSDictionary *)TemplateCacheGetFaceTemplate:(double)cache image:(double)image {
+    return ExecuteCachedFaceTemplateResultSDKFunction(^(FSDK_FaceTemplate *faceTemplate, TFace *face) {
+        return fsdk::TemplateCacheGetFaceTemplate(cache, image, faceTemplate, face);
+    });
+}
+
+- (NSDictionary *)CreateThumbnailStore:(NSString *)filename
+                               maxSize:(double)maxSize
+                       maxCachedImages:(double)maxCachedImages {
+    return ExecuteSDKFunction(^(NSMutableDictionary *map) {
+        fsdk::HThumbnailStore value = 0;
+        const int errorCode = fsdk::CreateThumbnailStore([filename UTF8String], maxSize, maxCachedImages, &value);
+
+        map[@"value"] = @(value);
+
+        return errorCode;
+    });
+}
+
+- (NSDictionary *)FreeThumbnailStore:(double)store {
+    return ExecuteSDKFunction(^(NSMutableDictionary *) {
+        return fsdk::FreeThumbnailStore(store);
+    });
+}
+
+- (NSDictionary *)CompactThumbnailStore:(double)store {
+    return ExecuteSDKFunction(^(NSMutableDictionary *) {
+        return fsdk::CompactThumbnailStore(store);
+    });
+}
+
+- (NSDictionary *)GetThumbnailStoreStatistics:(double)store {
+    return ExecuteLongArrayResultSDKFunction(^(long long *value) {
+        fsdk::ThumbnailStoreStatistics statistics = {};
+        const int errorCode = fsdk::GetThumbnailStoreStatistics(store, &statistics);
+
+        value[0] = statistics.thumbnails;
+        value[1] = statistics.fileSize;
+        value[2] = statistics.garbageSize;
+        value[3] = statistics.cachedImages;
+
+        return errorCode;
+    }, 4);
+}
+
+- (NSDictionary *)AttachThumbnailStore:(double)tracker store:(double)store {
+    return ExecuteSDKFunction(^(NSMutableDictionary *) {
+        return fsdk::AttachThumbnailStore(tracker, store);
+    });
+}
+
+- (NSDictionary *)GetTrackerFaceThumbnail:(double)tracker faceID:(double)faceID {
+    return ExecuteSDKFunction(^(NSMutableDictionary *map) {
+        fsdk::Thumbnail thumbnail = {};
+        const int errorCode = fsdk::GetTrackerFaceThumbnail(tracker, faceID, &thumbnail);
+
+        // The JPEG is encoded straight from the mapped store file
+        NSData *data = [NSData dataWithBytesNoCopy:(void *)thumbnail.data length:errorCode == FSDKE_OK ? thumbnail.size : 0 freeWhenDone:NO];
+        map[@"value"] = [data base64EncodedStringWithOptions:0];
+
+        return errorCode;
+    });
+}
+
+- (NSDictionary *)CreateKeyframeTracker:(double)tracker
+                       keyframeInterval:(double)keyframeInterval
+                           workingWidth:(double)workingWidth
+                           searchRadius:(double)searchRadius
+                         minCorrelation:(double)minCorrelation {
+    return ExecuteSDKFunction(^(NSMutableDictionary *map) {
+        fsdk::KeyframeTrackerParameters parameters;
+        parameters.keyframeInterval = keyframeInterval;
+        parameters.workingWidth = workingWidth;
+        parameters.searchRadius = searchRadius;
+        parameters.minCorrelation = minCorrelation;
+
+        fsdk::HKeyframeTracker value = 0;
+        const int errorCode = fsdk::CreateKeyframeTracker(tracker, parameters, &value);
+
+        map[@"value"] = @(value);
+
+        return errorCode;
+    });
+}
+
+- (NSDictionary *)FreeKeyframeTracker:(double)keyframeTracker {
+    return ExecuteSDKFunction(^(NSMutableDictionary *) {
+        return fsdk::FreeKeyframeTracker(keyframeTracker);
+    });
+}
+
+- (NSDictionary *)KeyframeTrackerFeedFrame:(double)keyframeTracker
+                                     index:(double)index
+                                     image:(double)image
+                                  maxFaces:(double)maxFaces {
+    return ExecuteSDKFunction(^(NSMutableDictionary *map) {
+        std::vector<long long> ids((size_t)maxFaces);
+        long long count = 0;
+        bool keyframe = false;
+        const int errorCode = fsdk::KeyframeTrackerFeedFrame(keyframeTracker, index, image, &count, ids.data(), maxFaces * sizeof(long long), &keyframe);
+
+        NSMutableArray *result = [NSMutableArray arrayWithCapacity:count];
+        for (int i = 0; i < count; ++i)
+            [result addObject:@(ids[i])];
+
+        map[@"value"] = result;
+        map[@"keyframe"] = @(keyframe);
+
+        return errorCode;
+    });
+}
+
+- (NSDictionary *)KeyframeTrackerGetFace:(double)keyframeTracker
+                                   index:(double)index
+                                      id:(double)id {
+    return ExecuteFaceResultSDKFunction(^(TFace *value) {
+        return fsdk::KeyframeTrackerGetFace(keyframeTracker, index, id, value);
+    });
+}
+
+- (NSDictionary *)KeyframeTrackerGetFacialFeatures:(double)keyframeTracker
+                                             index:(double)index
+                                                id:(double)id {
+    return ExecuteFeaturesResultSDKFunction(^(FSDK_Features* value) {
+        return fsdk::KeyframeTrackerGetFacialFeatures(keyframeTracker, index, id, value);
+    });
+}
+
+- (NSDictionary *)StartFrameRecording:(NSString *)filename compressed:(BOOL)compressed {
+    return ExecuteSDKFunction(^(NSMutableDictionary *) {
+        return fsdk::StartFrameRecording([filename UTF8String], compressed);
+    });
+}
+
+- (NSDictionary *)StopFrameRecording {
+    return ExecuteLongArrayResultSDKFunction(^(long long *value) {
+        fsdk::FrameRecordingStatistics statistics = {};
+        const int errorCode = fsdk::StopFrameRecording(&statistics);
+
+        value[0] = statistics.frames;
+        value[1] = statistics.bytes;
+
+        return errorCode;
+    }, 2);
+}
+
+- (NSDictionary *)AttachMemoryGovernor:(double)tracker
+                          maxTemplates:(double)maxTemplates
+                           targetRatio:(double)targetRatio
+                        minIdleSeconds:(double)minIdleSeconds
+                              interval:(double)interval {
+    return ExecuteSDKFunction(^(NSMutableDictionary *) {
+        fsdk::MemoryGovernorParameters parameters;
+        parameters.maxTemplates = maxTemplates;
+        parameters.targetRatio = targetRatio;
+        parameters.minIdleSeconds = minIdleSeconds;
+        parameters.intervalMs = interval;
+        return fsdk::AttachMemoryGovernor(tracker, parameters);
+    });
+}
+
+- (NSDictionary *)DetachMemoryGovernor:(double)tracker {
+    return ExecuteSDKFunction(^(NSMutableDictionary *) {
+        return fsdk::DetachMemoryGovernor(tracker);
+    });
+}
+
+- (NSDictionary *)GetMemoryGovernorStatistics:(double)tracker {
+    return ExecuteLongArrayResultSDKFunction(^(long long *value) {
+        fsdk::MemoryGovernorStatistics statistics = {};
+        const int errorCode = fsdk::GetMemoryGovernorStatistics(tracker, &statistics);
+
+        value[0] = statistics.ids;
+        value[1] = statistics.templates;
+        value[2] = statistics.protectedIDs;
+        value[3] = statistics.evictedIDs;
+        value[4] = statistics.evictedTemplates;
+        value[5] = statistics.sweeps;
+
+        return errorCode;
+    }, 6);
+}
+
+- (NSDictionary *)CreateResultSlot:(double)maxFaces attributes:(NSString *)attributes {
+    return ExecuteSDKFunction(^(NSMutableDictionary *map) {
+        fsdk::HResultSlot value = 0;
+        const int errorCode = fsdk::CreateResultSlot(maxFaces, [attributes UTF8String], &value);
+
+        map[@"value"] = @(value);
+
+        return errorCode;
+    });
+}
+
+- (NSDictionary *)FreeResultSlot:(double)slot {
+    return ExecuteSDKFunction(^(NSMutableDictionary *) {
+        return fsdk::FreeResultSlot(slot);
+    });
+}
+
+- (NSDictionary *)AttachResultSlot:(double)tracker slot:(double)slot {
+    return ExecuteSDKFunction(^(NSMutableDictionary *) {
+        return fsdk::AttachResultSlot(tracker, slot);
+    });
+}
+
+// Synchronous methods run on the JavaScript thread, where the runtime may be used
+- (NSDictionary *)InstallJSIBindings {
+    return ExecuteSDKFunction(^(NSMutableDictionary *) {
+        RCTCxxBridge *bridge = (RCTCxxBridge *)self.bridge;
+        if (!bridge || !bridge.runtime)
+            return FSDKE_FAILED;
+        fsdk::InstallJSIBindings(*(facebook::jsi::Runtime *)bridge.runtime);
+        return FSDKE_OK;
+    });
+}
+
+- (NSDictionary *)CreateQualityFilter:(double)minSharpness
+                        minBrightness:(double)minBrightness
+                        maxBrightness:(double)maxBrightness
+                   maxClippedFraction:(double)maxClippedFraction
+                       minEyeDistance:(double)minEyeDistance
+                              maxRoll:(double)maxRoll
+                               maxYaw:(double)maxYaw {
+    return ExecuteSDKFunction(^(NSMutableDictionary *map) {
+        fsdk::QualityFilterParameters parameters;
+        parameters.minSharpness = minSharpness;
+        parameters.minBrightness = minBrightness;
+        parameters.maxBrightness = maxBrightness;
+        parameters.maxClippedFraction = maxClippedFraction;
+        parameters.minEyeDistance = minEyeDistance;
+        parameters.maxRoll = maxRoll;
+        parameters.maxYaw = maxYaw;
+
+        fsdk::HQualityFilter value = 0;
+        const int errorCode = fsdk::CreateQualityFilter(parameters, &value);
+
+        map[@"value"] = @(value);
+
+        return errorCode;
+    });
+}
+
+- (NSDictionary *)FreeQualityFilter:(double)filter {
+    return ExecuteSDKFunction(^(NSMutableDictionary *) {
+        return fsdk::FreeQualityFilter(filter);
+    });
+}
+
+- (NSDictionary *)QualityFilterEvaluate:(double)filter
+                                  image:(double)image
+                                   face:(JS::NativeFaceSDK::Face &)face {
+    return ExecuteSDKFunction(^(NSMutableDictionary *map) {
+        const TFace value = JSFaceToFace(face);
+        fsdk::QualityScores scores = {};
+        const int errorCode = fsdk::QualityFilterEvaluate(filter, image, &value, &scores);
+
+        map[@"value"] = QualityScoresToNSDictionary(scores);
+
+        return errorCode;
+    });
+}
+
+- (NSDictionary *)QualityFilterEvaluateTrackerFace:(double)filter
+                                           tracker:(double)tracker
+                                             index:(double)index
+                                                id:(double)id
+                                             image:(double)image {
+    return ExecuteSDKFunction(^(NSMutableDictionary *map) {
+        fsdk::QualityScores scores = {};
+        const int errorCode = fsdk::QualityFilterEvaluateTrackerFace(filter, tracker, index, id, image, &scores);
+
+        map[@"value"] = QualityScoresToNSDictionary(scores);
+
+        return errorCode;
+    });
+}
+
+- (NSDictionary *)QualityFilterGetFaceTemplate:(double)filter
+                                         image:(double)image
+                                          face:(JS::NativeFaceSDK::Face &)face {
+    return ExecuteSDKFunction(^(NSMutableDictionary *map) {
+        const TFace value = JSFaceToFace(face);
+        FSDK_FaceTemplate faceTemplate = {};
+        fsdk::QualityScores scores = {};
+        const int errorCode = fsdk::QualityFilterGetFaceTemplate(filter, image, &value, &faceTemplate, &scores);
+
+        // No template is computed for a face failing the filter
+        map[@"value"] = errorCode == FSDKE_OK && !scores.failed ? FaceTemplateToBase64(faceTemplate) : @"";
+        map[@"quality"] = QualityScoresToNSDictionary(scores);
+
+        return errorCode;
+    });
+}
+
+- (NSDictionary *)StartInitialization:(NSString *)prefetchDirectories
+                               iBeta:(BOOL)iBeta
+                              warmUp:(BOOL)warmUp
+                   trackerParameters:(NSString *)trackerParameters {
+    NSString *dataDir = [NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES) firstObject];
+    NSString *dataDirPath = [@"external:dataDir=" stringByAppendingPathComponent:dataDir];
+
+    return ExecuteSDKFunction(^(NSMutableDictionary *) {
+        fsdk::InitializationParameters parameters;
+        parameters.prefetchDirectories = [prefetchDirectories UTF8String];
+        parameters.livenessModel = iBeta ? [dataDirPath UTF8String] : "";
+        parameters.warmUp = warmUp;
+        parameters.trackerParameters = [trackerParameters UTF8String];
+        return fsdk::StartInitialization(parameters);
+    });
+}
+
+- (NSDictionary *)GetInitializationStatus {
+    return ExecuteLongArrayResultSDKFunction(^(long long *value) {
+        fsdk::InitializationStatus status;
+        fsdk::GetInitializationStatus(&status);
+
+        // Durations are passed in microseconds
+        value[0] = status.state;
+        value[1] = status.errorCode;
+        value[2] = status.prefetchedFiles;
+        value[3] = status.prefetchedBytes;
+        value[4] = llround(status.prefetchSeconds * 1e6);
+        value[5] = llround(status.initializeSeconds * 1e6);
+        value[6] = llround(status.livenessSeconds * 1e6);
+        value[7] = llround(status.detectionSeconds * 1e6);
+        value[8] = llround(status.templateSeconds * 1e6);
+        value[9] = llround(status.trackerSeconds * 1e6);
+        value[10] = llround(status.totalSeconds * 1e6);
+
+        return FSDKE_OK;
+    }, 11);
+}
+
+- (NSDictionary *)CreateFaceIndex:(NSString *)filename
+                  maxConnections:(double)maxConnections
+                  efConstruction:(double)efConstruction
+                        efSearch:(double)efSearch {
+    return ExecuteSDKFunction(^(NSMutableDictionary *map) {
+        fsdk::FaceIndexParameters parameters;
+        parameters.maxConnections = maxConnections;
+        parameters.efConstruction = efConstruction;
+        parameters.efSearch = efSearch;
+
+        fsdk::HFaceIndex value = 0;
+        const int errorCode = fsdk::CreateFaceIndex([filename UTF8String], parameters, &value);
+
+        map[@"value"] = @(value);
+
+        return errorCode;
+    });
+}
+
+- (NSDictionary *)FreeFaceIndex:(double)index {
+    return ExecuteSDKFunction(^(NSMutableDictionary *) {
+        return fsdk::FreeFaceIndex(index);
+    });
+}
+
+- (NSDictionary *)SaveFaceIndex:(double)index {
+    return ExecuteSDKFunction(^(NSMutableDictionary *) {
+        return fsdk::SaveFaceIndex(index);
+    });
+}
+
+- (NSDictionary *)FaceIndexAddFaceTemplate:(double)index
+                                        id:(double)id
+                              faceTemplate:(NSString *)faceTemplate {
+    return ExecuteSDKFunction(^(NSMutableDictionary *) {
+        const FSDK_FaceTemplate value = Base64ToFaceTemplate(faceTemplate);
+        return fsdk::FaceIndexAddFaceTemplate(index, id, &value);
+    });
+}
+
+- (NSDictionary *)FaceIndexAddTrackerFaces:(double)index tracker:(double)tracker {
+    return ExecuteSDKFunction(^(NSMutableDictionary *map) {
+        long long value = 0;
+        const int errorCode = fsdk::FaceIndexAddTrackerFaces(index, tracker, &value);
+
+        map[@"value"] = @(value);
+
+        return errorCode;
+    });
+}
+
+- (NSDictionary *)FaceIndexRemoveID:(double)index id:(double)id {
+    return ExecuteSDKFunction(^(NSMutableDictionary *) {
+        return fsdk::FaceIndexRemoveID(index, id);
+    });
+}
+
+- (NSDictionary *)FaceIndexMatchFaces:(double)index
+                         faceTemplate:(NSString *)faceTemplate
+                            threshold:(double)threshold
+                              maxSize:(double)maxSize {
+    return ExecuteIDSimilaritiesSDKFunction(^(IDSimilarity *similarities, long long *count) {
+        const FSDK_FaceTemplate value = Base64ToFaceTemplate(faceTemplate);
+        return fsdk::FaceIndexMatchFaces(index, &value, threshold, similarities, count, maxSize * sizeof(IDSimilarity));
+    }, maxSize);
+}
+
+- (NSDictionary *)GetFaceIndexStatistics:(double)index {
+    return ExecuteLongArrayResultSDKFunction(^(long long *value) {
+        fsdk::FaceIndexStatistics statistics = {};
+        const int errorCode = fsdk::GetFaceIndexStatistics(index, &statistics);
+
+        value[0] = statistics.templates;
+        value[1] = statistics.ids;
+        value[2] = statistics.removed;
+        value[3] = statistics.searches;
+        value[4] = statistics.comparisons;
+
+        return errorCode;
+    }, 5);
+}
+
 - (NSDictionary *)InitializeIBeta {
     NSString *dataDir = [NSSearchPathForDirectoriesInDomains(NSCachesDirectory, NSUserDomainMask, YES) firstObject];
     NSString *dataDirPath = [@"external:dataDir=" stringByAppendingPathComponent:dataDir];
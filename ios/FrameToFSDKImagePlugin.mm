@@ -7,100 +7,73 @@
 #include <CoreVideo/CoreVideo.h>
 
 #include "LuxandFaceSDK.h"
+#include "FSDKTrace.h"
+#include "FSDKFrameConversion.h"
+#include "FSDKFrameRecording.h"
 
 @interface FrameToFSDKImagePlugin : FrameProcessorPlugin
 @end
 
-unsigned char *frameToRGBBuffer(Frame *frame, NSString **error, size_t *outWidth, size_t *outHeight) {
+// Clockwise rotation and mirroring that bring a frame of the orientation upright.
+void orientationToRotation(UIImageOrientation orientation, int *rotationDegrees, bool *mirrored) {
+    switch (orientation) {
+        case UIImageOrientationUp:            *rotationDegrees = 0;   *mirrored = false; break;
+        case UIImageOrientationDown:          *rotationDegrees = 180; *mirrored = false; break;
+        case UIImageOrientationLeft:          *rotationDegrees = 90;  *mirrored = false; break;
+        case UIImageOrientationRight:         *rotationDegrees = 270; *mirrored = false; break;
+        case UIImageOrientationUpMirrored:    *rotationDegrees = 0;   *mirrored = true;  break;
+        case UIImageOrientationDownMirrored:  *rotationDegrees = 180; *mirrored = true;  break;
+        case UIImageOrientationLeftMirrored:  *rotationDegrees = 90;  *mirrored = true;  break;
+        case UIImageOrientationRightMirrored: *rotationDegrees = 270; *mirrored = true;  break;
+    }
+}
+
+// VisionCamera reports frame timestamps in milliseconds on iOS, while recordings and traces use nanoseconds
+// as on Android.
+long long frameTimestamp(Frame *frame) {
+    return (long long)(frame.timestamp * 1e6);
+}
+
+// Planes of the pixel buffer are converted in place by the conversion shared with Android, which also
+// appends them to the frame recording in progress, if any.
+int frameToFSDKImage(Frame *frame, HImage *image, NSString **error) {
     if (!frame || ![frame isValid]) {
         *error = @"Invalid frame";
-        return nullptr;
+        return FSDKE_FAILED;
     }
 
     CVPixelBufferRef imageBuffer = CMSampleBufferGetImageBuffer(frame.buffer);
 
-    if (CVPixelBufferLockBaseAddress(imageBuffer, 0) != kCVReturnSuccess)
-        return nullptr;
-
-    const size_t width = CVPixelBufferGetWidth(imageBuffer);
-    const size_t height = CVPixelBufferGetHeight(imageBuffer);
-    unsigned char *rgbBuffer = new unsigned char[width * height * 3];
+    if (CVPixelBufferLockBaseAddress(imageBuffer, kCVPixelBufferLock_ReadOnly) != kCVReturnSuccess)
+        return FSDKE_FAILED;
 
-    ptrdiff_t outOffset, outRowStride, outPixelStride;
+    const int width = (int)CVPixelBufferGetWidth(imageBuffer);
+    const int height = (int)CVPixelBufferGetHeight(imageBuffer);
+    const long long timestamp = frameTimestamp(frame);
 
-    switch (frame.orientation) {
-        case UIImageOrientationUp:
-            outOffset = 0;
-            outRowStride = 3 * width;
-            outPixelStride = 3;
-            *outWidth = width;
-            *outHeight = height;
-            break;
-        case UIImageOrientationDown:
-            outOffset = 3 * (width * height - 1);
-            outRowStride = -3 * width;
-            outPixelStride = -3;
-            *outWidth = width;
-            *outHeight = height;
-            break;
-        case UIImageOrientationLeft:
-            outOffset = 3 * (height - 1);
-            outRowStride = -3;
-            outPixelStride = 3 * height;
-            *outWidth = height;
-            *outHeight = width;
-            break;            
-        case UIImageOrientationRight:
-            outOffset = 3 * height * (width - 1);
-            outRowStride = 3;
-            outPixelStride = -3 * height;
-            *outWidth = height;
-            *outHeight = width;
-            break;
-        case UIImageOrientationUpMirrored:
-            outOffset = 3 * (width - 1);
-            outRowStride = 3 * width;
-            outPixelStride = -3;
-            *outWidth = width;
-            *outHeight = height;
-            break;
-        case UIImageOrientationDownMirrored:
-            outOffset = 3 * width * (height - 1);
-            outRowStride = -3 * width;
-            outPixelStride = 3;
-            *outWidth = width;
-            *outHeight = height;
-            break;
-        case UIImageOrientationLeftMirrored:
-            outOffset = 0;
-            outRowStride = 3;
-            outPixelStride = 3 * height;
-            *outWidth = height;
-            *outHeight = width;
-            break;
-        case UIImageOrientationRightMirrored:
-            outOffset = 3 * (width * height - 1);
-            outRowStride = -3;
-            outPixelStride = -3 * height;
-            *outWidth = height;
-            *outHeight = width;
-            break;
-    }
+    int rotationDegrees = 0;
+    bool mirrored = false;
+    orientationToRotation(frame.orientation, &rotationDegrees, &mirrored);
 
+    int errorCode = FSDKE_FAILED;
     const unsigned int format = CVPixelBufferGetPixelFormatType(imageBuffer);
     switch (format) {
         case kCVPixelFormatType_32BGRA:
         case kCVPixelFormatType_Lossy_32BGRA: {
             const unsigned char *baseAddr = reinterpret_cast<unsigned char*>(CVPixelBufferGetBaseAddress(imageBuffer));
-            const size_t bytesPerRow = CVPixelBufferGetBytesPerRow(imageBuffer);
-
-            for (size_t y = 0; y < height; ++y) {
-                      unsigned char *rgbPtr = rgbBuffer + outOffset + outRowStride * y;
-                const unsigned char *rowPtr = baseAddr + bytesPerRow * y;
-
-                for (size_t x = 0; x < width; ++x, rgbPtr += outPixelStride, rowPtr += 4)
-                    memcpy(rgbPtr, rowPtr, 3);
-            }
+            const int bytesPerRow = (int)CVPixelBufferGetBytesPerRow(imageBuffer);
+            const long long size = (long long)bytesPerRow * height;
+
+            // Red, green and blue channels of the B, G, R, A pixels
+            const fsdk::ImagePlane planes[3] = {
+                {baseAddr + 2, size - 2, bytesPerRow, 4},
+                {baseAddr + 1, size - 1, bytesPerRow, 4},
+                {baseAddr, size, bytesPerRow, 4}
+            };
+
+            errorCode = fsdk::LoadImageFromColorPlanes(image, planes, width, height, rotationDegrees, mirrored);
+            if (errorCode == FSDKE_OK)
+                fsdk::RecordColorPlanesFrame(planes, width, height, rotationDegrees, mirrored, timestamp, *image);
             break;
         }
         case kCVPixelFormatType_420YpCbCr8BiPlanarFullRange:
@@ -113,43 +86,31 @@ unsigned char *frameToRGBBuffer(Frame *frame, NSString **error, size_t *outWidth
             const unsigned char *yPlane  = reinterpret_cast<unsigned char*>(CVPixelBufferGetBaseAddressOfPlane(imageBuffer, 0));
             const unsigned char *uvPlane = reinterpret_cast<unsigned char*>(CVPixelBufferGetBaseAddressOfPlane(imageBuffer, 1));
 
-            const size_t yBytesPerRow  = CVPixelBufferGetBytesPerRowOfPlane(imageBuffer, 0);
-            const size_t uvBytesPerRow = CVPixelBufferGetBytesPerRowOfPlane(imageBuffer, 1);
-
-            for (size_t y = 0; y < height; ++y) {
-                      unsigned char *rgbPtr = rgbBuffer + outOffset + outRowStride * y;
-                const unsigned char *yRow   = yPlane + yBytesPerRow * y;
-                const unsigned char *uvRow  = uvPlane + uvBytesPerRow * (y / 2);
+            const int yBytesPerRow  = (int)CVPixelBufferGetBytesPerRowOfPlane(imageBuffer, 0);
+            const int uvBytesPerRow = (int)CVPixelBufferGetBytesPerRowOfPlane(imageBuffer, 1);
+            const long long ySize  = (long long)yBytesPerRow * CVPixelBufferGetHeightOfPlane(imageBuffer, 0);
+            const long long uvSize = (long long)uvBytesPerRow * CVPixelBufferGetHeightOfPlane(imageBuffer, 1);
 
-                for (size_t x = 0; x < width; uvRow += 2 * (x % 2), ++yRow, rgbPtr += outPixelStride, ++x) {
-                    const unsigned int Y = *yRow;
-                    const unsigned int U = uvRow[0];
-                    const unsigned int V = uvRow[1];
+            // Chroma is interleaved as Cb, Cr pairs
+            const fsdk::ImagePlane y = {yPlane, ySize, yBytesPerRow, 1};
+            const fsdk::ImagePlane u = {uvPlane, uvSize, uvBytesPerRow, 2};
+            const fsdk::ImagePlane v = {uvPlane + 1, uvSize - 1, uvBytesPerRow, 2};
 
-                    const unsigned int R = Y + (91881 * V >> 16) - 179;
-                    const unsigned int G = Y - ((22544 * U + 46793 * V) >> 16) + 135;
-                    const unsigned int B = Y + (116129 * U >> 16) - 226;
-
-                    rgbPtr[0] = std::clamp(R, 0u, 255u);
-                    rgbPtr[1] = std::clamp(G, 0u, 255u);
-                    rgbPtr[2] = std::clamp(B, 0u, 255u);
-                }
-            }
+            errorCode = fsdk::LoadImageFromYUV420(image, y, u, v, width, height, rotationDegrees, mirrored);
+            if (errorCode == FSDKE_OK)
+                fsdk::RecordYUV420Frame(y, u, v, width, height, rotationDegrees, mirrored, timestamp, *image);
             break;
         }
         default: {
-            delete[] rgbBuffer;
-            rgbBuffer = nullptr;
-
             *error = [NSString stringWithFormat:@"Unknown image format: %u", format];
 
             break;
         }
     }
 
-    CVPixelBufferUnlockBaseAddress(imageBuffer, 0);
+    CVPixelBufferUnlockBaseAddress(imageBuffer, kCVPixelBufferLock_ReadOnly);
 
-    return rgbBuffer;
+    return errorCode;
 }
 
 @implementation FrameToFSDKImagePlugin
@@ -161,24 +122,22 @@ unsigned char *frameToRGBBuffer(Frame *frame, NSString **error, size_t *outWidth
 }
 
 - (id)callback:(Frame*)frame withArguments:(NSDictionary*)arguments {
+    // Later calls on this thread (i.e. FeedFrame from the same frame processor) are attributed to this frame.
+    fsdk::trace::SetFrameTimestamp(frameTimestamp(frame));
+    fsdk::trace::Span span("frameToFSDKImage");
+
     NSString* error = @"";
-    size_t width = 0, height = 0;
-    const unsigned char *buffer = frameToRGBBuffer(frame, &error, &width, &height);
-    
-    NSMutableDictionary *result = [NSMutableDictionary new];
-    
     HImage image = -1;
-    int errorCode = FSDKE_FAILED;
-    
-    if (buffer)
-        errorCode = FSDK_LoadImageFromBuffer(&image, buffer, width, height, width * 3, FSDK_IMAGE_COLOR_24BIT);
-    
+
+    // ConvertFrame and LoadImageFromBuffer spans are recorded by the shared conversion.
+    const int errorCode = frameToFSDKImage(frame, &image, &error);
+
+    NSMutableDictionary *result = [NSMutableDictionary new];
+
     result[@"errorCode"] = @(errorCode);
     result[@"error"] = error;
     result[@"handle"] = @(image);
 
-    delete[] buffer;
-    
     return result;
 }
 
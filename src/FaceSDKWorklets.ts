@@ -4,10 +4,15 @@ import LuxandFaceSDK, {
   type Face,
   type FaceImageResult,
   type FacePosition,
+  type FaceQuality as NativeFaceQuality,
+  type FaceQualityResult,
   type IDSimilarity,
+  type KeyframeResult,
+  type NativeFaceAtlas,
   type NativeFunctionNumberResult,
   type NativeFunctionResult,
   type Point,
+  type QualityFaceTemplateResult,
   type TrackerID
 } from './NativeFaceSDK';
 
@@ -37,6 +42,34 @@ export interface FaceImage {
 
 }
 
+export interface FaceAtlas extends NativeFaceAtlas {
+
+  width: number;
+  height: number;
+
+}
+
+export interface KeyframeFrame {
+
+  ids: number[];
+  keyframe: boolean;
+
+}
+
+export interface FaceQuality extends NativeFaceQuality {
+
+  passed: boolean;
+
+}
+
+export interface QualityFaceTemplate {
+
+  /** Base64 encoded template, empty when the face failed the filter */
+  template: string;
+  quality: FaceQuality;
+
+}
+
 var alert: (msg: string) => Promise<void>;
 if (Worklets !== undefined)
   alert = Worklets.createRunOnJS((msg: string) => Alert.alert('FaceSDK Error', msg));
@@ -86,6 +119,32 @@ function returnFaceImage(result: FaceImageResult = { value : { image: -1, featur
   };
 }
 
+function returnKeyframeFrame(result: KeyframeResult = { value: [], keyframe: false }): KeyframeFrame {
+  'worklet'
+
+  return {
+      ids: result.value,
+      keyframe: result.keyframe
+  };
+}
+
+const failedQuality: NativeFaceQuality = { sharpness: 0, brightness: 0, darkFraction: 0, brightFraction: 0, eyeDistance: 0, roll: 0, yaw: 0, failed: -1 };
+
+function returnFaceQuality(result: FaceQualityResult = { value: failedQuality }): FaceQuality {
+  'worklet'
+
+  return { ...result.value, passed: result.value.failed === 0 };
+}
+
+function returnQualityFaceTemplate(result: QualityFaceTemplateResult = { value: '', quality: failedQuality }): QualityFaceTemplate {
+  'worklet'
+
+  return {
+      template: result.value,
+      quality: { ...result.quality, passed: result.quality.failed === 0 }
+  };
+}
+
 function returnDefault<T>(defaultValue: T): (result?: { value: T }) => T {
   return (result?: { value: T }) => {
     'worklet'
@@ -102,6 +161,7 @@ const emptyPoint: Point = { x: 0, y: 0 };
 const emptyFacePosition: FacePosition = { xc: 0, yc: 0, w: 0, angle: 0 };
 const emptyFace: Face = { bbox: { p0: emptyPoint, p1: emptyPoint }, features: Array(5).fill(emptyPoint) };
 const emptyTrackerID: TrackerID = { id: -1, faceID: -1 };
+const emptyFaceAtlas: NativeFaceAtlas = { buffer: new ArrayBuffer(0), faces: [], features: new Int32Array(0), errorCodes: new Int32Array(0), channels: 0, stride: 0, faceSize: 0 };
 
 const returnZero           = returnDefault(0);
 const returnNegativeOne    = returnDefault(-1);
@@ -115,11 +175,31 @@ const returnIDs            = returnDefault<number[]>([]);
 const returnTrackerID      = returnDefault(emptyTrackerID);
 const returnIDSimilarities = returnDefault<IDSimilarity[]>([]);
 const returnErrorPosition  = returnDefault<number>(0);
+const returnFaceAtlas      = returnDefault(emptyFaceAtlas);
 
 var frameToFSDKImagePlugin: FrameProcessorPlugin | undefined;
 if (VisionCameraProxy !== undefined)
   frameToFSDKImagePlugin = VisionCameraProxy.initFrameProcessorPlugin('frameToFSDKImage', {});
 
+// The JSI binding is installed into the JavaScript runtime when the module is loaded and captured by the worklets,
+// which call it on their own runtime, so the atlas is extracted into native memory without copying it.
+var extractFaceAtlasBinding: typeof global.__FSDKExtractFaceAtlas;
+if (Worklets !== undefined) {
+  if (global.__FSDKExtractFaceAtlas === undefined)
+    LuxandFaceSDK.InstallJSIBindings();
+  extractFaceAtlasBinding = global.__FSDKExtractFaceAtlas;
+}
+
+function extractFaceAtlas(image: number, features: Int32Array, count: number, width: number, height: number, imageMode: number,
+                          threads: number): NativeFunctionResult & { result: { value: NativeFaceAtlas } } {
+  'worklet'
+
+  const atlas = extractFaceAtlasBinding?.(image, features, count, width, height, imageMode, threads) ?? ERROR.FAILED;
+  if (typeof atlas === 'number')
+    return { error: ERROR[atlas] ?? '', errorCode: atlas, result: { value: emptyFaceAtlas } };
+  return { error: '', errorCode: ERROR.OK, result: { value: atlas } };
+}
+
 export function frameToFSDKImage(frame: Frame): NativeFunctionNumberResult {
   'worklet'
 
@@ -324,6 +404,11 @@ export default class FSDK {
     return executeSDKFunction(LuxandFaceSDK.DetectMultipleFaces2, 'DetectMultipleFaces2', returnFaces, image, maxFaces);
   }
 
+  public static DetectMultipleFacesTiled(image: number, maxFaces: number = 100, tileSize: number = 1024, overlap: number = 128, threads: number = 0, fullImagePass: boolean = true, iouThreshold: number = 0.4): Face[] {
+    'worklet'
+    return executeSDKFunction(LuxandFaceSDK.DetectMultipleFacesTiled, 'DetectMultipleFacesTiled', returnFaces, image, maxFaces, tileSize, overlap, threads, fullImagePass, iouThreshold);
+  }
+
   public static SetFaceDetectionParameters(handleArbitraryRotations: boolean, determineFaceRotationAngle: boolean, internalResizeWidth: number): void {
     'worklet'
     return executeSDKFunction(LuxandFaceSDK.SetFaceDetectionParameters, 'SetFaceDetectionParameters', returnVoid, handleArbitraryRotations, determineFaceRotationAngle, internalResizeWidth);
@@ -648,4 +733,87 @@ export default class FSDK {
     'worklet'
     return executeSDKFunction(LuxandFaceSDK.CloseVideoCamera, 'CloseVideoCamera', returnVoid, camera);
   }
+
+  public static CreateAnalysisContext(image: number): number {
+    'worklet'
+    return executeSDKFunction(LuxandFaceSDK.CreateAnalysisContext, 'CreateAnalysisContext', returnNegativeOne, image);
+  }
+
+  public static FreeAnalysisContext(context: number): void {
+    'worklet'
+    return executeSDKFunction(LuxandFaceSDK.FreeAnalysisContext, 'FreeAnalysisContext', returnVoid, context);
+  }
+
+  public static AnalysisContextDetectFace(context: number): Face {
+    'worklet'
+    return executeSDKFunction(LuxandFaceSDK.AnalysisContextDetectFace, 'AnalysisContextDetectFace', returnFace, context);
+  }
+
+  public static AnalysisContextDetectFacialFeatures(context: number): Point[] {
+    'worklet'
+    return executeSDKFunction(LuxandFaceSDK.AnalysisContextDetectFacialFeatures, 'AnalysisContextDetectFacialFeatures', returnFeatures, context);
+  }
+
+  public static AnalysisContextDetectFacialAttribute(context: number, attribute: FacialAttribute | FacialAttribute[], maxSize: number = 256): string {
+    'worklet'
+    return executeSDKFunction(LuxandFaceSDK.AnalysisContextDetectFacialAttribute, 'AnalysisContextDetectFacialAttribute', returnEmptyString, context, attribute instanceof Array ? attribute.join(';') : attribute, maxSize);
+  }
+
+  public static AnalysisContextGetFaceTemplate(context: number): string {
+    'worklet'
+    return executeSDKFunction(LuxandFaceSDK.AnalysisContextGetFaceTemplate, 'AnalysisContextGetFaceTemplate', returnEmptyString, context);
+  }
+
+  public static GetTraceTime(): number {
+    'worklet'
+    return executeSDKFunction(LuxandFaceSDK.GetTraceTime, 'GetTraceTime', returnZero);
+  }
+
+  public static SetTraceFrameTimestamp(frameTimestamp: number): void {
+    'worklet'
+    return executeSDKFunction(LuxandFaceSDK.SetTraceFrameTimestamp, 'SetTraceFrameTimestamp', returnVoid, frameTimestamp);
+  }
+
+  public static RecordTraceSpan(name: string, frameTimestamp: number, start: number, end?: number): void {
+    'worklet'
+    const endTime = end ?? executeSDKFunction(LuxandFaceSDK.GetTraceTime, 'GetTraceTime', returnZero);
+    return executeSDKFunction(LuxandFaceSDK.RecordTraceSpan, 'RecordTraceSpan', returnVoid, name, frameTimestamp, start, endTime);
+  }
+
+  public static KeyframeTrackerFeedFrame(keyframeTracker: number, image: number, maxFaces: number = 256, index: number = 0): KeyframeFrame {
+    'worklet'
+    return executeSDKFunction(LuxandFaceSDK.KeyframeTrackerFeedFrame, 'KeyframeTrackerFeedFrame', returnKeyframeFrame, keyframeTracker, index, image, maxFaces);
+  }
+
+  public static KeyframeTrackerGetFace(keyframeTracker: number, id: number, index: number = 0): Face {
+    'worklet'
+    return executeSDKFunction(LuxandFaceSDK.KeyframeTrackerGetFace, 'KeyframeTrackerGetFace', returnFace, keyframeTracker, index, id);
+  }
+
+  public static KeyframeTrackerGetFacialFeatures(keyframeTracker: number, id: number, index: number = 0): Point[] {
+    'worklet'
+    return executeSDKFunction(LuxandFaceSDK.KeyframeTrackerGetFacialFeatures, 'KeyframeTrackerGetFacialFeatures', returnFeatures, keyframeTracker, index, id);
+  }
+
+  public static ExtractFaceAtlas(image: number, features: Int32Array, count: number, width: number, height: number, imageMode: IMAGEMODE = IMAGEMODE.IMAGE_COLOR_24BIT,
+                                 threads: number = 0): FaceAtlas {
+    'worklet'
+    const atlas = executeSDKFunction(extractFaceAtlas, 'ExtractFaceAtlas', returnFaceAtlas, image, features, count, width, height, imageMode, threads);
+    return { ...atlas, width, height };
+  }
+
+  public static QualityFilterEvaluate(filter: number, image: number, face: Face): FaceQuality {
+    'worklet'
+    return executeSDKFunction(LuxandFaceSDK.QualityFilterEvaluate, 'QualityFilterEvaluate', returnFaceQuality, filter, image, face);
+  }
+
+  public static QualityFilterEvaluateTrackerFace(filter: number, tracker: number, id: number, image: number, index: number = 0): FaceQuality {
+    'worklet'
+    return executeSDKFunction(LuxandFaceSDK.QualityFilterEvaluateTrackerFace, 'QualityFilterEvaluateTrackerFace', returnFaceQuality, filter, tracker, index, id, image);
+  }
+
+  public static QualityFilterGetFaceTemplate(filter: number, image: number, face: Face): QualityFaceTemplate {
+    'worklet'
+    return executeSDKFunction(LuxandFaceSDK.QualityFilterGetFaceTemplate, 'QualityFilterGetFaceTemplate', returnQualityFaceTemplate, filter, image, face);
+  }
 }
@@ -46,6 +46,19 @@ export interface IDSimilarity {
 
 }
 
+export interface FaceQuality {
+
+  sharpness: number;
+  brightness: number;
+  darkFraction: number;
+  brightFraction: number;
+  eyeDistance: number;
+  roll: number;
+  yaw: number;
+  failed: number;
+
+}
+
 export interface NativeFunctionResult {
 
   error: string;
@@ -66,6 +79,13 @@ export interface FeaturesResult       { value: Point[] }
 export interface FaceImageResult      { value: NativeFaceImage }
 export interface TrackerIDResult      { value: TrackerID }
 export interface IDSimilaritiesResult { value: IDSimilarity[] }
+export interface CachedFaceTemplateResult { value: string; face: Face }
+export interface FaceAtlasResult      { value: string; features: number[]; errorCodes: number[]; stride: number; faceSize: number }
+/** A face atlas returned by the __FSDKExtractFaceAtlas JSI binding, every array is a view of native memory */
+export interface NativeFaceAtlas      { buffer: ArrayBuffer; faces: Uint8Array[]; features: Int32Array; errorCodes: Int32Array; channels: number; stride: number; faceSize: number }
+export interface KeyframeResult       { value: number[]; keyframe: boolean }
+export interface FaceQualityResult    { value: FaceQuality }
+export interface QualityFaceTemplateResult { value: string; quality: FaceQuality }
 
 export type NativeFunctionVoidResult           = NativeFunctionResult & { result: VoidResult };
 export type NativeFunctionNumberResult         = NativeFunctionResult & { result: NumberResult };
@@ -80,6 +100,11 @@ export type NativeFunctionFeaturesResult       = NativeFunctionResult & { result
 export type NativeFunctionFaceImageResult      = NativeFunctionResult & { result: FaceImageResult };
 export type NativeFunctionTrackerIDResult      = NativeFunctionResult & { result: TrackerIDResult };
 export type NativeFunctionIDSimilaritiesResult = NativeFunctionResult & { result: IDSimilaritiesResult };
+export type NativeFunctionCachedFaceTemplateResult = NativeFunctionResult & { result: CachedFaceTemplateResult };
+export type NativeFunctionFaceAtlasResult      = NativeFunctionResult & { result: FaceAtlasResult };
+export type NativeFunctionKeyframeResult       = NativeFunctionResult & { result: KeyframeResult };
+export type NativeFunctionFaceQualityResult    = NativeFunctionResult & { result: FaceQualityResult };
+export type NativeFunctionQualityFaceTemplateResult = NativeFunctionResult & { result: QualityFaceTemplateResult };
 
 export interface Spec extends TurboModule {
 
@@ -118,11 +143,13 @@ export interface Spec extends TurboModule {
   CopyRectReplicateBorder(image: number, x1: number, y1: number, x2: number, y2: number): NativeFunctionNumberResult;
   MirrorImage(image: number, vertical: boolean): NativeFunctionVoidResult;
   ExtractFaceImage(image: number, features: Point[], width: number, height: number): NativeFunctionFaceImageResult;
+  ExtractFaceAtlas(image: number, features: number[], count: number, width: number, height: number, imageMode: number, threads: number): NativeFunctionFaceAtlasResult;
 
   DetectFace(image: number): NativeFunctionFacePositionResult;
   DetectFace2(image: number): NativeFunctionFaceResult;
   DetectMultipleFaces(image: number, maxFaces: number): NativeFunctionFacePositionsResult;
   DetectMultipleFaces2(image: number, maxFaces: number): NativeFunctionFacesResult;
+  DetectMultipleFacesTiled(image: number, maxFaces: number, tileSize: number, overlap: number, threads: number, fullImagePass: boolean, iouThreshold: number): NativeFunctionFacesResult;
   SetFaceDetectionParameters(handleArbitraryRotations: boolean, determineFaceRotationAngle: boolean, internalResizeWidth: number): NativeFunctionVoidResult;
   SetFaceDetectionThreshold(theshold: number): NativeFunctionVoidResult;
   GetDetectedFaceConfidence(): NativeFunctionNumberResult;
@@ -195,6 +222,73 @@ export interface Spec extends TurboModule {
   SetParameters(parameters: string): NativeFunctionNumberResult;
 
   InitializeIBeta(): NativeFunctionNumberResult;
+
+  CreateAnalysisContext(image: number): NativeFunctionNumberResult;
+  FreeAnalysisContext(context: number): NativeFunctionVoidResult;
+  AnalysisContextDetectFace(context: number): NativeFunctionFaceResult;
+  AnalysisContextDetectFacialFeatures(context: number): NativeFunctionFeaturesResult;
+  AnalysisContextDetectFacialAttribute(context: number, name: string, maxSize: number): NativeFunctionStringResult;
+  AnalysisContextGetFaceTemplate(context: number): NativeFunctionStringResult;
+
+  SetTraceEnabled(enabled: boolean, capacity: number): NativeFunctionVoidResult;
+  ClearTrace(): NativeFunctionVoidResult;
+  GetTraceTime(): NativeFunctionNumberResult;
+  SetTraceFrameTimestamp(frameTimestamp: number): NativeFunctionVoidResult;
+  RecordTraceSpan(name: string, frameTimestamp: number, start: number, end: number): NativeFunctionVoidResult;
+  DumpTrace(): NativeFunctionStringResult;
+  SaveTrace(filename: string): NativeFunctionVoidResult;
+
+  CreateTemplateCache(filename: string, maxEntries: number, configuration: string): NativeFunctionNumberResult;
+  FreeTemplateCache(cache: number): NativeFunctionVoidResult;
+  SaveTemplateCache(cache: number): NativeFunctionVoidResult;
+  ClearTemplateCache(cache: number): NativeFunctionVoidResult;
+  GetTemplateCacheStatistics(cache: number): NativeFunctionNumbersResult;
+  TemplateCacheGetFaceTemplateFromFile(cache: number, filename: string): NativeFunctionCachedFaceTemplateResult;
+  TemplateCacheGetFaceTemplateFromBuffer(cache: number, buffer: string): NativeFunctionCachedFaceTemplateResult;
+  TemplateCacheGetFaceTemplate(cache: number, image: number): NativeFunctionCachedFaceTemplateResult;
+
+  CreateThumbnailStore(filename: string, maxSize: number, maxCachedImages: number): NativeFunctionNumberResult;
+  FreeThumbnailStore(store: number): NativeFunctionVoidResult;
+  CompactThumbnailStore(store: number): NativeFunctionVoidResult;
+  GetThumbnailStoreStatistics(store: number): NativeFunctionNumbersResult;
+  AttachThumbnailStore(tracker: number, store: number): NativeFunctionVoidResult;
+  GetTrackerFaceThumbnail(tracker: number, faceID: number): NativeFunctionStringResult;
+
+  CreateKeyframeTracker(tracker: number, keyframeInterval: number, workingWidth: number, searchRadius: number, minCorrelation: number): NativeFunctionNumberResult;
+  FreeKeyframeTracker(keyframeTracker: number): NativeFunctionVoidResult;
+  KeyframeTrackerFeedFrame(keyframeTracker: number, index: number, image: number, maxFaces: number): NativeFunctionKeyframeResult;
+  KeyframeTrackerGetFace(keyframeTracker: number, index: number, id: number): NativeFunctionFaceResult;
+  KeyframeTrackerGetFacialFeatures(keyframeTracker: number, index: number, id: number): NativeFunctionFeaturesResult;
+
+  StartFrameRecording(filename: string, compressed: boolean): NativeFunctionVoidResult;
+  StopFrameRecording(): NativeFunctionNumbersResult;
+
+  AttachMemoryGovernor(tracker: number, maxTemplates: number, targetRatio: number, minIdleSeconds: number, interval: number): NativeFunctionVoidResult;
+  DetachMemoryGovernor(tracker: number): NativeFunctionVoidResult;
+  GetMemoryGovernorStatistics(tracker: number): NativeFunctionNumbersResult;
+
+  CreateResultSlot(maxFaces: number, attributes: string): NativeFunctionNumberResult;
+  FreeResultSlot(slot: number): NativeFunctionVoidResult;
+  AttachResultSlot(tracker: number, slot: number): NativeFunctionVoidResult;
+  InstallJSIBindings(): NativeFunctionVoidResult;
+
+  CreateQualityFilter(minSharpness: number, minBrightness: number, maxBrightness: number, maxClippedFraction: number, minEyeDistance: number, maxRoll: number, maxYaw: number): NativeFunctionNumberResult;
+  FreeQualityFilter(filter: number): NativeFunctionVoidResult;
+  QualityFilterEvaluate(filter: number, image: number, face: Face): NativeFunctionFaceQualityResult;
+  QualityFilterEvaluateTrackerFace(filter: number, tracker: number, index: number, id: number, image: number): NativeFunctionFaceQualityResult;
+  QualityFilterGetFaceTemplate(filter: number, image: number, face: Face): NativeFunctionQualityFaceTemplateResult;
+
+  CreateFaceIndex(filename: string, maxConnections: number, efConstruction: number, efSearch: number): NativeFunctionNumberResult;
+  FreeFaceIndex(index: number): NativeFunctionVoidResult;
+  SaveFaceIndex(index: number): NativeFunctionVoidResult;
+  FaceIndexAddFaceTemplate(index: number, id: number, faceTemplate: string): NativeFunctionVoidResult;
+  FaceIndexAddTrackerFaces(index: number, tracker: number): NativeFunctionNumberResult;
+  FaceIndexRemoveID(index: number, id: number): NativeFunctionVoidResult;
+  FaceIndexMatchFaces(index: number, faceTemplate: string, threshold: number, maxSize: number): NativeFunctionIDSimilaritiesResult;
+  GetFaceIndexStatistics(index: number): NativeFunctionNumbersResult;
+
+  StartInitialization(prefetchDirectories: string, iBeta: boolean, warmUp: boolean, trackerParameters: string): NativeFunctionVoidResult;
+  GetInitializationStatus(): NativeFunctionNumbersResult;
 }
 
 export default TurboModuleRegistry.getEnforcing<Spec>('LuxandFaceSDK');
@@ -214,6 +308,15 @@ export async function copyAssetsToCacheDirectory(): Promise<void> {
   await copyDirectory(sourceDir, destDir);
 };
 
+// Directories with the model files read by Initialize and the iBeta addon, Android assets are not files and are not listed
+export function modelDirectories(): string[] {
+  const cacheDir = RNFS.CachesDirectoryPath + '/data';
+
+  return Platform.OS == 'android'
+         ? [cacheDir]
+         : [RNFS.MainBundlePath + '/data', cacheDir];
+};
+
 async function copyDirectory(source: string, destination: string): Promise<void> {
   const files = Platform.OS == 'android'
                 ? await RNFS.readDirAssets(source)
@@ -47,6 +47,18 @@ export enum VIDEOCOMPRESSIONTYPE {
   MJPEG = 0
 }
 
+/**
+ * Checks of a quality filter, combined into FaceQuality.failed.
+ * @enum {number}
+ */
+export enum QUALITY_CHECK {
+  SHARPNESS  = 1,
+  BRIGHTNESS = 2,
+  CLIPPING   = 4,
+  FACE_SIZE  = 8,
+  POSE       = 16
+}
+
 export enum FEATURE {
   LEFT_EYE                    = 0,
   RIGHT_EYE                   = 1,
@@ -2,16 +2,24 @@ import { decode, encode } from 'base64-arraybuffer';
 import { Alert } from 'react-native';
 
 import LuxandFaceSDK, {
+  type CachedFaceTemplateResult,
+  type FaceAtlasResult,
   type Face,
+  type FaceQualityResult,
   type FaceImageResult,
   type FacePosition,
   type IDSimilarity,
+  type KeyframeResult,
+  type NativeFaceAtlas,
   type NativeFunctionResult,
   type NumberResult,
+  type NumbersResult,
   type Point,
+  type QualityFaceTemplateResult,
   type StringResult,
   type TrackerID,
   copyAssetsToCacheDirectory,
+  modelDirectories,
 } from './NativeFaceSDK';
 
 import {
@@ -27,6 +35,7 @@ import {
   type ParameterValue,
   type ParameterValueType,
   type Parameters,
+  QUALITY_CHECK,
   type TrackerFacialAttribute,
   type TrackerParameter,
   type TrackerParameters,
@@ -41,7 +50,7 @@ import {
 import FSDKWorklets from './FaceSDKWorklets';
 
 export {
-  ERROR, FACIAL_FEATURE_COUNT, FEATURE, FSDKError, IMAGEMODE, ON_ERROR, VIDEOCOMPRESSIONTYPE, type Face, type FacePosition,
+  ERROR, FACIAL_FEATURE_COUNT, FEATURE, FSDKError, IMAGEMODE, ON_ERROR, QUALITY_CHECK, VIDEOCOMPRESSIONTYPE, type Face, type FacePosition,
   type FacialAttribute, type IDSimilarity, type Parameter, type ParameterValue,
   type Parameters, type Point, type TrackerFacialAttribute, type TrackerID, type TrackerParameter, type TrackerParameters
 };
@@ -53,6 +62,184 @@ export interface FaceImage {
 
 }
 
+export interface AtlasFace {
+
+  pixels: Uint8Array;
+  features: Point[];
+  errorCode: number;
+
+}
+
+export interface FaceAtlas {
+
+  buffer: ArrayBuffer;
+  width: number;
+  height: number;
+  channels: number;
+  stride: number;
+  faceSize: number;
+  faces: AtlasFace[];
+  /** The features of all the faces packed as x, y pairs, FACIAL_FEATURE_COUNT points per face */
+  features: Int32Array;
+  errorCodes: Int32Array;
+
+}
+
+export interface CachedFaceTemplate {
+
+  template: FaceTemplate;
+  face: Face;
+
+}
+
+export interface TemplateCacheStatistics {
+
+  hits: number;
+  misses: number;
+  entries: number;
+  evictions: number;
+
+}
+
+export interface FaceIndexParameters {
+
+  /** Links per template in the index graph. More links raise the recall and the memory use. */
+  maxConnections?: number;
+  /** Candidates considered when a template is added. Higher values build a better index more slowly. */
+  efConstruction?: number;
+  /** Candidates collected by a search. Higher values raise the recall, the search time grows about linearly. */
+  efSearch?: number;
+
+}
+
+export interface FaceIndexStatistics {
+
+  templates: number;
+  ids: number;
+  /** Removed templates still kept in the index graph */
+  removed: number;
+  searches: number;
+  /** Templates compared by the searches */
+  comparisons: number;
+
+}
+
+export interface ThumbnailStoreStatistics {
+
+  thumbnails: number;
+  fileSize: number;
+  garbageSize: number;
+  cachedImages: number;
+
+}
+
+export interface FrameRecordingStatistics {
+
+  frames: number;
+  bytes: number;
+
+}
+
+export interface MemoryGovernorStatistics {
+
+  ids: number;
+  templates: number;
+  protectedIDs: number;
+  evictedIDs: number;
+  evictedTemplates: number;
+  sweeps: number;
+
+}
+
+export interface ResultSlotFace {
+
+  id: number;
+  bbox: { p0: Point; p1: Point };
+  name: string;
+  attributes: Record<string, number>;
+  rawAttributes: Record<string, string>;
+
+}
+
+export interface KeyframeFrame {
+
+  ids: number[];
+  keyframe: boolean;
+
+}
+
+export interface InitializationOptions {
+
+  /** Initialize the iBeta liveness addon, the same as {@member FSDK.InitializeIBeta}. */
+  iBeta?: boolean;
+  /** Read the model files into the page cache on several threads before initializing. */
+  prefetch?: boolean;
+  /** Run detection, template extraction and a tracker frame on a synthetic image, so the first frame is not slowed down. */
+  warmUp?: boolean;
+  /** Parameters of the warm-up tracker, should match the parameters of the application trackers. */
+  trackerParameters?: string | TrackerParameters;
+  /** Interval between the status checks, in milliseconds. */
+  pollInterval?: number;
+
+}
+
+/** Stage durations are in milliseconds, 0 for stages not run (yet). */
+export interface InitializationStatus {
+
+  state: 'idle' | 'running' | 'ready' | 'failed';
+  errorCode: number;
+  prefetchedFiles: number;
+  prefetchedBytes: number;
+  prefetch: number;
+  initialize: number;
+  liveness: number;
+  detection: number;
+  template: number;
+  tracker: number;
+  total: number;
+
+}
+
+export interface QualityFilterParameters {
+
+  /** The variance of the Laplacian of the full resolution face luma, blurred faces score low. 0 disables the check. */
+  minSharpness?: number;
+  /** The mean luma of the face, 0..255. */
+  minBrightness?: number;
+  maxBrightness?: number;
+  /** The maximal fraction of the face darker than 16 or brighter than 239. */
+  maxClippedFraction?: number;
+  /** The distance between the eyes in pixels. */
+  minEyeDistance?: number;
+  /** Head roll and estimated yaw in degrees. */
+  maxRoll?: number;
+  maxYaw?: number;
+
+}
+
+export interface FaceQuality {
+
+  sharpness: number;
+  brightness: number;
+  darkFraction: number;
+  brightFraction: number;
+  eyeDistance: number;
+  roll: number;
+  yaw: number;
+  /** QUALITY_CHECK values of the failed checks combined, 0 when the face passed */
+  failed: number;
+  passed: boolean;
+
+}
+
+export interface QualityFaceTemplate {
+
+  /** null when the face failed the filter */
+  template: FaceTemplate | null;
+  quality: FaceQuality;
+
+}
+
 function executeSDKFunction<P extends any[], T, V extends Record<string, any>>(func: (...args: P) => NativeFunctionResult & { result: V }, processor: (a?: V) => T, ...args: P): T {
   const result = func(...args);
   const errorCode = result.errorCode;
@@ -94,6 +281,51 @@ function returnCamera(result: NumberResult = { value: -1 }): Camera {
   return new Camera(result.value);
 }
 
+function returnAnalysisContext(result: NumberResult = { value: -1 }): AnalysisContext {
+  return new AnalysisContext(result.value);
+}
+
+function returnTemplateCache(result: NumberResult = { value: -1 }): TemplateCache {
+  return new TemplateCache(result.value);
+}
+
+function returnThumbnailStore(result: NumberResult = { value: -1 }): ThumbnailStore {
+  return new ThumbnailStore(result.value);
+}
+
+function returnResultSlot(result: NumberResult = { value: -1 }): ResultSlot {
+  return new ResultSlot(result.value);
+}
+
+function returnKeyframeTracker(result: NumberResult = { value: -1 }): KeyframeTracker {
+  return new KeyframeTracker(result.value);
+}
+
+function returnKeyframeFrame(result: KeyframeResult = { value: [], keyframe: false }): KeyframeFrame {
+  return { ids: result.value, keyframe: result.keyframe };
+}
+
+function returnFaceIndex(result: NumberResult = { value: -1 }): FaceIndex {
+  return new FaceIndex(result.value);
+}
+
+function returnQualityFilter(result: NumberResult = { value: -1 }): QualityFilter {
+  return new QualityFilter(result.value);
+}
+
+const FAILED_QUALITY: FaceQualityResult['value'] = { sharpness: 0, brightness: 0, darkFraction: 0, brightFraction: 0, eyeDistance: 0, roll: 0, yaw: 0, failed: -1 };
+
+function returnFaceQuality(result: FaceQualityResult = { value: FAILED_QUALITY }): FaceQuality {
+  return { ...result.value, passed: result.value.failed === 0 };
+}
+
+function returnQualityFaceTemplate(result: QualityFaceTemplateResult = { value: '', quality: FAILED_QUALITY }): QualityFaceTemplate {
+  return {
+    template: result.value ? FaceTemplate.FromBase64(result.value) : null,
+    quality: returnFaceQuality({ value: result.quality })
+  };
+}
+
 function returnFaceImage(result: FaceImageResult = { value : { image: -1, features: [] } }): FaceImage {
   return {
     image: new Image(result.value.image),
@@ -105,6 +337,80 @@ function returnFaceTemplate(result: StringResult = { value: '' }): FaceTemplate
   return FaceTemplate.FromBase64(result.value);
 }
 
+function makeFaceAtlas(atlas: NativeFaceAtlas, width: number, height: number): FaceAtlas {
+  const faces = Array.from(atlas.errorCodes, (errorCode, face) => {
+    const offset = face * FACIAL_FEATURE_COUNT * 2;
+    const features = Array.from({ length: FACIAL_FEATURE_COUNT }, (_, i) => ({
+      x: atlas.features[offset + 2 * i] ?? 0,
+      y: atlas.features[offset + 2 * i + 1] ?? 0
+    }));
+    return { pixels: atlas.faces[face] ?? new Uint8Array(0), features, errorCode };
+  });
+  const { buffer, channels, stride, faceSize, features, errorCodes } = atlas;
+  return { buffer, width, height, channels, stride, faceSize, faces, features, errorCodes };
+}
+
+function returnFaceAtlas(result: FaceAtlasResult, width: number, height: number, imageMode: IMAGEMODE): FaceAtlas {
+  const buffer = result.value == '' ? new ArrayBuffer(0) : decode(result.value);
+  const channels = imageMode == IMAGEMODE.IMAGE_GRAYSCALE_8BIT ? 1 : imageMode == IMAGEMODE.IMAGE_COLOR_24BIT ? 3 : 4;
+  const faces = result.errorCodes.map((_, face) => new Uint8Array(buffer, face * result.faceSize, result.faceSize));
+  return makeFaceAtlas({ buffer, faces, features: Int32Array.from(result.features), errorCodes: Int32Array.from(result.errorCodes),
+    channels, stride: result.stride, faceSize: result.faceSize }, width, height);
+}
+
+function packFaceFeatures(features: Point[][]): Int32Array {
+  const packed = new Int32Array(features.length * FACIAL_FEATURE_COUNT * 2);
+  features.forEach((points, face) => points.slice(0, FACIAL_FEATURE_COUNT).forEach((point, i) => {
+    packed[(face * FACIAL_FEATURE_COUNT + i) * 2] = point.x;
+    packed[(face * FACIAL_FEATURE_COUNT + i) * 2 + 1] = point.y;
+  }));
+  return packed;
+}
+
+function returnCachedFaceTemplate(result: CachedFaceTemplateResult = { value: '', face: emptyFace }): CachedFaceTemplate {
+  return {
+    template: FaceTemplate.FromBase64(result.value),
+    face: result.face
+  };
+}
+
+function returnFaceIndexStatistics(result: NumbersResult = { value: [0, 0, 0, 0, 0] }): FaceIndexStatistics {
+  const [templates = 0, ids = 0, removed = 0, searches = 0, comparisons = 0] = result.value;
+  return { templates, ids, removed, searches, comparisons };
+}
+
+function returnTemplateCacheStatistics(result: NumbersResult = { value: [0, 0, 0, 0] }): TemplateCacheStatistics {
+  const [hits = 0, misses = 0, entries = 0, evictions = 0] = result.value;
+  return { hits, misses, entries, evictions };
+}
+
+function returnThumbnailStoreStatistics(result: NumbersResult = { value: [0, 0, 0, 0] }): ThumbnailStoreStatistics {
+  const [thumbnails = 0, fileSize = 0, garbageSize = 0, cachedImages = 0] = result.value;
+  return { thumbnails, fileSize, garbageSize, cachedImages };
+}
+
+function returnFrameRecordingStatistics(result: NumbersResult = { value: [0, 0] }): FrameRecordingStatistics {
+  const [frames = 0, bytes = 0] = result.value;
+  return { frames, bytes };
+}
+
+function returnMemoryGovernorStatistics(result: NumbersResult = { value: [0, 0, 0, 0, 0, 0] }): MemoryGovernorStatistics {
+  const [ids = 0, templates = 0, protectedIDs = 0, evictedIDs = 0, evictedTemplates = 0, sweeps = 0] = result.value;
+  return { ids, templates, protectedIDs, evictedIDs, evictedTemplates, sweeps };
+}
+
+const InitializationStates = [ 'idle', 'running', 'ready', 'failed' ] as const;
+
+// Durations are passed in microseconds
+function returnInitializationStatus(result: NumbersResult = { value: [] }): InitializationStatus {
+  const [state = 0, errorCode = ERROR.OK, prefetchedFiles = 0, prefetchedBytes = 0, ...durations] = result.value;
+  const [prefetch = 0, initialize = 0, liveness = 0, detection = 0, template = 0, tracker = 0, total = 0] = durations.map(e => e / 1000);
+  return {
+    state: InitializationStates[state] ?? 'idle', errorCode, prefetchedFiles, prefetchedBytes,
+    prefetch, initialize, liveness, detection, template, tracker, total
+  };
+}
+
 function returnBuffer(result: StringResult = { value: '' }): Buffer {
   return Buffer.FromBase64(result.value);
 }
@@ -564,6 +870,31 @@ export class Image extends FSDKObject {
     return executeSDKFunction(LuxandFaceSDK.ExtractFaceImage, returnFaceImage, this.handle, features, width, height);
   }
 
+  /**
+   * Extract several faces at once, in parallel. The faces are written one after another into a single atlas buffer, every row of a face
+   * is padded to a multiple of 64 bytes. Faces that could not be extracted are filled with zeros and report their own error code.
+   * On the JavaScript thread the atlas, the features and the error codes are returned in native memory without copying them.
+   * @param {Point[][] | Int32Array} features Arrays of face key points, one per face, or the key points of all the faces packed as x, y pairs,
+   * FACIAL_FEATURE_COUNT points per face.
+   * @param {number} width Target face width.
+   * @param {number} height Target face height.
+   * @param {IMAGEMODE} imageMode Pixel format of the atlas.
+   * @param {number} threads The number of threads, 0 uses all the cores.
+   * @returns {FaceAtlas} The atlas with a view of every face into it and the features of the faces in their coordinates.
+   */
+  public extractFaceAtlas(features: Point[][] | Int32Array, width: number, height: number, imageMode: IMAGEMODE = IMAGEMODE.IMAGE_COLOR_24BIT, threads: number = 0): FaceAtlas {
+    const packed = features instanceof Int32Array ? features : packFaceFeatures(features);
+    const count = Math.floor(packed.length / (FACIAL_FEATURE_COUNT * 2));
+    const atlas = installJSIBindings() ? global.__FSDKExtractFaceAtlas?.(this.handle, packed, count, width, height, imageMode, threads) : undefined;
+    if (atlas !== undefined && typeof atlas !== 'number')
+      return makeFaceAtlas(atlas, width, height);
+
+    // Errors are reported by the module function, which returns the atlas as base64
+    const defaultResult = { value: '', features: [], errorCodes: [], stride: 0, faceSize: 0 };
+    return executeSDKFunction(LuxandFaceSDK.ExtractFaceAtlas, (result: FaceAtlasResult = defaultResult) => returnFaceAtlas(result, width, height, imageMode),
+      this.handle, Array.from(packed), count, width, height, imageMode, threads);
+  }
+
   /**
    * Detect a single face in the image. If multiple faces are present returns the one with the highest detection score. 
    * @returns {FacePosition} The detected face.
@@ -598,6 +929,21 @@ export class Image extends FSDKObject {
     return executeSDKFunction(LuxandFaceSDK.DetectMultipleFaces2, returnFaces, this.handle, maxFaces);
   }
 
+  /**
+   * Detect multiple faces in a large image using the improved face detection algorithm. The image is split into overlapping tiles
+   * which are processed in parallel, and faces found in several tiles are merged. Images not larger than a tile are processed as a whole.
+   * @param {number} maxFaces The maximal number of faces to detect.
+   * @param {number} tileSize The side of a square tile in pixels.
+   * @param {number} overlap The number of pixels shared by neighbouring tiles. Should be not less than the smallest face of interest.
+   * @param {number} threads The number of worker threads, 0 to use all available cores.
+   * @param {boolean} fullImagePass Also detect faces on the whole image to find faces larger than a tile.
+   * @param {number} iouThreshold Detections overlapping with a higher intersection over union are merged.
+   * @returns {Face[]} The detected faces.
+   */
+  public detectMultipleFacesTiled(maxFaces: number = 100, tileSize: number = 1024, overlap: number = 128, threads: number = 0, fullImagePass: boolean = true, iouThreshold: number = 0.4): Face[] {
+    return executeSDKFunction(LuxandFaceSDK.DetectMultipleFacesTiled, returnFaces, this.handle, maxFaces, tileSize, overlap, threads, fullImagePass, iouThreshold);
+  }
+
   /**
    * Detect 70 facial key points of a single face in the image. If multiple faces are present detects points for the face with the highest detection score. 
    * @returns {Point[]} The detected key points.
@@ -706,6 +1052,14 @@ export class Image extends FSDKObject {
   public detectFacialAttributeUsingFeaturesRaw(features: Point[], attribute: string | string[], maxSize: number = 256): string {
     return executeSDKFunction(LuxandFaceSDK.DetectFacialAttributeUsingFeatures, returnEmptyString, this.handle, features, attribute instanceof Array ? attribute.join(';') : attribute, maxSize);
   }
+
+  /**
+   * Create an analysis context for the image. The context caches face detection, facial features, attributes and the face template.
+   * @returns {AnalysisContext} The analysis context.
+   */
+  public createAnalysisContext(): AnalysisContext {
+    return AnalysisContext.Create(this);
+  }
 }
 
 
@@ -1039,6 +1393,71 @@ export class Tracker extends FSDKObject {
     return executeSDKFunction(LuxandFaceSDK.DeleteTrackerFaceImage, returnVoid, this.handle, faceID);
   }
 
+  /**
+   * Keep face images in a thumbnail store instead of tracker memory. Images set afterwards are stored as JPEG thumbnails,
+   * so they do not take space in tracker memory and are not saved with it. Images set before are still returned from tracker memory.
+   * @param {ThumbnailStore | null} store The store to attach, or null to detach the attached store.
+   * @returns {void}
+   */
+  public attachThumbnailStore(store: ThumbnailStore | null): void {
+    return executeSDKFunction(LuxandFaceSDK.AttachThumbnailStore, returnVoid, this.handle, store ? store.handle : 0);
+  }
+
+  /**
+   * Get the JPEG encoded face image for face id from the attached thumbnail store without decoding it. On the JavaScript thread
+   * the buffer is mapped from the store file without copying it; writing into it does not change the store.
+   * @param {number} faceID Face id to get the thumbnail for.
+   * @returns {Buffer} The JPEG thumbnail.
+   */
+  public getFaceThumbnail(faceID: number): Buffer {
+    const thumbnail = installJSIBindings() ? global.__FSDKGetTrackerFaceThumbnail?.(this.handle, faceID) : undefined;
+    if (thumbnail instanceof ArrayBuffer)
+      return Buffer.FromArrayBuffer(thumbnail);
+
+    // Errors are reported by the module function, which returns the thumbnail as base64
+    return executeSDKFunction(LuxandFaceSDK.GetTrackerFaceThumbnail, returnBuffer, this.handle, faceID);
+  }
+
+  /**
+   * Keep tracker memory within a budget of face templates. A native background thread purges the least recently seen ids
+   * without a name that are not locked whenever the tracker keeps more than maxTemplates templates, until it keeps targetRatio of them.
+   * Calling it again replaces the parameters.
+   * @param {number} maxTemplates The number of face templates to keep, 0 for 90% of the MemoryLimit tracker parameter.
+   * @param {number} minIdleSeconds Ids seen more recently than this are never purged.
+   * @param {number} targetRatio The share of the budget kept after purging.
+   * @param {number} interval How often tracker memory is checked, in milliseconds.
+   * @returns {void}
+   */
+  public attachMemoryGovernor(maxTemplates: number = 0, minIdleSeconds: number = 10, targetRatio: number = 0.8, interval: number = 1000): void {
+    return executeSDKFunction(LuxandFaceSDK.AttachMemoryGovernor, returnVoid, this.handle, maxTemplates, targetRatio, minIdleSeconds, interval);
+  }
+
+  /**
+   * Stop the memory governor of the tracker.
+   * @returns {void}
+   */
+  public detachMemoryGovernor(): void {
+    return executeSDKFunction(LuxandFaceSDK.DetachMemoryGovernor, returnVoid, this.handle);
+  }
+
+  /**
+   * Get the statistics of the memory governor: the ids and templates found by its last check and the totals of purged ids and templates.
+   * @returns {MemoryGovernorStatistics} The memory governor statistics.
+   */
+  public getMemoryGovernorStatistics(): MemoryGovernorStatistics {
+    return executeSDKFunction(LuxandFaceSDK.GetMemoryGovernorStatistics, returnMemoryGovernorStatistics, this.handle);
+  }
+
+  /**
+   * Publish the faces found on every frame fed to the tracker into a result slot. The faces are written natively right after
+   * the frame is processed and are read with ResultSlot.reader() on the JavaScript thread without passing them through runOnJS.
+   * @param {ResultSlot | null} slot The slot to attach, or null to detach the attached slot.
+   * @returns {void}
+   */
+  public attachResultSlot(slot: ResultSlot | null): void {
+    return executeSDKFunction(LuxandFaceSDK.AttachResultSlot, returnVoid, this.handle, slot ? slot.handle : 0);
+  }
+
   /**
    * Create a new id in the tracker memory.
    * @param {FaceTemplate} template Face template of the id.
@@ -1167,111 +1586,687 @@ export class Camera extends FSDKObject {
 }
 
 
-/** Main FSDK class, exposing all the functions at once */
-export default class FSDK {
-
-  public static readonly LuxandFaceSDK = LuxandFaceSDK;
-
-  public static readonly Image = Image;
-  public static readonly Buffer = Buffer;
-  public static readonly Camera = Camera;
-  public static readonly Tracker = Tracker;
-  public static readonly FaceTemplate = FaceTemplate;
+/**
+ * A wrapper object for an image analysis context. The context lazily detects the most confident face on the image, its facial features,
+ * attributes and face template. Each result is computed once and shared by subsequent calls, so different consumers of the same image
+ * do not repeat the detection. Cached results are dropped when the image is mirrored, and the context becomes invalid when the image is freed.
+ */
+export class AnalysisContext extends FSDKObject {
 
-  public static readonly ERROR = ERROR;
-  public static readonly FEATURE = FEATURE;
-  public static readonly IMAGEMODE = IMAGEMODE;
-  public static readonly FACIAL_FEATURE_COUNT = FACIAL_FEATURE_COUNT;
-  public static readonly VIDEOCOMPRESSIONTYPE = VIDEOCOMPRESSIONTYPE;
+  /**
+   * Create an analysis context for an image.
+   * @param {Image} image The image to analyze.
+   * @returns {AnalysisContext} The analysis context.
+   */
+  public static Create(image: Image): AnalysisContext {
+    return executeSDKFunction(LuxandFaceSDK.CreateAnalysisContext, returnAnalysisContext, image.handle);
+  }
 
-  public static readonly ON_ERROR = ON_ERROR;
-  public static onError = ON_ERROR.THROW;
+  /**
+   * Free the analysis context. The context becomes invalid.
+   * @returns {void}
+   */
+  public free(): void {
+    const result = executeSDKFunction(LuxandFaceSDK.FreeAnalysisContext, returnVoid, this.handle);
+    this.handle = -1;
+    return result;
+  }
 
-  public static readonly Worklets = FSDKWorklets;
+  /**
+   * Detect the most confident face on the image using the improved face detection algorithm.
+   * @returns {Face} The detected face.
+   */
+  public detectFace(): Face {
+    return executeSDKFunction(LuxandFaceSDK.AnalysisContextDetectFace, returnFace, this.handle);
+  }
 
+  /**
+   * Detect 70 facial key points of the detected face.
+   * @returns {Point[]} The detected key points.
+   */
+  public detectFacialFeatures(): Point[] {
+    return executeSDKFunction(LuxandFaceSDK.AnalysisContextDetectFacialFeatures, returnFeatures, this.handle);
+  }
 
   /**
-   * Set error behaviour. 
-   * @param {ON_ERROR} value The new on error behaviour.
-   * @returns {void}
+   * Detect facial attribute values (i.e. angles, liveness) of the detected face.
+   * @template {FacialAttribute[]} A
+   * @param {A} attributes The attributes to detect.
+   * @returns {Object} An object with attribute values. The obejct keys depend on which attriutes are requested.
    */
-  public static SetOnError(value: ON_ERROR): void {
-    this.onError = value;
+  public detectFacialAttribute<A extends FacialAttribute[]>(...attributes: A): FlatType<FacialAttributesResults<A>> {
+    return executeSDKFunction(LuxandFaceSDK.AnalysisContextDetectFacialAttribute, makeReturnAttributes(...attributes), this.handle, attributes.join(';'), 128 * attributes.length);
   }
 
   /**
-   * Activate the library. Must be called before any other FSDK function.
-   * @param {string} licenseKey The license key string.
-   * @returns {void}
+   * Detect facial attribute values (i.e. angles, liveness) of the detected face.
+   * @param {string | string[]} attribute The attribute (or array of attributes) to detect.
+   * @param {string} maxSize The maximal size of the returned string.
+   * @returns {string} A string with the detected attribute values in key1=value1;key2=value2; format.
    */
-  public static ActivateLibrary(licenseKey: string): void {
-    LuxandFaceSDK.SetParameter('environment', 'reactnative');
-    return executeSDKFunction(LuxandFaceSDK.ActivateLibrary, returnVoid, licenseKey);
+  public detectFacialAttributeRaw(attribute: string | string[], maxSize: number = 256): string {
+    return executeSDKFunction(LuxandFaceSDK.AnalysisContextDetectFacialAttribute, returnEmptyString, this.handle, attribute instanceof Array ? attribute.join(';') : attribute, maxSize);
   }
 
   /**
-   * Initializes the library. Must be called after {@member ActivateLibrary}.
-   * @returns {void}
+   * Get the face template of the detected face. Note that the face template size is 2068 bytes.
+   * @returns {FaceTemplate} The face template.
    */
-  public static Initialize(): void {
-    return executeSDKFunction(LuxandFaceSDK.Initialize, returnVoid);
+  public getFaceTemplate(): FaceTemplate {
+    return executeSDKFunction(LuxandFaceSDK.AnalysisContextGetFaceTemplate, returnFaceTemplate, this.handle);
   }
+}
+
+
+/**
+ * A wrapper object for a content addressed face template cache. Templates are looked up by a hash of the image file or buffer contents
+ * (or of the image pixels), of the global SDK parameters and of the cache configuration, so enrolling the same photos again skips decoding, face detection and template extraction.
+ * The least recently used entries are evicted when the cache exceeds its capacity. A cache created with a filename is loaded from the file
+ * and written back by save() and free().
+ */
+export class TemplateCache extends FSDKObject {
 
   /**
-   * Activates and initializes the library. Must be called before any other FSDK function.
-   * @param {string} licenseKey The license key string.
-   * @returns {void}
+   * Create a template cache.
+   * @param {string} filename The file to persist the cache in. An empty string creates a cache kept in memory only.
+   * @param {number} maxEntries The maximal number of cached templates. Each entry takes about 2.1 KB.
+   * @param {string} configuration Extra context for the keys. The parameters set with SetParameter(s), SetFaceDetectionParameters and
+   * SetFaceDetectionThreshold are added to the keys automatically, so this only needs to describe anything else that affects the templates.
+   * Entries created with a different configuration or different parameters are never returned.
+   * @returns {TemplateCache} The template cache.
    */
-  public static ActivateAndInitalize(licenseKey: string): void {
-    this.ActivateLibrary(licenseKey);
-    return this.Initialize();
+  public static Create(filename: string = '', maxEntries: number = 100000, configuration: string = ''): TemplateCache {
+    return executeSDKFunction(LuxandFaceSDK.CreateTemplateCache, returnTemplateCache, filename, maxEntries, configuration);
   }
 
   /**
-   * Get license information string.
-   * @returns {string} The information string.
+   * Save the cache and free it. The cache becomes invalid.
+   * @returns {void}
    */
-  public static GetLicenseInfo(): string {
-    return executeSDKFunction(LuxandFaceSDK.GetLicenseInfo, returnEmptyString)
+  public free(): void {
+    const result = executeSDKFunction(LuxandFaceSDK.FreeTemplateCache, returnVoid, this.handle);
+    this.handle = -1;
+    return result;
   }
 
   /**
-   * Create an empty image.
-   * @returns {Image} The image.
+   * Write the cache to its file. The file is replaced atomically.
+   * @returns {void}
    */
-  public static CreateEmptyImage(): Image {
-    return Image.Empty();
+  public save(): void {
+    return executeSDKFunction(LuxandFaceSDK.SaveTemplateCache, returnVoid, this.handle);
   }
 
   /**
-   * Free the internal image buffer. The image becomes invalid.
-   * @param {Image} image The image to free.
+   * Remove all the cached templates.
    * @returns {void}
    */
-  public static FreeImage(image: Image): void {
-    return image.free();
+  public clear(): void {
+    return executeSDKFunction(LuxandFaceSDK.ClearTemplateCache, returnVoid, this.handle);
   }
 
   /**
-   * Open an image from a file. PNG, JPG and BMP formats are supported.
-   * @param {string} filename The path to the image file.
-   * @returns {Image} The image.
+   * Get the number of cache hits, misses, stored entries and evicted entries.
+   * @returns {TemplateCacheStatistics} The cache statistics.
    */
-  public static LoadImageFromFile(filename: string): Image {
-    return Image.FromFile(filename);
+  public getStatistics(): TemplateCacheStatistics {
+    return executeSDKFunction(LuxandFaceSDK.GetTemplateCacheStatistics, returnTemplateCacheStatistics, this.handle);
   }
 
   /**
-   * Open an image from a file preserving the alpha channel. PNG, JPG and BMP formats are supported.
+   * Get the face template and the face detected on an image file (JPEG, PNG or any format supported by Image.FromFile).
+   * Images without faces are cached as well and fail with ERROR.FACE_NOT_FOUND.
    * @param {string} filename The path to the image file.
-   * @returns {Image} The image.
+   * @returns {CachedFaceTemplate} The face template and the face.
    */
-  public static LoadImageFromFileWithAlpha(filename: string): Image {
-    return Image.FromFileWithAlpha(filename);
+  public getFaceTemplateFromFile(filename: string): CachedFaceTemplate {
+    return executeSDKFunction(LuxandFaceSDK.TemplateCacheGetFaceTemplateFromFile, returnCachedFaceTemplate, this.handle, filename);
   }
 
   /**
-   * Load an image from a pixel byte buffer. The buffer encodes the image top to bottom with pixel stride equal to pixel byte size and row stride equal to {@param scanLine}.
+   * Get the face template and the face detected on a JPEG or PNG encoded image.
+   * @param {BufferLike} buffer The encoded image.
+   * @returns {CachedFaceTemplate} The face template and the face.
+   */
+  public getFaceTemplateFromBuffer(buffer: BufferLike): CachedFaceTemplate {
+    return executeSDKFunction(LuxandFaceSDK.TemplateCacheGetFaceTemplateFromBuffer, returnCachedFaceTemplate, this.handle, getBase64(buffer));
+  }
+
+  /**
+   * Get the face template and the face detected on an image. The cache key is computed from the image pixels.
+   * @param {Image} image The image.
+   * @returns {CachedFaceTemplate} The face template and the face.
+   */
+  public getFaceTemplate(image: Image): CachedFaceTemplate {
+    return executeSDKFunction(LuxandFaceSDK.TemplateCacheGetFaceTemplate, returnCachedFaceTemplate, this.handle, image.handle);
+  }
+}
+
+
+/**
+ * A wrapper object for a face thumbnail store. Thumbnails are downscaled JPEG images appended to a memory mapped file, which keeps face images
+ * of a tracker out of tracker memory. Thumbnails are decoded on access and the most recently used decoded images are kept in memory.
+ */
+export class ThumbnailStore extends FSDKObject {
+
+  /**
+   * Create a thumbnail store or open an existing one.
+   * @param {string} filename The file to keep the thumbnails in.
+   * @param {number} maxSize The maximal width and height of a thumbnail. Larger images are downscaled.
+   * JPEG quality is set by FSDK.SetJpegCompressionQuality.
+   * @param {number} maxCachedImages The maximal number of decoded images kept in memory.
+   * @returns {ThumbnailStore} The thumbnail store.
+   */
+  public static Create(filename: string, maxSize: number = 256, maxCachedImages: number = 64): ThumbnailStore {
+    return executeSDKFunction(LuxandFaceSDK.CreateThumbnailStore, returnThumbnailStore, filename, maxSize, maxCachedImages);
+  }
+
+  /**
+   * Free the store and detach it from trackers. The store becomes invalid, the thumbnails stay in its file.
+   * @returns {void}
+   */
+  public free(): void {
+    const result = executeSDKFunction(LuxandFaceSDK.FreeThumbnailStore, returnVoid, this.handle);
+    this.handle = -1;
+    return result;
+  }
+
+  /**
+   * Remove replaced and deleted thumbnails from the file. The store does it by itself when they take more than half of the file.
+   * @returns {void}
+   */
+  public compact(): void {
+    return executeSDKFunction(LuxandFaceSDK.CompactThumbnailStore, returnVoid, this.handle);
+  }
+
+  /**
+   * Get the number of stored thumbnails, the size of the file, the size taken by replaced and deleted thumbnails and the number of decoded images in memory.
+   * @returns {ThumbnailStoreStatistics} The store statistics.
+   */
+  public getStatistics(): ThumbnailStoreStatistics {
+    return executeSDKFunction(LuxandFaceSDK.GetThumbnailStoreStatistics, returnThumbnailStoreStatistics, this.handle);
+  }
+}
+
+
+/**
+ * Runs a tracker on every few frames only and moves the faces it found natively on the frames in between.
+ */
+export class KeyframeTracker extends FSDKObject {
+
+  /**
+   * Create a keyframe tracker over a tracker. The tracker keeps its parameters and face IDs.
+   * @param {Tracker} tracker The tracker to run on keyframes.
+   * @param {number} keyframeInterval The tracker runs on every keyframeInterval-th frame.
+   * @param {number} searchRadius The maximal displacement of a face between two frames, in pixels of the image downscaled to about workingWidth.
+   * @param {number} minCorrelation A frame where any face matches its keyframe appearance worse than this becomes a keyframe.
+   * @param {number} workingWidth The width the image is downscaled to for motion tracking.
+   * @returns {KeyframeTracker} The keyframe tracker.
+   */
+  public static Create(tracker: Tracker, keyframeInterval: number = 5, searchRadius: number = 12, minCorrelation: number = 0.7, workingWidth: number = 320): KeyframeTracker {
+    return executeSDKFunction(LuxandFaceSDK.CreateKeyframeTracker, returnKeyframeTracker, tracker.handle, keyframeInterval, workingWidth, searchRadius, minCorrelation);
+  }
+
+  /**
+   * Free the keyframe tracker. The tracker it runs is not freed.
+   * @returns {void}
+   */
+  public free(): void {
+    const result = executeSDKFunction(LuxandFaceSDK.FreeKeyframeTracker, returnVoid, this.handle);
+    this.handle = -1;
+    return result;
+  }
+
+  /**
+   * Process a frame. On keyframes it is fed to the tracker, on other frames the faces of the last keyframe are moved.
+   * @param {Image} image The image to process.
+   * @param {number} maxFaces Maximal number of faces to process.
+   * @param {number} index Camera index.
+   * @returns {KeyframeFrame} Array of ids and whether the frame was a keyframe.
+   */
+  public feedFrame(image: Image, maxFaces: number = 256, index: number = 0): KeyframeFrame {
+    return executeSDKFunction(LuxandFaceSDK.KeyframeTrackerFeedFrame, returnKeyframeFrame, this.handle, index, image.handle, maxFaces);
+  }
+
+  /**
+   * Get face (bounding box) for a id on the last frame.
+   * @param {number} id Id of the face to get face for.
+   * @param {number} index Camera index.
+   * @returns {Face} The face.
+   */
+  public getFace(id: number, index: number = 0): Face {
+    return executeSDKFunction(LuxandFaceSDK.KeyframeTrackerGetFace, returnFace, this.handle, index, id);
+  }
+
+  /**
+   * Get facial feature coordinates for a id on the last frame.
+   * @param {number} id Id of the face to get facial feature coordinates for.
+   * @param {number} index Camera index.
+   * @returns {Point[]} Array of 70 points -- the facial feature coordinates.
+   */
+  public getFacialFeatures(id: number, index: number = 0): Point[] {
+    return executeSDKFunction(LuxandFaceSDK.KeyframeTrackerGetFacialFeatures, returnFeatures, this.handle, index, id);
+  }
+}
+
+
+/** The reader functions defined natively by InstallJSIBindings */
+interface NativeResultSlotReader {
+
+  readonly sequence: number;
+  readonly timestamp: number;
+  readonly count: number;
+  readonly stride: number;
+  update(): boolean;
+  read(values: Float64Array): number;
+  name(face: number): string | undefined;
+  attribute(face: number, attribute: number): string | undefined;
+
+}
+
+declare global {
+  var __FSDKCreateResultSlotReader: ((slot: number) => NativeResultSlotReader | null | undefined) | undefined;
+  var __FSDKGetTrackerFaceThumbnail: ((tracker: number, faceID: number) => ArrayBuffer | number) | undefined;
+  var __FSDKExtractFaceAtlas: ((image: number, features: Int32Array, count: number, width: number, height: number, imageMode: number, threads: number) => NativeFaceAtlas | number) | undefined;
+}
+
+var jsiBindingsInstalled = false;
+
+function installJSIBindings(): boolean {
+  if (!jsiBindingsInstalled) {
+    executeSDKFunction(LuxandFaceSDK.InstallJSIBindings, returnVoid);
+    jsiBindingsInstalled = global.__FSDKCreateResultSlotReader !== undefined;
+  }
+  return jsiBindingsInstalled;
+}
+
+
+/**
+ * Holds the latest faces found by a tracker. The frame pipeline writes them natively and the JavaScript thread reads them through
+ * a ResultSlotReader, so neither side waits for the other and frames published faster than they are read are skipped.
+ */
+export class ResultSlot extends FSDKObject {
+
+  public maxFaces: number = 0;
+  public attributes: string[] = [];
+  private _reader?: ResultSlotReader;
+
+  /**
+   * Create a result slot.
+   * @param {number} maxFaces The maximal number of faces kept for a frame.
+   * @param {string[]} attributes Tracker facial attributes kept for every face, i.e. ['Liveness', 'ImageQuality'].
+   * @returns {ResultSlot} The result slot.
+   */
+  public static Create(maxFaces: number = 16, attributes: string[] = []): ResultSlot {
+    const slot = executeSDKFunction(LuxandFaceSDK.CreateResultSlot, returnResultSlot, maxFaces, attributes.join(';'));
+    slot.maxFaces = maxFaces;
+    slot.attributes = attributes;
+    return slot;
+  }
+
+  /**
+   * Free the slot and detach it from trackers. Readers of the slot keep returning its last snapshot.
+   * @returns {void}
+   */
+  public free(): void {
+    const result = executeSDKFunction(LuxandFaceSDK.FreeResultSlot, returnVoid, this.handle);
+    this.handle = -1;
+    return result;
+  }
+
+  /**
+   * Get the reader of the slot, created on the first call. Must be called on the JavaScript thread. A slot has a single reader,
+   * creating another one for the same slot (i.e. from another ResultSlot object) fails while the first one is alive.
+   * @returns {ResultSlotReader} The reader.
+   */
+  public reader(): ResultSlotReader {
+    if (this._reader)
+      return this._reader;
+
+    installJSIBindings();
+    const reader = global.__FSDKCreateResultSlotReader?.(this.handle);
+    if (reader === undefined)
+      throw new FSDKError(`Result slot ${this.handle} is invalid or JSI bindings are not available.`, ERROR.INVALID_ARGUMENT, {});
+    if (reader === null)
+      throw new FSDKError(`Result slot ${this.handle} already has a reader.`, ERROR.INVALID_ARGUMENT, {});
+
+    this._reader = new ResultSlotReader(reader, this.maxFaces, this.attributes);
+    return this._reader;
+  }
+}
+
+
+/**
+ * Reads the snapshots published into a result slot. Call update() as often as needed, i.e. on every animation frame:
+ * it does not block and returns false when there is nothing new.
+ */
+export class ResultSlotReader {
+
+  private readonly values: Float64Array;
+  private readonly stride: number;
+  private readonly _update: () => boolean;
+  private readonly _read: (values: Float64Array) => number;
+  private readonly _name: (face: number) => string | undefined;
+  private readonly _attribute: (face: number, attribute: number) => string | undefined;
+
+  constructor(private readonly native: NativeResultSlotReader, public readonly maxFaces: number, public readonly attributes: string[]) {
+    /** Native functions are taken once, so reading does not create them on every frame */
+    this._update = native.update;
+    this._read = native.read;
+    this._name = native.name;
+    this._attribute = native.attribute;
+    this.stride = native.stride;
+    this.values = new Float64Array(maxFaces * this.stride);
+  }
+
+  /**
+   * Take the latest published snapshot.
+   * @returns {boolean} Whether a new snapshot was published since the last call.
+   */
+  public update(): boolean {
+    return this._update();
+  }
+
+  /** The sequence number of the current snapshot, 0 before the first one */
+  public get sequence(): number {
+    return this.native.sequence;
+  }
+
+  /** The frame timestamp of the current snapshot in nanoseconds, comparable with FSDK.GetTraceTime() */
+  public get timestamp(): number {
+    return this.native.timestamp;
+  }
+
+  /**
+   * Get the faces of the current snapshot.
+   * @returns {ResultSlotFace[]} The faces. Attributes that are missing or not numbers have NaN values.
+   */
+  public faces(): ResultSlotFace[] {
+    const count = this._read(this.values);
+    const faces: ResultSlotFace[] = [];
+
+    for (let i = 0; i < count; ++i) {
+      const offset = i * this.stride;
+      const attributes: Record<string, number> = {};
+      const rawAttributes: Record<string, string> = {};
+      this.attributes.forEach((name, k) => {
+        attributes[name] = this.values[offset + 5 + k]!;
+        rawAttributes[name] = this._attribute(i, k) ?? '';
+      });
+
+      faces.push({
+        id: this.values[offset]!,
+        bbox: { p0: { x: this.values[offset + 1]!, y: this.values[offset + 2]! }, p1: { x: this.values[offset + 3]!, y: this.values[offset + 4]! } },
+        name: this._name(i) ?? '',
+        attributes,
+        rawAttributes,
+      });
+    }
+
+    return faces;
+  }
+}
+
+
+/**
+ * Scores a face before the expensive work on it (templates, liveness and other facial attributes) is done, so frames with
+ * blurred, badly exposed, small or turned away faces can be skipped. Scores are computed natively on the luma of the face
+ * and on its landmarks, which takes well under a millisecond.
+ */
+export class QualityFilter extends FSDKObject {
+
+  /**
+   * Create a quality filter. Checks without a threshold always pass.
+   * @param {QualityFilterParameters} parameters The thresholds of the checks.
+   * @returns {QualityFilter} The quality filter.
+   */
+  public static Create(parameters: QualityFilterParameters = {}): QualityFilter {
+    return executeSDKFunction(LuxandFaceSDK.CreateQualityFilter, returnQualityFilter,
+                              parameters.minSharpness ?? 0, parameters.minBrightness ?? 0, parameters.maxBrightness ?? 255,
+                              parameters.maxClippedFraction ?? 1, parameters.minEyeDistance ?? 0, parameters.maxRoll ?? 180, parameters.maxYaw ?? 90);
+  }
+
+  /**
+   * Free the quality filter.
+   * @returns {void}
+   */
+  public free(): void {
+    const result = executeSDKFunction(LuxandFaceSDK.FreeQualityFilter, returnVoid, this.handle);
+    this.handle = -1;
+    return result;
+  }
+
+  /**
+   * Score a face found on the image.
+   * @param {Image} image The image.
+   * @param {Face} face The face, i.e. returned by image.detectFace2().
+   * @returns {FaceQuality} The scores and the failed checks.
+   */
+  public evaluate(image: Image, face: Face): FaceQuality {
+    return executeSDKFunction(LuxandFaceSDK.QualityFilterEvaluate, returnFaceQuality, this.handle, image.handle, face);
+  }
+
+  /**
+   * Score the face of a tracker ID.
+   * @param {Tracker} tracker The tracker.
+   * @param {number} id The ID.
+   * @param {Image} image The last frame fed to the tracker.
+   * @param {number} index Camera index.
+   * @returns {FaceQuality} The scores and the failed checks.
+   */
+  public evaluateTrackerFace(tracker: Tracker, id: number, image: Image, index: number = 0): FaceQuality {
+    return executeSDKFunction(LuxandFaceSDK.QualityFilterEvaluateTrackerFace, returnFaceQuality, this.handle, tracker.handle, index, id, image.handle);
+  }
+
+  /**
+   * Extract the face template like image.getFaceTemplateInRegion2(face) if the face passes the filter.
+   * @param {Image} image The image.
+   * @param {Face} face The face.
+   * @returns {QualityFaceTemplate} The template, null if the face failed the filter, and the scores.
+   */
+  public getFaceTemplate(image: Image, face: Face): QualityFaceTemplate {
+    return executeSDKFunction(LuxandFaceSDK.QualityFilterGetFaceTemplate, returnQualityFaceTemplate, this.handle, image.handle, face);
+  }
+}
+
+
+/**
+ * An approximate nearest neighbour index of face templates, for identification among more people than
+ * tracker.matchFaces() compares in time. A search compares the template with a few thousand templates
+ * instead of all of them.
+ */
+export class FaceIndex extends FSDKObject {
+
+  /**
+   * Create a face index.
+   * @param {FaceIndexParameters} parameters The parameters of the index graph.
+   * @param {string} filename The file to persist the index in. An empty string creates an index kept in memory only.
+   * @returns {FaceIndex} The face index.
+   */
+  public static Create(parameters: FaceIndexParameters = {}, filename: string = ''): FaceIndex {
+    return executeSDKFunction(LuxandFaceSDK.CreateFaceIndex, returnFaceIndex, filename,
+                              parameters.maxConnections ?? 16, parameters.efConstruction ?? 200, parameters.efSearch ?? 128);
+  }
+
+  /**
+   * Save the index and free it. The index becomes invalid.
+   * @returns {void}
+   */
+  public free(): void {
+    const result = executeSDKFunction(LuxandFaceSDK.FreeFaceIndex, returnVoid, this.handle);
+    this.handle = -1;
+    return result;
+  }
+
+  /**
+   * Write the index to its file. The file is replaced atomically.
+   * @returns {void}
+   */
+  public save(): void {
+    return executeSDKFunction(LuxandFaceSDK.SaveFaceIndex, returnVoid, this.handle);
+  }
+
+  /**
+   * Add a face template of a person. A person may have several templates.
+   * @param {number} id The id of the person, i.e. a tracker id.
+   * @param {FaceTemplate} template The face template.
+   * @returns {void}
+   */
+  public addFaceTemplate(id: number, template: FaceTemplate): void {
+    return executeSDKFunction(LuxandFaceSDK.FaceIndexAddFaceTemplate, returnVoid, this.handle, id, template.asBase64());
+  }
+
+  /**
+   * Add the face templates of every id of the tracker, replacing the templates added for these ids before.
+   * @param {Tracker} tracker The tracker.
+   * @returns {number} The number of templates added.
+   */
+  public addTrackerFaces(tracker: Tracker): number {
+    return executeSDKFunction(LuxandFaceSDK.FaceIndexAddTrackerFaces, returnZero, this.handle, tracker.handle);
+  }
+
+  /**
+   * Remove all the templates of a person.
+   * @param {number} id The id of the person.
+   * @returns {void}
+   */
+  public removeID(id: number): void {
+    return executeSDKFunction(LuxandFaceSDK.FaceIndexRemoveID, returnVoid, this.handle, id);
+  }
+
+  /**
+   * Get ids and their similarities for a face template, like tracker.matchFaces().
+   * @param {FaceTemplate} template The template to find similar ids for.
+   * @param {number} threshold Matching similarity threshold for the returned ids.
+   * @param {number} maxSize Maximal number of ids to return.
+   * @returns {IDSimilarity[]} Array of ids and their similarities, the most similar first.
+   */
+  public matchFaces(template: FaceTemplate, threshold: number, maxSize: number = 16): IDSimilarity[] {
+    return executeSDKFunction(LuxandFaceSDK.FaceIndexMatchFaces, returnIDSimilarities, this.handle, template.asBase64(), threshold, maxSize);
+  }
+
+  /**
+   * Get the number of indexed templates, ids and removed templates, and the number of searches and templates compared.
+   * @returns {FaceIndexStatistics} The index statistics.
+   */
+  public getStatistics(): FaceIndexStatistics {
+    return executeSDKFunction(LuxandFaceSDK.GetFaceIndexStatistics, returnFaceIndexStatistics, this.handle);
+  }
+}
+
+/** Main FSDK class, exposing all the functions at once */
+export default class FSDK {
+
+  public static readonly LuxandFaceSDK = LuxandFaceSDK;
+
+  public static readonly Image = Image;
+  public static readonly Buffer = Buffer;
+  public static readonly Camera = Camera;
+  public static readonly Tracker = Tracker;
+  public static readonly FaceTemplate = FaceTemplate;
+  public static readonly AnalysisContext = AnalysisContext;
+  public static readonly TemplateCache = TemplateCache;
+  public static readonly ThumbnailStore = ThumbnailStore;
+  public static readonly KeyframeTracker = KeyframeTracker;
+  public static readonly ResultSlot = ResultSlot;
+  public static readonly QualityFilter = QualityFilter;
+  public static readonly FaceIndex = FaceIndex;
+
+  public static readonly ERROR = ERROR;
+  public static readonly FEATURE = FEATURE;
+  public static readonly IMAGEMODE = IMAGEMODE;
+  public static readonly FACIAL_FEATURE_COUNT = FACIAL_FEATURE_COUNT;
+  public static readonly VIDEOCOMPRESSIONTYPE = VIDEOCOMPRESSIONTYPE;
+  public static readonly QUALITY_CHECK = QUALITY_CHECK;
+
+  public static readonly ON_ERROR = ON_ERROR;
+  public static onError = ON_ERROR.THROW;
+
+  public static readonly Worklets = FSDKWorklets;
+
+
+  /**
+   * Set error behaviour. 
+   * @param {ON_ERROR} value The new on error behaviour.
+   * @returns {void}
+   */
+  public static SetOnError(value: ON_ERROR): void {
+    this.onError = value;
+  }
+
+  /**
+   * Activate the library. Must be called before any other FSDK function.
+   * @param {string} licenseKey The license key string.
+   * @returns {void}
+   */
+  public static ActivateLibrary(licenseKey: string): void {
+    LuxandFaceSDK.SetParameter('environment', 'reactnative');
+    return executeSDKFunction(LuxandFaceSDK.ActivateLibrary, returnVoid, licenseKey);
+  }
+
+  /**
+   * Initializes the library. Must be called after {@member ActivateLibrary}.
+   * @returns {void}
+   */
+  public static Initialize(): void {
+    return executeSDKFunction(LuxandFaceSDK.Initialize, returnVoid);
+  }
+
+  /**
+   * Activates and initializes the library. Must be called before any other FSDK function.
+   * @param {string} licenseKey The license key string.
+   * @returns {void}
+   */
+  public static ActivateAndInitalize(licenseKey: string): void {
+    this.ActivateLibrary(licenseKey);
+    return this.Initialize();
+  }
+
+  /**
+   * Get license information string.
+   * @returns {string} The information string.
+   */
+  public static GetLicenseInfo(): string {
+    return executeSDKFunction(LuxandFaceSDK.GetLicenseInfo, returnEmptyString)
+  }
+
+  /**
+   * Create an empty image.
+   * @returns {Image} The image.
+   */
+  public static CreateEmptyImage(): Image {
+    return Image.Empty();
+  }
+
+  /**
+   * Free the internal image buffer. The image becomes invalid.
+   * @param {Image} image The image to free.
+   * @returns {void}
+   */
+  public static FreeImage(image: Image): void {
+    return image.free();
+  }
+
+  /**
+   * Open an image from a file. PNG, JPG and BMP formats are supported.
+   * @param {string} filename The path to the image file.
+   * @returns {Image} The image.
+   */
+  public static LoadImageFromFile(filename: string): Image {
+    return Image.FromFile(filename);
+  }
+
+  /**
+   * Open an image from a file preserving the alpha channel. PNG, JPG and BMP formats are supported.
+   * @param {string} filename The path to the image file.
+   * @returns {Image} The image.
+   */
+  public static LoadImageFromFileWithAlpha(filename: string): Image {
+    return Image.FromFileWithAlpha(filename);
+  }
+
+  /**
+   * Load an image from a pixel byte buffer. The buffer encodes the image top to bottom with pixel stride equal to pixel byte size and row stride equal to {@param scanLine}.
    * @param {BufferLike} buffer The image buffer.
    * @param {number} width The width of the image.
    * @param {number} height The height of the image.
@@ -1466,6 +2461,20 @@ export default class FSDK {
     return image.extractFace(features, width, height);
   }
 
+  /**
+   * Extract several faces at once, in parallel, into a single atlas buffer.
+   * @param {Image} image The image to extract the faces from.
+   * @param {Point[][] | Int32Array} features Arrays of face key points, one per face, or the key points of all the faces packed as x, y pairs.
+   * @param {number} width Target face width.
+   * @param {number} height Target face height.
+   * @param {IMAGEMODE} imageMode Pixel format of the atlas.
+   * @param {number} threads The number of threads, 0 uses all the cores.
+   * @returns {FaceAtlas} The atlas with a view of every face into it and the features of the faces in their coordinates.
+   */
+  public static ExtractFaceAtlas(image: Image, features: Point[][] | Int32Array, width: number, height: number, imageMode: IMAGEMODE = IMAGEMODE.IMAGE_COLOR_24BIT, threads: number = 0): FaceAtlas {
+    return image.extractFaceAtlas(features, width, height, imageMode, threads);
+  }
+
   /**
    * Detect a single face in the image. If multiple faces are present returns the one with the highest detection score. 
    * @param {Image} image The image to detect face on.
@@ -1504,6 +2513,22 @@ export default class FSDK {
     return image.detectMultipleFaces2(maxFaces);
   }
 
+  /**
+   * Detect multiple faces in a large image using the improved face detection algorithm. The image is split into overlapping tiles
+   * which are processed in parallel, and faces found in several tiles are merged. Images not larger than a tile are processed as a whole.
+   * @param {Image} image The image to detect faces on.
+   * @param {number} maxFaces The maximal number of faces to detect.
+   * @param {number} tileSize The side of a square tile in pixels.
+   * @param {number} overlap The number of pixels shared by neighbouring tiles. Should be not less than the smallest face of interest.
+   * @param {number} threads The number of worker threads, 0 to use all available cores.
+   * @param {boolean} fullImagePass Also detect faces on the whole image to find faces larger than a tile.
+   * @param {number} iouThreshold Detections overlapping with a higher intersection over union are merged.
+   * @returns {Face[]} The detected faces.
+   */
+  public static DetectMultipleFacesTiled(image: Image, maxFaces: number = 100, tileSize: number = 1024, overlap: number = 128, threads: number = 0, fullImagePass: boolean = true, iouThreshold: number = 0.4): Face[] {
+    return image.detectMultipleFacesTiled(maxFaces, tileSize, overlap, threads, fullImagePass, iouThreshold);
+  }
+
   /**
    * Set face detection parameters. These do not apply to the improved face detection algorithm.
    * @param {boolean} handleArbitraryRotations Detect rotated faces.
@@ -2196,4 +3221,394 @@ export default class FSDK {
     await copyAssetsToCacheDirectory();
     return executeSDKFunction(LuxandFaceSDK.InitializeIBeta, returnVoid);
   }
+
+  /**
+   * Initialize the library on a background thread. Model files are prefetched on several threads, the models are warmed up
+   * on a synthetic image, and the JavaScript thread stays free meanwhile. Replaces {@member Initialize} and
+   * {@member InitializeIBeta}; no other function except {@member GetInitializationStatus} may be called until the promise resolves.
+   * @param {InitializationOptions} options The initialization options.
+   * @returns {Promise<InitializationStatus>} The final status with the durations of the stages.
+   */
+  public static async InitializeAsync(options: InitializationOptions = {}): Promise<InitializationStatus> {
+    const { iBeta = false, prefetch = true, warmUp = true, trackerParameters = '', pollInterval = 20 } = options;
+
+    if (iBeta)
+      await copyAssetsToCacheDirectory();
+
+    const directories = prefetch ? modelDirectories().join(';') : '';
+    executeSDKFunction(LuxandFaceSDK.StartInitialization, returnVoid, directories, iBeta, warmUp, getParametersString(trackerParameters));
+
+    let status = this.GetInitializationStatus();
+    while (status.state == 'running') {
+      await new Promise(resolve => setTimeout(resolve, pollInterval));
+      status = this.GetInitializationStatus();
+    }
+
+    if (status.state == 'failed')
+      throw new FSDKError(`Function FSDK.InitializeAsync failed with error ${ERROR[status.errorCode] ?? ''}: ${status.errorCode}.`, status.errorCode, status);
+
+    return status;
+  }
+
+  /**
+   * Get the state of the initialization started with {@member InitializeAsync} and the durations of its stages.
+   * @returns {InitializationStatus} The initialization status.
+   */
+  public static GetInitializationStatus(): InitializationStatus {
+    return executeSDKFunction(LuxandFaceSDK.GetInitializationStatus, returnInitializationStatus);
+  }
+
+  /**
+   * Create an analysis context for an image. The context caches face detection, facial features, attributes and the face template.
+   * @param {Image} image The image to analyze.
+   * @returns {AnalysisContext} The analysis context.
+   */
+  public static CreateAnalysisContext(image: Image): AnalysisContext {
+    return AnalysisContext.Create(image);
+  }
+
+  /**
+   * Free the analysis context. The context becomes invalid.
+   * @param {AnalysisContext} context The context to free.
+   * @returns {void}
+   */
+  public static FreeAnalysisContext(context: AnalysisContext): void {
+    return context.free();
+  }
+
+  /**
+   * Enable or disable frame latency tracing. Spans of the frame pipeline (frame conversion, image creation, FeedFrame and spans recorded
+   * with RecordTraceSpan) are kept in a ring buffer holding the last {@param capacity} spans. Disabled tracing has negligible overhead.
+   * @param {boolean} enabled Enable tracing.
+   * @param {number} capacity The number of spans to keep.
+   * @returns {void}
+   */
+  public static SetTraceEnabled(enabled: boolean, capacity: number = 65536): void {
+    return executeSDKFunction(LuxandFaceSDK.SetTraceEnabled, returnVoid, enabled, capacity);
+  }
+
+  /**
+   * Remove all the recorded trace spans.
+   * @returns {void}
+   */
+  public static ClearTrace(): void {
+    return executeSDKFunction(LuxandFaceSDK.ClearTrace, returnVoid);
+  }
+
+  /**
+   * Get the current time of the trace clock in nanoseconds. Use it to measure spans passed to RecordTraceSpan.
+   * @returns {number} The current time in nanoseconds.
+   */
+  public static GetTraceTime(): number {
+    return executeSDKFunction(LuxandFaceSDK.GetTraceTime, returnZero);
+  }
+
+  /**
+   * Record a trace span, i.e. the time spent between a worklet and a JS callback.
+   * @param {string} name The span name.
+   * @param {number} frameTimestamp The timestamp of the camera frame the span belongs to.
+   * @param {number} start The span start time obtained with GetTraceTime.
+   * @param {number} end The span end time obtained with GetTraceTime, the current time by default.
+   * @returns {void}
+   */
+  public static RecordTraceSpan(name: string, frameTimestamp: number, start: number, end: number = FSDK.GetTraceTime()): void {
+    return executeSDKFunction(LuxandFaceSDK.RecordTraceSpan, returnVoid, name, frameTimestamp, start, end);
+  }
+
+  /**
+   * Get the recorded trace spans in Chrome trace event format. The result can be opened in chrome://tracing or https://ui.perfetto.dev.
+   * @returns {string} The trace JSON.
+   */
+  public static DumpTrace(): string {
+    return executeSDKFunction(LuxandFaceSDK.DumpTrace, returnEmptyString);
+  }
+
+  /**
+   * Save the recorded trace spans to a file in Chrome trace event format.
+   * @param {string} filename The path to the trace file.
+   * @returns {void}
+   */
+  public static SaveTrace(filename: string): void {
+    return executeSDKFunction(LuxandFaceSDK.SaveTrace, returnVoid, filename);
+  }
+
+  /**
+   * Start recording the camera frames converted by the frameToFSDKImage frame processor plugin, replacing a recording in progress.
+   * Raw frames keep their planes, strides, orientation and timestamps, compressed recordings store every converted frame as a JPEG image.
+   * Recordings are replayed offline with the frame_replay benchmark.
+   * @param {string} filename The path to the recording file.
+   * @param {boolean} compressed Whether to store JPEG images instead of raw frames.
+   * @returns {void}
+   */
+  public static StartFrameRecording(filename: string, compressed: boolean = false): void {
+    return executeSDKFunction(LuxandFaceSDK.StartFrameRecording, returnVoid, filename, compressed);
+  }
+
+  /**
+   * Stop the frame recording. Fails with the first error that prevented a frame from being recorded.
+   * @returns {FrameRecordingStatistics} The number of recorded frames and the size of the recording.
+   */
+  public static StopFrameRecording(): FrameRecordingStatistics {
+    return executeSDKFunction(LuxandFaceSDK.StopFrameRecording, returnFrameRecordingStatistics);
+  }
+
+  /**
+   * Create a content addressed face template cache.
+   * @param {string} filename The file to persist the cache in. An empty string creates a cache kept in memory only.
+   * @param {number} maxEntries The maximal number of cached templates.
+   * @param {string} configuration A string describing everything that affects the templates (i.e. detection and recognition parameters).
+   * @returns {TemplateCache} The template cache.
+   */
+  public static CreateTemplateCache(filename: string = '', maxEntries: number = 100000, configuration: string = ''): TemplateCache {
+    return TemplateCache.Create(filename, maxEntries, configuration);
+  }
+
+  /**
+   * Save the template cache and free it. The cache becomes invalid.
+   * @param {TemplateCache} cache The cache to free.
+   * @returns {void}
+   */
+  public static FreeTemplateCache(cache: TemplateCache): void {
+    return cache.free();
+  }
+
+  /**
+   * Create a face thumbnail store or open an existing one.
+   * @param {string} filename The file to keep the thumbnails in.
+   * @param {number} maxSize The maximal width and height of a thumbnail.
+   * @param {number} maxCachedImages The maximal number of decoded images kept in memory.
+   * @returns {ThumbnailStore} The thumbnail store.
+   */
+  public static CreateThumbnailStore(filename: string, maxSize: number = 256, maxCachedImages: number = 64): ThumbnailStore {
+    return ThumbnailStore.Create(filename, maxSize, maxCachedImages);
+  }
+
+  /**
+   * Free the thumbnail store and detach it from trackers. The store becomes invalid.
+   * @param {ThumbnailStore} store The store to free.
+   * @returns {void}
+   */
+  public static FreeThumbnailStore(store: ThumbnailStore): void {
+    return store.free();
+  }
+
+  /**
+   * Keep face images of the tracker in a thumbnail store instead of tracker memory.
+   * @param {Tracker} tracker The tracker.
+   * @param {ThumbnailStore | null} store The store to attach, or null to detach the attached store.
+   * @returns {void}
+   */
+  public static AttachThumbnailStore(tracker: Tracker, store: ThumbnailStore | null): void {
+    return tracker.attachThumbnailStore(store);
+  }
+
+  /**
+   * Get the JPEG encoded face image for face id from the thumbnail store attached to the tracker.
+   * @param {Tracker} tracker The tracker.
+   * @param {number} faceID Face id to get the thumbnail for.
+   * @returns {Buffer} The JPEG thumbnail.
+   */
+  public static GetTrackerFaceThumbnail(tracker: Tracker, faceID: number): Buffer {
+    return tracker.getFaceThumbnail(faceID);
+  }
+
+  /**
+   * Keep tracker memory within a budget of face templates by purging the least recently seen ids without a name that are not locked.
+   * @param {Tracker} tracker The tracker.
+   * @param {number} maxTemplates The number of face templates to keep, 0 for 90% of the MemoryLimit tracker parameter.
+   * @param {number} minIdleSeconds Ids seen more recently than this are never purged.
+   * @param {number} targetRatio The share of the budget kept after purging.
+   * @param {number} interval How often tracker memory is checked, in milliseconds.
+   * @returns {void}
+   */
+  public static AttachMemoryGovernor(tracker: Tracker, maxTemplates: number = 0, minIdleSeconds: number = 10, targetRatio: number = 0.8, interval: number = 1000): void {
+    return tracker.attachMemoryGovernor(maxTemplates, minIdleSeconds, targetRatio, interval);
+  }
+
+  /**
+   * Stop the memory governor of the tracker.
+   * @param {Tracker} tracker The tracker.
+   * @returns {void}
+   */
+  public static DetachMemoryGovernor(tracker: Tracker): void {
+    return tracker.detachMemoryGovernor();
+  }
+
+  /**
+   * Get the statistics of the memory governor of the tracker.
+   * @param {Tracker} tracker The tracker.
+   * @returns {MemoryGovernorStatistics} The memory governor statistics.
+   */
+  public static GetMemoryGovernorStatistics(tracker: Tracker): MemoryGovernorStatistics {
+    return tracker.getMemoryGovernorStatistics();
+  }
+
+  /**
+   * Create a result slot holding the latest faces found by a tracker.
+   * @param {number} maxFaces The maximal number of faces kept for a frame.
+   * @param {string[]} attributes Tracker facial attributes kept for every face.
+   * @returns {ResultSlot} The result slot.
+   */
+  public static CreateResultSlot(maxFaces: number = 16, attributes: string[] = []): ResultSlot {
+    return ResultSlot.Create(maxFaces, attributes);
+  }
+
+  /**
+   * Free the result slot and detach it from trackers.
+   * @param {ResultSlot} slot The slot to free.
+   * @returns {void}
+   */
+  public static FreeResultSlot(slot: ResultSlot): void {
+    return slot.free();
+  }
+
+  /**
+   * Publish the faces found on every frame fed to the tracker into a result slot.
+   * @param {Tracker} tracker The tracker.
+   * @param {ResultSlot | null} slot The slot to attach, or null to detach the attached slot.
+   * @returns {void}
+   */
+  public static AttachResultSlot(tracker: Tracker, slot: ResultSlot | null): void {
+    return tracker.attachResultSlot(slot);
+  }
+
+  /**
+   * Create a keyframe tracker, which runs the tracker on every few frames only and moves the faces natively in between.
+   * @param {Tracker} tracker The tracker to run on keyframes.
+   * @param {number} keyframeInterval The tracker runs on every keyframeInterval-th frame.
+   * @param {number} searchRadius The maximal displacement of a face between two frames, in pixels of the downscaled image.
+   * @param {number} minCorrelation A frame where any face matches its keyframe appearance worse than this becomes a keyframe.
+   * @param {number} workingWidth The width the image is downscaled to for motion tracking.
+   * @returns {KeyframeTracker} The keyframe tracker.
+   */
+  public static CreateKeyframeTracker(tracker: Tracker, keyframeInterval: number = 5, searchRadius: number = 12, minCorrelation: number = 0.7, workingWidth: number = 320): KeyframeTracker {
+    return KeyframeTracker.Create(tracker, keyframeInterval, searchRadius, minCorrelation, workingWidth);
+  }
+
+  /**
+   * Free the keyframe tracker. The tracker it runs is not freed.
+   * @param {KeyframeTracker} keyframeTracker The keyframe tracker to free.
+   * @returns {void}
+   */
+  public static FreeKeyframeTracker(keyframeTracker: KeyframeTracker): void {
+    return keyframeTracker.free();
+  }
+
+  /**
+   * Process a frame with a keyframe tracker.
+   * @param {KeyframeTracker} keyframeTracker The keyframe tracker.
+   * @param {Image} image The image to process.
+   * @param {number} maxFaces Maximal number of faces to process.
+   * @param {number} index Camera index.
+   * @returns {KeyframeFrame} Array of ids and whether the frame was a keyframe.
+   */
+  public static KeyframeTrackerFeedFrame(keyframeTracker: KeyframeTracker, image: Image, maxFaces: number = 256, index: number = 0): KeyframeFrame {
+    return keyframeTracker.feedFrame(image, maxFaces, index);
+  }
+
+  /**
+   * Get face (bounding box) for a id on the last frame fed to the keyframe tracker.
+   * @param {KeyframeTracker} keyframeTracker The keyframe tracker.
+   * @param {number} id Id of the face to get face for.
+   * @param {number} index Camera index.
+   * @returns {Face} The face.
+   */
+  public static KeyframeTrackerGetFace(keyframeTracker: KeyframeTracker, id: number, index: number = 0): Face {
+    return keyframeTracker.getFace(id, index);
+  }
+
+  /**
+   * Get facial feature coordinates for a id on the last frame fed to the keyframe tracker.
+   * @param {KeyframeTracker} keyframeTracker The keyframe tracker.
+   * @param {number} id Id of the face to get facial feature coordinates for.
+   * @param {number} index Camera index.
+   * @returns {Point[]} Array of 70 points -- the facial feature coordinates.
+   */
+  public static KeyframeTrackerGetFacialFeatures(keyframeTracker: KeyframeTracker, id: number, index: number = 0): Point[] {
+    return keyframeTracker.getFacialFeatures(id, index);
+  }
+
+  /**
+   * Create a quality filter, which scores faces before templates or liveness are computed for them.
+   * @param {QualityFilterParameters} parameters The thresholds of the checks.
+   * @returns {QualityFilter} The quality filter.
+   */
+  public static CreateQualityFilter(parameters: QualityFilterParameters = {}): QualityFilter {
+    return QualityFilter.Create(parameters);
+  }
+
+  /**
+   * Free the quality filter.
+   * @param {QualityFilter} filter The quality filter to free.
+   * @returns {void}
+   */
+  public static FreeQualityFilter(filter: QualityFilter): void {
+    return filter.free();
+  }
+
+  /**
+   * Score a face found on the image.
+   * @param {QualityFilter} filter The quality filter.
+   * @param {Image} image The image.
+   * @param {Face} face The face.
+   * @returns {FaceQuality} The scores and the failed checks.
+   */
+  public static QualityFilterEvaluate(filter: QualityFilter, image: Image, face: Face): FaceQuality {
+    return filter.evaluate(image, face);
+  }
+
+  /**
+   * Score the face of a tracker ID.
+   * @param {QualityFilter} filter The quality filter.
+   * @param {Tracker} tracker The tracker.
+   * @param {number} id The ID.
+   * @param {Image} image The last frame fed to the tracker.
+   * @param {number} index Camera index.
+   * @returns {FaceQuality} The scores and the failed checks.
+   */
+  public static QualityFilterEvaluateTrackerFace(filter: QualityFilter, tracker: Tracker, id: number, image: Image, index: number = 0): FaceQuality {
+    return filter.evaluateTrackerFace(tracker, id, image, index);
+  }
+
+  /**
+   * Extract the face template if the face passes the quality filter.
+   * @param {QualityFilter} filter The quality filter.
+   * @param {Image} image The image.
+   * @param {Face} face The face.
+   * @returns {QualityFaceTemplate} The template, null if the face failed the filter, and the scores.
+   */
+  public static QualityFilterGetFaceTemplate(filter: QualityFilter, image: Image, face: Face): QualityFaceTemplate {
+    return filter.getFaceTemplate(image, face);
+  }
+
+  /**
+   * Create an approximate nearest neighbour index of face templates.
+   * @param {FaceIndexParameters} parameters The parameters of the index graph.
+   * @param {string} filename The file to persist the index in, an empty string for an index kept in memory only.
+   * @returns {FaceIndex} The face index.
+   */
+  public static CreateFaceIndex(parameters: FaceIndexParameters = {}, filename: string = ''): FaceIndex {
+    return FaceIndex.Create(parameters, filename);
+  }
+
+  /**
+   * Save the face index and free it.
+   * @param {FaceIndex} index The face index.
+   * @returns {void}
+   */
+  public static FreeFaceIndex(index: FaceIndex): void {
+    return index.free();
+  }
+
+  /**
+   * Find the ids most similar to the face template in the face index.
+   * @param {FaceIndex} index The face index.
+   * @param {FaceTemplate} template The template to find similar ids for.
+   * @param {number} threshold Matching similarity threshold for the returned ids.
+   * @param {number} maxSize Maximal number of ids to return.
+   * @returns {IDSimilarity[]} Array of ids and their similarities, the most similar first.
+   */
+  public static FaceIndexMatchFaces(index: FaceIndex, template: FaceTemplate, threshold: number, maxSize: number = 16): IDSimilarity[] {
+    return index.matchFaces(template, threshold, maxSize);
+  }
 }